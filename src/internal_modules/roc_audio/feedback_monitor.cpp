@@ -8,6 +8,7 @@
 
 #include "roc_audio/feedback_monitor.h"
 #include "roc_audio/packetizer.h"
+#include "roc_core/fast_clock.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/time.h"
@@ -67,13 +68,13 @@ void FeedbackMonitor::start() {
     started_ = true;
 }
 
-void FeedbackMonitor::process_feedback(packet::stream_source_t source_id,
+bool FeedbackMonitor::process_feedback(packet::stream_source_t source_id,
                                        const LatencyMetrics& latency_metrics,
                                        const packet::LinkMetrics& link_metrics) {
     roc_panic_if(!is_valid());
 
     if (!started_) {
-        return;
+        return false;
     }
 
     if (!has_feedback_) {
@@ -89,7 +90,7 @@ void FeedbackMonitor::process_feedback(packet::stream_source_t source_id,
             // receivers exists for a single sender, which is not supported.
             // This also protects from outdated reports delivered from recently
             // restarted receiver.
-            return;
+            return false;
         }
 
         roc_log(LogInfo,
@@ -111,7 +112,9 @@ void FeedbackMonitor::process_feedback(packet::stream_source_t source_id,
     }
 
     has_feedback_ = true;
-    last_feedback_ts_ = core::timestamp(core::ClockMonotonic);
+    last_feedback_ts_ = core::fast_timestamp();
+
+    return true;
 }
 
 void FeedbackMonitor::write(Frame& frame) {
@@ -163,7 +166,7 @@ bool FeedbackMonitor::update_tuner_(packet::stream_timestamp_t duration) {
         return true;
     }
 
-    if (core::timestamp(core::ClockMonotonic) - last_feedback_ts_ > feedback_timeout_) {
+    if (core::fast_timestamp() - last_feedback_ts_ > feedback_timeout_) {
         roc_log(LogInfo,
                 "feedback monitor: no reports from receiver during timeout:"
                 " source=%lu timeout=%.3fms",
@@ -80,7 +80,11 @@ public:
     void start();
 
     //! Process feedback from receiver.
-    void process_feedback(packet::stream_source_t source_id,
+    //! @returns
+    //!  false if report was ignored, e.g. because monitoring isn't started
+    //!  or because report came from another source too early after
+    //!  previous source change.
+    bool process_feedback(packet::stream_source_t source_id,
                           const LatencyMetrics& latency_metrics,
                           const packet::LinkMetrics& link_metrics);
 
@@ -8,6 +8,7 @@
 
 #include "roc_audio/profiling_reader.h"
 #include "roc_audio/sample_spec.h"
+#include "roc_core/fast_clock.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 
@@ -37,11 +38,11 @@ bool ProfilingReader::read(Frame& frame) {
 }
 
 core::nanoseconds_t ProfilingReader::read_(Frame& frame, bool& ret) {
-    const core::nanoseconds_t start = core::timestamp(core::ClockMonotonic);
+    const core::nanoseconds_t start = core::fast_timestamp();
 
     ret = reader_.read(frame);
 
-    return core::timestamp(core::ClockMonotonic) - start;
+    return core::fast_timestamp() - start;
 }
 
 } // namespace audio
@@ -8,6 +8,7 @@
 
 #include "roc_audio/profiling_writer.h"
 #include "roc_audio/sample_spec.h"
+#include "roc_core/fast_clock.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 
@@ -33,11 +34,11 @@ void ProfilingWriter::write(Frame& frame) {
 }
 
 core::nanoseconds_t ProfilingWriter::write_(Frame& frame) {
-    const core::nanoseconds_t start = core::timestamp(core::ClockMonotonic);
+    const core::nanoseconds_t start = core::fast_timestamp();
 
     writer_.write(frame);
 
-    return core::timestamp(core::ClockMonotonic) - start;
+    return core::fast_timestamp() - start;
 }
 
 } // namespace audio
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/timing_reader.h"
+
+namespace roc {
+namespace audio {
+
+TimingReader::TimingReader(IFrameReader& reader, core::NestedTimer& timer)
+    : reader_(reader)
+    , timer_(timer) {
+}
+
+bool TimingReader::read(Frame& frame) {
+    core::NestedTimer::Scope scope;
+    timer_.begin(scope);
+
+    const bool ret = reader_.read(frame);
+
+    histogram_.add(timer_.end(scope));
+
+    return ret;
+}
+
+const core::DurationHistogram& TimingReader::histogram() const {
+    return histogram_;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/timing_reader.h
+//! @brief Timing reader.
+
+#ifndef ROC_AUDIO_TIMING_READER_H_
+#define ROC_AUDIO_TIMING_READER_H_
+
+#include "roc_audio/iframe_reader.h"
+#include "roc_core/duration_histogram.h"
+#include "roc_core/nested_timer.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+//! Timing reader.
+//! @remarks
+//!  Measures time spent in wrapped reader and accumulates it into
+//!  histogram. Time of other scopes nested into it and measured by the
+//!  same timer is excluded, see core::NestedTimer.
+class TimingReader : public IFrameReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p reader is wrapped; TimingReader reads frames from it
+    //!  - @p timer is used to measure exclusive time
+    TimingReader(IFrameReader& reader, core::NestedTimer& timer);
+
+    //! Read audio frame.
+    virtual bool read(Frame& frame);
+
+    //! Get accumulated histogram.
+    const core::DurationHistogram& histogram() const;
+
+private:
+    IFrameReader& reader_;
+    core::NestedTimer& timer_;
+    core::DurationHistogram histogram_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_TIMING_READER_H_
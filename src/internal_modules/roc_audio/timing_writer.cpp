@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/timing_writer.h"
+
+namespace roc {
+namespace audio {
+
+TimingWriter::TimingWriter(IFrameWriter& writer, core::NestedTimer& timer)
+    : writer_(writer)
+    , timer_(timer) {
+}
+
+void TimingWriter::write(Frame& frame) {
+    core::NestedTimer::Scope scope;
+    timer_.begin(scope);
+
+    writer_.write(frame);
+
+    histogram_.add(timer_.end(scope));
+}
+
+const core::DurationHistogram& TimingWriter::histogram() const {
+    return histogram_;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/async_log_writer.h"
+#include "roc_core/atomic_ops.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+AsyncLogWriter::AsyncLogWriter(const AsyncLogConfig& config,
+                               AsyncLogHandler handler,
+                               void* handler_arg,
+                               IArena& arena)
+    : config_(config)
+    , handler_(handler)
+    , handler_arg_(handler_arg)
+    , lanes_(arena, config.num_lanes, config.lane_size)
+    , num_written_(0)
+    , num_delivered_(0)
+    , num_dropped_(0)
+    , num_reported_(0)
+    , last_report_(0)
+    , valid_(false) {
+    roc_panic_if_msg(!handler, "async log writer: handler is null");
+
+    if (!lanes_.is_valid()) {
+        return;
+    }
+
+    set_policy(config_.thread_policy);
+    valid_ = true;
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    if (is_joinable()) {
+        roc_panic("async log writer: attempt to call destructor"
+                  " before calling stop() and join()");
+    }
+}
+
+bool AsyncLogWriter::is_valid() const {
+    return valid_;
+}
+
+bool AsyncLogWriter::write(const LogMessage& message) {
+    roc_panic_if(!valid_);
+
+    Record record;
+    record.level = message.level;
+    record.module = message.module;
+    record.file = message.file;
+    record.line = message.line;
+    record.time = message.time;
+    record.tid = message.tid;
+
+    strncpy(record.text, message.text ? message.text : "", MaxTextLen - 1);
+    record.text[MaxTextLen - 1] = '\0';
+
+    if (!lanes_.push(record, record.tid)) {
+        AtomicOps::fetch_add_relaxed(num_dropped_, (uint64_t)1);
+        return false;
+    }
+
+    AtomicOps::fetch_add_relaxed(num_written_, (uint64_t)1);
+
+    // Wake up background thread only if it's sleeping, to avoid
+    // syscalls on every message during bursts.
+    // Fence pairs with the one in run().
+    AtomicOps::fence_seq_cst();
+    if (sleeping_ && sleeping_.exchange(0)) {
+        wake_sem_.post();
+    }
+
+    return true;
+}
+
+uint64_t AsyncLogWriter::num_dropped() const {
+    return AtomicOps::load_relaxed(num_dropped_);
+}
+
+void AsyncLogWriter::flush() {
+    roc_panic_if(!valid_);
+
+    const uint64_t target = AtomicOps::load_relaxed(num_written_);
+
+    while (AtomicOps::load_acquire(num_delivered_) < target) {
+        if (sleeping_.exchange(0)) {
+            wake_sem_.post();
+        }
+        sleep_for(ClockMonotonic, Millisecond);
+    }
+}
+
+void AsyncLogWriter::stop() {
+    stop_ = true;
+    wake_sem_.post();
+}
+
+void AsyncLogWriter::run() {
+    roc_panic_if(!valid_);
+
+    last_report_ = timestamp(ClockMonotonic);
+
+    for (;;) {
+        const size_t n_records = drain_();
+
+        report_drops_(false);
+
+        if (n_records != 0) {
+            continue;
+        }
+
+        if (stop_) {
+            break;
+        }
+
+        // Announce that we're going to sleep, then check lanes again,
+        // to not miss messages written before writers could see the flag.
+        sleeping_ = 1;
+        AtomicOps::fence_seq_cst();
+
+        if (drain_() != 0) {
+            sleeping_ = 0;
+            continue;
+        }
+
+        (void)wake_sem_.timed_wait(timestamp(ClockMonotonic) + config_.report_interval);
+
+        sleeping_ = 0;
+    }
+
+    drain_();
+    report_drops_(true);
+}
+
+size_t AsyncLogWriter::drain_() {
+    size_t n_records = 0;
+
+    Record record;
+
+    for (size_t lane = 0; lane < lanes_.num_lanes(); lane++) {
+        while (lanes_.pop(lane, record)) {
+            deliver_(record);
+            n_records++;
+        }
+    }
+
+    if (n_records != 0) {
+        AtomicOps::fetch_add_release(num_delivered_, (uint64_t)n_records);
+    }
+
+    return n_records;
+}
+
+void AsyncLogWriter::deliver_(const Record& record) {
+    LogMessage msg;
+    msg.level = (LogLevel)record.level;
+    msg.module = record.module;
+    msg.file = record.file;
+    msg.line = record.line;
+    msg.time = record.time;
+    msg.pid = Thread::get_pid();
+    msg.tid = record.tid;
+    msg.text = record.text;
+
+    handler_(msg, handler_arg_);
+}
+
+void AsyncLogWriter::report_drops_(bool force) {
+    const nanoseconds_t now = timestamp(ClockMonotonic);
+
+    if (!force && now - last_report_ < config_.report_interval) {
+        return;
+    }
+    last_report_ = now;
+
+    const uint64_t total = AtomicOps::load_relaxed(num_dropped_);
+    if (total == num_reported_) {
+        return;
+    }
+
+    char text[MaxTextLen] = {};
+    snprintf(text, sizeof(text) - 1, "async log writer: dropped %llu message(s)",
+             (unsigned long long)(total - num_reported_));
+
+    num_reported_ = total;
+
+    LogMessage msg;
+    msg.level = LogInfo;
+    msg.module = "roc_core";
+    msg.file = __FILE__;
+    msg.line = __LINE__;
+    msg.time = timestamp(ClockUnix);
+    msg.pid = Thread::get_pid();
+    msg.tid = Thread::get_tid();
+    msg.text = text;
+
+    handler_(msg, handler_arg_);
+}
+
+} // namespace core
+} // namespace roc
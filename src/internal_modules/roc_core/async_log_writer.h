@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/async_log_writer.h
+//! @brief Asynchronous log writer.
+
+#ifndef ROC_CORE_ASYNC_LOG_WRITER_H_
+#define ROC_CORE_ASYNC_LOG_WRITER_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/iarena.h"
+#include "roc_core/lane_ring_buffer.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+struct LogMessage;
+
+//! Asynchronous log writer configuration.
+struct AsyncLogConfig {
+    //! Number of lanes.
+    //! Each lane is a separate ring buffer, concurrent writers use
+    //! different lanes. Should be not greater than LaneRingBuffer::MaxLanes.
+    size_t num_lanes;
+
+    //! Maximum number of queued messages per lane.
+    //! If lane becomes full, messages are dropped.
+    size_t lane_size;
+
+    //! How often to report dropped messages.
+    nanoseconds_t report_interval;
+
+    //! Scheduling policy of background thread.
+    ThreadPolicy thread_policy;
+
+    AsyncLogConfig()
+        : num_lanes(8)
+        , lane_size(256)
+        , report_interval(Second) {
+    }
+};
+
+//! Asynchronous log message handler.
+typedef void (*AsyncLogHandler)(const LogMessage& message, void* arg);
+
+//! Asynchronous log writer.
+//!
+//! Copies messages into lock-free ring buffers and passes them to handler
+//! from background thread, so that threads producing logs never block on
+//! output or on each other.
+//!
+//! Writer has several lanes (see LaneRingBuffer). Each writing thread selects
+//! lane based on its thread ID, so in most cases each thread has its own lane,
+//! and messages of one thread are delivered in order.
+//!
+//! If all lanes are busy or the selected lane is full, message is dropped.
+//! Dropped messages are counted and periodically reported.
+class AsyncLogWriter : public Thread {
+public:
+    enum {
+        //! Maximum length of message text, including terminating zero.
+        MaxTextLen = 256
+    };
+
+    //! Initialize.
+    //! @p handler and @p handler_arg define where messages are passed.
+    AsyncLogWriter(const AsyncLogConfig& config,
+                   AsyncLogHandler handler,
+                   void* handler_arg,
+                   IArena& arena);
+
+    //! Deinitialize.
+    ~AsyncLogWriter();
+
+    //! Check if initialized without errors.
+    bool is_valid() const;
+
+    //! Enqueue message.
+    //! Makes a copy of message, including text. Module and file names
+    //! are expected to be string literals and are not copied.
+    //! Lock-free operation.
+    //! @returns
+    //!  false if message was dropped.
+    bool write(const LogMessage& message);
+
+    //! Get total number of dropped messages.
+    uint64_t num_dropped() const;
+
+    //! Wait until all enqueued messages are passed to handler.
+    //! Blocking operation.
+    void flush();
+
+    //! Stop background thread.
+    //! Remaining messages are delivered before thread exits.
+    void stop();
+
+private:
+    struct Record {
+        int level;
+        const char* module;
+        const char* file;
+        int line;
+        nanoseconds_t time;
+        uint64_t tid;
+        char text[MaxTextLen];
+    };
+
+    virtual void run();
+
+    size_t drain_();
+    void deliver_(const Record& record);
+    void report_drops_(bool force);
+
+    const AsyncLogConfig config_;
+
+    AsyncLogHandler handler_;
+    void* handler_arg_;
+
+    LaneRingBuffer<Record> lanes_;
+
+    Semaphore wake_sem_;
+    Atomic<int> sleeping_;
+
+    uint64_t num_written_;
+    uint64_t num_delivered_;
+    uint64_t num_dropped_;
+    uint64_t num_reported_;
+    nanoseconds_t last_report_;
+
+    Atomic<int> stop_;
+    bool valid_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_ASYNC_LOG_WRITER_H_
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/counting_arena.h"
+#include "roc_core/atomic_ops.h"
+
+namespace roc {
+namespace core {
+
+CountingArena::CountingArena(IArena& arena)
+    : arena_(arena)
+    , num_allocations_(0)
+    , num_failures_(0)
+    , num_bytes_(0)
+    , max_bytes_(0) {
+}
+
+size_t CountingArena::num_allocations() const {
+    return AtomicOps::load_relaxed(num_allocations_);
+}
+
+size_t CountingArena::num_failures() const {
+    return AtomicOps::load_relaxed(num_failures_);
+}
+
+size_t CountingArena::num_bytes() const {
+    return AtomicOps::load_relaxed(num_bytes_);
+}
+
+size_t CountingArena::max_bytes() const {
+    return AtomicOps::load_relaxed(max_bytes_);
+}
+
+void* CountingArena::allocate(size_t size) {
+    void* ptr = arena_.allocate(size);
+    if (!ptr) {
+        AtomicOps::fetch_add_relaxed(num_failures_, (size_t)1);
+        return NULL;
+    }
+
+    const size_t alloc_size = arena_.allocated_size(ptr);
+
+    AtomicOps::fetch_add_relaxed(num_allocations_, (size_t)1);
+
+    const size_t cur_bytes = AtomicOps::fetch_add_relaxed(num_bytes_, alloc_size)
+        + alloc_size;
+
+    // Lock-free update of maximum.
+    size_t prev_max = AtomicOps::load_relaxed(max_bytes_);
+    while (prev_max < cur_bytes) {
+        if (AtomicOps::compare_exchange_relaxed(max_bytes_, prev_max, cur_bytes)) {
+            break;
+        }
+    }
+
+    return ptr;
+}
+
+void CountingArena::deallocate(void* ptr) {
+    const size_t alloc_size = arena_.allocated_size(ptr);
+
+    arena_.deallocate(ptr);
+
+    AtomicOps::fetch_sub_relaxed(num_allocations_, (size_t)1);
+    AtomicOps::fetch_sub_relaxed(num_bytes_, alloc_size);
+}
+
+size_t CountingArena::compute_allocated_size(size_t size) const {
+    return arena_.compute_allocated_size(size);
+}
+
+size_t CountingArena::allocated_size(void* ptr) const {
+    return arena_.allocated_size(ptr);
+}
+
+} // namespace core
+} // namespace roc
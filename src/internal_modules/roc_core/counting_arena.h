@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/counting_arena.h
+//! @brief Counting arena.
+
+#ifndef ROC_CORE_COUNTING_ARENA_H_
+#define ROC_CORE_COUNTING_ARENA_H_
+
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Decorator around IArena to collect memory usage statistics.
+//! @remarks
+//!  Counts bytes as reported by underlying arena, i.e. including its
+//!  internal overhead.
+//!
+//! Thread-safe if underlying arena is thread-safe.
+class CountingArena : public NonCopyable<>, public IArena {
+public:
+    //! Initialize.
+    explicit CountingArena(IArena& arena);
+
+    //! Get number of currently allocated blocks.
+    size_t num_allocations() const;
+
+    //! Get number of failed allocations.
+    size_t num_failures() const;
+
+    //! Get number of currently allocated bytes.
+    size_t num_bytes() const;
+
+    //! Get maximum number of bytes allocated at the same time.
+    size_t max_bytes() const;
+
+    //! Allocate memory and update counters.
+    //! @returns
+    //!  pointer to a maximum aligned uninitialized memory at least of @p size
+    //!  bytes or NULL if memory can't be allocated.
+    virtual void* allocate(size_t size);
+
+    //! Deallocate previously allocated memory and update counters.
+    virtual void deallocate(void* ptr);
+
+    //! Computes how many bytes will be actually allocated if allocate() is called with
+    //! given size. Covers all internal overhead, if any.
+    virtual size_t compute_allocated_size(size_t size) const;
+
+    //! Returns how many bytes was allocated for given pointer returned by allocate().
+    //! Covers all internal overhead, if any.
+    //! Returns same value as computed by compute_allocated_size(size).
+    virtual size_t allocated_size(void* ptr) const;
+
+private:
+    IArena& arena_;
+
+    size_t num_allocations_;
+    size_t num_failures_;
+    size_t num_bytes_;
+    size_t max_bytes_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_COUNTING_ARENA_H_
@@ -21,6 +21,7 @@ CsvDumper::CsvDumper(const char* path, const CsvConfig& config, IArena& arena)
     if (!open_(path)) {
         return;
     }
+    set_policy(config.thread_policy);
     valid_ = true;
 }
 
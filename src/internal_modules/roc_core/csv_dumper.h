@@ -20,6 +20,7 @@
 #include "roc_core/spsc_ring_buffer.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
 #include "roc_core/time.h"
 
 namespace roc {
@@ -52,6 +53,9 @@ struct CsvConfig {
     //! If non-zero, each entry type is rate-limited according to this.
     nanoseconds_t max_interval;
 
+    //! Scheduling policy of background thread.
+    ThreadPolicy thread_policy;
+
     CsvConfig()
         : max_queued(1000)
         , max_interval(Millisecond) {
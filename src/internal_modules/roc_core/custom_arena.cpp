@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/custom_arena.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+CustomArena::CustomArena(allocate_func_t allocate_func,
+                         deallocate_func_t deallocate_func,
+                         void* arg)
+    : allocate_func_(allocate_func)
+    , deallocate_func_(deallocate_func)
+    , arg_(arg)
+    , num_allocations_(0) {
+    if (!allocate_func_ || !deallocate_func_) {
+        roc_panic("custom arena: allocation functions are null");
+    }
+}
+
+CustomArena::~CustomArena() {
+    if (num_allocations_ != 0) {
+        // Not a panic, because leaks may be caused by user code.
+        roc_log(LogError, "custom arena: detected leak(s): %d chunk(s) were not freed",
+                (int)num_allocations_);
+    }
+}
+
+size_t CustomArena::num_allocations() const {
+    return (size_t)num_allocations_;
+}
+
+void* CustomArena::allocate(size_t size) {
+    const size_t chunk_size = sizeof(ChunkHeader) + size;
+
+    ChunkHeader* chunk = (ChunkHeader*)allocate_func_(chunk_size, arg_);
+
+    if (!chunk) {
+        roc_log(LogError,
+                "custom arena: allocation failed: chunk_size=%lu payload_size=%lu",
+                (unsigned long)chunk_size, (unsigned long)size);
+        return NULL;
+    }
+
+    if ((size_t)chunk % sizeof(AlignMax) != 0) {
+        roc_log(LogError,
+                "custom arena: user allocator returned misaligned memory:"
+                " ptr=%p required_alignment=%lu",
+                (void*)chunk, (unsigned long)sizeof(AlignMax));
+        deallocate_func_(chunk, arg_);
+        return NULL;
+    }
+
+    chunk->size = size;
+
+    num_allocations_++;
+
+    return chunk->data;
+}
+
+void CustomArena::deallocate(void* ptr) {
+    if (!ptr) {
+        roc_panic("custom arena: null pointer");
+    }
+
+    ChunkHeader* chunk = ROC_CONTAINER_OF(ptr, ChunkHeader, data);
+
+    const int n = num_allocations_--;
+    if (n == 0) {
+        roc_panic("custom arena: unpaired deallocate");
+    }
+
+    deallocate_func_(chunk, arg_);
+}
+
+size_t CustomArena::compute_allocated_size(size_t size) const {
+    return sizeof(ChunkHeader) + size;
+}
+
+size_t CustomArena::allocated_size(void* ptr) const {
+    if (!ptr) {
+        roc_panic("custom arena: null pointer");
+    }
+
+    ChunkHeader* chunk = ROC_CONTAINER_OF(ptr, ChunkHeader, data);
+
+    return compute_allocated_size(chunk->size);
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/custom_arena.h
+//! @brief Arena with user-provided allocation functions.
+
+#ifndef ROC_CORE_CUSTOM_ARENA_H_
+#define ROC_CORE_CUSTOM_ARENA_H_
+
+#include "roc_core/align_ops.h"
+#include "roc_core/atomic.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Arena with user-provided allocation functions.
+//!
+//! Forwards allocations to user functions, e.g. NUMA-local allocator or real-time
+//! heap provided by application. User functions should return memory aligned at
+//! least as malloc() does.
+//!
+//! Stores payload size in a small header before user data, so that allocated
+//! size can be reported without asking user allocator.
+//!
+//! Allocated chunks have the following format:
+//! @code
+//!  +-------------+-----------+
+//!  | ChunkHeader | user data |
+//!  +-------------+-----------+
+//! @endcode
+//!
+//! Thread-safe if user functions are thread-safe.
+class CustomArena : public IArena, public NonCopyable<> {
+public:
+    //! Allocation function.
+    //! Should return pointer to at least @p size bytes, or NULL.
+    typedef void* (*allocate_func_t)(size_t size, void* arg);
+
+    //! Deallocation function.
+    typedef void (*deallocate_func_t)(void* ptr, void* arg);
+
+    //! Initialize.
+    //! @p arg is passed to both functions.
+    CustomArena(allocate_func_t allocate_func,
+                deallocate_func_t deallocate_func,
+                void* arg);
+
+    ~CustomArena();
+
+    //! Get number of allocated blocks.
+    size_t num_allocations() const;
+
+    //! Allocate memory.
+    virtual void* allocate(size_t size);
+
+    //! Deallocate previously allocated memory.
+    virtual void deallocate(void* ptr);
+
+    //! Computes how many bytes will be actually allocated if allocate() is called with
+    //! given size. Covers all internal overhead, if any.
+    virtual size_t compute_allocated_size(size_t size) const;
+
+    //! Returns how many bytes was allocated for given pointer returned by allocate().
+    //! Covers all internal overhead, if any.
+    //! Returns same value as computed by compute_allocated_size(size).
+    virtual size_t allocated_size(void* ptr) const;
+
+private:
+    struct ChunkHeader {
+        // Data size.
+        size_t size;
+        // User data.
+        AlignMax data[];
+    };
+
+    allocate_func_t allocate_func_;
+    deallocate_func_t deallocate_func_;
+    void* arg_;
+
+    Atomic<int> num_allocations_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_CUSTOM_ARENA_H_
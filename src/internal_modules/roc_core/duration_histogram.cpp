@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/duration_histogram.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+size_t highest_bit(uint64_t value) {
+    size_t bit = 0;
+
+    if (value >> 32) {
+        value >>= 32;
+        bit += 32;
+    }
+    if (value >> 16) {
+        value >>= 16;
+        bit += 16;
+    }
+    if (value >> 8) {
+        value >>= 8;
+        bit += 8;
+    }
+    if (value >> 4) {
+        value >>= 4;
+        bit += 4;
+    }
+    if (value >> 2) {
+        value >>= 2;
+        bit += 2;
+    }
+    if (value >> 1) {
+        bit += 1;
+    }
+
+    return bit;
+}
+
+} // namespace
+
+DurationHistogram::DurationHistogram() {
+    reset();
+}
+
+void DurationHistogram::add(nanoseconds_t duration) {
+    if (duration < 0) {
+        duration = 0;
+    }
+
+    buckets_[bucket_index_(duration)]++;
+    count_++;
+
+    if (duration > max_) {
+        max_ = duration;
+    }
+}
+
+uint64_t DurationHistogram::count() const {
+    return count_;
+}
+
+nanoseconds_t DurationHistogram::max() const {
+    return max_;
+}
+
+nanoseconds_t DurationHistogram::quantile(double q) const {
+    roc_panic_if_msg(q < 0 || q > 1,
+                     "duration histogram: quantile out of range: expected [0; 1], got %f",
+                     q);
+
+    if (count_ == 0) {
+        return 0;
+    }
+
+    const uint64_t rank = rank_(q);
+
+    uint64_t seen = 0;
+    size_t n = 0;
+
+    for (; n < NumBuckets - 1; n++) {
+        seen += buckets_[n];
+
+        if (seen >= rank) {
+            break;
+        }
+    }
+
+    return bucket_value_(n);
+}
+
+DurationMetrics DurationHistogram::metrics() const {
+    DurationMetrics metrics;
+
+    metrics.max = max_;
+    metrics.count = count_;
+
+    if (count_ == 0) {
+        return metrics;
+    }
+
+    // Ranks are non-decreasing, so all quantiles are found in a single
+    // pass over buckets.
+    const uint64_t rank_p50 = rank_(0.5);
+    const uint64_t rank_p99 = rank_(0.99);
+    const uint64_t rank_p999 = rank_(0.999);
+
+    bool found_p50 = false, found_p99 = false;
+
+    uint64_t seen = 0;
+    size_t n = 0;
+
+    for (; n < NumBuckets - 1; n++) {
+        seen += buckets_[n];
+
+        if (!found_p50 && seen >= rank_p50) {
+            metrics.p50 = bucket_value_(n);
+            found_p50 = true;
+        }
+        if (!found_p99 && seen >= rank_p99) {
+            metrics.p99 = bucket_value_(n);
+            found_p99 = true;
+        }
+        if (seen >= rank_p999) {
+            break;
+        }
+    }
+
+    metrics.p999 = bucket_value_(n);
+
+    if (!found_p50) {
+        metrics.p50 = metrics.p999;
+    }
+    if (!found_p99) {
+        metrics.p99 = metrics.p999;
+    }
+
+    return metrics;
+}
+
+void DurationHistogram::reset() {
+    for (size_t n = 0; n < NumBuckets; n++) {
+        buckets_[n] = 0;
+    }
+    count_ = 0;
+    max_ = 0;
+}
+
+uint64_t DurationHistogram::rank_(double q) const {
+    uint64_t rank = uint64_t(q * (double)count_ + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+    if (rank > count_) {
+        rank = count_;
+    }
+    return rank;
+}
+
+nanoseconds_t DurationHistogram::bucket_value_(size_t index) const {
+    // Last bucket also counts durations above its upper bound.
+    if (index == NumBuckets - 1) {
+        return max_;
+    }
+
+    const nanoseconds_t bound = bucket_upper_bound_(index);
+    return bound < max_ ? bound : max_;
+}
+
+size_t DurationHistogram::bucket_index_(nanoseconds_t duration) {
+    const uint64_t value = uint64_t(duration) >> ResolutionBits;
+
+    // Linear part: first octave is split with full resolution.
+    if (value < (1 << SubBucketBits)) {
+        return (size_t)value;
+    }
+
+    // Logarithmic part: octave is defined by highest bit, sub-bucket by
+    // following SubBucketBits bits.
+    const size_t msb = highest_bit(value);
+    const size_t octave = msb - SubBucketBits + 1;
+
+    if (octave > NumOctaves) {
+        return NumBuckets - 1;
+    }
+
+    const size_t sub_bucket =
+        size_t(value >> (msb - SubBucketBits)) & ((1 << SubBucketBits) - 1);
+
+    return (octave << SubBucketBits) | sub_bucket;
+}
+
+nanoseconds_t DurationHistogram::bucket_upper_bound_(size_t index) {
+    if (index < (1 << SubBucketBits)) {
+        return nanoseconds_t(index + 1) << ResolutionBits;
+    }
+
+    const size_t octave = index >> SubBucketBits;
+    const size_t sub_bucket = index & ((1 << SubBucketBits) - 1);
+    const size_t msb = octave + SubBucketBits - 1;
+
+    const uint64_t upper = uint64_t((1 << SubBucketBits) + sub_bucket + 1)
+        << (msb - SubBucketBits);
+
+    return nanoseconds_t(upper << ResolutionBits);
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/duration_histogram.h
+//! @brief Duration histogram.
+
+#ifndef ROC_CORE_DURATION_HISTOGRAM_H_
+#define ROC_CORE_DURATION_HISTOGRAM_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+//! Summary of duration distribution.
+struct DurationMetrics {
+    //! Median.
+    nanoseconds_t p50;
+
+    //! 99th percentile.
+    nanoseconds_t p99;
+
+    //! 99.9th percentile.
+    nanoseconds_t p999;
+
+    //! Maximum.
+    nanoseconds_t max;
+
+    //! Number of measurements.
+    uint64_t count;
+
+    DurationMetrics()
+        : p50(0)
+        , p99(0)
+        , p999(0)
+        , max(0)
+        , count(0) {
+    }
+};
+
+//! Duration histogram.
+//!
+//! Accumulates durations into fixed log-linear buckets: each power of two
+//! is split into 8 equal sub-buckets, which gives relative error below 12.5%.
+//! Durations are counted with 2^ResolutionBits nanoseconds precision,
+//! durations above the last bucket are counted in the last bucket.
+//!
+//! Adding a duration takes a few arithmetic operations, so histogram can be
+//! updated on every frame. No allocations, fixed memory footprint.
+//! Not thread-safe.
+class DurationHistogram : public NonCopyable<> {
+public:
+    enum {
+        //! Number of sub-buckets per power of two (log2).
+        SubBucketBits = 3,
+
+        //! Smallest distinguishable duration (log2 of nanoseconds).
+        ResolutionBits = 7,
+
+        //! Number of powers of two covered by buckets.
+        //! With 128ns resolution, buckets cover durations up to 17 seconds.
+        NumOctaves = 24,
+
+        //! Total number of buckets.
+        NumBuckets = (NumOctaves + 1) << SubBucketBits
+    };
+
+    //! Initialize empty histogram.
+    DurationHistogram();
+
+    //! Add measured duration.
+    //! Negative durations are counted as zero.
+    void add(nanoseconds_t duration);
+
+    //! Get number of added durations.
+    uint64_t count() const;
+
+    //! Get maximum added duration.
+    nanoseconds_t max() const;
+
+    //! Get quantile.
+    //! @p q should be in range [0; 1].
+    //! Returns upper bound of the bucket containing quantile, but not
+    //! greater than maximum added duration.
+    nanoseconds_t quantile(double q) const;
+
+    //! Compute summary.
+    //! @remarks
+    //!  All quantiles are computed in a single pass over buckets.
+    DurationMetrics metrics() const;
+
+    //! Remove all durations.
+    void reset();
+
+private:
+    uint64_t rank_(double q) const;
+    nanoseconds_t bucket_value_(size_t index) const;
+
+    static size_t bucket_index_(nanoseconds_t duration);
+    static nanoseconds_t bucket_upper_bound_(size_t index);
+
+    uint32_t buckets_[NumBuckets];
+    uint64_t count_;
+    nanoseconds_t max_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_DURATION_HISTOGRAM_H_
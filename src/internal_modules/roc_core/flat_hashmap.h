@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/flat_hashmap.h
+//! @brief Open-addressing hash table.
+
+#ifndef ROC_CORE_FLAT_HASHMAP_H_
+#define ROC_CORE_FLAT_HASHMAP_H_
+
+#include "roc_core/aligned_storage.h"
+#include "roc_core/attributes.h"
+#include "roc_core/hashsum.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Default key traits for FlatHashmap.
+//! Suitable for integer keys.
+template <class K> struct FlatHashmapKeyTraits {
+    //! Compute key hash.
+    static hashsum_t key_hash(const K& key) {
+        return hashsum_int(key);
+    }
+
+    //! Compare two keys for equality.
+    static bool key_equal(const K& key1, const K& key2) {
+        return key1 == key2;
+    }
+};
+
+//! Open-addressing hash table.
+//!
+//! Characteristics:
+//!  1) Flat. Keys and values are stored inline in a single array of slots, so
+//!     that lookup touches one or two cache lines instead of chasing pointers.
+//!  2) Linear probing with fingerprints. Each slot has a control byte holding
+//!     seven bits of key hash. Keys are compared only when fingerprint matches.
+//!  3) No tombstones. Removal uses backward shift, so lookup performance doesn't
+//!     degrade after many insertions and removals.
+//!  4) Controllable allocations. Arena is used only when the table grows, which
+//!     happens during insert() or reserve(). Other operations don't touch arena.
+//!  5) Zero allocations for small hash tables. A fixed number of slots can be
+//!     embedded directly into hash table object.
+//!
+//! Unlike Hashmap, this table is not intrusive: it owns copies of keys and values.
+//! It is best suited for small keys and values, like integers and pointers.
+//! Pointers to values are invalidated when table is modified.
+//!
+//! @tparam K defines key type; should be copy-constructible.
+//!
+//! @tparam V defines value type; should be copy-constructible.
+//!
+//! @tparam EmbeddedCapacity defines the capacity embedded directly into
+//! FlatHashmap. It is used instead of dynamic memory while the number of
+//! elements is smaller than this capacity.
+//!
+//! @tparam KeyTraits defines static key_hash() and key_equal() functions for
+//! keys, see FlatHashmapKeyTraits.
+template <class K,
+          class V,
+          size_t EmbeddedCapacity = 0,
+          class KeyTraits = FlatHashmapKeyTraits<K> >
+class FlatHashmap : public NonCopyable<> {
+public:
+    //! Initialize empty hashmap with arena.
+    //! @remarks
+    //!  Hashmap capacity may grow using arena.
+    explicit FlatHashmap(IArena& arena)
+        : arena_(arena)
+        , slots_(NULL)
+        , ctrl_(NULL)
+        , n_slots_(0)
+        , size_(0) {
+        if (NumEmbeddedSlots != 0) {
+            slots_ = (Slot*)embedded_slots_.memory();
+            ctrl_ = (uint8_t*)embedded_slots_.memory() + NumEmbeddedSlots * sizeof(Slot);
+            n_slots_ = NumEmbeddedSlots;
+            memset(ctrl_, 0, n_slots_);
+        }
+    }
+
+    //! Destroy all elements and release memory.
+    ~FlatHashmap() {
+        clear();
+        release_(slots_);
+    }
+
+    //! Get maximum number of elements that can be added to hashmap without
+    //! growing it.
+    size_t capacity() const {
+        return n_slots_ / LoadFactorDen * LoadFactorNum;
+    }
+
+    //! Get number of elements added to hashmap.
+    size_t size() const {
+        return size_;
+    }
+
+    //! Check if size is zero.
+    bool is_empty() const {
+        return size_ == 0;
+    }
+
+    //! Find value by key.
+    //!
+    //! @returns
+    //!  Pointer to the value or NULL if key is not found. Pointer is valid until
+    //!  hashmap is modified.
+    //!
+    //! @note
+    //!  - has O(1) complexity in average
+    //!  - computes key hash
+    V* find(const K& key) {
+        const size_t index = find_(key);
+        if (index == NotFound) {
+            return NULL;
+        }
+        return &slots_[index].value;
+    }
+
+    //! Find value by key.
+    //! @see find()
+    const V* find(const K& key) const {
+        const size_t index = find_(key);
+        if (index == NotFound) {
+            return NULL;
+        }
+        return &slots_[index].value;
+    }
+
+    //! Check if there is an element with given key.
+    bool contains(const K& key) const {
+        return find_(key) != NotFound;
+    }
+
+    //! Insert element into hashmap.
+    //!
+    //! @remarks
+    //!  Grows hashmap if needed.
+    //!
+    //! @returns
+    //!  false if the allocation failed.
+    //!
+    //! @pre
+    //!  Hashmap shouldn't have an element with the same key.
+    //!
+    //! @note
+    //!  - has O(1) complexity in average
+    //!  - computes key hash
+    //!  - may make allocations and deallocations
+    ROC_ATTR_NODISCARD bool insert(const K& key, const V& value) {
+        if (size_ + 1 > capacity()) {
+            if (!rehash_(n_slots_ == 0 ? (size_t)MinSlots : n_slots_ * 2)) {
+                return false;
+            }
+        }
+
+        const hashsum_t hash = KeyTraits::key_hash(key);
+        const uint8_t fp = fingerprint_(hash);
+
+        size_t index = hash & (n_slots_ - 1);
+
+        while (ctrl_[index] != 0) {
+            if (ctrl_[index] == fp && KeyTraits::key_equal(slots_[index].key, key)) {
+                roc_panic("flat hashmap: attempt to insert element with duplicate key");
+            }
+            index = (index + 1) & (n_slots_ - 1);
+        }
+
+        new (&slots_[index]) Slot(key, value);
+        ctrl_[index] = fp;
+        size_++;
+
+        return true;
+    }
+
+    //! Remove element from hashmap.
+    //!
+    //! @returns
+    //!  false if there is no element with given key.
+    //!
+    //! @note
+    //!  - has O(1) complexity in average
+    //!  - computes key hash
+    //!  - doesn't make allocations or deallocations
+    bool remove(const K& key) {
+        const size_t index = find_(key);
+        if (index == NotFound) {
+            return false;
+        }
+
+        erase_(index);
+        return true;
+    }
+
+    //! Remove all elements.
+    //! @remarks
+    //!  Doesn't release memory.
+    void clear() {
+        for (size_t index = 0; index < n_slots_; index++) {
+            if (ctrl_[index] != 0) {
+                slots_[index].~Slot();
+                ctrl_[index] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+    //! Grow hashmap to fit given number of elements.
+    //!
+    //! @returns
+    //!  false if the allocation failed.
+    //!
+    //! @note
+    //!  - has O(n) complexity
+    //!  - recomputes key hashes
+    //!  - makes allocations and deallocations
+    ROC_ATTR_NODISCARD bool reserve(size_t n_elems) {
+        size_t n_slots = (n_slots_ == 0 ? (size_t)MinSlots : n_slots_);
+        while (n_slots / LoadFactorDen * LoadFactorNum < n_elems) {
+            n_slots *= 2;
+        }
+
+        if (n_slots == n_slots_) {
+            return true;
+        }
+
+        return rehash_(n_slots);
+    }
+
+private:
+    enum {
+        // Maximum load factor.
+        LoadFactorNum = 3,
+        LoadFactorDen = 4,
+
+        // Minimum number of slots when table grows.
+        MinSlots = 16
+    };
+
+    enum {
+        // Number of slots needed for embedded capacity, rounded up to power of two.
+        EmbeddedNeeded = (EmbeddedCapacity * LoadFactorDen + LoadFactorNum - 1)
+            / LoadFactorNum,
+        EmbeddedRound0 = EmbeddedNeeded == 0 ? 0 : EmbeddedNeeded - 1,
+        EmbeddedRound1 = EmbeddedRound0 | (EmbeddedRound0 >> 1),
+        EmbeddedRound2 = EmbeddedRound1 | (EmbeddedRound1 >> 2),
+        EmbeddedRound3 = EmbeddedRound2 | (EmbeddedRound2 >> 4),
+        EmbeddedRound4 = EmbeddedRound3 | (EmbeddedRound3 >> 8),
+        EmbeddedRound5 = EmbeddedRound4 | (EmbeddedRound4 >> 16),
+
+        // How much slots are embedded directly into FlatHashmap object.
+        NumEmbeddedSlots = EmbeddedCapacity == 0 ? 0
+            : (int)EmbeddedRound5 + 1 < (int)MinSlots ? (int)MinSlots
+                                                      : (int)EmbeddedRound5 + 1
+    };
+
+    static const size_t NotFound = (size_t)-1;
+
+    struct Slot {
+        K key;
+        V value;
+
+        Slot(const K& k, const V& v)
+            : key(k)
+            , value(v) {
+        }
+    };
+
+    // Zero control byte means empty slot, so fingerprint always has high bit set.
+    static uint8_t fingerprint_(hashsum_t hash) {
+        return uint8_t(0x80 | (hash >> (sizeof(hashsum_t) * 8 - 7)));
+    }
+
+    size_t find_(const K& key) const {
+        if (size_ == 0) {
+            return NotFound;
+        }
+
+        const hashsum_t hash = KeyTraits::key_hash(key);
+        const uint8_t fp = fingerprint_(hash);
+
+        size_t index = hash & (n_slots_ - 1);
+
+        // Terminates because load factor guarantees at least one empty slot.
+        while (ctrl_[index] != 0) {
+            if (ctrl_[index] == fp && KeyTraits::key_equal(slots_[index].key, key)) {
+                return index;
+            }
+            index = (index + 1) & (n_slots_ - 1);
+        }
+
+        return NotFound;
+    }
+
+    // Remove element and shift following elements of the same cluster back,
+    // so that every element remains reachable from its home slot.
+    void erase_(size_t hole) {
+        const size_t mask = n_slots_ - 1;
+
+        slots_[hole].~Slot();
+        ctrl_[hole] = 0;
+        size_--;
+
+        size_t index = (hole + 1) & mask;
+
+        while (ctrl_[index] != 0) {
+            const size_t home = KeyTraits::key_hash(slots_[index].key) & mask;
+
+            // Move element if its home slot is not in (hole; index] range
+            // (with wrap-around).
+            if (((index - home) & mask) >= ((index - hole) & mask)) {
+                new (&slots_[hole]) Slot(slots_[index]);
+                ctrl_[hole] = ctrl_[index];
+
+                slots_[index].~Slot();
+                ctrl_[index] = 0;
+
+                hole = index;
+            }
+
+            index = (index + 1) & mask;
+        }
+    }
+
+    bool rehash_(size_t new_n_slots) {
+        roc_panic_if_not((new_n_slots & (new_n_slots - 1)) == 0);
+
+        if (new_n_slots <= n_slots_) {
+            return true;
+        }
+
+        void* memory = arena_.allocate(new_n_slots * (sizeof(Slot) + 1));
+        if (!memory) {
+            return false;
+        }
+
+        Slot* old_slots = slots_;
+        uint8_t* old_ctrl = ctrl_;
+        const size_t old_n_slots = n_slots_;
+
+        slots_ = (Slot*)memory;
+        ctrl_ = (uint8_t*)memory + new_n_slots * sizeof(Slot);
+        n_slots_ = new_n_slots;
+
+        memset(ctrl_, 0, n_slots_);
+
+        for (size_t old_index = 0; old_index < old_n_slots; old_index++) {
+            if (old_ctrl[old_index] == 0) {
+                continue;
+            }
+
+            size_t index =
+                KeyTraits::key_hash(old_slots[old_index].key) & (n_slots_ - 1);
+            while (ctrl_[index] != 0) {
+                index = (index + 1) & (n_slots_ - 1);
+            }
+
+            new (&slots_[index]) Slot(old_slots[old_index]);
+            ctrl_[index] = old_ctrl[old_index];
+
+            old_slots[old_index].~Slot();
+        }
+
+        release_(old_slots);
+
+        return true;
+    }
+
+    void release_(Slot* slots) {
+        if (slots && (void*)slots != embedded_slots_.memory()) {
+            arena_.deallocate(slots);
+        }
+    }
+
+    IArena& arena_;
+
+    Slot* slots_;
+    uint8_t* ctrl_;
+    size_t n_slots_;
+    size_t size_;
+
+    AlignedStorage<NumEmbeddedSlots * (sizeof(Slot) + 1)> embedded_slots_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_FLAT_HASHMAP_H_
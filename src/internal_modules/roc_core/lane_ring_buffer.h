@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/lane_ring_buffer.h
+//! @brief Multi-producer set of single-producer circular buffers.
+
+#ifndef ROC_CORE_LANE_RING_BUFFER_H_
+#define ROC_CORE_LANE_RING_BUFFER_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/panic.h"
+#include "roc_core/spsc_ring_buffer.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Thread-safe lock-free set of circular buffers ("lanes") of copyable objects,
+//! shared by multiple writers and single reader.
+//!
+//! Each lane is a separate SpscRingBuffer. Writer selects lane based on a key
+//! provided by caller, typically thread ID, and occupies it for the duration
+//! of write. If the lane is busy (another writer is using it), the next one is
+//! tried. Thus, in most cases, each thread has its own lane, and objects written
+//! by one thread are read in order. Objects of different threads may be reordered,
+//! so as objects of one thread if it had to switch lane.
+//!
+//! If all lanes are busy or the selected lane is full, write fails.
+//!
+//! @tparam T defines object type, it should be copyable.
+template <class T> class LaneRingBuffer : public NonCopyable<> {
+public:
+    enum {
+        //! Maximum number of lanes.
+        MaxLanes = 32
+    };
+
+    //! Initialize.
+    //! @p num_lanes should be in range [1; MaxLanes].
+    //! @p lane_size defines maximum number of objects in each lane.
+    LaneRingBuffer(IArena& arena, size_t num_lanes, size_t lane_size)
+        : num_lanes_(num_lanes)
+        , valid_(false) {
+        roc_panic_if_msg(num_lanes == 0 || num_lanes > MaxLanes,
+                         "lane ring buffer: invalid number of lanes:"
+                         " expected [1; %d], got %lu",
+                         (int)MaxLanes, (unsigned long)num_lanes);
+
+        for (size_t n = 0; n < num_lanes_; n++) {
+            lanes_[n].reset(new (lanes_[n]) SpscRingBuffer<T>(arena, lane_size));
+
+            if (!lanes_[n]->is_valid()) {
+                return;
+            }
+        }
+
+        valid_ = true;
+    }
+
+    //! Check if initialized successfully.
+    bool is_valid() const {
+        return valid_;
+    }
+
+    //! Get number of lanes.
+    size_t num_lanes() const {
+        return num_lanes_;
+    }
+
+    //! Append object to the lane selected by @p key.
+    //! @remarks
+    //!  Can be called concurrently from multiple threads.
+    //!  Lock-free operation.
+    //! @returns
+    //!  false if all lanes were busy or the selected lane was full.
+    ROC_ATTR_NODISCARD bool push(const T& object, uint64_t key) {
+        roc_panic_if(!valid_);
+
+        // Start from lane determined by key, so that in most cases
+        // each thread uses its own lane.
+        const size_t start_lane = size_t(key % num_lanes_);
+
+        for (size_t n = 0; n < num_lanes_; n++) {
+            const size_t lane = (start_lane + n) % num_lanes_;
+
+            if (!lane_busy_[lane].compare_exchange(0, 1)) {
+                continue;
+            }
+
+            const bool ok = lanes_[lane]->push_back(object);
+
+            lane_busy_[lane] = 0;
+
+            return ok;
+        }
+
+        return false;
+    }
+
+    //! Remove first object from given lane.
+    //! @remarks
+    //!  Should be called from single thread, or calls should be serialized.
+    //!  Lock-free operation.
+    //! @returns
+    //!  false if the lane was empty.
+    ROC_ATTR_NODISCARD bool pop(size_t lane, T& object) {
+        roc_panic_if(!valid_);
+        roc_panic_if(lane >= num_lanes_);
+
+        return lanes_[lane]->pop_front(object);
+    }
+
+private:
+    Optional<SpscRingBuffer<T> > lanes_[MaxLanes];
+    Atomic<int> lane_busy_[MaxLanes];
+
+    const size_t num_lanes_;
+    bool valid_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_LANE_RING_BUFFER_H_
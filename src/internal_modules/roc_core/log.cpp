@@ -6,6 +6,8 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include <stdlib.h>
+
 #include "roc_core/log.h"
 #include "roc_core/global_destructor.h"
 #include "roc_core/panic.h"
@@ -28,6 +30,9 @@ void backend_handler(const LogMessage& msg, void** args) {
 
 Logger::Logger()
     : level_(LogError)
+    , async_writer_(NULL)
+    , async_exit_registered_(false)
+    , async_stopped_(false)
     , colors_mode_(ColorsDisabled)
     , location_mode_(LocationDisabled) {
     handler_ = &backend_handler;
@@ -99,24 +104,70 @@ void Logger::set_handler(LogHandler handler, void** args, size_t n_args) {
     }
 }
 
+bool Logger::enable_async(const AsyncLogConfig& config) {
+    Mutex::Lock lock(async_mutex_);
+
+    if (async_stopped_) {
+        return false;
+    }
+
+    // Messages enqueued but not delivered by the time process exits would be
+    // lost, so stop writer at exit, which delivers them and reports drops.
+    if (!async_exit_registered_) {
+        if (atexit(&Logger::async_exit_handler_) != 0) {
+            return false;
+        }
+        async_exit_registered_ = true;
+    }
+
+    if (!async_writer_storage_) {
+        async_writer_storage_.reset(new (async_writer_storage_) AsyncLogWriter(
+            config, &Logger::async_handler_, this, async_arena_));
+
+        if (!async_writer_storage_->is_valid() || !async_writer_storage_->start()) {
+            async_writer_storage_.reset(NULL);
+            return false;
+        }
+    }
+
+    AtomicOps::store_release(async_writer_, async_writer_storage_.get());
+
+    return true;
+}
+
+void Logger::disable_async() {
+    Mutex::Lock lock(async_mutex_);
+
+    if (!async_writer_storage_ || async_stopped_) {
+        return;
+    }
+
+    AtomicOps::store_release(async_writer_, (AsyncLogWriter*)NULL);
+
+    // Threads that have already fetched writer may still enqueue messages,
+    // they will be delivered by background thread later.
+    async_writer_storage_->flush();
+}
+
+uint64_t Logger::num_dropped() const {
+    Mutex::Lock lock(async_mutex_);
+
+    if (!async_writer_storage_) {
+        return 0;
+    }
+
+    return async_writer_storage_->num_dropped();
+}
+
 void Logger::writef(LogLevel level,
                     const char* module,
                     const char* file,
                     int line,
                     const char* format,
                     ...) {
-    Mutex::Lock lock(mutex_);
-
-    if (level > level_ || level == LogNone) {
-        return;
-    }
-
-    // If user installed custom log handler and did not uninstall it until process
-    // exit, it may happen that user's library will deinitialize before our
-    // library (if we're in different shared libraries). If this happened, attempt
-    // to invoke handler at this point may cause crashes. To reduce probability of
-    // this, we stop using user handler as soon as we have detected it.
-    if (handler_ != &backend_handler && GlobalDestructor::is_destroying()) {
+    // Check level without lock, so that disabled messages are cheap
+    // even if macro was bypassed.
+    if (level > get_level() || level == LogNone) {
         return;
     }
 
@@ -137,6 +188,62 @@ void Logger::writef(LogLevel level,
     msg.pid = Thread::get_pid();
     msg.tid = Thread::get_tid();
     msg.text = text;
+
+    // In asynchronous mode, only enqueue message, it will be passed
+    // to handler from background thread.
+    if (AsyncLogWriter* writer = AtomicOps::load_acquire(async_writer_)) {
+        writer->write(msg);
+        return;
+    }
+
+    handle_(msg);
+}
+
+void Logger::async_handler_(const LogMessage& msg, void* arg) {
+    Logger& self = *(Logger*)arg;
+
+    // Level could be lowered after message was enqueued.
+    if (msg.level > self.get_level()) {
+        return;
+    }
+
+    LogMessage msg_copy = msg;
+    self.handle_(msg_copy);
+}
+
+void Logger::async_exit_handler_() {
+    Logger::instance().stop_async_();
+}
+
+void Logger::stop_async_() {
+    Mutex::Lock lock(async_mutex_);
+
+    async_stopped_ = true;
+
+    if (!async_writer_storage_) {
+        return;
+    }
+
+    AtomicOps::store_release(async_writer_, (AsyncLogWriter*)NULL);
+
+    // Background thread delivers remaining messages and reports drops
+    // before exiting.
+    async_writer_storage_->stop();
+    async_writer_storage_->join();
+}
+
+void Logger::handle_(LogMessage& msg) {
+    Mutex::Lock lock(mutex_);
+
+    // If user installed custom log handler and did not uninstall it until process
+    // exit, it may happen that user's library will deinitialize before our
+    // library (if we're in different shared libraries). If this happened, attempt
+    // to invoke handler at this point may cause crashes. To reduce probability of
+    // this, we stop using user handler as soon as we have detected it.
+    if (handler_ != &backend_handler && GlobalDestructor::is_destroying()) {
+        return;
+    }
+
     msg.location_mode = location_mode_;
     msg.colors_mode = colors_mode_;
 
@@ -12,11 +12,14 @@
 #ifndef ROC_CORE_LOG_H_
 #define ROC_CORE_LOG_H_
 
+#include "roc_core/async_log_writer.h"
 #include "roc_core/atomic_ops.h"
 #include "roc_core/attributes.h"
+#include "roc_core/heap_arena.h"
 #include "roc_core/log_backend.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
 #include "roc_core/singleton.h"
 #include "roc_core/time.h"
 
@@ -145,6 +148,30 @@ public:
     //!  Other threads will see the change immediately.
     void set_handler(LogHandler handler, void** args, size_t n_args);
 
+    //! Enable asynchronous mode.
+    //! @remarks
+    //!  In asynchronous mode, writef() formats message on the calling thread,
+    //!  puts it into lock-free buffer and returns; messages are passed to handler
+    //!  from background thread. If buffer is full, message is dropped, and number
+    //!  of dropped messages is periodically reported.
+    //! @note
+    //!  Background thread is created on first call and lives until process exit.
+    //!  @p config is used only on first call. At normal process exit, background
+    //!  thread delivers enqueued messages, reports drops, and is stopped; after
+    //!  that, asynchronous mode can't be enabled again.
+    //! @returns
+    //!  false if background thread can't be started.
+    bool enable_async(const AsyncLogConfig& config = AsyncLogConfig());
+
+    //! Disable asynchronous mode.
+    //! @remarks
+    //!  Further messages are passed to handler from the calling thread.
+    //!  Blocks until messages enqueued before the call are passed to handler.
+    void disable_async();
+
+    //! Get number of messages dropped in asynchronous mode.
+    uint64_t num_dropped() const;
+
 private:
     friend class Singleton<Logger>;
 
@@ -152,8 +179,22 @@ private:
 
     Logger();
 
+    static void async_handler_(const LogMessage& msg, void* arg);
+    static void async_exit_handler_();
+
+    void stop_async_();
+
+    void handle_(LogMessage& msg);
+
     int level_;
 
+    AsyncLogWriter* async_writer_;
+    Optional<AsyncLogWriter> async_writer_storage_;
+    HeapArena async_arena_;
+    Mutex async_mutex_;
+    bool async_exit_registered_;
+    bool async_stopped_;
+
     Mutex mutex_;
 
     LogHandler handler_;
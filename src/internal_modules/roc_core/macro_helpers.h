@@ -43,4 +43,10 @@
 //! Stringize macro.
 #define ROC_STRINGIZE(s) ROC_STRINGIZE_(s)
 
+//! Concatenate macro helper.
+#define ROC_CONCAT_(a, b) a##b
+
+//! Concatenate macro.
+#define ROC_CONCAT(a, b) ROC_CONCAT_(a, b)
+
 #endif // ROC_CORE_MACRO_HELPERS_H_
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/nested_timer.h
+//! @brief Timer for nested scopes.
+
+#ifndef ROC_CORE_NESTED_TIMER_H_
+#define ROC_CORE_NESTED_TIMER_H_
+
+#include "roc_core/fast_clock.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+//! Timer for nested scopes.
+//!
+//! Measures exclusive time of scopes that may be nested into each other,
+//! i.e. time spent in the scope itself, minus time spent in all scopes
+//! nested into it and measured by the same timer.
+//!
+//! For example, if pipeline stages are chained and each stage calls the
+//! next one, measuring every stage with the same timer gives time spent
+//! in each individual stage.
+//!
+//! All scopes measured by the same timer should be entered and left on
+//! the same thread, in LIFO order. Not thread-safe.
+class NestedTimer : public NonCopyable<> {
+public:
+    //! State of a single scope.
+    struct Scope {
+        //! Time when scope was entered.
+        nanoseconds_t start;
+
+        //! Time of nested scopes of enclosing scope.
+        nanoseconds_t saved_nested;
+
+        Scope()
+            : start(0)
+            , saved_nested(0) {
+        }
+    };
+
+    //! Initialize.
+    NestedTimer()
+        : nested_(0) {
+    }
+
+    //! Enter scope.
+    void begin(Scope& scope) {
+        scope.start = fast_timestamp();
+        scope.saved_nested = nested_;
+        nested_ = 0;
+    }
+
+    //! Leave scope.
+    //! @returns
+    //!  exclusive time of the scope.
+    nanoseconds_t end(Scope& scope) {
+        const nanoseconds_t elapsed = fast_timestamp() - scope.start;
+        const nanoseconds_t exclusive = elapsed - nested_;
+
+        nested_ = scope.saved_nested + elapsed;
+
+        return exclusive;
+    }
+
+private:
+    nanoseconds_t nested_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_NESTED_TIMER_H_
@@ -39,6 +39,14 @@ enum {
         (SlabPool_LeakGuard | SlabPool_OverflowGuard | SlabPool_OwnershipGuard)
 };
 
+//! Memory pool preallocation options.
+enum SlabPoolPreallocFlag {
+    //! Lock preallocated memory in RAM, so that it's never paged out.
+    SlabPool_LockMemory = (1 << 0),
+    //! Don't grow pool after preallocation, fail allocations instead.
+    SlabPool_FixedCapacity = (1 << 1),
+};
+
 //! Memory pool.
 //!
 //! Implements slab allocator algorithm. Allocates large chunks of memory ("slabs") from
@@ -52,6 +60,10 @@ enum {
 //!
 //! The returned memory is always maximum-aligned.
 //!
+//! Pool can be preallocated to a given capacity up-front using preallocate(), which
+//! also pre-faults (and optionally locks) its memory and optionally disables further
+//! growth. This allows to avoid allocations and page faults in steady state.
+//!
 //! Implements three safety measures:
 //!  - to catch double-free and other logical bugs, inserts link to owning pool before
 //!    user data, and panics if it differs when memory is returned to pool
@@ -111,6 +123,20 @@ public:
         return impl_.reserve(n_objects);
     }
 
+    //! Preallocate memory for given number of objects.
+    //! @remarks
+    //!  Reserves slots for @p n_objects, pre-faults their memory, and applies
+    //!  options from @p flags, defined by SlabPoolPreallocFlag.
+    //!  Slabs allocated later, if any, are pre-faulted and locked as well.
+    //!  Locked slabs are allocated from OS instead of arena, page-aligned and
+    //!  page-rounded. Slabs allocated before this call are pre-faulted, but
+    //!  not locked, so pool should not be used before it's preallocated.
+    //! @returns
+    //!  false if allocation or locking failed.
+    ROC_ATTR_NODISCARD bool preallocate(size_t n_objects, size_t flags) {
+        return impl_.preallocate(n_objects, flags);
+    }
+
     //! Allocate memory for an object.
     virtual void* allocate() {
         return impl_.allocate();
@@ -126,6 +152,21 @@ public:
         return impl_.num_guard_failures();
     }
 
+    //! Get number of objects currently allocated.
+    size_t num_used() const {
+        return impl_.num_used();
+    }
+
+    //! Get maximum number of objects allocated at the same time.
+    size_t max_used() const {
+        return impl_.max_used();
+    }
+
+    //! Get number of objects that can be allocated without growing pool.
+    size_t capacity() const {
+        return impl_.capacity();
+    }
+
 private:
     enum {
         SlotSize = (sizeof(SlabPoolImpl::SlotHeader) + sizeof(SlabPoolImpl::SlotCanary)
@@ -9,6 +9,7 @@
 #include "roc_core/slab_pool_impl.h"
 #include "roc_core/align_ops.h"
 #include "roc_core/log.h"
+#include "roc_core/memory_lock.h"
 #include "roc_core/memory_ops.h"
 #include "roc_core/panic.h"
 #include "roc_core/slab_pool.h"
@@ -41,6 +42,10 @@ SlabPoolImpl::SlabPoolImpl(const char* name,
     : name_(name)
     , arena_(arena)
     , n_used_slots_(0)
+    , n_max_used_slots_(0)
+    , prefault_(false)
+    , lock_memory_(false)
+    , fixed_capacity_(false)
     , slab_min_bytes_(clamp(min_alloc_bytes, preallocated_size, max_alloc_bytes))
     , slab_max_bytes_(max_alloc_bytes)
     , unaligned_slot_size_(sizeof(SlotHeader) + sizeof(SlotCanary) + object_size
@@ -80,6 +85,36 @@ bool SlabPoolImpl::reserve(size_t n_objects) {
     return reserve_slots_(n_objects);
 }
 
+bool SlabPoolImpl::preallocate(size_t n_objects, size_t flags) {
+    Mutex::Lock lock(mutex_);
+
+    prefault_ = true;
+    lock_memory_ = (flags & SlabPool_LockMemory) != 0;
+    fixed_capacity_ = false;
+
+    // Prefault free slots allocated before this call; used slots are touched
+    // by users. Memory allocated before this call comes from arena and can't
+    // be locked. New slabs are prefaulted and, if requested, locked when
+    // allocated.
+    prefault_free_slots_();
+
+    if (!reserve_slots_(n_objects)) {
+        roc_log(LogError, "slab pool (%s): can't preallocate %lu objects", name_,
+                (unsigned long)n_objects);
+        return false;
+    }
+
+    fixed_capacity_ = (flags & SlabPool_FixedCapacity) != 0;
+
+    roc_log(LogDebug,
+            "slab pool (%s): preallocated: n_slots=%lu n_bytes=%lu locked=%d fixed=%d",
+            name_, (unsigned long)(n_used_slots_ + free_slots_.size()),
+            (unsigned long)((n_used_slots_ + free_slots_.size()) * slot_size_),
+            (int)lock_memory_, (int)fixed_capacity_);
+
+    return true;
+}
+
 void* SlabPoolImpl::allocate() {
     Slot* slot;
 
@@ -130,6 +165,24 @@ size_t SlabPoolImpl::num_guard_failures() const {
     return num_guard_failures_;
 }
 
+size_t SlabPoolImpl::num_used() const {
+    Mutex::Lock lock(mutex_);
+
+    return n_used_slots_;
+}
+
+size_t SlabPoolImpl::max_used() const {
+    Mutex::Lock lock(mutex_);
+
+    return n_max_used_slots_;
+}
+
+size_t SlabPoolImpl::capacity() const {
+    Mutex::Lock lock(mutex_);
+
+    return n_used_slots_ + free_slots_.size();
+}
+
 void* SlabPoolImpl::give_slot_to_user_(Slot* slot) {
     slot->~Slot();
 
@@ -195,6 +248,10 @@ SlabPoolImpl::Slot* SlabPoolImpl::acquire_slot_() {
     if (slot != NULL) {
         free_slots_.remove(*slot);
         n_used_slots_++;
+
+        if (n_max_used_slots_ < n_used_slots_) {
+            n_max_used_slots_ = n_used_slots_;
+        }
     }
 
     return slot;
@@ -239,14 +296,35 @@ void SlabPoolImpl::increase_slab_size_(size_t desired_slots) {
 }
 
 bool SlabPoolImpl::allocate_new_slab_() {
+    if (fixed_capacity_) {
+        return false;
+    }
+
     const size_t slab_size_bytes = slot_offset_(slab_cur_slots_);
 
-    void* memory = arena_.allocate(slab_size_bytes);
+    // Locked slabs are allocated directly from OS instead of arena, because
+    // they should occupy whole pages not shared with other allocations.
+    const bool locked = prefault_ && lock_memory_;
+
+    void* memory = locked ? allocate_locked_memory(slab_size_bytes)
+                          : arena_.allocate(slab_size_bytes);
     if (memory == NULL) {
+        if (locked) {
+            roc_log(LogError, "slab pool (%s): can't allocate locked slab: size=%lu",
+                    name_, (unsigned long)slab_size_bytes);
+        }
         return false;
     }
 
     Slab* slab = new (memory) Slab;
+    slab->size = slab_size_bytes;
+    slab->locked = locked;
+
+    // Locked memory is already faulted in.
+    if (prefault_ && !locked) {
+        prefault_slab_(slab);
+    }
+
     slabs_.push_back(*slab);
 
     for (size_t n = 0; n < slab_cur_slots_; n++) {
@@ -273,7 +351,24 @@ void SlabPoolImpl::deallocate_everything_() {
 
     while (Slab* slab = slabs_.front()) {
         slabs_.remove(*slab);
-        arena_.deallocate(slab);
+        if (slab->locked) {
+            deallocate_locked_memory(slab, slab->size);
+        } else {
+            arena_.deallocate(slab);
+        }
+    }
+}
+
+void SlabPoolImpl::prefault_slab_(Slab* slab) {
+    // Touch every page of new slab before placing slots into it, so that
+    // page faults happen now and not when slots are given to user.
+    memset((char*)slab + slab_hdr_size_, 0, slab->size - slab_hdr_size_);
+}
+
+void SlabPoolImpl::prefault_free_slots_() {
+    for (Slot* slot = free_slots_.front(); slot != NULL;
+         slot = free_slots_.nextof(*slot)) {
+        memset((char*)slot + sizeof(Slot), 0, slot_size_ - sizeof(Slot));
     }
 }
 
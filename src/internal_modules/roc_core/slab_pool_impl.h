@@ -72,6 +72,9 @@ public:
     //! Reserve memory for given number of objects.
     ROC_ATTR_NODISCARD bool reserve(size_t n_objects);
 
+    //! Preallocate memory for given number of objects.
+    ROC_ATTR_NODISCARD bool preallocate(size_t n_objects, size_t flags);
+
     //! Allocate memory for an object.
     void* allocate();
 
@@ -87,8 +90,20 @@ public:
     //! Get number of guard failures.
     size_t num_guard_failures() const;
 
+    //! Get number of used slots.
+    size_t num_used() const;
+
+    //! Get maximum number of used slots.
+    size_t max_used() const;
+
+    //! Get number of used and free slots.
+    size_t capacity() const;
+
 private:
-    struct Slab : ListNode<> {};
+    struct Slab : ListNode<> {
+        size_t size;
+        bool locked;
+    };
     struct Slot : ListNode<> {};
 
     void* give_slot_to_user_(Slot* slot);
@@ -100,6 +115,8 @@ private:
 
     void increase_slab_size_(size_t desired_n_slots);
     bool allocate_new_slab_();
+    void prefault_slab_(Slab* slab);
+    void prefault_free_slots_();
     void deallocate_everything_();
 
     void add_preallocated_memory_(void* memory, size_t memory_size);
@@ -117,6 +134,11 @@ private:
     List<Slab, NoOwnership> slabs_;
     List<Slot, NoOwnership> free_slots_;
     size_t n_used_slots_;
+    size_t n_max_used_slots_;
+
+    bool prefault_;
+    bool lock_memory_;
+    bool fixed_capacity_;
 
     const size_t slab_min_bytes_;
     const size_t slab_max_bytes_;
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/fast_clock.h"
+#include "roc_core/atomic_ops.h"
+#include "roc_core/cpu_instructions.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define ROC_FAST_CLOCK_HAS_TSC
+#include <cpuid.h>
+#endif
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// How long to measure TSC frequency at startup.
+const nanoseconds_t CalibrationDuration = Millisecond;
+
+// How often to re-anchor TSC to monotonic clock, by default.
+const nanoseconds_t DefaultReanchorInterval = 50 * Millisecond;
+
+// Fixed-point precision of nanoseconds per tick multiplier.
+const unsigned MultShift = 32;
+
+uint64_t ns_per_tick_2_mult(nanoseconds_t ns, uint64_t ticks) {
+    return uint64_t(double(ns) / double(ticks) * double(uint64_t(1) << MultShift));
+}
+
+#if defined(ROC_FAST_CLOCK_HAS_TSC)
+
+inline uint64_t read_tsc() {
+    uint32_t lo = 0, hi = 0;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return (uint64_t(hi) << 32) | lo;
+}
+
+// Invariant TSC runs at constant rate in all ACPI P-, C- and T-states,
+// and is synchronized between cores.
+bool cpu_has_invariant_tsc() {
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) {
+        return false;
+    }
+
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+
+    return (edx & (1u << 8)) != 0;
+}
+
+#else
+
+inline uint64_t read_tsc() {
+    return 0;
+}
+
+bool cpu_has_invariant_tsc() {
+    return false;
+}
+
+#endif
+
+// Kernel may decide that TSC is unreliable (e.g. on some VMs or multi-socket
+// machines) and switch to another clocksource. In this case, we don't trust
+// TSC either.
+bool os_uses_tsc() {
+#if defined(__linux__)
+    const int fd =
+        open("/sys/devices/system/clocksource/clocksource0/current_clocksource",
+             O_RDONLY);
+    if (fd < 0) {
+        // Can't check, rely on CPU flags.
+        return true;
+    }
+
+    char buf[16] = {};
+    const ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+
+    return n >= 3 && buf[0] == 't' && buf[1] == 's' && buf[2] == 'c';
+#else
+    return true;
+#endif
+}
+
+} // namespace
+
+FastClock::FastClock(FastClockSource source, nanoseconds_t reanchor_interval)
+    : source_(FastClock_Monotonic)
+    , reanchor_interval_(reanchor_interval > 0 ? reanchor_interval
+                                               : DefaultReanchorInterval)
+    , reanchor_ticks_(0)
+    , last_ns_(0)
+    , anchor_ver_(0)
+    , anchor_tsc_(0)
+    , anchor_ns_(0)
+    , anchor_mult_(0) {
+    if (source != FastClock_Monotonic) {
+        if (tsc_supported()) {
+            source_ = FastClock_Tsc;
+        } else if (source == FastClock_Tsc) {
+            roc_log(LogDebug, "fast clock: tsc not usable, falling back to monotonic");
+        }
+    }
+
+    if (source_ == FastClock_Tsc) {
+        calibrate_();
+    }
+
+    roc_log(LogDebug, "fast clock: initialized: source=%s",
+            fast_clock_source_to_str(source_));
+}
+
+bool FastClock::tsc_supported() {
+    return cpu_has_invariant_tsc() && os_uses_tsc();
+}
+
+FastClockSource FastClock::source() const {
+    return source_;
+}
+
+nanoseconds_t FastClock::now() {
+    if (source_ != FastClock_Tsc) {
+        return timestamp(ClockMonotonic);
+    }
+
+    Anchor anchor;
+    load_anchor_(anchor);
+
+    const uint64_t tsc = read_tsc();
+
+    if (tsc < anchor.tsc || tsc - anchor.tsc >= reanchor_ticks_) {
+        return clamp_(reanchor_(anchor, tsc));
+    }
+
+    // Delta is limited by re-anchoring interval, so the product fits into
+    // 64 bits for any realistic TSC frequency.
+    return clamp_(anchor.ns
+                  + nanoseconds_t(((tsc - anchor.tsc) * anchor.mult) >> MultShift));
+}
+
+void FastClock::calibrate_() {
+    const nanoseconds_t start_ns = timestamp(ClockMonotonic);
+    const uint64_t start_tsc = read_tsc();
+
+    nanoseconds_t end_ns = start_ns;
+    uint64_t end_tsc = start_tsc;
+
+    while (end_ns - start_ns < CalibrationDuration) {
+        end_ns = timestamp(ClockMonotonic);
+        end_tsc = read_tsc();
+    }
+
+    Anchor anchor;
+    anchor.tsc = end_tsc;
+    anchor.ns = end_ns;
+    anchor.mult = ns_per_tick_2_mult(end_ns - start_ns, end_tsc - start_tsc);
+
+    reanchor_ticks_ = uint64_t(double(reanchor_interval_) / double(end_ns - start_ns)
+                               * double(end_tsc - start_tsc));
+
+    if (!try_store_anchor_(anchor)) {
+        roc_panic("fast clock: unexpected concurrent store");
+    }
+
+    roc_log(LogDebug, "fast clock: calibrated tsc: freq=%.3fMHz",
+            double(end_tsc - start_tsc) / double(end_ns - start_ns) * 1e3);
+}
+
+nanoseconds_t FastClock::reanchor_(const Anchor& anchor, uint64_t tsc) {
+    const nanoseconds_t ns = timestamp(ClockMonotonic);
+
+    Anchor new_anchor = anchor;
+    new_anchor.tsc = tsc;
+    new_anchor.ns = ns;
+
+    // Refine ratio using long interval since previous anchor. Skip it if TSC
+    // went backwards or interval is suspiciously short (e.g. thread was
+    // preempted between reading clocks).
+    if (tsc > anchor.tsc && ns - anchor.ns >= reanchor_interval_ / 2) {
+        new_anchor.mult = ns_per_tick_2_mult(ns - anchor.ns, tsc - anchor.tsc);
+    }
+
+    // If another thread re-anchors concurrently, keep its result.
+    (void)try_store_anchor_(new_anchor);
+
+    return ns;
+}
+
+// Extrapolated TSC time may run slightly ahead of monotonic clock, so after
+// re-anchoring, or when another thread reads an older anchor, raw timestamp
+// may be smaller than previously returned one. Never go back in this case.
+nanoseconds_t FastClock::clamp_(nanoseconds_t ns) {
+    nanoseconds_t last_ns = AtomicOps::load_relaxed(last_ns_);
+
+    while (ns > last_ns) {
+        // On failure, last_ns is updated to the current value.
+        if (AtomicOps::compare_exchange_relaxed(last_ns_, last_ns, ns)) {
+            return ns;
+        }
+    }
+
+    return last_ns;
+}
+
+// Reader side of seqlock.
+// All fields are accessed atomically, so we need only acquire ordering,
+// which is free on x86.
+void FastClock::load_anchor_(Anchor& anchor) const {
+    for (;;) {
+        const uint32_t ver0 = AtomicOps::load_acquire(anchor_ver_);
+
+        anchor.tsc = AtomicOps::load_relaxed(anchor_tsc_);
+        anchor.ns = AtomicOps::load_relaxed(anchor_ns_);
+        anchor.mult = AtomicOps::load_relaxed(anchor_mult_);
+
+        AtomicOps::fence_acquire();
+
+        const uint32_t ver1 = AtomicOps::load_relaxed(anchor_ver_);
+
+        if (ver0 == ver1 && (ver0 & 1) == 0) {
+            return;
+        }
+
+        cpu_relax();
+    }
+}
+
+// Writer side of seqlock.
+// Fails if there is concurrent writer.
+bool FastClock::try_store_anchor_(const Anchor& anchor) {
+    uint32_t ver = AtomicOps::load_relaxed(anchor_ver_);
+    if (ver & 1) {
+        return false;
+    }
+
+    if (!AtomicOps::compare_exchange_relaxed(anchor_ver_, ver, ver + 1)) {
+        return false;
+    }
+    AtomicOps::fence_release();
+
+    AtomicOps::store_relaxed(anchor_tsc_, anchor.tsc);
+    AtomicOps::store_relaxed(anchor_ns_, anchor.ns);
+    AtomicOps::store_relaxed(anchor_mult_, anchor.mult);
+
+    AtomicOps::store_release(anchor_ver_, ver + 2);
+
+    return true;
+}
+
+const char* fast_clock_source_to_str(FastClockSource source) {
+    switch (source) {
+    case FastClock_Auto:
+        return "auto";
+    case FastClock_Tsc:
+        return "tsc";
+    case FastClock_Monotonic:
+        return "monotonic";
+    }
+
+    return "<invalid>";
+}
+
+} // namespace core
+} // namespace roc
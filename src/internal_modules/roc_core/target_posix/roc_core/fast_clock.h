@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/fast_clock.h
+//! @brief Fast monotonic clock.
+
+#ifndef ROC_CORE_FAST_CLOCK_H_
+#define ROC_CORE_FAST_CLOCK_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/singleton.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+//! Fast clock source.
+enum FastClockSource {
+    //! Select best available source at runtime.
+    FastClock_Auto,
+
+    //! CPU timestamp counter, calibrated against monotonic clock.
+    //! Used only if CPU reports invariant TSC and OS uses TSC itself.
+    FastClock_Tsc,
+
+    //! Regular monotonic clock.
+    FastClock_Monotonic
+};
+
+//! Fast monotonic clock.
+//!
+//! Provides timestamps in the same time base as timestamp(ClockMonotonic),
+//! but avoids calling into OS on every invocation when possible.
+//!
+//! When CPU timestamp counter is usable, timestamps are computed from it
+//! using a ratio calibrated at startup. To compensate drift and clock
+//! slewing, the clock is periodically re-anchored to ClockMonotonic, so
+//! it never deviates from it by more than a few microseconds. Returned
+//! timestamps never decrease, even if re-anchoring moves the clock back.
+//!
+//! Calibration busy-waits for about a millisecond, so the default instance
+//! should be created during initialization, before it's used on real-time
+//! threads; see FastClock::instance().
+//!
+//! Intended for hot-path measurements and deadlines, like profiling and
+//! pipeline task scheduling. Thread-safe.
+class FastClock : public NonCopyable<> {
+public:
+    //! Get default instance.
+    //! @remarks
+    //!  Instance is created and calibrated on first call. node::Context
+    //!  calls it during construction, so that calibration never happens
+    //!  on pipeline threads.
+    static FastClock& instance() {
+        return Singleton<FastClock>::instance();
+    }
+
+    //! Initialize.
+    //! @remarks
+    //!  If @p source is FastClock_Tsc, but TSC is not usable, falls back to
+    //!  FastClock_Monotonic. If TSC is used, calibrates it against monotonic
+    //!  clock, which takes about a millisecond.
+    //!  @p reanchor_interval defines how often TSC is re-anchored to monotonic
+    //!  clock; zero means default interval.
+    explicit FastClock(FastClockSource source = FastClock_Auto,
+                       nanoseconds_t reanchor_interval = 0);
+
+    //! Check if TSC can be used on this machine.
+    static bool tsc_supported();
+
+    //! Get effective clock source.
+    //! @remarks
+    //!  Either FastClock_Tsc or FastClock_Monotonic.
+    FastClockSource source() const;
+
+    //! Get current monotonic timestamp, in nanoseconds.
+    nanoseconds_t now();
+
+private:
+    struct Anchor {
+        uint64_t tsc;
+        nanoseconds_t ns;
+        uint64_t mult;
+    };
+
+    void calibrate_();
+    nanoseconds_t reanchor_(const Anchor& anchor, uint64_t tsc);
+    nanoseconds_t clamp_(nanoseconds_t ns);
+
+    void load_anchor_(Anchor& anchor) const;
+    bool try_store_anchor_(const Anchor& anchor);
+
+    FastClockSource source_;
+    nanoseconds_t reanchor_interval_;
+    uint64_t reanchor_ticks_;
+
+    // Last returned timestamp, accessed atomically.
+    nanoseconds_t last_ns_;
+
+    // Anchor is protected by a lightweight seqlock, built directly
+    // on atomic word-sized fields. Unlike core::Seqlock, it doesn't
+    // need full fences on read path.
+    uint32_t anchor_ver_;
+    uint64_t anchor_tsc_;
+    nanoseconds_t anchor_ns_;
+    uint64_t anchor_mult_;
+};
+
+//! Get current monotonic timestamp using fast clock.
+//! @remarks
+//!  Same as timestamp(ClockMonotonic), but cheaper on machines with usable TSC.
+inline nanoseconds_t fast_timestamp() {
+    return FastClock::instance().now();
+}
+
+//! Get name of fast clock source.
+const char* fast_clock_source_to_str(FastClockSource source);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_FAST_CLOCK_H_
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdio.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/huge_page_arena.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+size_t regular_page_size() {
+    const long sz = sysconf(_SC_PAGESIZE);
+    if (sz <= 0) {
+        return 4096;
+    }
+    return (size_t)sz;
+}
+
+bool is_power_of_two(size_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+// Read default huge page size from /proc/meminfo.
+// Returns zero if it's not available.
+size_t default_huge_page_size() {
+#if defined(__linux__)
+    FILE* fp = fopen("/proc/meminfo", "r");
+    if (!fp) {
+        return 0;
+    }
+
+    size_t page_size = 0;
+
+    char line[128];
+    while (fgets(line, sizeof(line), fp)) {
+        unsigned long size_kb = 0;
+        if (sscanf(line, "Hugepagesize: %lu kB", &size_kb) == 1) {
+            page_size = (size_t)size_kb * 1024;
+            break;
+        }
+    }
+
+    fclose(fp);
+
+    if (!is_power_of_two(page_size) || page_size < regular_page_size()) {
+        return 0;
+    }
+
+    return page_size;
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+HugePageArena::HugePageArena()
+    : page_size_(default_huge_page_size())
+    , hugetlb_supported_(page_size_ != 0)
+    , num_allocations_(0)
+    , num_hugetlb_allocations_(0)
+    , advise_failed_(0) {
+    if (page_size_ == 0) {
+        page_size_ = regular_page_size();
+    }
+
+    roc_log(LogDebug, "huge page arena: initializing: page_size=%lu hugetlb=%d",
+            (unsigned long)page_size_, (int)hugetlb_supported_);
+}
+
+HugePageArena::~HugePageArena() {
+    if (num_allocations_ != 0) {
+        roc_panic("huge page arena: detected leak(s): %d chunk(s) were not freed",
+                  (int)num_allocations_);
+    }
+}
+
+size_t HugePageArena::page_size() const {
+    return page_size_;
+}
+
+size_t HugePageArena::page_capacity() const {
+    return page_size_ - sizeof(ChunkHeader);
+}
+
+size_t HugePageArena::num_allocations() const {
+    return (size_t)num_allocations_;
+}
+
+size_t HugePageArena::num_hugetlb_allocations() const {
+    return (size_t)num_hugetlb_allocations_;
+}
+
+void* HugePageArena::allocate(size_t size) {
+    const size_t chunk_size = compute_allocated_size(size);
+
+    bool hugetlb = true;
+    void* memory = map_hugetlb_(chunk_size);
+
+    if (!memory) {
+        hugetlb = false;
+        memory = map_aligned_(chunk_size);
+    }
+
+    if (!memory) {
+        roc_log(LogError,
+                "huge page arena: allocation failed: chunk_size=%lu payload_size=%lu",
+                (unsigned long)chunk_size, (unsigned long)size);
+        return NULL;
+    }
+
+    ChunkHeader* chunk = (ChunkHeader*)memory;
+    chunk->size = chunk_size;
+    chunk->hugetlb = hugetlb;
+
+    num_allocations_++;
+    if (hugetlb) {
+        num_hugetlb_allocations_++;
+    }
+
+    return chunk->data;
+}
+
+void HugePageArena::deallocate(void* ptr) {
+    if (!ptr) {
+        roc_panic("huge page arena: null pointer");
+    }
+
+    ChunkHeader* chunk = ROC_CONTAINER_OF(ptr, ChunkHeader, data);
+
+    const int n = num_allocations_--;
+    if (n == 0) {
+        roc_panic("huge page arena: unpaired deallocate");
+    }
+    if (chunk->hugetlb) {
+        num_hugetlb_allocations_--;
+    }
+
+    const size_t chunk_size = chunk->size;
+
+    if (munmap(chunk, chunk_size) != 0) {
+        roc_panic("huge page arena: munmap(): size=%lu: %s", (unsigned long)chunk_size,
+                  errno_to_str().c_str());
+    }
+}
+
+size_t HugePageArena::compute_allocated_size(size_t size) const {
+    return AlignOps::align_as(sizeof(ChunkHeader) + size, page_size_);
+}
+
+size_t HugePageArena::allocated_size(void* ptr) const {
+    if (!ptr) {
+        roc_panic("huge page arena: null pointer");
+    }
+
+    ChunkHeader* chunk = ROC_CONTAINER_OF(ptr, ChunkHeader, data);
+
+    return chunk->size;
+}
+
+void* HugePageArena::map_hugetlb_(size_t size) {
+#if defined(MAP_HUGETLB)
+    if (!hugetlb_supported_) {
+        return NULL;
+    }
+
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+    if (memory == MAP_FAILED) {
+        // Typically means that no huge pages are reserved in system.
+        roc_log(LogTrace, "huge page arena: mmap(MAP_HUGETLB): size=%lu: %s",
+                (unsigned long)size, errno_to_str().c_str());
+        return NULL;
+    }
+
+    return memory;
+#else
+    (void)size;
+    return NULL;
+#endif
+}
+
+void* HugePageArena::map_aligned_(size_t size) {
+    // Over-map by one page and trim, so that mapping starts at huge page
+    // boundary and kernel can use transparent huge pages for all of it.
+    const size_t map_size = size + page_size_;
+
+    void* memory =
+        mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (memory == MAP_FAILED) {
+        roc_log(LogError, "huge page arena: mmap(): size=%lu: %s",
+                (unsigned long)map_size, errno_to_str().c_str());
+        return NULL;
+    }
+
+    char* map_begin = (char*)memory;
+    char* map_end = map_begin + map_size;
+
+    char* begin = (char*)AlignOps::align_as((size_t)map_begin, page_size_);
+    char* end = begin + size;
+
+    if (begin != map_begin) {
+        munmap(map_begin, size_t(begin - map_begin));
+    }
+    if (end != map_end) {
+        munmap(end, size_t(map_end - end));
+    }
+
+#if defined(MADV_HUGEPAGE)
+    if (madvise(begin, size, MADV_HUGEPAGE) != 0) {
+        // Transparent huge pages may be disabled; memory is still usable.
+        if (advise_failed_.exchange(1) == 0) {
+            roc_log(LogDebug, "huge page arena: madvise(MADV_HUGEPAGE): size=%lu: %s",
+                    (unsigned long)size, errno_to_str().c_str());
+        }
+    }
+#endif
+
+    return begin;
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/huge_page_arena.h
+//! @brief Huge page arena.
+
+#ifndef ROC_CORE_HUGE_PAGE_ARENA_H_
+#define ROC_CORE_HUGE_PAGE_ARENA_H_
+
+#include "roc_core/align_ops.h"
+#include "roc_core/atomic.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Arena that maps memory in huge pages.
+//!
+//! Every allocation is a separate anonymous mapping, with size rounded up to
+//! huge page size. Intended for large and rare allocations, like slabs of
+//! SlabPool; small objects would waste most of the page.
+//!
+//! On Linux, first tries to map explicit huge pages (MAP_HUGETLB). If they are
+//! not reserved in the system, maps memory aligned to huge page boundary and
+//! asks kernel to back it with transparent huge pages (MADV_HUGEPAGE). On other
+//! systems, just maps memory with regular pages.
+//!
+//! Allocated chunks have the following format:
+//! @code
+//!  +-------------+-----------+---------+
+//!  | ChunkHeader | user data | padding |
+//!  +-------------+-----------+---------+
+//! @endcode
+//!
+//! Thread-safe.
+class HugePageArena : public IArena, public NonCopyable<> {
+public:
+    //! Initialize.
+    HugePageArena();
+
+    ~HugePageArena();
+
+    //! Get huge page size.
+    size_t page_size() const;
+
+    //! Get maximum allocation size that fits into single huge page.
+    size_t page_capacity() const;
+
+    //! Get number of allocated chunks.
+    size_t num_allocations() const;
+
+    //! Get number of chunks backed by explicit huge pages.
+    size_t num_hugetlb_allocations() const;
+
+    //! Allocate memory.
+    virtual void* allocate(size_t size);
+
+    //! Deallocate previously allocated memory.
+    virtual void deallocate(void* ptr);
+
+    //! Computes how many bytes will be actually allocated if allocate() is called with
+    //! given size. Covers all internal overhead, if any.
+    virtual size_t compute_allocated_size(size_t size) const;
+
+    //! Returns how many bytes was allocated for given pointer returned by allocate().
+    //! Covers all internal overhead, if any.
+    //! Returns same value as computed by compute_allocated_size(size).
+    virtual size_t allocated_size(void* ptr) const;
+
+private:
+    struct ChunkHeader {
+        // Mapping size.
+        size_t size;
+        // Whether mapping uses explicit huge pages.
+        bool hugetlb;
+        // User data.
+        AlignMax data[];
+    };
+
+    void* map_hugetlb_(size_t size);
+    void* map_aligned_(size_t size);
+
+    size_t page_size_;
+    bool hugetlb_supported_;
+
+    Atomic<int> num_allocations_;
+    Atomic<int> num_hugetlb_allocations_;
+    Atomic<int> advise_failed_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_HUGE_PAGE_ARENA_H_
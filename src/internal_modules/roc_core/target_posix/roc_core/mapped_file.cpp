@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/mapped_file.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+MappedFile::MappedFile()
+    : fd_(-1)
+    , writable_(false)
+    , data_(NULL)
+    , size_(0) {
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open_read(const char* path) {
+    roc_panic_if(!path);
+
+    if (fd_ != -1) {
+        roc_panic("mapped file: already opened");
+    }
+
+    fd_ = ::open(path, O_RDONLY);
+    if (fd_ == -1) {
+        roc_log(LogDebug, "mapped file: open(): path=%s: %s", path,
+                errno_to_str(errno).c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        roc_log(LogError, "mapped file: fstat(): path=%s: %s", path,
+                errno_to_str(errno).c_str());
+        close();
+        return false;
+    }
+
+    if (!S_ISREG(st.st_mode)) {
+        // pipes and devices can't be mapped
+        roc_log(LogDebug, "mapped file: not a regular file: path=%s", path);
+        close();
+        return false;
+    }
+
+    writable_ = false;
+
+    if (!map_((size_t)st.st_size)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool MappedFile::open_write(const char* path) {
+    roc_panic_if(!path);
+
+    if (fd_ != -1) {
+        roc_panic("mapped file: already opened");
+    }
+
+    fd_ = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ == -1) {
+        roc_log(LogDebug, "mapped file: open(): path=%s: %s", path,
+                errno_to_str(errno).c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode)) {
+        roc_log(LogDebug, "mapped file: not a regular file: path=%s", path);
+        close();
+        return false;
+    }
+
+    writable_ = true;
+
+    return true;
+}
+
+bool MappedFile::is_open() const {
+    return fd_ != -1;
+}
+
+uint8_t* MappedFile::data() const {
+    return data_;
+}
+
+size_t MappedFile::size() const {
+    return size_;
+}
+
+bool MappedFile::resize(size_t size) {
+    if (fd_ == -1) {
+        roc_panic("mapped file: not opened");
+    }
+
+    if (!writable_) {
+        roc_panic("mapped file: can't resize file opened for reading");
+    }
+
+    if (size == size_) {
+        return true;
+    }
+
+    unmap_();
+
+    if (ftruncate(fd_, (off_t)size) != 0) {
+        roc_log(LogError, "mapped file: ftruncate(): size=%lu: %s", (unsigned long)size,
+                errno_to_str(errno).c_str());
+        return false;
+    }
+
+#if defined(__linux__)
+    if (size != 0) {
+        // allocate blocks in advance, so that writes to mapping don't
+        // cause SIGBUS when disk is full
+        const int err = posix_fallocate(fd_, 0, (off_t)size);
+        if (err != 0) {
+            roc_log(LogError, "mapped file: posix_fallocate(): size=%lu: %s",
+                    (unsigned long)size, errno_to_str(err).c_str());
+            return false;
+        }
+    }
+#endif
+
+    return map_(size);
+}
+
+void MappedFile::close() {
+    unmap_();
+
+    if (fd_ != -1) {
+        if (::close(fd_) != 0) {
+            roc_log(LogError, "mapped file: close(): %s", errno_to_str(errno).c_str());
+        }
+        fd_ = -1;
+    }
+
+    writable_ = false;
+}
+
+bool MappedFile::map_(size_t size) {
+    roc_panic_if(data_);
+
+    if (size == 0) {
+        // empty mapping is not allowed
+        return true;
+    }
+
+    void* data = mmap(NULL, size, writable_ ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                      MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+        roc_log(LogError, "mapped file: mmap(): size=%lu: %s", (unsigned long)size,
+                errno_to_str(errno).c_str());
+        return false;
+    }
+
+    if (!writable_) {
+        // hint that file will be read sequentially
+        (void)posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+    }
+
+    data_ = (uint8_t*)data;
+    size_ = size;
+
+    return true;
+}
+
+void MappedFile::unmap_() {
+    if (!data_) {
+        return;
+    }
+
+    if (munmap(data_, size_) != 0) {
+        roc_log(LogError, "mapped file: munmap(): %s", errno_to_str(errno).c_str());
+    }
+
+    data_ = NULL;
+    size_ = 0;
+}
+
+} // namespace core
+} // namespace roc
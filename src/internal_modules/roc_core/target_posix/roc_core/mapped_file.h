@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/mapped_file.h
+//! @brief Memory-mapped file.
+
+#ifndef ROC_CORE_MAPPED_FILE_H_
+#define ROC_CORE_MAPPED_FILE_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Memory-mapped file.
+//! @remarks
+//!  Maps the whole file into memory. File opened for reading is mapped
+//!  read-only. File opened for writing is mapped read-write, and can be
+//!  resized; disk space is allocated in advance when growing it.
+class MappedFile : public NonCopyable<> {
+public:
+    //! Initialize.
+    MappedFile();
+
+    //! Unmap and close file.
+    ~MappedFile();
+
+    //! Open existing file for reading and map it.
+    ROC_ATTR_NODISCARD bool open_read(const char* path);
+
+    //! Create or truncate file for writing.
+    //! @remarks
+    //!  Initially file is empty and nothing is mapped; use resize()
+    //!  to allocate space.
+    ROC_ATTR_NODISCARD bool open_write(const char* path);
+
+    //! Check if file is opened.
+    bool is_open() const;
+
+    //! Get mapped data.
+    //! @remarks
+    //!  Returns NULL if file is empty.
+    //!  Pointer is invalidated by resize() and close().
+    uint8_t* data() const;
+
+    //! Get size of mapped data.
+    size_t size() const;
+
+    //! Change size of file opened for writing and remap it.
+    //! @remarks
+    //!  When growing, disk space is allocated in advance, so that writing
+    //!  to the mapping doesn't fail later because of lack of space.
+    ROC_ATTR_NODISCARD bool resize(size_t size);
+
+    //! Unmap and close file.
+    void close();
+
+private:
+    bool map_(size_t size);
+    void unmap_();
+
+    int fd_;
+    bool writable_;
+
+    uint8_t* data_;
+    size_t size_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_MAPPED_FILE_H_
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/memory_lock.h"
+#include "roc_core/panic.h"
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+namespace roc {
+namespace core {
+
+namespace {
+
+size_t round_to_pages(size_t size) {
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) {
+        roc_panic("memory lock: sysconf(_SC_PAGESIZE): %s", errno_to_str().c_str());
+    }
+
+    return (size + (size_t)page_size - 1) / (size_t)page_size * (size_t)page_size;
+}
+
+} // namespace
+
+void* allocate_locked_memory(size_t size) {
+    roc_panic_if(size == 0);
+
+    // mlock() works with whole pages and doesn't nest, so locked region
+    // should not share pages with memory of other owners, which may be
+    // locked and unlocked independently. Hence map separate pages.
+    const size_t mapped_size = round_to_pages(size);
+
+    void* data = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
+        roc_log(LogError, "memory lock: mmap(): size=%lu: %s",
+                (unsigned long)mapped_size, errno_to_str().c_str());
+        return NULL;
+    }
+
+    if (mlock(data, mapped_size) != 0) {
+        roc_log(LogError, "memory lock: mlock(): size=%lu: %s",
+                (unsigned long)mapped_size, errno_to_str().c_str());
+        if (munmap(data, mapped_size) != 0) {
+            roc_panic("memory lock: munmap(): %s", errno_to_str().c_str());
+        }
+        return NULL;
+    }
+
+    return data;
+}
+
+void deallocate_locked_memory(void* data, size_t size) {
+    roc_panic_if(!data);
+
+    const size_t mapped_size = round_to_pages(size);
+
+    if (munlock(data, mapped_size) != 0) {
+        roc_log(LogError, "memory lock: munlock(): size=%lu: %s",
+                (unsigned long)mapped_size, errno_to_str().c_str());
+    }
+
+    if (munmap(data, mapped_size) != 0) {
+        roc_panic("memory lock: munmap(): %s", errno_to_str().c_str());
+    }
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/memory_lock.h
+//! @brief Memory locking.
+
+#ifndef ROC_CORE_MEMORY_LOCK_H_
+#define ROC_CORE_MEMORY_LOCK_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Allocate memory region locked in RAM.
+//! @remarks
+//!  Memory is mapped directly from OS, is page-aligned, and its size is rounded
+//!  up to page size, so locked pages are never shared with other allocations.
+//!  Pages are faulted in and are not paged out until memory is deallocated.
+//!  Usually requires CAP_IPC_LOCK or sufficient RLIMIT_MEMLOCK.
+//! @returns
+//!  NULL if memory can't be allocated or locked.
+void* allocate_locked_memory(size_t size);
+
+//! Unlock and deallocate memory region allocated by allocate_locked_memory().
+//! @p size should be the same as passed to allocate_locked_memory().
+void deallocate_locked_memory(void* data, size_t size);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_MEMORY_LOCK_H_
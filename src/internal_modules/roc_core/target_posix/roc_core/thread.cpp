@@ -14,6 +14,9 @@
 #include <lwp.h>
 #endif
 
+#include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
 #include <unistd.h>
 
 #include "roc_core/errno_to_str.h"
@@ -24,11 +27,26 @@
 namespace roc {
 namespace core {
 
-uint64_t Thread::get_pid() {
-    return (uint64_t)getpid();
+namespace {
+
+// Thread ID is queried on hot paths, like logging and tracing, and getting
+// it may require a syscall, so it's cached per thread. Zero means not cached.
+__thread uint64_t cached_tid = 0;
+
+pthread_once_t atfork_once = PTHREAD_ONCE_INIT;
+
+void reset_cached_tid() {
+    // Thread of child process has its own ID.
+    cached_tid = 0;
 }
 
-uint64_t Thread::get_tid() {
+void register_atfork() {
+    if (int err = pthread_atfork(NULL, NULL, &reset_cached_tid)) {
+        roc_panic("thread: pthread_atfork(): %s", errno_to_str(err).c_str());
+    }
+}
+
+uint64_t query_tid() {
 #if defined(SYS_gettid)
     return (uint64_t)(pid_t)syscall(SYS_gettid);
 #elif defined(__FreeBSD__)
@@ -46,6 +64,21 @@ uint64_t Thread::get_tid() {
 #endif
 }
 
+} // namespace
+
+uint64_t Thread::get_pid() {
+    return (uint64_t)getpid();
+}
+
+uint64_t Thread::get_tid() {
+    if (cached_tid == 0) {
+        pthread_once(&atfork_once, &register_atfork);
+        cached_tid = query_tid();
+    }
+
+    return cached_tid;
+}
+
 bool Thread::enable_realtime() {
     sched_param param;
     memset(&param, 0, sizeof(param));
@@ -61,6 +94,79 @@ bool Thread::enable_realtime() {
     return true;
 }
 
+bool Thread::apply_policy(const ThreadPolicy& policy) {
+    bool ok = true;
+
+    if (policy.scheduler == ThreadSched_Default && policy.priority != 0) {
+        roc_log(LogError,
+                "thread: can't set priority: prio=%d: priority can be set only with"
+                " real-time scheduler",
+                policy.priority);
+        ok = false;
+    }
+
+    if (policy.scheduler != ThreadSched_Default) {
+        const int sched_policy =
+            policy.scheduler == ThreadSched_Fifo ? SCHED_FIFO : SCHED_RR;
+
+        sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = policy.priority != 0
+            ? policy.priority
+            : sched_get_priority_max(sched_policy);
+
+        if (int err = pthread_setschedparam(pthread_self(), sched_policy, &param)) {
+            roc_log(LogError,
+                    "thread: can't set scheduler: sched=%s prio=%d:"
+                    " pthread_setschedparam(): %s",
+                    thread_scheduler_to_str(policy.scheduler), param.sched_priority,
+                    errno_to_str(err).c_str());
+            ok = false;
+        }
+    }
+
+    if (policy.nice != 0) {
+#if defined(__linux__)
+        // On Linux, nice level is per-thread attribute, and setpriority()
+        // with thread id affects only that thread.
+        if (setpriority(PRIO_PROCESS, (id_t)get_tid(), policy.nice) != 0) {
+            roc_log(LogError, "thread: can't set nice level: nice=%d: setpriority(): %s",
+                    policy.nice, errno_to_str(errno).c_str());
+            ok = false;
+        }
+#else
+        roc_log(LogError, "thread: can't set nice level: not supported on this platform");
+        ok = false;
+#endif
+    }
+
+    if (policy.cpu_mask != 0) {
+#if defined(__linux__)
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+
+        for (size_t cpu = 0; cpu < ThreadPolicy_MaxCpus; cpu++) {
+            if (policy.cpu_mask & ((uint64_t)1 << cpu)) {
+                CPU_SET(cpu, &cpu_set);
+            }
+        }
+
+        if (int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)) {
+            roc_log(LogError,
+                    "thread: can't set cpu affinity: pthread_setaffinity_np(): %s",
+                    errno_to_str(err).c_str());
+            ok = false;
+        }
+#else
+        roc_log(LogError,
+                "thread: can't set cpu affinity: not supported on this platform");
+        ok = false;
+#endif
+    }
+
+    return ok;
+}
+
 Thread::Thread()
     : started_(0)
     , joinable_(0) {
@@ -76,6 +182,16 @@ bool Thread::is_joinable() const {
     return joinable_;
 }
 
+void Thread::set_policy(const ThreadPolicy& policy) {
+    Mutex::Lock lock(mutex_);
+
+    if (started_) {
+        roc_panic("thread: can't set policy after thread was started");
+    }
+
+    policy_ = policy;
+}
+
 bool Thread::start() {
     Mutex::Lock lock(mutex_);
 
@@ -111,7 +227,15 @@ void Thread::join() {
 }
 
 void* Thread::thread_runner_(void* ptr) {
-    static_cast<Thread*>(ptr)->run();
+    Thread& self = *static_cast<Thread*>(ptr);
+
+    if (!self.policy_.is_default()) {
+        if (!apply_policy(self.policy_)) {
+            roc_log(LogError, "thread: failed to apply thread policy, ignoring");
+        }
+    }
+
+    self.run();
     return NULL;
 }
 
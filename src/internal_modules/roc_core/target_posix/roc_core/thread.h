@@ -19,6 +19,7 @@
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/thread_policy.h"
 
 namespace roc {
 namespace core {
@@ -30,11 +31,29 @@ public:
     static uint64_t get_pid();
 
     //! Get numeric identifier of current thread.
+    //! @remarks
+    //!  Identifier is cached in thread-local storage, so only first call
+    //!  in each thread may be expensive.
     static uint64_t get_tid();
 
     //! Raise current thread priority to realtime.
     ROC_ATTR_NODISCARD static bool enable_realtime();
 
+    //! Apply scheduling policy to current thread.
+    //! @remarks
+    //!  Tries to apply all parts of the policy, even if some of them fail.
+    //! @returns
+    //!  false if some part of the policy can't be applied, e.g. because
+    //!  of insufficient privileges or lack of support on platform.
+    ROC_ATTR_NODISCARD static bool apply_policy(const ThreadPolicy& policy);
+
+    //! Set scheduling policy for thread.
+    //! @remarks
+    //!  Should be called before start(). The policy is applied from the
+    //!  new thread before invoking run(). If it can't be applied, thread
+    //!  is still started with default scheduling.
+    void set_policy(const ThreadPolicy& policy);
+
     //! Check if thread was started and can be joined.
     //! @returns
     //!  true if start() was called and join() was not called yet.
@@ -63,6 +82,8 @@ private:
 
     pthread_t thread_;
 
+    ThreadPolicy policy_;
+
     int started_;
     Atomic<int> joinable_;
 
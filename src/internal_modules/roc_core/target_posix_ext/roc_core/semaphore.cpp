@@ -39,9 +39,19 @@ bool Semaphore::timed_wait(nanoseconds_t deadline) {
     }
 
     for (;;) {
+        // Deadline is in ClockMonotonic domain, like on other platforms, but
+        // sem_timedwait() expects CLOCK_REALTIME, so convert it. Expired deadline
+        // still allows to decrement counter if it's non-zero.
+        nanoseconds_t timeout = deadline - timestamp(ClockMonotonic);
+        if (timeout < 0) {
+            timeout = 0;
+        }
+
+        const nanoseconds_t unix_deadline = timestamp(ClockUnix) + timeout;
+
         timespec ts;
-        ts.tv_sec = long(deadline / Second);
-        ts.tv_nsec = long(deadline % Second);
+        ts.tv_sec = long(unix_deadline / Second);
+        ts.tv_nsec = long(unix_deadline % Second);
 
         if (sem_timedwait(&sem_, &ts) == 0) {
             return true;
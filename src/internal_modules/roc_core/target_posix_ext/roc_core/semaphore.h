@@ -32,7 +32,7 @@ public:
 
     //! Wait until the counter becomes non-zero, decrement it, and return true.
     //! If deadline expires before the counter becomes non-zero, returns false.
-    //! Deadline should be in the same time domain as core::timestamp().
+    //! Deadline should be in ClockMonotonic domain of core::timestamp().
     ROC_ATTR_NODISCARD bool timed_wait(nanoseconds_t deadline);
 
     //! Wait until the counter becomes non-zero, decrement it, and return.
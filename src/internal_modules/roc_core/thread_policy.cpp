@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/thread_policy.h"
+#include "roc_core/log.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+bool parse_int(const char* str, const char* end, long& result) {
+    if (str == end) {
+        return false;
+    }
+
+    char* number_end = NULL;
+    result = strtol(str, &number_end, 10);
+
+    return number_end == end;
+}
+
+bool parse_cpus(const char* str, const char* end, uint64_t& mask) {
+    mask = 0;
+
+    for (;;) {
+        const char* item_end = str;
+        while (item_end < end && *item_end != '+') {
+            item_end++;
+        }
+
+        const char* dash = str;
+        while (dash < item_end && *dash != '-') {
+            dash++;
+        }
+
+        long first = 0, last = 0;
+
+        if (!parse_int(str, dash, first)) {
+            return false;
+        }
+
+        if (dash == item_end) {
+            last = first;
+        } else if (!parse_int(dash + 1, item_end, last)) {
+            return false;
+        }
+
+        if (first < 0 || last < first || last >= (long)ThreadPolicy_MaxCpus) {
+            return false;
+        }
+
+        for (long cpu = first; cpu <= last; cpu++) {
+            mask |= (uint64_t)1 << cpu;
+        }
+
+        if (item_end == end) {
+            break;
+        }
+
+        str = item_end + 1;
+    }
+
+    return true;
+}
+
+bool match_key(const char* str, const char* eq, const char* key) {
+    const size_t len = (size_t)(eq - str);
+    return len == strlen(key) && strncmp(str, key, len) == 0;
+}
+
+bool match_value(const char* str, const char* end, const char* value) {
+    const size_t len = (size_t)(end - str);
+    return len == strlen(value) && strncmp(str, value, len) == 0;
+}
+
+} // namespace
+
+const char* thread_scheduler_to_str(ThreadScheduler scheduler) {
+    switch (scheduler) {
+    case ThreadSched_Default:
+        return "default";
+    case ThreadSched_Fifo:
+        return "fifo";
+    case ThreadSched_RoundRobin:
+        return "rr";
+    }
+
+    return "<invalid>";
+}
+
+bool parse_thread_policy(const char* str, ThreadPolicy& result) {
+    if (str == NULL) {
+        roc_log(LogError, "parse thread policy: string is null");
+        return false;
+    }
+
+    ThreadPolicy policy = result;
+
+    while (*str) {
+        const char* end = strchr(str, ',');
+        if (!end) {
+            end = str + strlen(str);
+        }
+
+        const char* eq = str;
+        while (eq < end && *eq != '=') {
+            eq++;
+        }
+
+        if (eq == end) {
+            roc_log(LogError,
+                    "parse thread policy: invalid format: expected"
+                    " comma-separated list of <key>=<value>");
+            return false;
+        }
+
+        const char* value = eq + 1;
+        long number = 0;
+
+        if (match_key(str, eq, "sched")) {
+            if (match_value(value, end, "default")) {
+                policy.scheduler = ThreadSched_Default;
+            } else if (match_value(value, end, "fifo")) {
+                policy.scheduler = ThreadSched_Fifo;
+            } else if (match_value(value, end, "rr")) {
+                policy.scheduler = ThreadSched_RoundRobin;
+            } else {
+                roc_log(LogError,
+                        "parse thread policy: invalid sched: expected"
+                        " <default|fifo|rr>");
+                return false;
+            }
+        } else if (match_key(str, eq, "prio")) {
+            if (!parse_int(value, end, number) || number < 0 || number > 99) {
+                roc_log(LogError,
+                        "parse thread policy: invalid prio: expected number in"
+                        " range [0; 99]");
+                return false;
+            }
+            policy.priority = (int)number;
+        } else if (match_key(str, eq, "nice")) {
+            if (!parse_int(value, end, number) || number < -20 || number > 19) {
+                roc_log(LogError,
+                        "parse thread policy: invalid nice: expected number in"
+                        " range [-20; 19]");
+                return false;
+            }
+            policy.nice = (int)number;
+        } else if (match_key(str, eq, "cpus")) {
+            if (!parse_cpus(value, end, policy.cpu_mask)) {
+                roc_log(LogError,
+                        "parse thread policy: invalid cpus: expected '+'-separated"
+                        " list of cpu numbers or ranges in range [0; %lu]",
+                        (unsigned long)ThreadPolicy_MaxCpus - 1);
+                return false;
+            }
+        } else {
+            roc_log(LogError,
+                    "parse thread policy: unknown key: expected"
+                    " <sched|prio|nice|cpus>");
+            return false;
+        }
+
+        str = *end ? end + 1 : end;
+    }
+
+    if (policy.scheduler == ThreadSched_Default && policy.priority != 0) {
+        roc_log(LogError,
+                "parse thread policy: invalid prio: priority can be set only with"
+                " real-time scheduler <fifo|rr>");
+        return false;
+    }
+
+    result = policy;
+    return true;
+}
+
+} // namespace core
+} // namespace roc
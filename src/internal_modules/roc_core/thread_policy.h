@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/thread_policy.h
+//! @brief Thread scheduling policy.
+
+#ifndef ROC_CORE_THREAD_POLICY_H_
+#define ROC_CORE_THREAD_POLICY_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Thread scheduler.
+enum ThreadScheduler {
+    //! Don't change scheduler, use the one inherited from creator.
+    ThreadSched_Default,
+
+    //! Real-time first-in first-out scheduler (SCHED_FIFO).
+    ThreadSched_Fifo,
+
+    //! Real-time round-robin scheduler (SCHED_RR).
+    ThreadSched_RoundRobin
+};
+
+//! Maximum number of CPUs that can be specified in affinity mask.
+static const size_t ThreadPolicy_MaxCpus = 64;
+
+//! Thread scheduling policy.
+//! @remarks
+//!  Default-constructed policy doesn't change anything.
+struct ThreadPolicy {
+    //! Scheduler.
+    ThreadScheduler scheduler;
+
+    //! Real-time priority.
+    //! Allowed only with real-time schedulers, must be zero otherwise.
+    //! If zero, maximum priority allowed for scheduler is used.
+    int priority;
+
+    //! Nice level, from -20 to 19.
+    //! If zero, nice level is not changed.
+    int nice;
+
+    //! CPU affinity mask.
+    //! N-th bit enables N-th CPU.
+    //! If zero, affinity is not changed.
+    uint64_t cpu_mask;
+
+    ThreadPolicy()
+        : scheduler(ThreadSched_Default)
+        , priority(0)
+        , nice(0)
+        , cpu_mask(0) {
+    }
+
+    //! Check if policy changes anything.
+    bool is_default() const {
+        return scheduler == ThreadSched_Default && priority == 0 && nice == 0
+            && cpu_mask == 0;
+    }
+};
+
+//! Get string name of thread scheduler.
+const char* thread_scheduler_to_str(ThreadScheduler scheduler);
+
+//! Parse thread policy from string.
+//!
+//! @remarks
+//!  The input string is a comma-separated list of zero or more options:
+//!   - "sched=<default|fifo|rr>"
+//!   - "prio=<number>"
+//!   - "nice=<number>"
+//!   - "cpus=<list>", where list is '+'-separated list of CPU numbers
+//!     or ranges, e.g. "0-3+6"
+//!
+//!  Omitted options keep their values from @p result.
+//!  Resulting policy should not have non-zero priority with default scheduler.
+//!
+//! @returns
+//!  false if string can't be parsed.
+ROC_ATTR_NODISCARD bool parse_thread_policy(const char* string, ThreadPolicy& result);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_THREAD_POLICY_H_
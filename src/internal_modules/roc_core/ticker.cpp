@@ -7,21 +7,37 @@
  */
 
 #include "roc_core/ticker.h"
+#include "roc_core/cpu_instructions.h"
+#include "roc_core/fast_clock.h"
+#include "roc_core/stddefs.h"
 
 namespace roc {
 namespace core {
 
-Ticker::Ticker(ticks_t freq)
+Ticker::Ticker(ticks_t freq, const TickerConfig& config)
     : ratio_(double(freq) / Second)
+    , config_(config)
+    , margin_(0)
+    , avg_oversleep_(0)
     , start_(0)
     , started_(false) {
+    if (config_.enable_spinning) {
+        roc_panic_if_msg(config_.min_spin_margin < 0
+                             || config_.min_spin_margin > config_.max_spin_margin,
+                         "ticker: invalid spin margin limits: min=%lld max=%lld",
+                         (long long)config_.min_spin_margin,
+                         (long long)config_.max_spin_margin);
+
+        margin_ = std::min(std::max(config_.spin_margin, config_.min_spin_margin),
+                           config_.max_spin_margin);
+    }
 }
 
 void Ticker::start() {
     if (started_) {
         roc_panic("ticker: can't start ticker twice");
     }
-    start_ = timestamp(ClockMonotonic);
+    start_ = fast_timestamp();
     started_ = true;
 }
 
@@ -30,7 +46,7 @@ Ticker::ticks_t Ticker::elapsed() {
         start();
         return 0;
     } else {
-        return ticks_t(double(timestamp(ClockMonotonic) - start_) * ratio_);
+        return ticks_t(double(fast_timestamp() - start_) * ratio_);
     }
 }
 
@@ -38,7 +54,58 @@ void Ticker::wait(ticks_t ticks) {
     if (!started_) {
         start();
     }
-    sleep_until(ClockMonotonic, start_ + nanoseconds_t(ticks / ratio_));
+
+    const nanoseconds_t deadline = start_ + nanoseconds_t(ticks / ratio_);
+
+    if (config_.enable_spinning) {
+        sleep_and_spin_(deadline);
+    } else {
+        sleep_until(ClockMonotonic, deadline);
+    }
+}
+
+nanoseconds_t Ticker::spin_margin() const {
+    return margin_;
+}
+
+void Ticker::sleep_and_spin_(nanoseconds_t deadline) {
+    nanoseconds_t now = fast_timestamp();
+
+    if (deadline - now > margin_) {
+        // Coarse part: let OS scheduler wake us up a bit earlier than needed.
+        const nanoseconds_t wakeup = deadline - margin_;
+
+        sleep_until(ClockMonotonic, wakeup);
+
+        now = fast_timestamp();
+        update_margin_(now - wakeup);
+    }
+
+    // Fine part: busy wait for the remaining time.
+    while (now < deadline) {
+        cpu_relax();
+        now = fast_timestamp();
+    }
+}
+
+void Ticker::update_margin_(nanoseconds_t oversleep) {
+    if (oversleep < 0) {
+        oversleep = 0;
+    }
+
+    avg_oversleep_ += (oversleep - avg_oversleep_) / 8;
+
+    if (oversleep > margin_) {
+        // We woke up after deadline, grow quickly.
+        margin_ = oversleep + oversleep / 4;
+    } else {
+        // Slowly shrink towards twice the average oversleep,
+        // to keep spinning time (and CPU usage) low.
+        margin_ = std::max(avg_oversleep_ * 2, margin_ - margin_ / 64);
+    }
+
+    margin_ = std::min(std::max(margin_, config_.min_spin_margin),
+                       config_.max_spin_margin);
 }
 
 } // namespace core
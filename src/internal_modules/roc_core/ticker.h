@@ -19,6 +19,36 @@
 namespace roc {
 namespace core {
 
+//! Ticker parameters.
+struct TickerConfig {
+    //! Enable hybrid sleep/spin pacing.
+    //! @remarks
+    //!  If disabled, ticker sleeps until deadline, and wakeup precision
+    //!  depends on OS scheduler. If enabled, ticker sleeps until deadline
+    //!  minus spin margin, and then spins on monotonic clock until deadline.
+    //!  This trades some CPU time for much lower wakeup jitter.
+    bool enable_spinning;
+
+    //! Initial spin margin, in nanoseconds.
+    //! @remarks
+    //!  Margin is then adjusted automatically according to observed oversleep.
+    nanoseconds_t spin_margin;
+
+    //! Minimum spin margin, in nanoseconds.
+    nanoseconds_t min_spin_margin;
+
+    //! Maximum spin margin, in nanoseconds.
+    nanoseconds_t max_spin_margin;
+
+    //! Initialize config with defaults.
+    TickerConfig()
+        : enable_spinning(false)
+        , spin_margin(200 * Microsecond)
+        , min_spin_margin(20 * Microsecond)
+        , max_spin_margin(2 * Millisecond) {
+    }
+};
+
 //! Ticker.
 class Ticker : public NonCopyable<> {
 public:
@@ -28,7 +58,8 @@ public:
     //! Initialize.
     //! @remarks
     //!  @p freq defines the number of ticks per second.
-    explicit Ticker(ticks_t freq);
+    //!  @p config defines pacing mode.
+    explicit Ticker(ticks_t freq, const TickerConfig& config = TickerConfig());
 
     //! Start ticker.
     void start();
@@ -41,8 +72,21 @@ public:
     //! If ticker is not started yet, it is started automatically.
     void wait(ticks_t ticks);
 
+    //! Get current spin margin.
+    //! @remarks
+    //!  Returns zero if spinning is disabled.
+    nanoseconds_t spin_margin() const;
+
 private:
+    void sleep_and_spin_(nanoseconds_t deadline);
+    void update_margin_(nanoseconds_t oversleep);
+
     const double ratio_;
+    const TickerConfig config_;
+
+    nanoseconds_t margin_;
+    nanoseconds_t avg_oversleep_;
+
     nanoseconds_t start_;
     bool started_;
 };
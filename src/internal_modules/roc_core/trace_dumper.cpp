@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/trace_dumper.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+TraceDumper::TraceDumper(const char* path,
+                         const TraceDumperConfig& config,
+                         Tracer& tracer)
+    : config_(config)
+    , tracer_(tracer)
+    , file_(NULL)
+    , pid_(Thread::get_pid())
+    , first_event_(true)
+    , failed_(false)
+    , valid_(false) {
+    if (!open_(path)) {
+        return;
+    }
+    set_policy(config.thread_policy);
+    valid_ = true;
+}
+
+TraceDumper::~TraceDumper() {
+    if (is_joinable()) {
+        roc_panic("trace dumper: attempt to call destructor"
+                  " before calling stop() and join()");
+    }
+
+    close_();
+}
+
+bool TraceDumper::is_valid() const {
+    return valid_;
+}
+
+void TraceDumper::stop() {
+    stop_ = true;
+    stop_sem_.post();
+}
+
+void TraceDumper::run() {
+    roc_panic_if(!valid_);
+
+    roc_log(LogDebug, "trace dumper: running background thread");
+
+    while (!stop_) {
+        while (drain_() == BatchSize) {
+        }
+
+        (void)stop_sem_.timed_wait(timestamp(ClockMonotonic) + config_.flush_interval);
+    }
+
+    while (drain_() != 0) {
+    }
+
+    roc_log(LogDebug, "trace dumper: exiting background thread, dropped_events=%llu",
+            (unsigned long long)tracer_.num_dropped());
+
+    close_();
+}
+
+bool TraceDumper::open_(const char* path) {
+    roc_panic_if(file_);
+
+    file_ = fopen(path, "w");
+    if (!file_) {
+        roc_log(LogError, "trace dumper: failed to open output file \"%s\": %s", path,
+                errno_to_str().c_str());
+        return false;
+    }
+
+    if (fprintf(file_, "{\"traceEvents\":[") < 0) {
+        roc_log(LogError, "trace dumper: failed to write output file: %s",
+                errno_to_str().c_str());
+        close_();
+        return false;
+    }
+
+    return true;
+}
+
+void TraceDumper::close_() {
+    if (file_) {
+        if (fprintf(file_, "\n]}\n") < 0) {
+            roc_log(LogError, "trace dumper: failed to write output file: %s",
+                    errno_to_str().c_str());
+        }
+        if (fclose(file_) != 0) {
+            roc_log(LogError, "trace dumper: failed to close output file: %s",
+                    errno_to_str().c_str());
+        }
+        file_ = NULL;
+    }
+}
+
+size_t TraceDumper::drain_() {
+    const size_t n_events = tracer_.read(events_, BatchSize);
+
+    for (size_t n = 0; n < n_events && !failed_; n++) {
+        if (!dump_(events_[n])) {
+            failed_ = true;
+        }
+    }
+
+    if (n_events != 0 && !failed_) {
+        fflush(file_);
+    }
+
+    return n_events;
+}
+
+bool TraceDumper::dump_(const TraceEvent& event) {
+    roc_panic_if(!file_);
+
+    // Timestamps in trace event format are in microseconds.
+    // Event names are string literals from instrumented code and
+    // don't need escaping.
+    int ret = fprintf(file_,
+                      "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lld.%03d,"
+                      "\"pid\":%llu,\"tid\":%llu",
+                      first_event_ ? "" : ",", event.name, (char)event.phase,
+                      (long long)(event.time / Microsecond),
+                      (int)(event.time % Microsecond), (unsigned long long)pid_,
+                      (unsigned long long)event.tid);
+
+    if (ret >= 0) {
+        if (event.phase == TracePhase_Complete) {
+            ret = fprintf(file_, ",\"dur\":%lld.%03d}",
+                          (long long)(event.duration / Microsecond),
+                          (int)(event.duration % Microsecond));
+        } else {
+            ret = fprintf(file_, ",\"s\":\"t\"}");
+        }
+    }
+
+    if (ret < 0) {
+        roc_log(LogError, "trace dumper: failed to write output file: %s",
+                errno_to_str().c_str());
+        return false;
+    }
+
+    first_event_ = false;
+
+    return true;
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/trace_dumper.h
+//! @brief Asynchronous trace dumper.
+
+#ifndef ROC_CORE_TRACE_DUMPER_H_
+#define ROC_CORE_TRACE_DUMPER_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
+#include "roc_core/time.h"
+#include "roc_core/tracer.h"
+
+namespace roc {
+namespace core {
+
+//! Trace dumper configuration.
+struct TraceDumperConfig {
+    //! How often to drain tracer.
+    //! Should be small enough so that tracer lanes don't overflow.
+    nanoseconds_t flush_interval;
+
+    //! Scheduling policy of background thread.
+    ThreadPolicy thread_policy;
+
+    TraceDumperConfig()
+        : flush_interval(Millisecond * 50) {
+    }
+};
+
+//! Asynchronous trace dumper.
+//!
+//! Periodically drains events from Tracer in background thread and writes
+//! them to file in Chrome trace event format (JSON), which can be opened
+//! in chrome://tracing or Perfetto UI.
+//!
+//! Dumper doesn't enable tracer; it should be enabled separately.
+class TraceDumper : public Thread {
+public:
+    //! Open file.
+    //! @p path - output file.
+    TraceDumper(const char* path, const TraceDumperConfig& config, Tracer& tracer);
+
+    //! Close file.
+    ~TraceDumper();
+
+    //! Check if opened without errors.
+    bool is_valid() const;
+
+    //! Stop background thread.
+    //! Remaining events are written before thread exits.
+    void stop();
+
+private:
+    enum { BatchSize = 256 };
+
+    virtual void run();
+
+    bool open_(const char* path);
+    void close_();
+    size_t drain_();
+    bool dump_(const TraceEvent& event);
+
+    const TraceDumperConfig config_;
+
+    Tracer& tracer_;
+
+    FILE* file_;
+    uint64_t pid_;
+    bool first_event_;
+    bool failed_;
+
+    TraceEvent events_[BatchSize];
+
+    Semaphore stop_sem_;
+    Atomic<int> stop_;
+    bool valid_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_TRACE_DUMPER_H_
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/tracer.h"
+#include "roc_core/fast_clock.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+Tracer::Tracer()
+    : lanes_(NULL)
+    , enabled_(false)
+    , num_dropped_(0) {
+}
+
+bool Tracer::is_compiled_in() {
+#ifdef ROC_ENABLE_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool Tracer::enable(const TraceConfig& config) {
+    Mutex::Lock lock(mutex_);
+
+    if (!lanes_storage_) {
+        lanes_storage_.reset(new (lanes_storage_) LaneRingBuffer<TraceEvent>(
+            arena_, config.num_lanes, config.lane_size));
+
+        if (!lanes_storage_->is_valid()) {
+            roc_log(LogError, "tracer: can't allocate lanes");
+            lanes_storage_.reset(NULL);
+            return false;
+        }
+
+        // Pairs with acquire in add_().
+        AtomicOps::store_release(lanes_, lanes_storage_.get());
+    }
+
+    AtomicOps::store_relaxed(enabled_, true);
+
+    return true;
+}
+
+void Tracer::disable() {
+    AtomicOps::store_relaxed(enabled_, false);
+}
+
+void Tracer::add_instant(const char* name) {
+    TraceEvent event;
+    event.name = name;
+    event.time = fast_timestamp();
+    event.tid = Thread::get_tid();
+    event.phase = TracePhase_Instant;
+
+    add_(event);
+}
+
+void Tracer::add_complete(const char* name, nanoseconds_t start_time) {
+    TraceEvent event;
+    event.name = name;
+    event.time = start_time;
+    event.duration = fast_timestamp() - start_time;
+    event.tid = Thread::get_tid();
+    event.phase = TracePhase_Complete;
+
+    add_(event);
+}
+
+size_t Tracer::read(TraceEvent* events, size_t max_events) {
+    roc_panic_if(!events && max_events != 0);
+
+    Mutex::Lock lock(mutex_);
+
+    LaneRingBuffer<TraceEvent>* lanes = AtomicOps::load_acquire(lanes_);
+    if (!lanes) {
+        return 0;
+    }
+
+    size_t n_events = 0;
+
+    TraceEvent event;
+
+    for (size_t lane = 0; lane < lanes->num_lanes(); lane++) {
+        while (n_events < max_events && lanes->pop(lane, event)) {
+            events[n_events++] = event;
+        }
+    }
+
+    return n_events;
+}
+
+uint64_t Tracer::num_dropped() const {
+    return AtomicOps::load_relaxed(num_dropped_);
+}
+
+void Tracer::add_(const TraceEvent& event) {
+    // Not checking enabled_ here, so that complete event is not lost if tracing
+    // was disabled in the middle of a scope. Callers check it before.
+    LaneRingBuffer<TraceEvent>* lanes = AtomicOps::load_acquire(lanes_);
+    if (!lanes) {
+        return;
+    }
+
+    if (!lanes->push(event, event.tid)) {
+        AtomicOps::fetch_add_relaxed(num_dropped_, (uint64_t)1);
+    }
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/tracer.h
+//! @brief Timeline tracer.
+
+#ifndef ROC_CORE_TRACER_H_
+#define ROC_CORE_TRACER_H_
+
+#include "roc_core/atomic_ops.h"
+#include "roc_core/fast_clock.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/lane_ring_buffer.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/singleton.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+#ifdef ROC_ENABLE_TRACING
+
+//! Trace current scope.
+//! @remarks
+//!  Remembers time now and records complete event when scope is left.
+//!  @p name should be a string literal.
+//!  If tracing is disabled at runtime, costs one relaxed atomic load.
+//!  If tracing is not compiled in, expands to nothing.
+#define roc_trace_scope(name)                                                            \
+    ::roc::core::TraceScope ROC_CONCAT(roc_trace_scope_, __LINE__)(name)
+
+//! Trace instant event.
+//! @remarks
+//!  @p name should be a string literal.
+//!  If tracing is not compiled in, expands to nothing.
+#define roc_trace_instant(name)                                                          \
+    do {                                                                                 \
+        ::roc::core::Tracer& tracer = ::roc::core::Tracer::instance();                   \
+        if (tracer.is_enabled()) {                                                       \
+            tracer.add_instant(name);                                                    \
+        }                                                                                \
+    } while (0)
+
+#else // !ROC_ENABLE_TRACING
+
+#define roc_trace_scope(name) ((void)0)
+#define roc_trace_instant(name) ((void)0)
+
+#endif // ROC_ENABLE_TRACING
+
+namespace roc {
+namespace core {
+
+//! Trace event phase.
+//! Values match phase codes of Chrome trace event format.
+enum TracePhase {
+    TracePhase_Complete = 'X', //!< Duration event with start time and duration.
+    TracePhase_Instant = 'i'   //!< Instant event.
+};
+
+//! Trace event.
+struct TraceEvent {
+    //! Event name, a string literal.
+    const char* name;
+
+    //! Monotonic timestamp.
+    //! For complete events, start time.
+    nanoseconds_t time;
+
+    //! Duration of complete event.
+    nanoseconds_t duration;
+
+    //! ID of thread which produced event.
+    uint64_t tid;
+
+    //! Event phase.
+    TracePhase phase;
+
+    TraceEvent()
+        : name(NULL)
+        , time(0)
+        , duration(0)
+        , tid(0)
+        , phase(TracePhase_Instant) {
+    }
+};
+
+//! Tracer configuration.
+struct TraceConfig {
+    //! Number of lanes.
+    //! Should be not greater than LaneRingBuffer::MaxLanes.
+    size_t num_lanes;
+
+    //! Maximum number of buffered events per lane.
+    //! If lane becomes full, events are dropped.
+    size_t lane_size;
+
+    TraceConfig()
+        : num_lanes(8)
+        , lane_size(8192) {
+    }
+};
+
+//! Timeline tracer.
+//!
+//! Collects complete (duration) and instant events from any thread into
+//! binary ring buffers, which are then drained by a single reader, typically
+//! TraceDumper, and converted to a human-readable timeline.
+//!
+//! Adding event is lock-free and doesn't allocate: event holds only pointer
+//! to a string literal, timestamps, and thread ID. Like AsyncLogWriter, tracer
+//! uses LaneRingBuffer with thread ID as the key, so that in most cases each
+//! thread has its own ring buffer. If all lanes are busy or the selected lane
+//! is full, event is dropped and counted.
+//!
+//! Duration is recorded as a single complete event when it ends, rather than
+//! as a pair of begin and end events, so that a dropped event never leaves
+//! an unpaired begin or end in the timeline.
+//!
+//! Tracer is disabled by default. Instrumentation macros are compiled in
+//! only if ROC_ENABLE_TRACING is defined.
+class Tracer : public NonCopyable<> {
+public:
+    //! Get tracer instance.
+    static Tracer& instance() {
+        return Singleton<Tracer>::instance();
+    }
+
+    //! Check if instrumentation macros are compiled in.
+    static bool is_compiled_in();
+
+    //! Check if tracing is enabled.
+    //! Lock-free operation.
+    bool is_enabled() const {
+        return AtomicOps::load_relaxed(enabled_);
+    }
+
+    //! Enable tracing.
+    //! @remarks
+    //!  Lanes are allocated on first call and live until process exit.
+    //!  @p config is used only on first call.
+    //! @returns
+    //!  false if allocation failed.
+    bool enable(const TraceConfig& config = TraceConfig());
+
+    //! Disable tracing.
+    //! @remarks
+    //!  Already buffered events can still be read.
+    void disable();
+
+    //! Add instant event for calling thread.
+    //! Lock-free operation.
+    void add_instant(const char* name);
+
+    //! Add complete event for calling thread.
+    //! @remarks
+    //!  Event lasts from @p start_time, obtained from fast_timestamp(), till now.
+    //!  Lock-free operation.
+    void add_complete(const char* name, nanoseconds_t start_time);
+
+    //! Read buffered events.
+    //! @remarks
+    //!  Moves up to @p max_events events to @p events and returns their count.
+    //!  Events of one thread are read in order, events of different threads
+    //!  are not sorted. Can be called from any thread, but concurrent reads
+    //!  are serialized.
+    size_t read(TraceEvent* events, size_t max_events);
+
+    //! Get total number of dropped events.
+    uint64_t num_dropped() const;
+
+private:
+    friend class Singleton<Tracer>;
+
+    Tracer();
+
+    void add_(const TraceEvent& event);
+
+    Optional<LaneRingBuffer<TraceEvent> > lanes_storage_;
+    LaneRingBuffer<TraceEvent>* lanes_;
+
+    int enabled_;
+    uint64_t num_dropped_;
+
+    HeapArena arena_;
+    Mutex mutex_;
+};
+
+//! Traces duration of a scope.
+//! @remarks
+//!  Usually created using roc_trace_scope() macro.
+class TraceScope : public NonCopyable<> {
+public:
+    //! Remember start time if tracing is enabled.
+    explicit TraceScope(const char* name)
+        : name_(name)
+        , start_time_(0) {
+        if (Tracer::instance().is_enabled()) {
+            start_time_ = fast_timestamp();
+        }
+    }
+
+    //! Add complete event if tracing was enabled when scope was entered.
+    ~TraceScope() {
+        if (start_time_ != 0) {
+            Tracer::instance().add_complete(name_, start_time_);
+        }
+    }
+
+private:
+    const char* name_;
+    nanoseconds_t start_time_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_TRACER_H_
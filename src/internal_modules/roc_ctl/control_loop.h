@@ -18,6 +18,7 @@
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/shared_ptr.h"
+#include "roc_core/thread_policy.h"
 #include "roc_ctl/basic_control_endpoint.h"
 #include "roc_ctl/control_task_executor.h"
 #include "roc_ctl/control_task_queue.h"
@@ -174,7 +175,11 @@ public:
     };
 
     //! Initialize.
-    ControlLoop(netio::NetworkLoop& network_loop, core::IArena& arena);
+    //! @remarks
+    //!  @p thread_policy defines scheduling policy of control thread.
+    ControlLoop(netio::NetworkLoop& network_loop,
+                core::IArena& arena,
+                const core::ThreadPolicy& thread_policy = core::ThreadPolicy());
 
     virtual ~ControlLoop();
 
@@ -76,6 +76,7 @@ protected:
         , renewed_deadline_(0)
         , effective_deadline_(0)
         , effective_version_(0)
+        , wheel_list_(-1)
         , func_(reinterpret_cast<ControlTaskFunc>(task_func))
         , executor_(NULL)
         , completer_(NULL)
@@ -86,13 +87,18 @@ protected:
 
 private:
     friend class ControlTaskQueue;
+    friend class ControlTaskWheel;
+
+    // Allows unit tests to set task deadline and drive ControlTaskWheel
+    // directly with simulated time.
+    friend struct ControlTaskWheelTestAccess;
 
     enum State {
         // task is in ready queue or being fetched from it; after it's
         // fetched, it will be processed, cancelled, or rescheduled
         StateReady,
 
-        // task is in sleeping queue, waiting for its deadline
+        // task is in sleeping wheel, waiting for its deadline
         StateSleeping,
 
         // task cancellation is initiated
@@ -155,6 +161,9 @@ private:
     // version of currently active task deadline
     core::seqlock_version_t effective_version_;
 
+    // index of list in sleeping tasks wheel, or -1 if task is not there
+    int wheel_list_;
+
     // function to be executed
     ControlTaskFunc func_;
 
@@ -14,11 +14,13 @@
 namespace roc {
 namespace ctl {
 
-ControlTaskQueue::ControlTaskQueue()
+ControlTaskQueue::ControlTaskQueue(const core::ThreadPolicy& thread_policy)
     : started_(false)
     , stop_(false)
     , fetch_ready_(true)
-    , ready_queue_size_(0) {
+    , ready_queue_size_(0)
+    , sleeping_queue_(core::timestamp(core::ClockMonotonic)) {
+    Thread::set_policy(thread_policy);
     start_thread_();
 }
 
@@ -802,17 +804,12 @@ ControlTask* ControlTaskQueue::fetch_ready_task_() {
 }
 
 ControlTask* ControlTaskQueue::fetch_sleeping_task_() {
-    ControlTask* task = sleeping_queue_.front();
+    ControlTask* task =
+        sleeping_queue_.pop_expired(core::timestamp(core::ClockMonotonic));
     if (!task) {
         return NULL;
     }
 
-    if (task->effective_deadline_ > core::timestamp(core::ClockMonotonic)) {
-        return NULL;
-    }
-
-    remove_sleeping_task_(*task);
-
     if (!task->state_.compare_exchange(ControlTask::StateSleeping,
                                        ControlTask::StateProcessing)) {
         return NULL;
@@ -827,19 +824,7 @@ ControlTask* ControlTaskQueue::fetch_sleeping_task_() {
 void ControlTaskQueue::insert_sleeping_task_(ControlTask& task) {
     roc_panic_if_not(task.effective_deadline_ > 0);
 
-    ControlTask* pos = sleeping_queue_.front();
-
-    for (; pos; pos = sleeping_queue_.nextof(*pos)) {
-        if (pos->effective_deadline_ > task.effective_deadline_) {
-            break;
-        }
-    }
-
-    if (pos) {
-        sleeping_queue_.insert_before(task, *pos);
-    } else {
-        sleeping_queue_.push_back(task);
-    }
+    sleeping_queue_.insert(task);
 }
 
 void ControlTaskQueue::remove_sleeping_task_(ControlTask& task) {
@@ -853,11 +838,7 @@ core::nanoseconds_t ControlTaskQueue::update_wakeup_timer_() {
 
     // Sleep only if there are no tasks in ready queue.
     if (ready_queue_size_ == 0) {
-        if (ControlTask* task = sleeping_queue_.front()) {
-            deadline = task->effective_deadline_;
-        } else {
-            deadline = -1;
-        }
+        deadline = sleeping_queue_.next_deadline();
     }
 
     roc_log(LogTrace, "control task queue: updating wakeup deadline: deadline=%lld",
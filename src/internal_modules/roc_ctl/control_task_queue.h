@@ -17,10 +17,12 @@
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/mutex.h"
 #include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
 #include "roc_core/time.h"
 #include "roc_core/timer.h"
 #include "roc_ctl/control_task.h"
 #include "roc_ctl/control_task_executor.h"
+#include "roc_ctl/control_task_wheel.h"
 #include "roc_ctl/icontrol_task_completer.h"
 
 namespace roc {
@@ -55,8 +57,9 @@ namespace ctl {
 //!    - tasks to be re-scheduled with another deadline (renewed_deadline_ > 0)
 //!    - tasks to be canceled                           (renewed_deadline_ < 0)
 //!
-//!  - sleeping_queue_ - a sorted queue of tasks with non-zero deadline, scheduled for
-//!    execution in future; the task at the head has the smallest (nearest) deadline;
+//!  - sleeping_queue_ - a hierarchical timing wheel (ControlTaskWheel) of tasks with
+//!    non-zero deadline, scheduled for execution in future; it provides constant-time
+//!    insertion and removal, and fetches expired tasks in order of their deadlines;
 //!
 //!  - pause_queue_ - an unsorted queue to keep track of all currently paused tasks.
 //!
@@ -65,7 +68,7 @@ namespace ctl {
 //!
 //! wakeup_timer_ (core::Timer) is used to set or wait for the next wakeup time of the
 //! background thread. This time is set to zero when ready_queue_ is non-empty, otherwise
-//! it is set to the deadline of the first task in sleeping_queue_ if it's non-empty, and
+//! it is set to the next deadline reported by sleeping_queue_ if it's non-empty, and
 //! otherwise is set to infinity (-1). The timer allows to update the deadline
 //! concurrently from any thread.
 //!
@@ -126,8 +129,9 @@ class ControlTaskQueue : private core::Thread {
 public:
     //! Initialize.
     //! @remarks
-    //!  Starts background thread.
-    ControlTaskQueue();
+    //!  Starts background thread with given scheduling policy.
+    explicit ControlTaskQueue(
+        const core::ThreadPolicy& thread_policy = core::ThreadPolicy());
 
     //! Destroy.
     //! @remarks
@@ -275,7 +279,7 @@ private:
 
     core::Atomic<int> ready_queue_size_;
     core::MpscQueue<ControlTask, core::NoOwnership> ready_queue_;
-    core::List<ControlTask, core::NoOwnership> sleeping_queue_;
+    ControlTaskWheel sleeping_queue_;
     core::List<ControlTask, core::NoOwnership> paused_queue_;
 
     core::Timer wakeup_timer_;
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_ctl/control_task_wheel.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace ctl {
+
+namespace {
+
+// Duration of one tick of the first level.
+// With 4 levels of 64 slots, wheel covers about 4.6 hours ahead.
+const core::nanoseconds_t TickDuration = core::Millisecond;
+
+// Returns index of lowest set bit, mask should be non-zero.
+size_t lowest_bit(uint64_t mask) {
+    size_t n = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        n++;
+    }
+    return n;
+}
+
+} // namespace
+
+ControlTaskWheel::ControlTaskWheel(core::nanoseconds_t now)
+    : current_tick_(deadline_2_tick_(now))
+    , size_(0) {
+    for (size_t n = 0; n < NumLevels; n++) {
+        level_masks_[n] = 0;
+    }
+}
+
+ControlTaskWheel::~ControlTaskWheel() {
+    for (size_t n = 0; n < NumLists; n++) {
+        while (ControlTask* task = lists_[n].front()) {
+            lists_[n].remove(*task);
+            task->wheel_list_ = NoList;
+        }
+    }
+}
+
+size_t ControlTaskWheel::size() const {
+    return size_;
+}
+
+bool ControlTaskWheel::contains(const ControlTask& task) const {
+    return task.wheel_list_ != NoList;
+}
+
+void ControlTaskWheel::insert(ControlTask& task) {
+    roc_panic_if_not(task.effective_deadline_ > 0);
+    roc_panic_if_msg(contains(task), "control task wheel: task is already in wheel");
+
+    place_(task);
+    size_++;
+}
+
+void ControlTaskWheel::remove(ControlTask& task) {
+    roc_panic_if_msg(!contains(task), "control task wheel: task is not in wheel");
+
+    const size_t index = (size_t)task.wheel_list_;
+
+    lists_[index].remove(task);
+    task.wheel_list_ = NoList;
+    size_--;
+
+    if (index < OverflowList && lists_[index].is_empty()) {
+        level_masks_[index / NumSlots] &= ~(uint64_t(1) << (index % NumSlots));
+    }
+}
+
+ControlTask* ControlTaskWheel::pop_expired(core::nanoseconds_t now) {
+    const uint64_t now_tick = deadline_2_tick_(now);
+
+    if (size_ == 0) {
+        // Nothing to cascade, just jump forward.
+        if (current_tick_ < now_tick) {
+            current_tick_ = now_tick;
+        }
+        return NULL;
+    }
+
+    advance_(now_tick);
+
+    ControlTask* task = lists_[ExpiredList].front();
+
+    if (!task) {
+        // Current slot contains tasks of current tick, some of
+        // them may be not expired yet.
+        task = lists_[current_tick_ & (NumSlots - 1)].front();
+
+        if (!task || task->effective_deadline_ > now) {
+            return NULL;
+        }
+    }
+
+    remove(*task);
+
+    return task;
+}
+
+core::nanoseconds_t ControlTaskWheel::next_deadline() const {
+    if (size_ == 0) {
+        return -1;
+    }
+
+    if (ControlTask* task = lists_[ExpiredList].front()) {
+        return task->effective_deadline_;
+    }
+
+    // Slots of first level are sorted, so we can report exact deadline.
+    {
+        const size_t cur_slot = size_t(current_tick_ & (NumSlots - 1));
+        const uint64_t mask = level_masks_[0] >> cur_slot;
+
+        if (mask != 0) {
+            const size_t slot = cur_slot + lowest_bit(mask);
+            return lists_[slot].front()->effective_deadline_;
+        }
+    }
+
+    // For upper levels, report time when nearest non-empty slot should
+    // be cascaded.
+    for (size_t level = 1; level < NumLevels; level++) {
+        const size_t shift = SlotBits * level;
+        const size_t cur_slot = size_t((current_tick_ >> shift) & (NumSlots - 1));
+
+        if (cur_slot + 1 == NumSlots) {
+            continue;
+        }
+
+        const uint64_t mask = level_masks_[level] >> (cur_slot + 1);
+
+        if (mask != 0) {
+            const size_t slot = cur_slot + 1 + lowest_bit(mask);
+            const size_t upper_shift = shift + SlotBits;
+            const uint64_t tick = ((current_tick_ >> upper_shift) << upper_shift)
+                | (uint64_t(slot) << shift);
+
+            return core::nanoseconds_t(tick) * TickDuration;
+        }
+    }
+
+    // Overflow list is redistributed when the whole wheel turns around.
+    const size_t shift = SlotBits * NumLevels;
+    const uint64_t tick = ((current_tick_ >> shift) + 1) << shift;
+
+    return core::nanoseconds_t(tick) * TickDuration;
+}
+
+uint64_t ControlTaskWheel::deadline_2_tick_(core::nanoseconds_t deadline) {
+    return uint64_t(deadline / TickDuration);
+}
+
+void ControlTaskWheel::place_(ControlTask& task) {
+    uint64_t tick = deadline_2_tick_(task.effective_deadline_);
+    if (tick < current_tick_) {
+        tick = current_tick_;
+    }
+
+    // Find lowest level, in which task's tick and current tick belong
+    // to the same revolution.
+    for (size_t level = 0; level < NumLevels; level++) {
+        const size_t shift = SlotBits * level;
+
+        if (((tick ^ current_tick_) >> (shift + SlotBits)) != 0) {
+            continue;
+        }
+
+        const size_t slot = size_t((tick >> shift) & (NumSlots - 1));
+        const size_t index = level * NumSlots + slot;
+
+        if (level == 0) {
+            insert_sorted_(lists_[index], task);
+        } else {
+            lists_[index].push_back(task);
+        }
+
+        task.wheel_list_ = (int)index;
+        level_masks_[level] |= uint64_t(1) << slot;
+
+        return;
+    }
+
+    lists_[OverflowList].push_back(task);
+    task.wheel_list_ = OverflowList;
+}
+
+void ControlTaskWheel::insert_sorted_(TaskList& list, ControlTask& task) {
+    // Search from the back, since tasks are usually added with
+    // increasing deadlines. Tasks with same deadline keep FIFO order.
+    ControlTask* pos = list.back();
+
+    while (pos && pos->effective_deadline_ > task.effective_deadline_) {
+        pos = list.prevof(*pos);
+    }
+
+    if (pos) {
+        list.insert_after(task, *pos);
+    } else {
+        list.push_front(task);
+    }
+}
+
+void ControlTaskWheel::move_list_(size_t index) {
+    while (ControlTask* task = lists_[index].front()) {
+        lists_[index].remove(*task);
+        lists_[ExpiredList].push_back(*task);
+        task->wheel_list_ = ExpiredList;
+    }
+
+    if (index < OverflowList) {
+        level_masks_[index / NumSlots] &= ~(uint64_t(1) << (index % NumSlots));
+    }
+}
+
+void ControlTaskWheel::advance_(uint64_t tick) {
+    while (current_tick_ < tick) {
+        if (level_masks_[0] == 0) {
+            // First level is empty, skip to its next revolution.
+            const uint64_t next_tick = ((current_tick_ >> SlotBits) + 1) << SlotBits;
+
+            if (next_tick > tick) {
+                current_tick_ = tick;
+                break;
+            }
+
+            current_tick_ = next_tick;
+        } else {
+            const size_t slot = size_t(current_tick_ & (NumSlots - 1));
+
+            if (level_masks_[0] & (uint64_t(1) << slot)) {
+                // All tasks of passed tick are expired.
+                move_list_(slot);
+            }
+
+            current_tick_++;
+        }
+
+        if ((current_tick_ & (NumSlots - 1)) == 0) {
+            cascade_();
+        }
+    }
+}
+
+void ControlTaskWheel::cascade_() {
+    TaskList tasks;
+
+    // Collect tasks from slots of upper levels, which revolution starts
+    // at current tick, and from overflow list if the whole wheel turns around.
+    for (size_t level = 1; level <= NumLevels; level++) {
+        const size_t shift = SlotBits * level;
+
+        if ((current_tick_ & ((uint64_t(1) << shift) - 1)) != 0) {
+            break;
+        }
+
+        size_t index = OverflowList;
+
+        if (level < NumLevels) {
+            index = level * NumSlots + size_t((current_tick_ >> shift) & (NumSlots - 1));
+            level_masks_[level] &= ~(uint64_t(1) << (index % NumSlots));
+        }
+
+        while (ControlTask* task = lists_[index].front()) {
+            lists_[index].remove(*task);
+            tasks.push_back(*task);
+        }
+    }
+
+    // Redistribute them to lower levels.
+    while (ControlTask* task = tasks.front()) {
+        tasks.remove(*task);
+        place_(*task);
+    }
+}
+
+} // namespace ctl
+} // namespace roc
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_ctl/control_task_wheel.h
+//! @brief Timing wheel for sleeping control tasks.
+
+#ifndef ROC_CTL_CONTROL_TASK_WHEEL_H_
+#define ROC_CTL_CONTROL_TASK_WHEEL_H_
+
+#include "roc_core/list.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_ctl/control_task.h"
+
+namespace roc {
+namespace ctl {
+
+//! Hierarchical timing wheel for sleeping control tasks.
+//!
+//! Holds tasks with non-zero deadline (ControlTask::effective_deadline_)
+//! and allows to fetch tasks which deadline has expired, in order of deadlines.
+//!
+//! Time is divided into ticks. The wheel has several levels, every level
+//! has a fixed number of slots (buckets), and every slot of a level covers
+//! as many ticks as the whole previous level. Tasks which are too far in
+//! the future to fit into the last level are kept in overflow list.
+//!
+//! When the current tick moves to the beginning of a slot of upper level,
+//! tasks from that slot are redistributed (cascaded) to lower levels.
+//! Slots of the lowest level are kept sorted by deadline, so tasks are
+//! fetched exactly in order of their deadlines.
+//!
+//! Insertion and removal take constant time, except for ordering within
+//! a single slot of the lowest level, which holds tasks of a single tick.
+//!
+//! Not thread-safe.
+class ControlTaskWheel : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p now defines current time, in the same time base as task deadlines.
+    explicit ControlTaskWheel(core::nanoseconds_t now);
+
+    ~ControlTaskWheel();
+
+    //! Get number of tasks in wheel.
+    size_t size() const;
+
+    //! Check if task is in wheel.
+    bool contains(const ControlTask& task) const;
+
+    //! Add task to wheel.
+    //! @pre
+    //!  Task deadline should be positive and task should not be in wheel.
+    void insert(ControlTask& task);
+
+    //! Remove task from wheel.
+    //! @pre
+    //!  Task should be in wheel.
+    void remove(ControlTask& task);
+
+    //! Remove and return task with earliest deadline, if it's not after @p now.
+    //! @returns
+    //!  NULL if there are no expired tasks.
+    ControlTask* pop_expired(core::nanoseconds_t now);
+
+    //! Get time when the wheel should be checked next time.
+    //! @returns
+    //!  exact deadline of earliest task, if it belongs to the nearest ticks,
+    //!  or an earlier time when more distant tasks will need cascading;
+    //!  -1 if wheel is empty.
+    core::nanoseconds_t next_deadline() const;
+
+private:
+    typedef core::List<ControlTask, core::NoOwnership> TaskList;
+
+    enum {
+        // Number of bits in slot index.
+        SlotBits = 6,
+
+        // Number of slots in every level.
+        NumSlots = 1 << SlotBits,
+
+        // Number of levels.
+        NumLevels = 4,
+
+        // Index of list for tasks beyond last level.
+        OverflowList = NumLevels * NumSlots,
+
+        // Index of list for expired tasks.
+        ExpiredList = OverflowList + 1,
+
+        // Total number of lists.
+        NumLists = ExpiredList + 1,
+
+        // Marks task which is not in wheel.
+        NoList = -1
+    };
+
+    static uint64_t deadline_2_tick_(core::nanoseconds_t deadline);
+
+    void place_(ControlTask& task);
+    void insert_sorted_(TaskList& list, ControlTask& task);
+    void move_list_(size_t index);
+
+    void advance_(uint64_t tick);
+    void cascade_();
+
+    TaskList lists_[NumLists];
+
+    // Bitmask of non-empty slots, per level.
+    uint64_t level_masks_[NumLevels];
+
+    // Tick corresponding to current slot of first level.
+    uint64_t current_tick_;
+
+    size_t size_;
+};
+
+} // namespace ctl
+} // namespace roc
+
+#endif // ROC_CTL_CONTROL_TASK_WHEEL_H_
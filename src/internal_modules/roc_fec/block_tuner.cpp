@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/block_tuner.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+void BlockTunerConfig::deduce_defaults(const WriterConfig& writer_config) {
+    if (min_repair_packets == 0) {
+        min_repair_packets = 1;
+    }
+
+    if (max_repair_packets == 0) {
+        // By default, allow up to 100% redundancy, or configured number
+        // of repair packets, if it's higher.
+        max_repair_packets =
+            std::max(writer_config.n_source_packets, writer_config.n_repair_packets);
+        max_repair_packets = std::max(max_repair_packets, min_repair_packets);
+    }
+
+    if (loss_margin == 0) {
+        loss_margin = 2.0f;
+    }
+
+    if (loss_decay == 0) {
+        loss_decay = 0.25f;
+    }
+
+    if (decrease_cooldown == 0) {
+        decrease_cooldown = 5 * core::Second;
+    }
+}
+
+BlockTuner::BlockTuner(const BlockTunerConfig& tuner_config,
+                       const WriterConfig& writer_config)
+    : n_source_packets_(writer_config.n_source_packets)
+    , min_repair_packets_(tuner_config.min_repair_packets)
+    , max_repair_packets_(tuner_config.max_repair_packets)
+    , loss_margin_(tuner_config.loss_margin)
+    , loss_decay_(tuner_config.loss_decay)
+    , decrease_cooldown_(tuner_config.decrease_cooldown)
+    , n_repair_packets_(0)
+    , loss_(0)
+    , last_change_ts_(0)
+    , valid_(false) {
+    if (n_source_packets_ == 0 || min_repair_packets_ > max_repair_packets_
+        || loss_margin_ <= 0 || loss_decay_ <= 0 || loss_decay_ > 1
+        || decrease_cooldown_ < 0) {
+        roc_log(LogError,
+                "fec block tuner: invalid config:"
+                " sblen=%lu min_rblen=%lu max_rblen=%lu loss_margin=%.3f"
+                " loss_decay=%.3f decrease_cooldown=%.3fms",
+                (unsigned long)n_source_packets_, (unsigned long)min_repair_packets_,
+                (unsigned long)max_repair_packets_, (double)loss_margin_,
+                (double)loss_decay_, (double)decrease_cooldown_ / core::Millisecond);
+        return;
+    }
+
+    // Start from configured number of repair packets, trimmed to bounds.
+    n_repair_packets_ = std::min(
+        std::max(writer_config.n_repair_packets, min_repair_packets_), max_repair_packets_);
+
+    roc_log(LogDebug,
+            "fec block tuner: initializing:"
+            " sblen=%lu rblen=%lu min_rblen=%lu max_rblen=%lu loss_margin=%.3f",
+            (unsigned long)n_source_packets_, (unsigned long)n_repair_packets_,
+            (unsigned long)min_repair_packets_, (unsigned long)max_repair_packets_,
+            (double)loss_margin_);
+
+    valid_ = true;
+}
+
+bool BlockTuner::is_valid() const {
+    return valid_;
+}
+
+size_t BlockTuner::n_source_packets() const {
+    roc_panic_if(!is_valid());
+
+    return n_source_packets_;
+}
+
+size_t BlockTuner::n_repair_packets() const {
+    roc_panic_if(!is_valid());
+
+    return n_repair_packets_;
+}
+
+float BlockTuner::loss_ratio() const {
+    roc_panic_if(!is_valid());
+
+    return loss_;
+}
+
+bool BlockTuner::update(float fract_loss, core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    if (fract_loss < 0) {
+        fract_loss = 0;
+    }
+    if (fract_loss > 1) {
+        fract_loss = 1;
+    }
+
+    // Fast attack, slow decay: react to loss bursts immediately, but
+    // don't drop protection on a single clean report.
+    if (fract_loss > loss_) {
+        loss_ = fract_loss;
+    } else {
+        loss_ += (fract_loss - loss_) * loss_decay_;
+    }
+
+    const size_t target_rblen = compute_repair_packets_(loss_);
+
+    size_t new_rblen = n_repair_packets_;
+
+    if (target_rblen > n_repair_packets_) {
+        new_rblen = target_rblen;
+    } else if (target_rblen < n_repair_packets_
+               && current_time - last_change_ts_ >= decrease_cooldown_) {
+        new_rblen = n_repair_packets_ - 1;
+    }
+
+    if (new_rblen == n_repair_packets_) {
+        return false;
+    }
+
+    roc_log(LogDebug,
+            "fec block tuner: changing repair block length:"
+            " loss=%.4f sblen=%lu old_rblen=%lu new_rblen=%lu",
+            (double)loss_, (unsigned long)n_source_packets_,
+            (unsigned long)n_repair_packets_, (unsigned long)new_rblen);
+
+    n_repair_packets_ = new_rblen;
+    last_change_ts_ = current_time;
+
+    return true;
+}
+
+size_t BlockTuner::compute_repair_packets_(float loss) const {
+    // Block of sblen source and rblen repair packets can recover up to rblen
+    // losses. With loss ratio L, we expect L * (sblen + rblen) losses per block,
+    // hence we need rblen >= sblen * L / (1 - L).
+    const float scaled_loss = loss * loss_margin_;
+
+    if (scaled_loss >= 1) {
+        return max_repair_packets_;
+    }
+
+    const float rblen_f = (float)n_source_packets_ * scaled_loss / (1 - scaled_loss);
+
+    if (rblen_f >= (float)max_repair_packets_) {
+        return max_repair_packets_;
+    }
+
+    size_t rblen = (size_t)rblen_f;
+    if ((float)rblen < rblen_f) {
+        rblen++;
+    }
+
+    return std::min(std::max(rblen, min_repair_packets_), max_repair_packets_);
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/block_tuner.h
+//! @brief FEC block tuner.
+
+#ifndef ROC_FEC_BLOCK_TUNER_H_
+#define ROC_FEC_BLOCK_TUNER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_fec/writer.h"
+
+namespace roc {
+namespace fec {
+
+//! FEC block tuner parameters.
+struct BlockTunerConfig {
+    //! Enable adaptive number of repair packets.
+    //! @remarks
+    //!  If disabled, number of repair packets is fixed and is taken
+    //!  from WriterConfig.
+    bool enable_tuning;
+
+    //! Minimum number of repair packets in block.
+    //! @note
+    //!  If zero, default value is used.
+    size_t min_repair_packets;
+
+    //! Maximum number of repair packets in block.
+    //! @note
+    //!  If zero, default value is used.
+    size_t max_repair_packets;
+
+    //! Redundancy margin.
+    //! @remarks
+    //!  Number of repair packets is selected so that the block can recover
+    //!  observed loss ratio multiplied by this factor.
+    //! @note
+    //!  If zero, default value is used.
+    //!  Negative value is an error.
+    float loss_margin;
+
+    //! Smoothing factor for decreasing loss, in range (0; 1].
+    //! @remarks
+    //!  When reported loss grows, estimate is updated immediately.
+    //!  When reported loss drops, estimate moves towards it by this fraction
+    //!  of the difference on every report.
+    //! @note
+    //!  If zero, default value is used.
+    float loss_decay;
+
+    //! Minimum interval between decreasing number of repair packets.
+    //! @remarks
+    //!  Number of repair packets is increased as soon as loss is reported,
+    //!  but is decreased by one packet at most once per this interval.
+    //! @note
+    //!  If zero, default value is used.
+    //!  Negative value is an error.
+    core::nanoseconds_t decrease_cooldown;
+
+    BlockTunerConfig()
+        : enable_tuning(false)
+        , min_repair_packets(0)
+        , max_repair_packets(0)
+        , loss_margin(0)
+        , loss_decay(0)
+        , decrease_cooldown(0) {
+    }
+
+    //! Automatically fill missing settings.
+    void deduce_defaults(const WriterConfig& writer_config);
+};
+
+//! FEC block tuner.
+//!
+//! Selects number of repair packets per FEC block based on loss ratio
+//! reported by receiver.
+//!
+//! @b Flow
+//!
+//!  - when sender pipeline obtains RTCP report from receiver, it computes
+//!    fractional loss since previous report and passes it to update()
+//!  - tuner maintains smoothed loss estimate and computes how many repair
+//!    packets are needed to recover it within configured bounds
+//!  - pipeline passes n_repair_packets() to fec::Writer::resize(), which
+//!    applies new size starting from next block
+class BlockTuner : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    BlockTuner(const BlockTunerConfig& tuner_config, const WriterConfig& writer_config);
+
+    //! Check if the object was initialized successfully.
+    bool is_valid() const;
+
+    //! Get number of source packets in block.
+    size_t n_source_packets() const;
+
+    //! Get currently selected number of repair packets in block.
+    size_t n_repair_packets() const;
+
+    //! Get smoothed loss ratio.
+    float loss_ratio() const;
+
+    //! Process fractional loss reported by receiver.
+    //! @p fract_loss is in range [0; 1].
+    //! @p current_time is monotonic timestamp of the report.
+    //! @returns
+    //!  true if number of repair packets was changed.
+    bool update(float fract_loss, core::nanoseconds_t current_time);
+
+private:
+    size_t compute_repair_packets_(float loss) const;
+
+    const size_t n_source_packets_;
+    const size_t min_repair_packets_;
+    const size_t max_repair_packets_;
+
+    const float loss_margin_;
+    const float loss_decay_;
+    const core::nanoseconds_t decrease_cooldown_;
+
+    size_t n_repair_packets_;
+    float loss_;
+
+    core::nanoseconds_t last_change_ts_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_BLOCK_TUNER_H_
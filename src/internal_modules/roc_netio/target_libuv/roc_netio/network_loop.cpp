@@ -12,6 +12,7 @@
 #include "roc_core/macro_helpers.h"
 #include "roc_core/panic.h"
 #include "roc_core/shared_ptr.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace netio {
@@ -104,7 +105,8 @@ NetworkLoop::Tasks::ResolveEndpointAddress::get_address() const {
 
 NetworkLoop::NetworkLoop(core::IPool& packet_pool,
                          core::IPool& buffer_pool,
-                         core::IArena& arena)
+                         core::IArena& arena,
+                         const core::ThreadPolicy& thread_policy)
     : packet_factory_(packet_pool, buffer_pool)
     , arena_(arena)
     , started_(false)
@@ -136,6 +138,7 @@ NetworkLoop::NetworkLoop(core::IPool& packet_pool,
     task_sem_.data = this;
     task_sem_initialized_ = true;
 
+    Thread::set_policy(thread_policy);
     started_ = Thread::start();
 }
 
@@ -301,6 +304,8 @@ void NetworkLoop::stop_sem_cb_(uv_async_t* handle) {
 }
 
 void NetworkLoop::process_pending_tasks_() {
+    roc_trace_scope("network tasks");
+
     // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
     // try_pop_front_exclusive() may return NULL if the queue is not empty, but
     // push_back() is currently in progress. In this case we can exit the loop
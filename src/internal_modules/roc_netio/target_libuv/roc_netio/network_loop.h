@@ -25,6 +25,7 @@
 #include "roc_core/optional.h"
 #include "roc_core/semaphore.h"
 #include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
 #include "roc_netio/iconn.h"
@@ -189,7 +190,11 @@ public:
     //! Initialize.
     //! @remarks
     //!  Start background thread if the object was successfully constructed.
-    NetworkLoop(core::IPool& packet_pool, core::IPool& buffer_pool, core::IArena& arena);
+    //!  @p thread_policy defines scheduling policy of network thread.
+    NetworkLoop(core::IPool& packet_pool,
+                core::IPool& buffer_pool,
+                core::IArena& arena,
+                const core::ThreadPolicy& thread_policy = core::ThreadPolicy());
 
     //! Destroy. Stop all receivers and senders.
     //! @remarks
@@ -13,6 +13,7 @@
 #include "roc_core/shared_ptr.h"
 #include "roc_core/string_builder.h"
 #include "roc_core/time.h"
+#include "roc_core/tracer.h"
 #include "roc_netio/socket_ops.h"
 #include "roc_status/code_to_str.h"
 
@@ -220,6 +221,8 @@ void UdpPort::alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf) {
     roc_panic_if_not(handle);
     roc_panic_if_not(buf);
 
+    roc_trace_scope("udp recv");
+
     UdpPort& self = *(UdpPort*)handle->data;
 
     core::BufferPtr bp = self.packet_factory_.new_packet_buffer();
@@ -347,6 +350,8 @@ void UdpPort::recv_cb_(uv_udp_t* handle,
 void UdpPort::write_sem_cb_(uv_async_t* handle) {
     roc_panic_if_not(handle);
 
+    roc_trace_scope("udp send");
+
     UdpPort& self = *(UdpPort*)handle->data;
 
     // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
@@ -7,31 +7,109 @@
  */
 
 #include "roc_node/context.h"
+#include "roc_core/fast_clock.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 
 namespace roc {
 namespace node {
 
+namespace {
+
+template <class T>
+bool preallocate_pool(core::SlabPool<T>& pool,
+                      size_t n_objects,
+                      const ContextConfig& config) {
+    if (n_objects == 0) {
+        return true;
+    }
+
+    size_t flags = 0;
+    if (config.lock_memory) {
+        flags |= core::SlabPool_LockMemory;
+    }
+    if (config.fixed_pools) {
+        flags |= core::SlabPool_FixedCapacity;
+    }
+
+    return pool.preallocate(n_objects, flags);
+}
+
+template <class T> ContextPoolMetrics pool_metrics(const core::SlabPool<T>& pool) {
+    ContextPoolMetrics metrics;
+
+    metrics.num_used = pool.num_used();
+    metrics.max_used = pool.max_used();
+    metrics.capacity = pool.capacity();
+
+    return metrics;
+}
+
+} // namespace
+
 Context::Context(const ContextConfig& config, core::IArena& arena)
-    : arena_(arena)
-    , packet_pool_("packet_pool", arena_)
-    , packet_buffer_pool_(
-          "packet_buffer_pool", arena_, sizeof(core::Buffer) + config.max_packet_size)
-    , frame_buffer_pool_(
-          "frame_buffer_pool", arena_, sizeof(core::Buffer) + config.max_frame_size)
+    : arena_(select_arena_(config, arena))
+    , pool_arena_(select_pool_arena_(config))
+    , packet_pool_("packet_pool",
+                   pool_arena_,
+                   sizeof(packet::Packet),
+                   slab_min_bytes_(sizeof(packet::Packet)),
+                   slab_max_bytes_(sizeof(packet::Packet)))
+    , packet_buffer_pool_("packet_buffer_pool",
+                          pool_arena_,
+                          sizeof(core::Buffer) + config.max_packet_size,
+                          slab_min_bytes_(sizeof(core::Buffer) + config.max_packet_size),
+                          slab_max_bytes_(sizeof(core::Buffer) + config.max_packet_size))
+    , frame_buffer_pool_("frame_buffer_pool",
+                         pool_arena_,
+                         sizeof(core::Buffer) + config.max_frame_size,
+                         slab_min_bytes_(sizeof(core::Buffer) + config.max_frame_size),
+                         slab_max_bytes_(sizeof(core::Buffer) + config.max_frame_size))
     , encoding_map_(arena_)
-    , network_loop_(packet_pool_, packet_buffer_pool_, arena_)
-    , control_loop_(network_loop_, arena_) {
-    roc_log(LogDebug, "context: initializing");
+    , network_loop_(packet_pool_, packet_buffer_pool_, arena_, config.network_thread)
+    , control_loop_(network_loop_, arena_, config.control_thread)
+    , pools_ok_(false) {
+    roc_log(LogDebug,
+            "context: initializing:"
+            " prealloc_packets=%lu prealloc_frames=%lu lock_memory=%d fixed_pools=%d"
+            " custom_alloc=%d huge_pages=%d",
+            (unsigned long)config.prealloc_packets, (unsigned long)config.prealloc_frames,
+            (int)config.lock_memory, (int)config.fixed_pools, (int)!!custom_arena_,
+            (int)config.huge_pages);
+
+    // Calibrate fast clock now, instead of on first use on pipeline thread.
+    const core::FastClockSource clock_source = core::FastClock::instance().source();
+    roc_log(LogDebug, "context: using fast clock: source=%s",
+            core::fast_clock_source_to_str(clock_source));
+
+    if (!preallocate_pool(packet_pool_, config.prealloc_packets, config)
+        || !preallocate_pool(packet_buffer_pool_, config.prealloc_packets, config)
+        || !preallocate_pool(frame_buffer_pool_, config.prealloc_frames, config)) {
+        roc_log(LogError, "context: can't preallocate pools");
+        return;
+    }
+
+    pools_ok_ = true;
 }
 
 Context::~Context() {
-    roc_log(LogDebug, "context: deinitializing");
+    const ContextMetrics metrics = get_metrics();
+
+    roc_log(LogDebug,
+            "context: deinitializing: max_bytes=%lu alloc_failures=%lu"
+            " max_packets=%lu/%lu max_packet_buffers=%lu/%lu max_frame_buffers=%lu/%lu",
+            (unsigned long)metrics.memory.max_bytes,
+            (unsigned long)metrics.memory.num_failures,
+            (unsigned long)metrics.packet_pool.max_used,
+            (unsigned long)metrics.packet_pool.capacity,
+            (unsigned long)metrics.packet_buffer_pool.max_used,
+            (unsigned long)metrics.packet_buffer_pool.capacity,
+            (unsigned long)metrics.frame_buffer_pool.max_used,
+            (unsigned long)metrics.frame_buffer_pool.capacity);
 }
 
 bool Context::is_valid() {
-    return network_loop_.is_valid() && control_loop_.is_valid();
+    return pools_ok_ && network_loop_.is_valid() && control_loop_.is_valid();
 }
 
 core::IArena& Context::arena() {
@@ -62,5 +140,71 @@ ctl::ControlLoop& Context::control_loop() {
     return control_loop_;
 }
 
+ContextMetrics Context::get_metrics() const {
+    ContextMetrics metrics;
+
+    metrics.memory.num_allocations = arena_.num_allocations();
+    metrics.memory.num_bytes = arena_.num_bytes();
+    metrics.memory.max_bytes = arena_.max_bytes();
+    metrics.memory.num_failures = arena_.num_failures();
+
+    if (huge_page_counter_) {
+        // Peaks of two arenas are summed, so max_bytes is an upper bound.
+        metrics.memory.num_allocations += huge_page_counter_->num_allocations();
+        metrics.memory.num_bytes += huge_page_counter_->num_bytes();
+        metrics.memory.max_bytes += huge_page_counter_->max_bytes();
+        metrics.memory.num_failures += huge_page_counter_->num_failures();
+    }
+
+    metrics.packet_pool = pool_metrics(packet_pool_);
+    metrics.packet_buffer_pool = pool_metrics(packet_buffer_pool_);
+    metrics.frame_buffer_pool = pool_metrics(frame_buffer_pool_);
+
+    return metrics;
+}
+
+core::IArena& Context::select_arena_(const ContextConfig& config, core::IArena& arena) {
+    if (config.alloc_func && config.dealloc_func) {
+        custom_arena_.reset(new (custom_arena_) core::CustomArena(
+            config.alloc_func, config.dealloc_func, config.alloc_arg));
+        return *custom_arena_;
+    }
+
+    return arena;
+}
+
+core::IArena& Context::select_pool_arena_(const ContextConfig& config) {
+    if (config.huge_pages) {
+        huge_page_arena_.reset(new (huge_page_arena_) core::HugePageArena());
+        huge_page_counter_.reset(new (huge_page_counter_)
+                                     core::CountingArena(*huge_page_arena_));
+        return *huge_page_counter_;
+    }
+
+    return arena_;
+}
+
+size_t Context::slab_min_bytes_(size_t object_size) const {
+    const size_t max_bytes = slab_max_bytes_(object_size);
+
+    // Leave room for rounding slab up to whole number of objects.
+    return max_bytes - max_bytes / 4;
+}
+
+size_t Context::slab_max_bytes_(size_t object_size) const {
+    if (!huge_page_arena_) {
+        return 0;
+    }
+
+    // Make every slab fit single huge page. Objects too large for that are
+    // allocated in slabs of default size.
+    const size_t page_capacity = huge_page_arena_->page_capacity();
+    if (object_size * 8 > page_capacity) {
+        return 0;
+    }
+
+    return page_capacity;
+}
+
 } // namespace node
 } // namespace roc
@@ -15,9 +15,14 @@
 #include "roc_audio/sample.h"
 #include "roc_core/allocation_policy.h"
 #include "roc_core/atomic.h"
+#include "roc_core/counting_arena.h"
+#include "roc_core/custom_arena.h"
+#include "roc_core/huge_page_arena.h"
 #include "roc_core/iarena.h"
+#include "roc_core/optional.h"
 #include "roc_core/ref_counted.h"
 #include "roc_core/slab_pool.h"
+#include "roc_core/thread_policy.h"
 #include "roc_ctl/control_loop.h"
 #include "roc_netio/network_loop.h"
 #include "roc_packet/packet_factory.h"
@@ -34,16 +39,128 @@ struct ContextConfig {
     //! Maximum size in bytes of an audio frame.
     size_t max_frame_size;
 
+    //! Scheduling policy of network thread.
+    core::ThreadPolicy network_thread;
+
+    //! Scheduling policy of control thread.
+    core::ThreadPolicy control_thread;
+
+    //! Number of packets to preallocate.
+    //! If non-zero, packet and packet buffer pools are allocated and pre-faulted
+    //! for this number of packets when context is created.
+    //! If zero, pools grow on demand.
+    size_t prealloc_packets;
+
+    //! Number of frames to preallocate.
+    //! If non-zero, frame buffer pool is allocated and pre-faulted for this
+    //! number of frames when context is created.
+    //! If zero, pool grows on demand.
+    size_t prealloc_frames;
+
+    //! Lock preallocated memory in RAM.
+    //! Applied only to preallocated pools.
+    bool lock_memory;
+
+    //! Don't grow preallocated pools.
+    //! If enabled, allocations fail instead of growing pool when preallocated
+    //! memory is exhausted. Applied only to preallocated pools.
+    bool fixed_pools;
+
+    //! Back packet and frame pools with huge pages.
+    //! Pool memory is mapped by core::HugePageArena and is not allocated via
+    //! arena or custom memory functions.
+    bool huge_pages;
+
+    //! Custom memory allocation function.
+    //! If set together with dealloc_func, all memory of context and its
+    //! nodes is allocated using these functions instead of the arena
+    //! passed to context.
+    core::CustomArena::allocate_func_t alloc_func;
+
+    //! Custom memory deallocation function.
+    core::CustomArena::deallocate_func_t dealloc_func;
+
+    //! Argument for custom memory functions.
+    void* alloc_arg;
+
     ContextConfig()
         : max_packet_size(2048)
-        , max_frame_size(4096) {
+        , max_frame_size(4096)
+        , prealloc_packets(0)
+        , prealloc_frames(0)
+        , lock_memory(false)
+        , fixed_pools(false)
+        , huge_pages(false)
+        , alloc_func(NULL)
+        , dealloc_func(NULL)
+        , alloc_arg(NULL) {
+    }
+};
+
+//! Pool usage metrics.
+struct ContextPoolMetrics {
+    //! Number of currently allocated objects.
+    size_t num_used;
+
+    //! Maximum number of objects allocated at the same time.
+    //! Can be used to choose preallocation sizes.
+    size_t max_used;
+
+    //! Number of objects that can be allocated without growing pool.
+    size_t capacity;
+
+    ContextPoolMetrics()
+        : num_used(0)
+        , max_used(0)
+        , capacity(0) {
     }
 };
 
+//! Memory usage metrics.
+struct ContextMemoryMetrics {
+    //! Number of currently allocated memory blocks.
+    size_t num_allocations;
+
+    //! Number of currently allocated bytes, including allocator overhead.
+    size_t num_bytes;
+
+    //! Maximum number of bytes allocated at the same time.
+    size_t max_bytes;
+
+    //! Number of failed allocations.
+    size_t num_failures;
+
+    ContextMemoryMetrics()
+        : num_allocations(0)
+        , num_bytes(0)
+        , max_bytes(0)
+        , num_failures(0) {
+    }
+};
+
+//! Node context metrics.
+struct ContextMetrics {
+    //! Memory usage of context and its nodes.
+    ContextMemoryMetrics memory;
+
+    //! Packet pool usage.
+    ContextPoolMetrics packet_pool;
+
+    //! Packet buffer pool usage.
+    ContextPoolMetrics packet_buffer_pool;
+
+    //! Frame buffer pool usage.
+    ContextPoolMetrics frame_buffer_pool;
+};
+
 //! Node context.
 class Context : public core::RefCounted<Context, core::ManualAllocation> {
 public:
     //! Initialize.
+    //! @remarks
+    //!  All memory is allocated from @p arena, unless custom memory functions
+    //!  are provided in @p config. Context object itself is always allocated
+    //!  by the caller.
     explicit Context(const ContextConfig& config, core::IArena& arena);
 
     //! Deinitialize.
@@ -53,6 +170,7 @@ public:
     bool is_valid();
 
     //! Get arena.
+    //! All allocations from it are counted in context metrics.
     core::IArena& arena();
 
     //! Get packet pool.
@@ -73,8 +191,22 @@ public:
     //! Get control event loop.
     ctl::ControlLoop& control_loop();
 
+    //! Get memory and pools usage metrics.
+    ContextMetrics get_metrics() const;
+
 private:
-    core::IArena& arena_;
+    core::IArena& select_arena_(const ContextConfig& config, core::IArena& arena);
+    core::IArena& select_pool_arena_(const ContextConfig& config);
+
+    size_t slab_min_bytes_(size_t object_size) const;
+    size_t slab_max_bytes_(size_t object_size) const;
+
+    core::Optional<core::CustomArena> custom_arena_;
+    core::CountingArena arena_;
+
+    core::Optional<core::HugePageArena> huge_page_arena_;
+    core::Optional<core::CountingArena> huge_page_counter_;
+    core::IArena& pool_arena_;
 
     core::SlabPool<packet::Packet> packet_pool_;
     core::SlabPool<core::Buffer> packet_buffer_pool_;
@@ -84,6 +216,8 @@ private:
 
     netio::NetworkLoop network_loop_;
     ctl::ControlLoop control_loop_;
+
+    bool pools_ok_;
 };
 
 } // namespace node
@@ -297,15 +297,22 @@ bool Receiver::get_metrics(slot_index_t slot_index,
         }
     }
 
-    pipeline::ReceiverLoop::Tasks::QuerySlot task(
-        slot->handle, slot_metrics_,
-        party_metrics_.size() != 0 ? party_metrics_.data() : NULL, party_metrics_size);
-    if (!pipeline_.schedule_and_wait(task)) {
-        roc_log(LogError,
-                "receiver node:"
-                " can't get metrics of slot %lu: operation failed",
-                (unsigned long)slot_index);
-        return false;
+    pipeline::ReceiverParticipantMetrics* party_metrics =
+        party_metrics_.size() != 0 ? party_metrics_.data() : NULL;
+
+    // Read metrics published by pipeline, without waiting for it.
+    // If snapshot can't hold all participants, fall back to querying pipeline.
+    if (!pipeline_.read_slot_metrics(slot->handle, slot_metrics_, party_metrics,
+                                     party_metrics_size)) {
+        pipeline::ReceiverLoop::Tasks::QuerySlot task(slot->handle, slot_metrics_,
+                                                      party_metrics, party_metrics_size);
+        if (!pipeline_.schedule_and_wait(task)) {
+            roc_log(LogError,
+                    "receiver node:"
+                    " can't get metrics of slot %lu: operation failed",
+                    (unsigned long)slot_index);
+            return false;
+        }
     }
 
     if (slot_metrics_arg) {
@@ -133,14 +133,9 @@ bool ReceiverDecoder::get_metrics(slot_metrics_func_t slot_metrics_func,
     pipeline::ReceiverParticipantMetrics party_metrics;
     size_t party_metrics_size = 1;
 
-    pipeline::ReceiverLoop::Tasks::QuerySlot task(slot_, slot_metrics, &party_metrics,
-                                                  &party_metrics_size);
-    if (!pipeline_.schedule_and_wait(task)) {
-        roc_log(LogError,
-                "receiver decoder node:"
-                " can't get metrics: operation failed");
-        return false;
-    }
+    // Read metrics published by pipeline, without waiting for it.
+    // Snapshot always has room for one participant, so it can't fail.
+    pipeline_.read_slot_metrics(slot_, slot_metrics, &party_metrics, &party_metrics_size);
 
     if (slot_metrics_arg) {
         slot_metrics_func(slot_metrics, slot_metrics_arg);
@@ -173,6 +168,34 @@ status::StatusCode ReceiverDecoder::write_packet(address::Interface iface,
     return writer->write(packet);
 }
 
+status::StatusCode ReceiverDecoder::write_packets(address::Interface iface,
+                                                  const packet::PacketPtr* packets,
+                                                  size_t n_packets,
+                                                  status::StatusCode* codes) {
+    roc_panic_if_not(is_valid());
+
+    roc_panic_if(iface < 0);
+    roc_panic_if(iface >= (int)address::Iface_Max);
+
+    roc_panic_if(!packets && n_packets != 0);
+    roc_panic_if(!codes && n_packets != 0);
+
+    packet::IWriter* writer = endpoint_writers_[iface];
+    if (!writer) {
+        roc_log(LogError,
+                "receiver decoder node:"
+                " can't write to %s interface: interface not activated",
+                address::interface_to_str(iface));
+        for (size_t n = 0; n < n_packets; n++) {
+            // TODO(gh-183): return StatusNotFound
+            codes[n] = status::StatusUnknown;
+        }
+        return status::StatusUnknown;
+    }
+
+    return writer->write_many(packets, n_packets, codes);
+}
+
 status::StatusCode ReceiverDecoder::read_packet(address::Interface iface,
                                                 packet::PacketPtr& packet) {
     roc_panic_if_not(is_valid());
@@ -66,6 +66,17 @@ public:
     ROC_ATTR_NODISCARD status::StatusCode write_packet(address::Interface iface,
                                                        const packet::PacketPtr& packet);
 
+    //! Write batch of packets for decoding.
+    //! @remarks
+    //!  Resolves interface writer once and passes the whole batch to its
+    //!  write_many(), so that pipeline is signaled once per batch.
+    //!  Status of each packet is stored into corresponding element of @p codes.
+    //!  Returns StatusOK if all packets were written, or the first failure.
+    ROC_ATTR_NODISCARD status::StatusCode write_packets(address::Interface iface,
+                                                        const packet::PacketPtr* packets,
+                                                        size_t n_packets,
+                                                        status::StatusCode* codes);
+
     //! Read encoded packet.
     //! @note
     //!  Typically used to generate control packets with feedback for sender.
@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_node/relay.h"
+#include "roc_address/endpoint_uri_to_str.h"
+#include "roc_address/socket_addr_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace node {
+
+Relay::Relay(Context& context, const pipeline::RelayConfig& pipeline_config)
+    : Node(context)
+    , pipeline_(pipeline_config,
+                context.encoding_map(),
+                context.packet_pool(),
+                context.packet_buffer_pool(),
+                context.arena())
+    , slot_pool_("slot_pool", context.arena())
+    , slot_map_(context.arena())
+    , stop_(0)
+    , valid_(false) {
+    roc_log(LogDebug, "relay node: initializing");
+
+    if (!pipeline_.is_valid()) {
+        return;
+    }
+
+    if (!start()) {
+        roc_log(LogError, "relay node: can't start relay thread");
+        return;
+    }
+
+    valid_ = true;
+}
+
+Relay::~Relay() {
+    roc_log(LogDebug, "relay node: deinitializing");
+
+    // First stop thread, so that pipeline is not refreshed anymore.
+    if (is_joinable()) {
+        stop_ = 1;
+        pipeline_.interrupt_wait();
+        join();
+    }
+
+    // Then remove all slots and input ports.
+    while (core::SharedPtr<Slot> slot = slot_map_.front()) {
+        cleanup_slot_(*slot);
+        slot_map_.remove(*slot);
+    }
+
+    for (size_t p = 0; p < address::Iface_Max; p++) {
+        remove_port_(input_ports_[p]);
+    }
+}
+
+bool Relay::is_valid() const {
+    return valid_;
+}
+
+bool Relay::bind(address::Interface iface, address::EndpointUri& uri) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    roc_panic_if(iface < 0);
+    roc_panic_if(iface >= (int)address::Iface_Max);
+
+    roc_log(LogInfo, "relay node: binding %s interface to %s",
+            address::interface_to_str(iface), address::endpoint_uri_to_str(uri).c_str());
+
+    if (!uri.verify(address::EndpointUri::Subset_Full)) {
+        roc_log(LogError, "relay node: can't bind %s interface: invalid uri",
+                address::interface_to_str(iface));
+        return false;
+    }
+
+    Port& port = input_ports_[iface];
+
+    if (port.handle) {
+        roc_log(LogError,
+                "relay node: can't bind %s interface: interface is already bound",
+                address::interface_to_str(iface));
+        return false;
+    }
+
+    netio::NetworkLoop::Tasks::ResolveEndpointAddress resolve_task(uri);
+    if (!context().network_loop().schedule_and_wait(resolve_task)) {
+        roc_log(LogError,
+                "relay node: can't bind %s interface: can't resolve endpoint address",
+                address::interface_to_str(iface));
+        return false;
+    }
+
+    port.config.bind_address = resolve_task.get_address();
+
+    netio::NetworkLoop::Tasks::AddUdpPort port_task(port.config);
+    if (!context().network_loop().schedule_and_wait(port_task)) {
+        roc_log(LogError,
+                "relay node: can't bind %s interface: can't bind interface to local port",
+                address::interface_to_str(iface));
+        return false;
+    }
+
+    port.handle = port_task.get_handle();
+
+    packet::IWriter* outbound_writer = NULL;
+
+    if (iface == address::Iface_AudioControl) {
+        netio::NetworkLoop::Tasks::StartUdpSend send_task(port.handle);
+        if (!context().network_loop().schedule_and_wait(send_task)) {
+            roc_log(LogError,
+                    "relay node: can't bind %s interface:"
+                    " can't start sending on local port",
+                    address::interface_to_str(iface));
+            remove_port_(port);
+            return false;
+        }
+
+        outbound_writer = &send_task.get_outbound_writer();
+    }
+
+    pipeline::RelayEndpoint* endpoint = NULL;
+
+    {
+        core::Mutex::Lock pipeline_lock(pipeline_mutex_);
+
+        endpoint = pipeline_.add_input_endpoint(iface, uri.proto(),
+                                                port.config.bind_address, outbound_writer);
+    }
+
+    if (!endpoint) {
+        roc_log(LogError,
+                "relay node: can't bind %s interface: can't add endpoint to pipeline",
+                address::interface_to_str(iface));
+        remove_port_(port);
+        return false;
+    }
+
+    netio::NetworkLoop::Tasks::StartUdpRecv recv_task(port.handle,
+                                                      endpoint->inbound_writer());
+    if (!context().network_loop().schedule_and_wait(recv_task)) {
+        roc_log(LogError,
+                "relay node: can't bind %s interface:"
+                " can't start receiving on local port",
+                address::interface_to_str(iface));
+        return false;
+    }
+
+    if (uri.port() == 0) {
+        // Report back the port number we've selected.
+        if (!uri.set_port(port.config.bind_address.port())) {
+            roc_panic("relay node: can't set endpoint port");
+        }
+    }
+
+    return true;
+}
+
+bool Relay::connect(slot_index_t slot_index,
+                    address::Interface iface,
+                    const address::EndpointUri& uri) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    roc_panic_if(iface < 0);
+    roc_panic_if(iface >= (int)address::Iface_Max);
+
+    roc_log(LogInfo, "relay node: connecting %s interface of slot %lu to %s",
+            address::interface_to_str(iface), (unsigned long)slot_index,
+            address::endpoint_uri_to_str(uri).c_str());
+
+    if (!uri.verify(address::EndpointUri::Subset_Full)) {
+        roc_log(LogError,
+                "relay node: can't connect %s interface of slot %lu: invalid uri",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+        return false;
+    }
+
+    core::SharedPtr<Slot> slot = get_slot_(slot_index, true);
+    if (!slot) {
+        roc_log(LogError,
+                "relay node:"
+                " can't connect %s interface of slot %lu:"
+                " can't create slot",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+        return false;
+    }
+
+    Port& port = slot->ports[iface];
+
+    if (port.handle) {
+        roc_log(LogError,
+                "relay node:"
+                " can't connect %s interface of slot %lu:"
+                " interface is already connected",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+        return false;
+    }
+
+    netio::NetworkLoop::Tasks::ResolveEndpointAddress resolve_task(uri);
+    if (!context().network_loop().schedule_and_wait(resolve_task)) {
+        roc_log(LogError,
+                "relay node:"
+                " can't connect %s interface of slot %lu:"
+                " can't resolve endpoint address",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+        return false;
+    }
+
+    const address::SocketAddr& address = resolve_task.get_address();
+
+    if (!port.config.bind_address.set_host_port(
+            address.family(), address.family() == address::Family_IPv4 ? "0.0.0.0" : "::",
+            0)) {
+        roc_panic("relay node: can't set %s interface address",
+                  address::interface_to_str(iface));
+    }
+
+    netio::NetworkLoop::Tasks::AddUdpPort port_task(port.config);
+    if (!context().network_loop().schedule_and_wait(port_task)) {
+        roc_log(LogError,
+                "relay node:"
+                " can't connect %s interface of slot %lu:"
+                " can't bind to local port",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+        return false;
+    }
+
+    port.handle = port_task.get_handle();
+
+    netio::NetworkLoop::Tasks::StartUdpSend send_task(port.handle);
+    if (!context().network_loop().schedule_and_wait(send_task)) {
+        roc_log(LogError,
+                "relay node:"
+                " can't connect %s interface of slot %lu:"
+                " can't start sending on local port",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+        remove_port_(port);
+        return false;
+    }
+
+    pipeline::RelayEndpoint* endpoint = NULL;
+
+    {
+        core::Mutex::Lock pipeline_lock(pipeline_mutex_);
+
+        endpoint = pipeline_.add_output_endpoint(slot->output, iface, uri.proto(),
+                                                 address, send_task.get_outbound_writer());
+    }
+
+    if (!endpoint) {
+        roc_log(LogError,
+                "relay node:"
+                " can't connect %s interface of slot %lu:"
+                " can't add endpoint to pipeline",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+        remove_port_(port);
+        return false;
+    }
+
+    if (iface == address::Iface_AudioControl) {
+        netio::NetworkLoop::Tasks::StartUdpRecv recv_task(port.handle,
+                                                          endpoint->inbound_writer());
+        if (!context().network_loop().schedule_and_wait(recv_task)) {
+            roc_log(LogError,
+                    "relay node:"
+                    " can't connect %s interface of slot %lu:"
+                    " can't start receiving on local port",
+                    address::interface_to_str(iface), (unsigned long)slot_index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Relay::unlink(slot_index_t slot_index) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    roc_log(LogDebug, "relay node: unlinking slot %lu", (unsigned long)slot_index);
+
+    core::SharedPtr<Slot> slot = get_slot_(slot_index, false);
+    if (!slot) {
+        roc_log(LogError, "relay node: can't unlink slot %lu: can't find slot",
+                (unsigned long)slot_index);
+        return false;
+    }
+
+    cleanup_slot_(*slot);
+    slot_map_.remove(*slot);
+
+    return true;
+}
+
+size_t Relay::num_slots() {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if_not(is_valid());
+
+    return slot_map_.size();
+}
+
+void Relay::run() {
+    roc_log(LogDebug, "relay node: starting relay thread");
+
+    while (!stop_) {
+        const core::nanoseconds_t current_time = core::timestamp(core::ClockUnix);
+
+        core::nanoseconds_t deadline = 0;
+
+        {
+            core::Mutex::Lock pipeline_lock(pipeline_mutex_);
+
+            deadline = pipeline_.refresh(current_time);
+        }
+
+        // Sleep until network thread delivers new packets, or until it's
+        // time to generate reports. Pipeline deadline is in unix time, and
+        // wait deadline is monotonic, so convert it.
+        core::nanoseconds_t wait_deadline = 0;
+        if (deadline != 0) {
+            wait_deadline = core::timestamp(core::ClockMonotonic)
+                + std::max(deadline - current_time, (core::nanoseconds_t)0);
+        }
+
+        // Doesn't need lock, waiting is thread-safe.
+        pipeline_.wait_packets(wait_deadline);
+    }
+
+    roc_log(LogDebug, "relay node: finishing relay thread");
+}
+
+core::SharedPtr<Relay::Slot> Relay::get_slot_(slot_index_t slot_index,
+                                              bool auto_create) {
+    core::SharedPtr<Slot> slot = slot_map_.find(slot_index);
+
+    if (!slot) {
+        if (auto_create) {
+            pipeline::RelayOutput* output = NULL;
+
+            {
+                core::Mutex::Lock pipeline_lock(pipeline_mutex_);
+
+                output = pipeline_.create_output();
+            }
+
+            if (!output) {
+                roc_log(LogError, "relay node: failed to create slot %lu",
+                        (unsigned long)slot_index);
+                return NULL;
+            }
+
+            slot = new (slot_pool_) Slot(slot_pool_, slot_index, output);
+            if (!slot || !slot_map_.insert(*slot)) {
+                roc_log(LogError, "relay node: failed to create slot %lu",
+                        (unsigned long)slot_index);
+
+                core::Mutex::Lock pipeline_lock(pipeline_mutex_);
+                pipeline_.delete_output(output);
+
+                return NULL;
+            }
+        } else {
+            roc_log(LogError, "relay node: failed to find slot %lu",
+                    (unsigned long)slot_index);
+            return NULL;
+        }
+    }
+
+    return slot;
+}
+
+void Relay::cleanup_slot_(Slot& slot) {
+    // Output writes to network ports, and network ports write to output,
+    // so keep pipeline locked while tearing down both.
+    core::Mutex::Lock pipeline_lock(pipeline_mutex_);
+
+    // First remove network ports, so that they don't write to output anymore.
+    // It's safe to wait for network loop here, because it never locks pipeline.
+    for (size_t p = 0; p < address::Iface_Max; p++) {
+        remove_port_(slot.ports[p]);
+    }
+
+    // Then remove pipeline output.
+    if (slot.output) {
+        pipeline_.delete_output(slot.output);
+        slot.output = NULL;
+    }
+}
+
+void Relay::remove_port_(Port& port) {
+    if (!port.handle) {
+        return;
+    }
+
+    netio::NetworkLoop::Tasks::RemovePort task(port.handle);
+    if (!context().network_loop().schedule_and_wait(task)) {
+        roc_panic("relay node: can't remove network port");
+    }
+
+    port.handle = NULL;
+}
+
+} // namespace node
+} // namespace roc
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_node/relay.h
+//! @brief Relay node.
+
+#ifndef ROC_NODE_RELAY_H_
+#define ROC_NODE_RELAY_H_
+
+#include "roc_address/endpoint_uri.h"
+#include "roc_address/interface.h"
+#include "roc_address/protocol.h"
+#include "roc_core/allocation_policy.h"
+#include "roc_core/atomic.h"
+#include "roc_core/hashmap.h"
+#include "roc_core/mutex.h"
+#include "roc_core/ref_counted.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_node/context.h"
+#include "roc_node/node.h"
+#include "roc_packet/iwriter.h"
+#include "roc_pipeline/packet_relay.h"
+
+namespace roc {
+namespace node {
+
+//! Relay node.
+//!
+//! Receives packets from one sender on input interfaces (bind), and forwards
+//! them to multiple receivers on output slots (connect), without decoding.
+//!
+//! Pipeline is refreshed on a dedicated thread, which sleeps until network
+//! thread delivers packets, or until it's time to generate RTCP reports.
+class Relay : public Node, private core::Thread {
+public:
+    //! Slot index.
+    typedef uint64_t slot_index_t;
+
+    //! Initialize.
+    Relay(Context& context, const pipeline::RelayConfig& pipeline_config);
+
+    //! Deinitialize.
+    ~Relay();
+
+    //! Check if successfully constructed.
+    bool is_valid() const;
+
+    //! Bind input interface to local endpoint.
+    ROC_ATTR_NODISCARD bool bind(address::Interface iface, address::EndpointUri& uri);
+
+    //! Connect output slot to remote endpoint.
+    //! @remarks
+    //!  Source and repair interfaces of output should use the same protocols
+    //!  as corresponding input interfaces, so they should be bound first.
+    ROC_ATTR_NODISCARD bool connect(slot_index_t slot_index,
+                                    address::Interface iface,
+                                    const address::EndpointUri& uri);
+
+    //! Remove output slot.
+    ROC_ATTR_NODISCARD bool unlink(slot_index_t slot_index);
+
+    //! Get number of output slots.
+    size_t num_slots();
+
+private:
+    struct Port {
+        netio::UdpConfig config;
+        netio::NetworkLoop::PortHandle handle;
+
+        Port()
+            : handle(NULL) {
+        }
+    };
+
+    struct Slot : core::RefCounted<Slot, core::PoolAllocation>, core::HashmapNode<> {
+        const slot_index_t index;
+        pipeline::RelayOutput* output;
+        Port ports[address::Iface_Max];
+
+        Slot(core::IPool& pool, slot_index_t index, pipeline::RelayOutput* output)
+            : core::RefCounted<Slot, core::PoolAllocation>(pool)
+            , index(index)
+            , output(output) {
+        }
+
+        slot_index_t key() const {
+            return index;
+        }
+
+        static core::hashsum_t key_hash(slot_index_t index) {
+            return core::hashsum_int(index);
+        }
+
+        static bool key_equal(slot_index_t index1, slot_index_t index2) {
+            return index1 == index2;
+        }
+    };
+
+    virtual void run();
+
+    core::SharedPtr<Slot> get_slot_(slot_index_t slot_index, bool auto_create);
+    void cleanup_slot_(Slot& slot);
+    void remove_port_(Port& port);
+
+    // Protects pipeline, it's accessed from both relay thread and API calls.
+    core::Mutex pipeline_mutex_;
+    pipeline::PacketRelay pipeline_;
+
+    // Protects slots and input ports.
+    core::Mutex mutex_;
+
+    Port input_ports_[address::Iface_Max];
+
+    core::SlabPool<Slot> slot_pool_;
+    core::Hashmap<Slot> slot_map_;
+
+    core::Atomic<int> stop_;
+
+    bool valid_;
+};
+
+} // namespace node
+} // namespace roc
+
+#endif // ROC_NODE_RELAY_H_
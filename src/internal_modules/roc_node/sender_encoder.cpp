@@ -134,14 +134,9 @@ bool SenderEncoder::get_metrics(slot_metrics_func_t slot_metrics_func,
     pipeline::SenderParticipantMetrics party_metrics;
     size_t party_metrics_size = 1;
 
-    pipeline::SenderLoop::Tasks::QuerySlot task(slot_, slot_metrics, &party_metrics,
-                                                &party_metrics_size);
-    if (!pipeline_.schedule_and_wait(task)) {
-        roc_log(LogError,
-                "sender encoder node:"
-                " can't get metrics: operation failed");
-        return false;
-    }
+    // Read metrics published by pipeline, without waiting for it.
+    // Snapshot always has room for one participant, so it can't fail.
+    pipeline_.read_slot_metrics(slot_, slot_metrics, &party_metrics, &party_metrics_size);
 
     if (slot_metrics_arg) {
         slot_metrics_func(slot_metrics, slot_metrics_arg);
@@ -160,10 +155,7 @@ bool SenderEncoder::is_complete() {
     roc_panic_if_not(is_valid());
 
     pipeline::SenderSlotMetrics slot_metrics;
-    pipeline::SenderLoop::Tasks::QuerySlot task(slot_, slot_metrics, NULL, NULL);
-    if (!pipeline_.schedule_and_wait(task)) {
-        return false;
-    }
+    pipeline_.read_slot_metrics(slot_, slot_metrics, NULL, NULL);
 
     return slot_metrics.is_complete;
 }
@@ -188,6 +180,30 @@ status::StatusCode SenderEncoder::read_packet(address::Interface iface,
     return reader->read(packet);
 }
 
+status::StatusCode SenderEncoder::read_packets(address::Interface iface,
+                                               packet::PacketPtr* packets,
+                                               size_t max_packets,
+                                               size_t& n_packets) {
+    roc_panic_if_not(is_valid());
+
+    roc_panic_if(iface < 0);
+    roc_panic_if(iface >= (int)address::Iface_Max);
+
+    n_packets = 0;
+
+    if (!endpoint_readers_[iface]) {
+        roc_log(LogError,
+                "sender encoder node:"
+                " can't read from %s interface: interface not activated",
+                address::interface_to_str(iface));
+        // TODO(gh-183): return StatusNotFound
+        return status::StatusNoData;
+    }
+
+    // Reader of activated interface is always its queue.
+    return endpoint_queues_[iface]->read_many(packets, max_packets, n_packets);
+}
+
 status::StatusCode SenderEncoder::write_packet(address::Interface iface,
                                                const packet::PacketPtr& packet) {
     roc_panic_if_not(is_valid());
@@ -71,6 +71,16 @@ public:
     ROC_ATTR_NODISCARD status::StatusCode read_packet(address::Interface iface,
                                                       packet::PacketPtr& packet);
 
+    //! Read batch of encoded packets.
+    //! @remarks
+    //!  Reads up to @p max_packets packets from interface queue, acquiring
+    //!  queue lock once, and sets @p n_packets to the number of packets read.
+    //!  Returns StatusNoData if there are no packets.
+    ROC_ATTR_NODISCARD status::StatusCode read_packets(address::Interface iface,
+                                                       packet::PacketPtr* packets,
+                                                       size_t max_packets,
+                                                       size_t& n_packets);
+
     //! Write packet for decoding.
     //! @note
     //!  Typically used to deliver control packets with receiver feedback.
@@ -13,7 +13,8 @@
 namespace roc {
 namespace packet {
 
-ConcurrentQueue::ConcurrentQueue(Mode mode) {
+ConcurrentQueue::ConcurrentQueue(Mode mode)
+    : reader_waiting_(0) {
     if (mode == Blocking) {
         write_sem_.reset(new (write_sem_) core::Semaphore());
     }
@@ -22,12 +23,34 @@ ConcurrentQueue::ConcurrentQueue(Mode mode) {
 status::StatusCode ConcurrentQueue::read(PacketPtr& ptr) {
     core::Mutex::Lock lock(read_mutex_);
 
-    if (write_sem_) {
-        write_sem_->wait();
+    ptr = pop_blocking_();
+    if (!ptr) {
+        return status::StatusNoData;
     }
 
-    ptr = queue_.pop_front_exclusive();
-    if (!ptr) {
+    return status::StatusOK;
+}
+
+status::StatusCode
+ConcurrentQueue::read_many(PacketPtr* packets, size_t max_packets, size_t& n_packets) {
+    roc_panic_if(!packets && max_packets != 0);
+
+    core::Mutex::Lock lock(read_mutex_);
+
+    n_packets = 0;
+
+    while (n_packets < max_packets) {
+        // In blocking mode, wait only for the first packet.
+        packets[n_packets] =
+            n_packets == 0 ? pop_blocking_() : queue_.pop_front_exclusive();
+        if (!packets[n_packets]) {
+            break;
+        }
+
+        n_packets++;
+    }
+
+    if (n_packets == 0) {
         return status::StatusNoData;
     }
 
@@ -41,12 +64,59 @@ status::StatusCode ConcurrentQueue::write(const PacketPtr& packet) {
 
     queue_.push_back(*packet);
 
-    if (write_sem_) {
-        write_sem_->post();
+    wake_reader_();
+
+    return status::StatusOK;
+}
+
+status::StatusCode ConcurrentQueue::write_many(const PacketPtr* packets,
+                                               size_t n_packets,
+                                               status::StatusCode* codes) {
+    roc_panic_if(!packets && n_packets != 0);
+    roc_panic_if(!codes && n_packets != 0);
+
+    for (size_t n = 0; n < n_packets; n++) {
+        if (!packets[n]) {
+            roc_panic("concurrent queue: packet is null");
+        }
+
+        queue_.push_back(*packets[n]);
+        codes[n] = status::StatusOK;
+    }
+
+    if (n_packets != 0) {
+        wake_reader_();
     }
 
     return status::StatusOK;
 }
 
+PacketPtr ConcurrentQueue::pop_blocking_() {
+    for (;;) {
+        PacketPtr packet = queue_.pop_front_exclusive();
+        if (packet || !write_sem_) {
+            return packet;
+        }
+
+        // Announce that we're going to sleep and re-check queue. If writer
+        // pushed packets before it could see the announcement, we'll see them
+        // here; otherwise writer will see the announcement and post semaphore.
+        reader_waiting_.exchange(1);
+
+        packet = queue_.pop_front_exclusive();
+        if (packet) {
+            return packet;
+        }
+
+        write_sem_->wait();
+    }
+}
+
+void ConcurrentQueue::wake_reader_() {
+    if (write_sem_ && reader_waiting_.exchange(0) != 0) {
+        write_sem_->post();
+    }
+}
+
 } // namespace packet
 } // namespace roc
@@ -12,6 +12,7 @@
 #ifndef ROC_PACKET_CONCURRENT_QUEUE_H_
 #define ROC_PACKET_CONCURRENT_QUEUE_H_
 
+#include "roc_core/atomic.h"
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
@@ -43,12 +44,33 @@ public:
     //! @see Mode.
     virtual ROC_ATTR_NODISCARD status::StatusCode read(PacketPtr&);
 
+    //! Read up to @p max_packets packets.
+    //! Acquires read lock once for the whole batch. In blocking mode, waits
+    //! only for the first packet and then takes what is already queued.
+    //! Sets @p n_packets to the number of packets stored into @p packets.
+    //! Returns StatusNoData if no packets were read.
+    ROC_ATTR_NODISCARD status::StatusCode
+    read_many(PacketPtr* packets, size_t max_packets, size_t& n_packets);
+
     //! Add packet to the queue.
     //! Wait-free operation.
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet);
 
+    //! Add batch of packets to the queue.
+    //! Wakes up blocked reader at most once per batch instead of once per packet.
+    //! Never fails, so all elements of @p codes are set to StatusOK.
+    virtual ROC_ATTR_NODISCARD status::StatusCode
+    write_many(const PacketPtr* packets, size_t n_packets, status::StatusCode* codes);
+
 private:
+    PacketPtr pop_blocking_();
+    void wake_reader_();
+
+    // In blocking mode, semaphore is posted only when reader announced that
+    // it's going to sleep, so the number of posts doesn't match the number
+    // of packets, and reader re-checks queue after every wakeup.
     core::Optional<core::Semaphore> write_sem_;
+    core::Atomic<int> reader_waiting_;
     core::Mutex read_mutex_;
     core::MpscQueue<Packet> queue_;
 };
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/fanout.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+Fanout::Fanout(core::IArena& arena)
+    : writers_(arena) {
+}
+
+bool Fanout::has_output(IWriter& writer) const {
+    for (size_t n = 0; n < writers_.size(); n++) {
+        if (writers_[n] == &writer) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t Fanout::num_outputs() const {
+    return writers_.size();
+}
+
+bool Fanout::add_output(IWriter& writer) {
+    roc_panic_if_msg(has_output(writer), "fanout: writer is already added");
+
+    if (!writers_.push_back(&writer)) {
+        roc_log(LogError, "fanout: can't allocate output");
+        return false;
+    }
+
+    return true;
+}
+
+void Fanout::remove_output(IWriter& writer) {
+    for (size_t n = 0; n < writers_.size(); n++) {
+        if (writers_[n] == &writer) {
+            writers_[n] = writers_.back();
+            writers_.pop_back();
+            return;
+        }
+    }
+
+    roc_panic("fanout: writer is not added");
+}
+
+status::StatusCode Fanout::write(const PacketPtr& packet) {
+    status::StatusCode code = status::StatusOK;
+
+    for (size_t n = 0; n < writers_.size(); n++) {
+        const status::StatusCode wr_code = writers_[n]->write(packet);
+        if (wr_code != status::StatusOK && code == status::StatusOK) {
+            code = wr_code;
+        }
+    }
+
+    return code;
+}
+
+} // namespace packet
+} // namespace roc
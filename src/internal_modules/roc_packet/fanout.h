@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/fanout.h
+//! @brief Duplicate packets to multiple writers.
+
+#ifndef ROC_PACKET_FANOUT_H_
+#define ROC_PACKET_FANOUT_H_
+
+#include "roc_core/array.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace packet {
+
+//! Duplicates packet stream to multiple output writers.
+//! @remarks
+//!  Same packet object is passed to every writer. If writer needs to
+//!  modify packet, it should make a copy.
+class Fanout : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    Fanout(core::IArena& arena);
+
+    //! Check if writer is already added.
+    bool has_output(IWriter& writer) const;
+
+    //! Get number of output writers.
+    size_t num_outputs() const;
+
+    //! Add output writer.
+    ROC_ATTR_NODISCARD bool add_output(IWriter& writer);
+
+    //! Remove output writer.
+    void remove_output(IWriter& writer);
+
+    //! Write packet.
+    //! @remarks
+    //!  Writes packet to every output writer.
+    //!  If some writer fails, returns its status, but still writes packet
+    //!  to remaining writers.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet);
+
+private:
+    core::Array<IWriter*, 2> writers_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_FANOUT_H_
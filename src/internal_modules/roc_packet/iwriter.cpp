@@ -7,6 +7,7 @@
  */
 
 #include "roc_packet/iwriter.h"
+#include "roc_core/panic.h"
 
 namespace roc {
 namespace packet {
@@ -14,5 +15,24 @@ namespace packet {
 IWriter::~IWriter() {
 }
 
+status::StatusCode IWriter::write_many(const PacketPtr* packets,
+                                       size_t n_packets,
+                                       status::StatusCode* codes) {
+    roc_panic_if(!packets && n_packets != 0);
+    roc_panic_if(!codes && n_packets != 0);
+
+    status::StatusCode result = status::StatusOK;
+
+    for (size_t n = 0; n < n_packets; n++) {
+        codes[n] = write(packets[n]);
+
+        if (codes[n] != status::StatusOK && result == status::StatusOK) {
+            result = codes[n];
+        }
+    }
+
+    return result;
+}
+
 } // namespace packet
 } // namespace roc
@@ -32,6 +32,21 @@ public:
     //!
     //! @see status::StatusCode.
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr&) = 0;
+
+    //! Write batch of packets.
+    //!
+    //! Packets are written in order. Failure of one packet doesn't prevent
+    //! writing the rest of them. Status of each packet is stored into
+    //! corresponding element of @p codes.
+    //!
+    //! Default implementation invokes write() for every packet. Writers that
+    //! can amortize per-packet overhead, e.g. signaling, override it.
+    //!
+    //! @returns
+    //!  status::StatusOK if all packets were written, or code of first failed
+    //!  packet otherwise.
+    virtual ROC_ATTR_NODISCARD status::StatusCode
+    write_many(const PacketPtr* packets, size_t n_packets, status::StatusCode* codes);
 };
 
 } // namespace packet
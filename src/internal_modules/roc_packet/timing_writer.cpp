@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/timing_writer.h"
+
+namespace roc {
+namespace packet {
+
+TimingWriter::TimingWriter(IWriter& writer, core::NestedTimer& timer)
+    : writer_(writer)
+    , timer_(timer) {
+}
+
+status::StatusCode TimingWriter::write(const PacketPtr& packet) {
+    core::NestedTimer::Scope scope;
+    timer_.begin(scope);
+
+    const status::StatusCode code = writer_.write(packet);
+
+    histogram_.add(timer_.end(scope));
+
+    return code;
+}
+
+const core::DurationHistogram& TimingWriter::histogram() const {
+    return histogram_;
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/timing_writer.h
+//! @brief Timing writer.
+
+#ifndef ROC_PACKET_TIMING_WRITER_H_
+#define ROC_PACKET_TIMING_WRITER_H_
+
+#include "roc_core/duration_histogram.h"
+#include "roc_core/nested_timer.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/iwriter.h"
+
+namespace roc {
+namespace packet {
+
+//! Timing writer.
+//! @remarks
+//!  Measures time spent in wrapped writer and accumulates it into
+//!  histogram. Time of other scopes nested into it and measured by the
+//!  same timer is excluded, see core::NestedTimer.
+class TimingWriter : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p writer is wrapped; TimingWriter writes packets to it
+    //!  - @p timer is used to measure exclusive time
+    TimingWriter(IWriter& writer, core::NestedTimer& timer);
+
+    //! Write packet.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet);
+
+    //! Get accumulated histogram.
+    const core::DurationHistogram& histogram() const;
+
+private:
+    IWriter& writer_;
+    core::NestedTimer& timer_;
+    core::DurationHistogram histogram_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_TIMING_WRITER_H_
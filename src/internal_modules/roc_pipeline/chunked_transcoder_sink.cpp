@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/chunked_transcoder_sink.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_pipeline/transcoder_sink.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+size_t gcd(size_t a, size_t b) {
+    while (b != 0) {
+        const size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool append_samples(core::Array<audio::sample_t>& array,
+                    const audio::sample_t* samples,
+                    size_t n_samples) {
+    const size_t pos = array.size();
+
+    if (!array.grow_exp(pos + n_samples) || !array.resize(pos + n_samples)) {
+        return false;
+    }
+
+    memcpy(array.data() + pos, samples, n_samples * sizeof(audio::sample_t));
+
+    return true;
+}
+
+} // namespace
+
+ChunkedTranscoderSink::ChunkedTranscoderSink(
+    const TranscoderConfig& config,
+    const ChunkedTranscoderConfig& chunked_config,
+    audio::IFrameWriter* output_writer,
+    core::IPool& buffer_pool,
+    core::IArena& arena)
+    : config_(config)
+    , output_writer_(output_writer)
+    , buffer_pool_(buffer_pool)
+    , arena_(arena)
+    , num_threads_(chunked_config.num_threads)
+    , in_frame_size_(0)
+    , out_frame_size_(0)
+    , chunk_len_(0)
+    , overlap_len_(0)
+    , rate_num_(1)
+    , rate_den_(1)
+    , in_samples_(arena)
+    , history_len_(0)
+    , failed_(false)
+    , valid_(false) {
+    config_.deduce_defaults();
+
+    if (num_threads_ == 0 || num_threads_ > MaxThreads) {
+        roc_log(LogError,
+                "chunked transcoder: invalid number of threads:"
+                " expected [1; %d], got %lu",
+                (int)MaxThreads, (unsigned long)num_threads_);
+        return;
+    }
+
+    const audio::SampleSpec& in_spec = config_.input_sample_spec;
+    const audio::SampleSpec& out_spec = config_.output_sample_spec;
+
+    const size_t rate_gcd = gcd(in_spec.sample_rate(), out_spec.sample_rate());
+
+    rate_num_ = out_spec.sample_rate() / rate_gcd;
+    rate_den_ = in_spec.sample_rate() / rate_gcd;
+
+    // Align lengths so that they correspond to integer number of output samples.
+    chunk_len_ = align_up(in_spec.ns_2_samples_per_chan(chunked_config.chunk_length),
+                          rate_den_);
+
+    if (in_spec.sample_rate() != out_spec.sample_rate()) {
+        overlap_len_ = align_up(
+            in_spec.ns_2_samples_per_chan(chunked_config.chunk_overlap), rate_den_);
+    }
+
+    if (chunk_len_ == 0 || chunk_len_ < overlap_len_) {
+        roc_log(LogError,
+                "chunked transcoder: chunk length should be non-zero and"
+                " not less than overlap: chunk_len=%lu overlap_len=%lu",
+                (unsigned long)chunk_len_, (unsigned long)overlap_len_);
+        return;
+    }
+
+    in_frame_size_ = in_spec.ns_2_samples_per_chan(chunked_config.frame_length)
+        * in_spec.num_channels();
+    out_frame_size_ = out_spec.ns_2_samples_per_chan(chunked_config.frame_length)
+        * out_spec.num_channels();
+
+    if (in_frame_size_ == 0 || out_frame_size_ == 0) {
+        roc_log(LogError, "chunked transcoder: frame size cannot be 0");
+        return;
+    }
+
+    {
+        // Check that transcoder can be constructed with given config.
+        TranscoderSink transcoder(config_, NULL, buffer_pool_, arena_);
+        if (!transcoder.is_valid()) {
+            return;
+        }
+    }
+
+    roc_log(LogDebug,
+            "chunked transcoder: initializing:"
+            " n_threads=%lu chunk_len=%lu overlap_len=%lu rate_ratio=%lu/%lu",
+            (unsigned long)num_threads_, (unsigned long)chunk_len_,
+            (unsigned long)overlap_len_, (unsigned long)rate_num_,
+            (unsigned long)rate_den_);
+
+    valid_ = true;
+}
+
+bool ChunkedTranscoderSink::is_valid() {
+    return valid_;
+}
+
+bool ChunkedTranscoderSink::flush() {
+    roc_panic_if(!is_valid());
+
+    const size_t in_chans = config_.input_sample_spec.num_channels();
+
+    while (!failed_ && in_samples_.size() / in_chans > history_len_) {
+        if (!process_(true)) {
+            failed_ = true;
+        }
+    }
+
+    in_samples_.clear();
+    history_len_ = 0;
+
+    return !failed_;
+}
+
+sndio::ISink* ChunkedTranscoderSink::to_sink() {
+    return this;
+}
+
+sndio::ISource* ChunkedTranscoderSink::to_source() {
+    return NULL;
+}
+
+sndio::DeviceType ChunkedTranscoderSink::type() const {
+    return sndio::DeviceType_Sink;
+}
+
+sndio::DeviceState ChunkedTranscoderSink::state() const {
+    return sndio::DeviceState_Active;
+}
+
+void ChunkedTranscoderSink::pause() {
+    // no-op
+}
+
+bool ChunkedTranscoderSink::resume() {
+    return true;
+}
+
+bool ChunkedTranscoderSink::restart() {
+    return true;
+}
+
+audio::SampleSpec ChunkedTranscoderSink::sample_spec() const {
+    return config_.output_sample_spec;
+}
+
+core::nanoseconds_t ChunkedTranscoderSink::latency() const {
+    return 0;
+}
+
+bool ChunkedTranscoderSink::has_latency() const {
+    return false;
+}
+
+bool ChunkedTranscoderSink::has_clock() const {
+    return false;
+}
+
+void ChunkedTranscoderSink::write(audio::Frame& frame) {
+    roc_panic_if(!is_valid());
+
+    const size_t in_chans = config_.input_sample_spec.num_channels();
+
+    if (frame.num_raw_samples() % in_chans != 0) {
+        roc_panic("chunked transcoder: unexpected frame size");
+    }
+
+    if (failed_) {
+        return;
+    }
+
+    if (!append_samples(in_samples_, frame.raw_samples(), frame.num_raw_samples())) {
+        roc_log(LogError, "chunked transcoder: can't allocate input buffer");
+        failed_ = true;
+        return;
+    }
+
+    // Wait until there is a full chunk for every thread, plus overlap
+    // after the last chunk.
+    const size_t pending_len = in_samples_.size() / in_chans - history_len_;
+
+    if (pending_len >= num_threads_ * chunk_len_ + overlap_len_) {
+        if (!process_(false)) {
+            failed_ = true;
+        }
+    }
+}
+
+bool ChunkedTranscoderSink::process_(bool last) {
+    const size_t in_chans = config_.input_sample_spec.num_channels();
+    const size_t out_chans = config_.output_sample_spec.num_channels();
+
+    const size_t total_len = in_samples_.size() / in_chans;
+
+    size_t n_chunks = 0;
+
+    // Start chunk workers.
+    for (size_t n = 0; n < num_threads_; n++) {
+        const size_t begin = history_len_ + n * chunk_len_;
+        if (begin >= total_len) {
+            break;
+        }
+
+        size_t end = begin + chunk_len_;
+        if (end > total_len) {
+            roc_panic_if(!last);
+            end = total_len;
+        }
+
+        const size_t pre_len = ROC_MIN(overlap_len_, begin);
+        const size_t post_len = ROC_MIN(overlap_len_, total_len - end);
+
+        const size_t skip_out = pre_len * rate_num_ / rate_den_ * out_chans;
+        // If this is the last chunk of the stream, keep all its output.
+        const size_t keep_out = end == total_len && last
+            ? 0
+            : (end - begin) * rate_num_ / rate_den_ * out_chans;
+
+        audio::sample_t* window = in_samples_.data() + (begin - pre_len) * in_chans;
+        const size_t window_size = (pre_len + end - begin + post_len) * in_chans;
+
+        workers_[n].reset(new (workers_[n])
+                              Worker(*this, window, window_size, skip_out, keep_out));
+
+        if (!workers_[n]->start()) {
+            roc_log(LogError, "chunked transcoder: can't start thread");
+            workers_[n].reset();
+            break;
+        }
+
+        n_chunks++;
+    }
+
+    // Wait workers and write their output in order.
+    bool ok = n_chunks != 0;
+
+    for (size_t n = 0; n < n_chunks; n++) {
+        workers_[n]->join();
+
+        if (ok && !workers_[n]->succeeded()) {
+            roc_log(LogError, "chunked transcoder: can't transcode chunk");
+            ok = false;
+        }
+
+        if (ok) {
+            ok = write_output_(workers_[n]->out_samples(), workers_[n]->n_out_samples());
+        }
+
+        workers_[n].reset();
+    }
+
+    if (!ok) {
+        return false;
+    }
+
+    // Drop transcoded input, but keep the tail as history for next chunk.
+    const size_t consumed_len =
+        ROC_MIN(history_len_ + n_chunks * chunk_len_, total_len);
+    const size_t new_history_len = ROC_MIN(overlap_len_, consumed_len);
+    const size_t drop_len = consumed_len - new_history_len;
+
+    memmove(in_samples_.data(), in_samples_.data() + drop_len * in_chans,
+            (total_len - drop_len) * in_chans * sizeof(audio::sample_t));
+
+    if (!in_samples_.resize((total_len - drop_len) * in_chans)) {
+        roc_panic("chunked transcoder: can't shrink array");
+    }
+
+    history_len_ = new_history_len;
+
+    return true;
+}
+
+bool ChunkedTranscoderSink::write_output_(audio::sample_t* samples, size_t n_samples) {
+    if (!output_writer_) {
+        return true;
+    }
+
+    const size_t out_chans = config_.output_sample_spec.num_channels();
+
+    for (size_t pos = 0; pos < n_samples; pos += out_frame_size_) {
+        const size_t frame_size = ROC_MIN(out_frame_size_, n_samples - pos);
+
+        audio::Frame frame(samples + pos, frame_size);
+        frame.set_duration(packet::stream_timestamp_t(frame_size / out_chans));
+
+        output_writer_->write(frame);
+    }
+
+    return true;
+}
+
+ChunkedTranscoderSink::Worker::Worker(ChunkedTranscoderSink& parent,
+                                      audio::sample_t* in_samples,
+                                      size_t n_in_samples,
+                                      size_t skip_out,
+                                      size_t keep_out)
+    : parent_(parent)
+    , in_samples_(in_samples)
+    , n_in_samples_(n_in_samples)
+    , out_samples_(parent.arena_)
+    , skip_out_(skip_out)
+    , keep_out_(keep_out)
+    , out_pos_(0)
+    , succeeded_(false) {
+}
+
+bool ChunkedTranscoderSink::Worker::succeeded() const {
+    return succeeded_;
+}
+
+audio::sample_t* ChunkedTranscoderSink::Worker::out_samples() {
+    return out_samples_.data();
+}
+
+size_t ChunkedTranscoderSink::Worker::n_out_samples() const {
+    return out_samples_.size();
+}
+
+void ChunkedTranscoderSink::Worker::run() {
+    TranscoderSink transcoder(parent_.config_, this, parent_.buffer_pool_,
+                              parent_.arena_);
+    if (!transcoder.is_valid()) {
+        return;
+    }
+
+    const size_t in_chans = parent_.config_.input_sample_spec.num_channels();
+
+    for (size_t pos = 0; pos < n_in_samples_; pos += parent_.in_frame_size_) {
+        const size_t frame_size = ROC_MIN(parent_.in_frame_size_, n_in_samples_ - pos);
+
+        audio::Frame frame(in_samples_ + pos, frame_size);
+        frame.set_duration(packet::stream_timestamp_t(frame_size / in_chans));
+
+        transcoder.write(frame);
+    }
+
+    if (out_pos_ == (size_t)-1) {
+        // allocation failed
+        return;
+    }
+
+    if (keep_out_ != 0 && out_samples_.size() != keep_out_) {
+        roc_log(LogError,
+                "chunked transcoder: not enough output samples, overlap is too small:"
+                " expected=%lu actual=%lu",
+                (unsigned long)keep_out_, (unsigned long)out_samples_.size());
+        return;
+    }
+
+    succeeded_ = true;
+}
+
+void ChunkedTranscoderSink::Worker::write(audio::Frame& frame) {
+    if (out_pos_ == (size_t)-1) {
+        return;
+    }
+
+    const audio::sample_t* samples = frame.raw_samples();
+    size_t n_samples = frame.num_raw_samples();
+
+    // Skip output produced from overlap before the chunk.
+    if (out_pos_ < skip_out_) {
+        const size_t n_skip = ROC_MIN(n_samples, skip_out_ - out_pos_);
+        samples += n_skip;
+        n_samples -= n_skip;
+        out_pos_ += n_skip;
+    }
+
+    // Skip output produced from overlap after the chunk.
+    if (keep_out_ != 0) {
+        n_samples = ROC_MIN(n_samples, skip_out_ + keep_out_ - out_pos_);
+    }
+
+    if (n_samples == 0) {
+        return;
+    }
+
+    if (!append_samples(out_samples_, samples, n_samples)) {
+        roc_log(LogError, "chunked transcoder: can't allocate output buffer");
+        out_pos_ = (size_t)-1;
+        return;
+    }
+
+    out_pos_ += n_samples;
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/chunked_transcoder_sink.h
+//! @brief Chunked parallel transcoder sink pipeline.
+
+#ifndef ROC_PIPELINE_CHUNKED_TRANSCODER_SINK_H_
+#define ROC_PIPELINE_CHUNKED_TRANSCODER_SINK_H_
+
+#include "roc_audio/iframe_writer.h"
+#include "roc_audio/sample.h"
+#include "roc_core/array.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/ipool.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/thread.h"
+#include "roc_pipeline/config.h"
+#include "roc_sndio/isink.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Chunked parallel transcoder sink pipeline.
+//! @remarks
+//!  Does the same as TranscoderSink, but is intended for offline processing
+//!  when neither input nor output has clock.
+//!
+//!  Input frames are accumulated until there is one chunk per thread. Then
+//!  chunks are transcoded in parallel, each by its own TranscoderSink, and
+//!  results are written to output in order.
+//!
+//!  When resampling is needed, each chunk is transcoded together with some
+//!  input from neighbor chunks: input before the chunk primes resampler
+//!  history, and input after the chunk pushes out samples delayed by
+//!  resampler. Output produced from the overlap is discarded. Chunk and
+//!  overlap lengths are aligned so that they correspond to an integer number
+//!  of output samples, hence outputs of the chunks are stitched seamlessly.
+//!
+//!  flush() should be called after the last frame is written.
+class ChunkedTranscoderSink : public sndio::ISink, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    ChunkedTranscoderSink(const TranscoderConfig& config,
+                          const ChunkedTranscoderConfig& chunked_config,
+                          audio::IFrameWriter* output_writer,
+                          core::IPool& buffer_pool,
+                          core::IArena& arena);
+
+    //! Check if the pipeline was successfully constructed.
+    bool is_valid();
+
+    //! Transcode remaining input.
+    //! @remarks
+    //!  Should be called after the last frame was written.
+    //!  Returns false if transcoding of any chunk failed.
+    ROC_ATTR_NODISCARD bool flush();
+
+    //! Cast IDevice to ISink.
+    virtual sndio::ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual sndio::ISource* to_source();
+
+    //! Get device type.
+    virtual sndio::DeviceType type() const;
+
+    //! Get device state.
+    virtual sndio::DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the sink.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the sink.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the sink supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the sink has own clock.
+    virtual bool has_clock() const;
+
+    //! Write audio frame.
+    virtual void write(audio::Frame& frame);
+
+    //! Maximum number of threads.
+    enum { MaxThreads = 64 };
+
+private:
+    // Transcodes one chunk on its own thread.
+    class Worker : public core::Thread, public audio::IFrameWriter {
+    public:
+        // Output samples are kept starting from skip_out, at most keep_out
+        // samples, or until the end if keep_out is zero.
+        Worker(ChunkedTranscoderSink& parent,
+               audio::sample_t* in_samples,
+               size_t n_in_samples,
+               size_t skip_out,
+               size_t keep_out);
+
+        bool succeeded() const;
+
+        audio::sample_t* out_samples();
+        size_t n_out_samples() const;
+
+    private:
+        virtual void run();
+        virtual void write(audio::Frame& frame);
+
+        ChunkedTranscoderSink& parent_;
+
+        audio::sample_t* in_samples_;
+        size_t n_in_samples_;
+
+        core::Array<audio::sample_t> out_samples_;
+        size_t skip_out_;
+        size_t keep_out_;
+        size_t out_pos_;
+
+        bool succeeded_;
+    };
+
+    bool process_(bool last);
+    bool write_output_(audio::sample_t* samples, size_t n_samples);
+
+    TranscoderConfig config_;
+
+    audio::IFrameWriter* output_writer_;
+    core::IPool& buffer_pool_;
+    core::IArena& arena_;
+
+    size_t num_threads_;
+
+    size_t in_frame_size_;
+    size_t out_frame_size_;
+
+    // Sizes in samples per channel.
+    size_t chunk_len_;
+    size_t overlap_len_;
+
+    // Numerator and denominator of output to input rate ratio.
+    size_t rate_num_;
+    size_t rate_den_;
+
+    core::Array<audio::sample_t> in_samples_;
+    // Number of samples per channel at the beginning of in_samples_
+    // that were already transcoded and are kept as history.
+    size_t history_len_;
+
+    core::Optional<Worker> workers_[MaxThreads];
+
+    bool failed_;
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_CHUNKED_TRANSCODER_SINK_H_
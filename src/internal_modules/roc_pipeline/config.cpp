@@ -17,15 +17,20 @@ SenderSinkConfig::SenderSinkConfig()
     , payload_type(rtp::PayloadType_L16_Stereo)
     , packet_length(DefaultPacketLength)
     , enable_timing(false)
+    , enable_precise_timing(false)
+    , precise_timing_margin(0)
     , enable_auto_duration(false)
     , enable_auto_cts(false)
     , enable_profiling(false)
-    , enable_interleaving(false) {
+    , enable_stage_timing(false)
+    , enable_interleaving(false)
+    , enable_shared_encoding(false) {
 }
 
 void SenderSinkConfig::deduce_defaults() {
     latency.deduce_defaults(DefaultLatency, false);
     resampler.deduce_defaults(latency.tuner_backend, latency.tuner_profile);
+    fec_tuner.deduce_defaults(fec_writer);
 }
 
 SenderSlotConfig::SenderSlotConfig() {
@@ -37,8 +42,13 @@ void SenderSlotConfig::deduce_defaults() {
 ReceiverCommonConfig::ReceiverCommonConfig()
     : output_sample_spec(DefaultSampleSpec)
     , enable_timing(false)
+    , enable_precise_timing(false)
+    , precise_timing_margin(0)
     , enable_auto_reclock(false)
-    , enable_profiling(false) {
+    , enable_profiling(false)
+    , enable_stage_timing(false)
+    , session_threads(0)
+    , session_pool_size(0) {
 }
 
 void ReceiverCommonConfig::deduce_defaults() {
@@ -70,6 +80,12 @@ ReceiverSlotConfig::ReceiverSlotConfig()
 void ReceiverSlotConfig::deduce_defaults() {
 }
 
+RelayConfig::RelayConfig() {
+}
+
+void RelayConfig::deduce_defaults() {
+}
+
 TranscoderConfig::TranscoderConfig()
     : input_sample_spec(DefaultSampleSpec)
     , output_sample_spec(DefaultSampleSpec)
@@ -81,5 +97,12 @@ void TranscoderConfig::deduce_defaults() {
                               audio::LatencyTunerProfile_Default);
 }
 
+ChunkedTranscoderConfig::ChunkedTranscoderConfig()
+    : num_threads(2)
+    , chunk_length(10 * core::Second)
+    , chunk_overlap(200 * core::Millisecond)
+    , frame_length(10 * core::Millisecond) {
+}
+
 } // namespace pipeline
 } // namespace roc
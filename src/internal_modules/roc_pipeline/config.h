@@ -21,6 +21,7 @@
 #include "roc_audio/watchdog.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/time.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/codec_config.h"
 #include "roc_fec/reader.h"
 #include "roc_fec/writer.h"
@@ -74,6 +75,9 @@ struct SenderSinkConfig {
     //! FEC encoder parameters.
     fec::CodecConfig fec_encoder;
 
+    //! FEC block tuner parameters.
+    fec::BlockTunerConfig fec_tuner;
+
     //! Latency parameters.
     audio::LatencyConfig latency;
 
@@ -92,6 +96,19 @@ struct SenderSinkConfig {
     //! Constrain receiver speed using a CPU timer according to the sample rate.
     bool enable_timing;
 
+    //! Use hybrid sleep/spin pacing when timing is enabled.
+    //! @remarks
+    //!  Reduces wakeup jitter at the cost of some CPU time.
+    //!  See core::TickerConfig.
+    bool enable_precise_timing;
+
+    //! Maximum spin margin for precise timing.
+    //! @remarks
+    //!  Ticker adapts spin margin to observed oversleep, but never spins
+    //!  longer than this before each deadline. Limits CPU time spent on
+    //!  spinning. If zero, default from core::TickerConfig is used.
+    core::nanoseconds_t precise_timing_margin;
+
     //! Automatically fill duration of input frames.
     bool enable_auto_duration;
 
@@ -101,9 +118,21 @@ struct SenderSinkConfig {
     //! Profile moving average of frames being written.
     bool enable_profiling;
 
+    //! Collect histograms of time spent in individual pipeline stages.
+    //! @remarks
+    //!  When disabled, stages are not instrumented and don't have overhead.
+    bool enable_stage_timing;
+
     //! Interleave packets.
     bool enable_interleaving;
 
+    //! Share encoding between slots with identical transport settings.
+    //! @remarks
+    //!  When enabled, slots that use same protocols for source and repair
+    //!  endpoints don't encode audio themselves, but send copies of packets
+    //!  produced by the first such slot.
+    bool enable_shared_encoding;
+
     //! Initialize config.
     SenderSinkConfig();
 
@@ -137,12 +166,47 @@ struct ReceiverCommonConfig {
     //! Constrain receiver speed using a CPU timer according to the sample rate.
     bool enable_timing;
 
+    //! Use hybrid sleep/spin pacing when timing is enabled.
+    //! @remarks
+    //!  Reduces wakeup jitter at the cost of some CPU time.
+    //!  See core::TickerConfig.
+    bool enable_precise_timing;
+
+    //! Maximum spin margin for precise timing.
+    //! @remarks
+    //!  Ticker adapts spin margin to observed oversleep, but never spins
+    //!  longer than this before each deadline. Limits CPU time spent on
+    //!  spinning. If zero, default from core::TickerConfig is used.
+    core::nanoseconds_t precise_timing_margin;
+
     //! Automatically invoke reclock before returning frames with invocation time.
     bool enable_auto_reclock;
 
     //! Profile moving average of frames being written.
     bool enable_profiling;
 
+    //! Collect histograms of time spent in individual pipeline stages.
+    //! @remarks
+    //!  When disabled, stages are not instrumented and don't have overhead.
+    bool enable_stage_timing;
+
+    //! Number of additional threads for processing sessions.
+    //! @remarks
+    //!  If zero, all sessions are processed on pipeline thread.
+    //!  Otherwise, sessions are partitioned between pipeline thread and
+    //!  given number of worker threads, which produce session frames in
+    //!  parallel before mixing.
+    size_t session_threads;
+
+    //! Number of sessions prepared in advance.
+    //! @remarks
+    //!  If zero, sessions are constructed and destroyed on pipeline thread.
+    //!  Otherwise, given number of spare sessions are constructed in background
+    //!  thread, so that new sessions can be started without allocations, and
+    //!  removed sessions are destroyed in background thread.
+    //!  See ReceiverSessionPool.
+    size_t session_pool_size;
+
     //! Initialize config.
     ReceiverCommonConfig();
 
@@ -210,6 +274,21 @@ struct ReceiverSlotConfig {
     void deduce_defaults();
 };
 
+//! Parameters of packet relay.
+struct RelayConfig {
+    //! RTCP config.
+    //! @remarks
+    //!  Used both for reports sent to upstream sender and for reports
+    //!  sent to downstream receivers.
+    rtcp::Config rtcp;
+
+    //! Initialize config.
+    RelayConfig();
+
+    //! Fill unset values with defaults.
+    void deduce_defaults();
+};
+
 //! Converter parameters.
 struct TranscoderConfig {
     //! Input sample spec
@@ -234,6 +313,28 @@ struct TranscoderConfig {
     void deduce_defaults();
 };
 
+//! Chunked transcoder parameters.
+struct ChunkedTranscoderConfig {
+    //! Number of threads transcoding chunks in parallel.
+    size_t num_threads;
+
+    //! Duration of input chunk transcoded by one thread.
+    core::nanoseconds_t chunk_length;
+
+    //! Duration of input overlap with neighbor chunks.
+    //! @remarks
+    //!  Input before the chunk primes resampler history, and input after the
+    //!  chunk pushes out samples delayed by resampler. Should be greater than
+    //!  resampler latency. Not used if no resampling is needed.
+    core::nanoseconds_t chunk_overlap;
+
+    //! Duration of frames written to output.
+    core::nanoseconds_t frame_length;
+
+    //! Initialize config.
+    ChunkedTranscoderConfig();
+};
+
 } // namespace pipeline
 } // namespace roc
 
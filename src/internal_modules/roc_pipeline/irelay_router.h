@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/irelay_router.h
+//! @brief Relay packet router interface.
+
+#ifndef ROC_PIPELINE_IRELAY_ROUTER_H_
+#define ROC_PIPELINE_IRELAY_ROUTER_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/time.h"
+#include "roc_packet/packet.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Relay packet router interface.
+//! RelayEndpoint uses this interface to pass parsed inbound packets
+//! to relay input or relay output.
+class IRelayRouter {
+public:
+    virtual ~IRelayRouter();
+
+    //! Route parsed inbound packet.
+    virtual ROC_ATTR_NODISCARD status::StatusCode
+    route_packet(const packet::PacketPtr& packet, core::nanoseconds_t current_time) = 0;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_IRELAY_ROUTER_H_
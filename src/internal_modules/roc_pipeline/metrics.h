@@ -13,6 +13,7 @@
 #define ROC_PIPELINE_METRICS_H_
 
 #include "roc_audio/latency_tuner.h"
+#include "roc_core/duration_histogram.h"
 #include "roc_core/stddefs.h"
 #include "roc_packet/ilink_meter.h"
 #include "roc_packet/units.h"
@@ -43,6 +44,22 @@ struct SenderSlotMetrics {
     //! Is slot configuration complete (all endpoints bound).
     bool is_complete;
 
+    //! Time spent in resampler per frame.
+    //! Filled only if stage timing is enabled and resampler is used.
+    core::DurationMetrics resampler_timing;
+
+    //! Time spent in channel mapper per frame.
+    //! Filled only if stage timing is enabled and channel mapper is used.
+    core::DurationMetrics channel_mapper_timing;
+
+    //! Time spent in packetizer per frame, including encoding.
+    //! Filled only if stage timing is enabled.
+    core::DurationMetrics packetizer_timing;
+
+    //! Time spent in FEC writer per packet, including encoding.
+    //! Filled only if stage timing is enabled and FEC is used.
+    core::DurationMetrics fec_writer_timing;
+
     SenderSlotMetrics()
         : source_id(0)
         , num_participants(0)
@@ -58,6 +75,22 @@ struct ReceiverParticipantMetrics {
     //! Latency metrics.
     audio::LatencyMetrics latency;
 
+    //! Time spent in depacketizer per frame, including decoding.
+    //! Filled only if stage timing is enabled.
+    core::DurationMetrics depacketizer_timing;
+
+    //! Time spent in FEC reader per packet, including decoding.
+    //! Filled only if stage timing is enabled and FEC is used.
+    core::DurationMetrics fec_reader_timing;
+
+    //! Time spent in channel mapper per frame.
+    //! Filled only if stage timing is enabled and channel mapper is used.
+    core::DurationMetrics channel_mapper_timing;
+
+    //! Time spent in resampler per frame.
+    //! Filled only if stage timing is enabled and resampler is used.
+    core::DurationMetrics resampler_timing;
+
     ReceiverParticipantMetrics() {
     }
 };
@@ -70,9 +103,24 @@ struct ReceiverSlotMetrics {
     //! Number of participants (remote senders) connected to slot.
     size_t num_participants;
 
+    //! Number of packets routed to sessions using routing cache.
+    size_t num_route_cache_hits;
+
+    //! Number of packets routed to sessions without routing cache.
+    //! Hit rate is num_route_cache_hits / (num_route_cache_hits +
+    //! num_route_cache_misses).
+    size_t num_route_cache_misses;
+
+    //! Time spent in mixer per frame.
+    //! Mixer is shared by all slots of the receiver. Filled only if stage
+    //! timing is enabled.
+    core::DurationMetrics mixer_timing;
+
     ReceiverSlotMetrics()
         : source_id(0)
-        , num_participants(0) {
+        , num_participants(0)
+        , num_route_cache_hits(0)
+        , num_route_cache_misses(0) {
     }
 };
 
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/metrics_snapshot.h
+//! @brief Metrics snapshot.
+
+#ifndef ROC_PIPELINE_METRICS_SNAPSHOT_H_
+#define ROC_PIPELINE_METRICS_SNAPSHOT_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/panic.h"
+#include "roc_core/seqlock.h"
+#include "roc_core/stddefs.h"
+#include "roc_pipeline/metrics.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Metrics snapshot.
+//!
+//! Holds a copy of metrics of one slot and its participants, published
+//! by pipeline thread and readable from any thread without waiting
+//! for pipeline.
+//!
+//! Writes should be serialized (pipeline does it). Reads are lock-free
+//! and may be called concurrently with writes.
+//!
+//! Snapshot can hold metrics of up to MaxParticipants participants.
+//!
+//! Snapshot remembers whether it was read since last check, which allows
+//! pipeline to refresh expensive metrics only when someone reads them.
+template <class SlotMetrics, class PartyMetrics>
+class MetricsSnapshot : public core::NonCopyable<> {
+public:
+    enum {
+        //! Maximum number of participants stored in snapshot.
+        MaxParticipants = 16
+    };
+
+    //! Initialize with empty metrics.
+    MetricsSnapshot()
+        : data_(Data())
+        , was_read_(1) {
+    }
+
+    //! Publish metrics.
+    //! @remarks
+    //!  Copies slot metrics and first @p party_count participant metrics,
+    //!  but no more than MaxParticipants.
+    //!  Should not be called concurrently.
+    void store(const SlotMetrics& slot_metrics,
+               const PartyMetrics* party_metrics,
+               size_t party_count) {
+        roc_panic_if(party_count != 0 && !party_metrics);
+
+        if (party_count > MaxParticipants) {
+            party_count = MaxParticipants;
+        }
+
+        scratch_.slot = slot_metrics;
+        for (size_t n = 0; n < party_count; n++) {
+            scratch_.party[n] = party_metrics[n];
+        }
+        scratch_.party_count = party_count;
+
+        data_.exclusive_store(scratch_);
+    }
+
+    //! Check whether metrics were read since last call.
+    //! @remarks
+    //!  Returns true if load() was called since last call of this method
+    //!  (or since construction), and clears the flag.
+    //!  Should not be called concurrently with store().
+    bool check_and_clear_read() {
+        return was_read_.exchange(0) != 0;
+    }
+
+    //! Read last published metrics.
+    //! @remarks
+    //!  Semantics of @p party_metrics and @p party_count is the same as in
+    //!  ReceiverSlot::get_metrics() and SenderSlot::get_metrics().
+    //!  Can be called from any thread.
+    //! @returns
+    //!  false if caller requested more participants than snapshot could hold;
+    //!  in this case, only stored participants are returned.
+    bool load(SlotMetrics& slot_metrics,
+              PartyMetrics* party_metrics,
+              size_t* party_count) const {
+        Data data;
+        core::seqlock_version_t ver;
+        data_.wait_load_v(data, ver);
+
+        was_read_ = 1;
+
+        slot_metrics = data.slot;
+
+        if (!party_metrics || !party_count) {
+            if (party_count) {
+                *party_count = 0;
+            }
+            return true;
+        }
+
+        bool complete = true;
+
+        if (*party_count > data.party_count) {
+            complete = data.slot.num_participants <= data.party_count;
+            *party_count = data.party_count;
+        }
+
+        for (size_t n = 0; n < *party_count; n++) {
+            party_metrics[n] = data.party[n];
+        }
+
+        return complete;
+    }
+
+private:
+    struct Data {
+        SlotMetrics slot;
+        PartyMetrics party[MaxParticipants];
+        size_t party_count;
+
+        Data()
+            : party_count(0) {
+        }
+    };
+
+    core::Seqlock<Data> data_;
+    Data scratch_;
+
+    mutable core::Atomic<int> was_read_;
+};
+
+//! Receiver slot metrics snapshot.
+typedef MetricsSnapshot<ReceiverSlotMetrics, ReceiverParticipantMetrics>
+    ReceiverMetricsSnapshot;
+
+//! Sender slot metrics snapshot.
+typedef MetricsSnapshot<SenderSlotMetrics, SenderParticipantMetrics>
+    SenderMetricsSnapshot;
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_METRICS_SNAPSHOT_H_
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/packet_relay.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+PacketRelay::PacketRelay(const RelayConfig& config,
+                         const rtp::EncodingMap& encoding_map,
+                         core::IPool& packet_pool,
+                         core::IPool& packet_buffer_pool,
+                         core::IArena& arena)
+    : config_(config)
+    , encoding_map_(encoding_map)
+    , packet_factory_(packet_pool, packet_buffer_pool)
+    , arena_(arena)
+    , valid_(false) {
+    config_.deduce_defaults();
+
+    input_.reset(new (input_) RelayInput(config_, state_tracker_, encoding_map_,
+                                         packet_factory_, arena_));
+    if (!input_ || !input_->is_valid()) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+PacketRelay::~PacketRelay() {
+    while (core::SharedPtr<RelayOutput> output = outputs_.back()) {
+        delete_output(output.get());
+    }
+}
+
+bool PacketRelay::is_valid() const {
+    return valid_;
+}
+
+RelayEndpoint* PacketRelay::add_input_endpoint(address::Interface iface,
+                                               address::Protocol proto,
+                                               const address::SocketAddr& inbound_address,
+                                               packet::IWriter* outbound_writer) {
+    roc_panic_if(!is_valid());
+
+    return input_->add_endpoint(iface, proto, inbound_address, outbound_writer);
+}
+
+RelayOutput* PacketRelay::create_output() {
+    roc_panic_if(!is_valid());
+
+    roc_log(LogInfo, "packet relay: adding output");
+
+    core::SharedPtr<RelayOutput> output = new (arena_)
+        RelayOutput(config_, state_tracker_, encoding_map_, packet_factory_, arena_);
+
+    if (!output || !output->is_valid()) {
+        roc_log(LogError, "packet relay: can't create output");
+        return NULL;
+    }
+
+    outputs_.push_back(*output);
+
+    return output.get();
+}
+
+void PacketRelay::delete_output(RelayOutput* output) {
+    roc_panic_if(!is_valid());
+    roc_panic_if(!output);
+
+    roc_log(LogInfo, "packet relay: removing output");
+
+    input_->remove_output(output->input_writer());
+    outputs_.remove(*output);
+}
+
+RelayEndpoint* PacketRelay::add_output_endpoint(RelayOutput* output,
+                                                address::Interface iface,
+                                                address::Protocol proto,
+                                                const address::SocketAddr& outbound_address,
+                                                packet::IWriter& outbound_writer) {
+    roc_panic_if(!is_valid());
+    roc_panic_if(!output);
+
+    if (iface != address::Iface_AudioControl) {
+        // Packets are forwarded as is, so transport protocols should match.
+        address::Protocol input_proto = address::Proto_None;
+        if (!input_->get_proto(iface, input_proto)) {
+            roc_log(LogError,
+                    "packet relay: can't add %s output endpoint:"
+                    " input endpoint for this interface is not bound",
+                    address::interface_to_str(iface));
+            return NULL;
+        }
+
+        if (input_proto != proto) {
+            roc_log(LogError,
+                    "packet relay: can't add %s output endpoint:"
+                    " protocol mismatch: input=%s output=%s",
+                    address::interface_to_str(iface), address::proto_to_str(input_proto),
+                    address::proto_to_str(proto));
+            return NULL;
+        }
+    }
+
+    RelayEndpoint* endpoint =
+        output->add_endpoint(iface, proto, outbound_address, outbound_writer);
+    if (!endpoint) {
+        return NULL;
+    }
+
+    if (iface == address::Iface_AudioSource) {
+        if (!input_->add_output(output->input_writer())) {
+            roc_log(LogError, "packet relay: can't register output");
+            return NULL;
+        }
+    }
+
+    return endpoint;
+}
+
+size_t PacketRelay::num_outputs() const {
+    roc_panic_if(!is_valid());
+
+    return outputs_.size();
+}
+
+core::nanoseconds_t PacketRelay::refresh(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    core::nanoseconds_t next_deadline = input_->refresh(current_time);
+
+    for (core::SharedPtr<RelayOutput> output = outputs_.front(); output;
+         output = outputs_.nextof(*output)) {
+        const core::nanoseconds_t output_deadline = output->refresh(current_time);
+
+        if (output_deadline != 0) {
+            if (next_deadline == 0) {
+                next_deadline = output_deadline;
+            } else {
+                next_deadline = std::min(next_deadline, output_deadline);
+            }
+        }
+    }
+
+    return next_deadline;
+}
+
+void PacketRelay::wait_packets(core::nanoseconds_t deadline) {
+    state_tracker_.wait_pending_packets(deadline);
+}
+
+void PacketRelay::interrupt_wait() {
+    state_tracker_.interrupt_wait();
+}
+
+} // namespace pipeline
+} // namespace roc
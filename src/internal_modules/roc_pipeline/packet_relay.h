@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/packet_relay.h
+//! @brief Packet relay pipeline.
+
+#ifndef ROC_PIPELINE_PACKET_RELAY_H_
+#define ROC_PIPELINE_PACKET_RELAY_H_
+
+#include "roc_address/interface.h"
+#include "roc_address/protocol.h"
+#include "roc_address/socket_addr.h"
+#include "roc_core/iarena.h"
+#include "roc_core/ipool.h"
+#include "roc_core/list.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/relay_endpoint.h"
+#include "roc_pipeline/relay_input.h"
+#include "roc_pipeline/relay_output.h"
+#include "roc_pipeline/state_tracker.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Packet relay pipeline.
+//!
+//! Receives packets from one upstream sender and forwards them to multiple
+//! downstream receivers, without decoding and re-encoding audio.
+//!
+//! Contains:
+//!  - one relay input, which receives packets from sender
+//!  - one or more relay outputs, one per receiver
+//!
+//! Pipeline:
+//!  - input: packets
+//!  - output: packets
+class PacketRelay : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PacketRelay(const RelayConfig& config,
+                const rtp::EncodingMap& encoding_map,
+                core::IPool& packet_pool,
+                core::IPool& packet_buffer_pool,
+                core::IArena& arena);
+
+    ~PacketRelay();
+
+    //! Check if the pipeline was successfully constructed.
+    bool is_valid() const;
+
+    //! Add input endpoint.
+    //!  - @p inbound_address specifies address on which packets are received
+    //!  - @p outbound_writer is used to send RTCP reports to sender, required
+    //!    only for control endpoint
+    RelayEndpoint* add_input_endpoint(address::Interface iface,
+                                      address::Protocol proto,
+                                      const address::SocketAddr& inbound_address,
+                                      packet::IWriter* outbound_writer);
+
+    //! Create output.
+    RelayOutput* create_output();
+
+    //! Delete output.
+    void delete_output(RelayOutput* output);
+
+    //! Add output endpoint.
+    //! @remarks
+    //!  Protocol of output endpoint should be the same as protocol of
+    //!  input endpoint with the same interface.
+    RelayEndpoint* add_output_endpoint(RelayOutput* output,
+                                       address::Interface iface,
+                                       address::Protocol proto,
+                                       const address::SocketAddr& outbound_address,
+                                       packet::IWriter& outbound_writer);
+
+    //! Get number of outputs.
+    size_t num_outputs() const;
+
+    //! Refresh pipeline according to current time.
+    //! @remarks
+    //!  Pulls packets received by endpoints and forwards them to outputs.
+    //!  Should be invoked periodically.
+    //! @returns
+    //!  deadline (absolute time) when refresh should be invoked again
+    //!  to generate reports, or zero if there is no such deadline.
+    core::nanoseconds_t refresh(core::nanoseconds_t current_time);
+
+    //! Block until endpoints receive packets.
+    //! @remarks
+    //!  Returns when there are packets to be pulled by refresh(), when
+    //!  @p deadline expires, or when interrupt_wait() is called.
+    //!  Deadline is an absolute time in ClockMonotonic domain, or zero
+    //!  for no deadline.
+    //!  Thread-safe.
+    void wait_packets(core::nanoseconds_t deadline);
+
+    //! Wake up thread blocked in wait_packets().
+    //! @remarks
+    //!  Thread-safe.
+    void interrupt_wait();
+
+private:
+    RelayConfig config_;
+
+    const rtp::EncodingMap& encoding_map_;
+
+    packet::PacketFactory packet_factory_;
+    core::IArena& arena_;
+
+    StateTracker state_tracker_;
+
+    core::Optional<RelayInput> input_;
+    core::List<RelayOutput> outputs_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_PACKET_RELAY_H_
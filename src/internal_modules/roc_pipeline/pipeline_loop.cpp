@@ -9,6 +9,7 @@
 #include "roc_pipeline/pipeline_loop.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/tracer.h"
 
 namespace roc {
 namespace pipeline {
@@ -159,6 +160,8 @@ bool PipelineLoop::maybe_process_tasks_() {
         return false;
     }
 
+    roc_trace_scope("pipeline task slice");
+
     processing_state_ = ProcRunning;
 
     int n_pending_frames = 0;
@@ -193,6 +196,8 @@ bool PipelineLoop::maybe_process_tasks_() {
 }
 
 bool PipelineLoop::process_subframes_and_tasks(audio::Frame& frame) {
+    roc_trace_scope("pipeline frame");
+
     if (config_.enable_precise_task_scheduling) {
         return process_subframes_and_tasks_precise_(frame);
     }
@@ -331,6 +336,8 @@ void PipelineLoop::cancel_async_task_processing_() {
 }
 
 void PipelineLoop::process_task_(PipelineTask& task, bool notify) {
+    roc_trace_scope("pipeline task");
+
     IPipelineTaskCompleter* completer = task.completer_;
 
     task.success_ = process_task_imp(task);
@@ -346,6 +353,8 @@ void PipelineLoop::process_task_(PipelineTask& task, bool notify) {
 bool PipelineLoop::process_next_subframe_(audio::Frame& frame,
                                           packet::stream_timestamp_t* frame_pos,
                                           packet::stream_timestamp_t frame_duration) {
+    roc_trace_scope("pipeline subframe");
+
     const size_t subframe_duration = max_samples_between_tasks_
         ? std::min(frame_duration - *frame_pos, max_samples_between_tasks_)
         : frame_duration;
@@ -10,6 +10,7 @@
 #include "roc_address/protocol.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/tracer.h"
 #include "roc_fec/composer.h"
 #include "roc_fec/headers.h"
 #include "roc_fec/parser.h"
@@ -193,6 +194,8 @@ status::StatusCode ReceiverEndpoint::pull_packets(core::nanoseconds_t current_ti
 
     roc_panic_if(!parser_);
 
+    roc_trace_scope("receiver pull packets");
+
     // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
     // It may return NULL either if the queue is empty or if the packets in the
     // queue were added in a very short time or are being added currently. It's
@@ -220,11 +223,42 @@ status::StatusCode ReceiverEndpoint::write(const packet::PacketPtr& packet) {
     roc_panic_if(!packet);
     roc_panic_if(!parser_);
 
+    roc_trace_instant("packet arrival");
+
     state_tracker_.add_pending_packets(+1);
     inbound_queue_.push_back(*packet);
 
     return status::StatusOK;
 }
 
+// Implementation of inbound_writer().write_many()
+status::StatusCode ReceiverEndpoint::write_many(const packet::PacketPtr* packets,
+                                                size_t n_packets,
+                                                status::StatusCode* codes) {
+    roc_panic_if(!is_valid());
+
+    roc_panic_if(!packets && n_packets != 0);
+    roc_panic_if(!codes && n_packets != 0);
+    roc_panic_if(!parser_);
+
+    if (n_packets == 0) {
+        return status::StatusOK;
+    }
+
+    roc_trace_instant("packets arrival");
+
+    // Update counter once per batch, so that waiting pipeline is woken up once.
+    state_tracker_.add_pending_packets((int)n_packets);
+
+    for (size_t n = 0; n < n_packets; n++) {
+        roc_panic_if(!packets[n]);
+
+        inbound_queue_.push_back(*packets[n]);
+        codes[n] = status::StatusOK;
+    }
+
+    return status::StatusOK;
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -97,6 +97,8 @@ public:
 
 private:
     virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
+    virtual ROC_ATTR_NODISCARD status::StatusCode write_many(
+        const packet::PacketPtr* packets, size_t n_packets, status::StatusCode* codes);
 
     const address::Protocol proto_;
 
@@ -7,6 +7,7 @@
  */
 
 #include "roc_pipeline/receiver_loop.h"
+#include "roc_core/fast_clock.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/thread.h"
@@ -109,8 +110,18 @@ ReceiverLoop::ReceiverLoop(IPipelineTaskScheduler& scheduler,
     }
 
     if (source_config.common.enable_timing) {
+        core::TickerConfig ticker_config;
+        ticker_config.enable_spinning = source_config.common.enable_precise_timing;
+        if (source_config.common.precise_timing_margin > 0) {
+            ticker_config.max_spin_margin = source_config.common.precise_timing_margin;
+            ticker_config.spin_margin =
+                std::min(ticker_config.spin_margin, ticker_config.max_spin_margin);
+            ticker_config.min_spin_margin =
+                std::min(ticker_config.min_spin_margin, ticker_config.max_spin_margin);
+        }
+
         ticker_.reset(new (ticker_) core::Ticker(
-            source_config.common.output_sample_spec.sample_rate()));
+            source_config.common.output_sample_spec.sample_rate(), ticker_config));
         if (!ticker_) {
             return;
         }
@@ -129,6 +140,19 @@ sndio::ISource& ReceiverLoop::source() {
     return *this;
 }
 
+bool ReceiverLoop::read_slot_metrics(SlotHandle slot,
+                                     ReceiverSlotMetrics& slot_metrics,
+                                     ReceiverParticipantMetrics* party_metrics,
+                                     size_t* party_count) const {
+    roc_panic_if(!is_valid());
+
+    if (!slot) {
+        roc_panic("receiver loop: slot handle is null");
+    }
+
+    return ((ReceiverSlot*)slot)->read_metrics(slot_metrics, party_metrics, party_count);
+}
+
 sndio::ISink* ReceiverLoop::to_sink() {
     roc_panic_if(!is_valid());
 
@@ -235,7 +259,13 @@ bool ReceiverLoop::read(audio::Frame& frame) {
     }
 
     // invokes process_subframe_imp() and process_task_imp()
-    if (!process_subframes_and_tasks(frame)) {
+    const bool success = process_subframes_and_tasks(frame);
+
+    // Publish once per frame rather than per sub-frame, because collecting
+    // metrics of all sessions isn't free.
+    source_.publish_metrics();
+
+    if (!success) {
         return false;
     }
 
@@ -249,7 +279,7 @@ bool ReceiverLoop::read(audio::Frame& frame) {
 }
 
 core::nanoseconds_t ReceiverLoop::timestamp_imp() const {
-    return core::timestamp(core::ClockMonotonic);
+    return core::fast_timestamp();
 }
 
 uint64_t ReceiverLoop::tid_imp() const {
@@ -267,7 +297,13 @@ bool ReceiverLoop::process_task_imp(PipelineTask& basic_task) {
     Task& task = (Task&)basic_task;
 
     roc_panic_if_not(task.func_);
-    return (this->*(task.func_))(task);
+    const bool success = (this->*(task.func_))(task);
+
+    // Task may change slots configuration, make it visible to
+    // read_slot_metrics() without waiting for next frame.
+    source_.publish_metrics();
+
+    return success;
 }
 
 bool ReceiverLoop::task_create_slot_(Task& task) {
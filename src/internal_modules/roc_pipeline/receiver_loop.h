@@ -138,6 +138,19 @@ public:
     //!  Samples received from remote peers become available in this source.
     sndio::ISource& source();
 
+    //! Get metrics of slot without waiting for pipeline.
+    //! @remarks
+    //!  Returns metrics published by pipeline after last processed frame or
+    //!  task. Unlike QuerySlot task, can be called from any thread and never
+    //!  blocks on pipeline. The slot should not be deleted concurrently.
+    //! @returns
+    //!  false if snapshot doesn't contain all requested participants; in this
+    //!  case, QuerySlot task can be used to get full metrics.
+    bool read_slot_metrics(SlotHandle slot,
+                           ReceiverSlotMetrics& slot_metrics,
+                           ReceiverParticipantMetrics* party_metrics,
+                           size_t* party_count) const;
+
 private:
     // Methods of sndio::ISource
     virtual sndio::ISink* to_sink();
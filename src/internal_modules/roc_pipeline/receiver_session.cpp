@@ -20,6 +20,7 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
                                  const rtp::EncodingMap& encoding_map,
                                  packet::PacketFactory& packet_factory,
                                  audio::FrameFactory& frame_factory,
+                                 core::NestedTimer* stage_timer,
                                  core::IArena& arena)
     : core::RefCounted<ReceiverSession, core::ArenaAllocation>(arena)
     , frame_reader_(NULL)
@@ -30,6 +31,8 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         return;
     }
 
+    core::NestedTimer& timer = stage_timer ? *stage_timer : stage_timer_;
+
     packet_router_.reset(new (packet_router_) packet::Router(arena));
     if (!packet_router_) {
         return;
@@ -122,6 +125,12 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         }
         pkt_reader = fec_reader_.get();
 
+        if (common_config.enable_stage_timing) {
+            fec_reader_timing_.reset(new (fec_reader_timing_)
+                                         packet::TimingReader(*pkt_reader, timer));
+            pkt_reader = fec_reader_timing_.get();
+        }
+
         fec_filter_.reset(new (fec_filter_) rtp::Filter(*pkt_reader, *payload_decoder_,
                                                         common_config.rtp_filter,
                                                         pkt_encoding->sample_spec));
@@ -158,6 +167,12 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         }
         frm_reader = depacketizer_.get();
 
+        if (common_config.enable_stage_timing) {
+            depacketizer_timing_.reset(new (depacketizer_timing_)
+                                           audio::TimingReader(*frm_reader, timer));
+            frm_reader = depacketizer_timing_.get();
+        }
+
         if (session_config.watchdog.no_playback_timeout >= 0
             || session_config.watchdog.choppy_playback_timeout >= 0) {
             watchdog_.reset(new (watchdog_) audio::Watchdog(
@@ -186,6 +201,12 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
             return;
         }
         frm_reader = channel_mapper_reader_.get();
+
+        if (common_config.enable_stage_timing) {
+            channel_mapper_timing_.reset(new (channel_mapper_timing_)
+                                             audio::TimingReader(*frm_reader, timer));
+            frm_reader = channel_mapper_timing_.get();
+        }
     }
 
     if (session_config.latency.tuner_profile != audio::LatencyTunerProfile_Intact
@@ -211,6 +232,12 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
             return;
         }
         frm_reader = resampler_reader_.get();
+
+        if (common_config.enable_stage_timing) {
+            resampler_timing_.reset(new (resampler_timing_)
+                                        audio::TimingReader(*frm_reader, timer));
+            frm_reader = resampler_timing_.get();
+        }
     }
 
     latency_monitor_.reset(new (latency_monitor_) audio::LatencyMonitor(
@@ -363,6 +390,23 @@ void ReceiverSession::process_report(const rtcp::SendReport& report) {
     }
 }
 
+void ReceiverSession::update_timing_metrics() {
+    roc_panic_if(!is_valid());
+
+    if (depacketizer_timing_) {
+        depacketizer_timing_metrics_ = depacketizer_timing_->histogram().metrics();
+    }
+    if (fec_reader_timing_) {
+        fec_reader_timing_metrics_ = fec_reader_timing_->histogram().metrics();
+    }
+    if (channel_mapper_timing_) {
+        channel_mapper_timing_metrics_ = channel_mapper_timing_->histogram().metrics();
+    }
+    if (resampler_timing_) {
+        resampler_timing_metrics_ = resampler_timing_->histogram().metrics();
+    }
+}
+
 ReceiverParticipantMetrics ReceiverSession::get_metrics() const {
     roc_panic_if(!is_valid());
 
@@ -370,6 +414,11 @@ ReceiverParticipantMetrics ReceiverSession::get_metrics() const {
     metrics.link = source_meter_->metrics();
     metrics.latency = latency_monitor_->metrics();
 
+    metrics.depacketizer_timing = depacketizer_timing_metrics_;
+    metrics.fec_reader_timing = fec_reader_timing_metrics_;
+    metrics.channel_mapper_timing = channel_mapper_timing_metrics_;
+    metrics.resampler_timing = resampler_timing_metrics_;
+
     return metrics;
 }
 
@@ -21,9 +21,11 @@
 #include "roc_audio/iresampler.h"
 #include "roc_audio/latency_monitor.h"
 #include "roc_audio/resampler_reader.h"
+#include "roc_audio/timing_reader.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/iarena.h"
 #include "roc_core/list_node.h"
+#include "roc_core/nested_timer.h"
 #include "roc_core/optional.h"
 #include "roc_core/ref_counted.h"
 #include "roc_core/scoped_ptr.h"
@@ -37,6 +39,7 @@
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/router.h"
 #include "roc_packet/sorted_queue.h"
+#include "roc_packet/timing_reader.h"
 #include "roc_packet/units.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/metrics.h"
@@ -59,11 +62,17 @@ class ReceiverSession : public core::RefCounted<ReceiverSession, core::ArenaAllo
                         public core::ListNode<> {
 public:
     //! Initialize.
+    //! @remarks
+    //!  If stage timing is enabled, @p stage_timer is used to measure stages.
+    //!  It should be shared with the caller of frame_reader() if it's called
+    //!  on the same thread, so that caller's time excludes session stages.
+    //!  If it's NULL, session uses its own timer.
     ReceiverSession(const ReceiverSessionConfig& session_config,
                     const ReceiverCommonConfig& common_config,
                     const rtp::EncodingMap& encoding_map,
                     packet::PacketFactory& packet_factory,
                     audio::FrameFactory& frame_factory,
+                    core::NestedTimer* stage_timer,
                     core::IArena& arena);
 
     //! Check if the session was succefully constructed.
@@ -112,7 +121,15 @@ public:
     //! Process RTCP report obtained from sender.
     void process_report(const rtcp::SendReport& report);
 
+    //! Recompute stage timing metrics.
+    //! @remarks
+    //!  Stage timing metrics returned by get_metrics() are computed from
+    //!  histograms only by this method, because it's relatively expensive.
+    void update_timing_metrics();
+
     //! Get session metrics.
+    //! @remarks
+    //!  Stage timing metrics are from last update_timing_metrics() call.
     ReceiverParticipantMetrics get_metrics() const;
 
 private:
@@ -148,6 +165,17 @@ private:
 
     core::Optional<audio::LatencyMonitor> latency_monitor_;
 
+    core::NestedTimer stage_timer_;
+    core::Optional<packet::TimingReader> fec_reader_timing_;
+    core::Optional<audio::TimingReader> depacketizer_timing_;
+    core::Optional<audio::TimingReader> channel_mapper_timing_;
+    core::Optional<audio::TimingReader> resampler_timing_;
+
+    core::DurationMetrics fec_reader_timing_metrics_;
+    core::DurationMetrics depacketizer_timing_metrics_;
+    core::DurationMetrics channel_mapper_timing_metrics_;
+    core::DurationMetrics resampler_timing_metrics_;
+
     bool valid_;
 };
 
@@ -20,6 +20,8 @@ ReceiverSessionGroup::ReceiverSessionGroup(const ReceiverSourceConfig& source_co
                                            const ReceiverSlotConfig& slot_config,
                                            StateTracker& state_tracker,
                                            audio::Mixer& mixer,
+                                           ReceiverSessionWorkers* session_workers,
+                                           core::NestedTimer* stage_timer,
                                            const rtp::EncodingMap& encoding_map,
                                            packet::PacketFactory& packet_factory,
                                            audio::FrameFactory& frame_factory,
@@ -28,6 +30,8 @@ ReceiverSessionGroup::ReceiverSessionGroup(const ReceiverSourceConfig& source_co
     , slot_config_(slot_config)
     , state_tracker_(state_tracker)
     , mixer_(mixer)
+    , session_workers_(session_workers)
+    , stage_timer_(stage_timer)
     , encoding_map_(encoding_map)
     , arena_(arena)
     , packet_factory_(packet_factory)
@@ -39,11 +43,26 @@ ReceiverSessionGroup::ReceiverSessionGroup(const ReceiverSourceConfig& source_co
         return;
     }
 
+    if (source_config_.common.session_pool_size != 0) {
+        session_pool_.reset(new (session_pool_) ReceiverSessionPool(
+            source_config_.common.session_pool_size, source_config_.common,
+            encoding_map_, packet_factory_, frame_factory_, stage_timer_, arena_));
+        if (!session_pool_->start()) {
+            session_pool_.reset();
+            return;
+        }
+    }
+
     valid_ = true;
 }
 
 ReceiverSessionGroup::~ReceiverSessionGroup() {
     remove_all_sessions_();
+
+    if (session_pool_) {
+        session_pool_->stop();
+        session_pool_->join();
+    }
 }
 
 bool ReceiverSessionGroup::is_valid() const {
@@ -145,11 +164,22 @@ size_t ReceiverSessionGroup::num_sessions() const {
     return sessions_.size();
 }
 
+void ReceiverSessionGroup::update_timing_metrics() {
+    roc_panic_if(!is_valid());
+
+    for (core::SharedPtr<ReceiverSession> sess = sessions_.front(); sess;
+         sess = sessions_.nextof(*sess)) {
+        sess->update_timing_metrics();
+    }
+}
+
 void ReceiverSessionGroup::get_slot_metrics(ReceiverSlotMetrics& slot_metrics) const {
     roc_panic_if(!is_valid());
 
     slot_metrics.source_id = identity_->ssrc();
     slot_metrics.num_participants = sessions_.size();
+    slot_metrics.num_route_cache_hits = session_router_.num_cache_hits();
+    slot_metrics.num_route_cache_misses = session_router_.num_cache_misses();
 }
 
 void ReceiverSessionGroup::get_participant_metrics(
@@ -282,28 +312,27 @@ ReceiverSessionGroup::route_transport_packet_(const packet::PacketPtr& packet) {
     core::SharedPtr<ReceiverSession> sess;
 
     if (slot_config_.enable_routing) {
-        // Find route by packet SSRC.
-        if (packet->has_source_id()) {
-            sess = session_router_.find_by_source(packet->source_id());
-        }
-
-        if (!sess && packet->udp()) {
-            // If there is no route found, fallback to finding route by *source* address.
-            //
-            // We assume that packets sent from the same remote source address belong to
-            // the same session.
-            //
-            // This does not conform to RFC 3550 (it mandates routing only by
-            // *destination* address) and is not guaranteed to work, but it works in
-            // simple cases, assuming that sender uses single port to send all packets
-            // (which is often the case) and there are no retranslators involved (which is
-            // rarely the case).
-            //
-            // If we have functioning RTCP or RTSP, this fallback logic isn't used because
-            // we'll either find route based on SSRC, or will use separate destination
-            // addresses (and hence separate session groups) for each sender.
-            sess = session_router_.find_by_address(packet->udp()->src_addr);
-        }
+        // Find route by packet SSRC, and if there is no route found, fallback to
+        // finding route by *source* address.
+        //
+        // We assume that packets sent from the same remote source address belong to
+        // the same session.
+        //
+        // This does not conform to RFC 3550 (it mandates routing only by
+        // *destination* address) and is not guaranteed to work, but it works in
+        // simple cases, assuming that sender uses single port to send all packets
+        // (which is often the case) and there are no retranslators involved (which is
+        // rarely the case).
+        //
+        // If we have functioning RTCP or RTSP, this fallback logic isn't used because
+        // we'll either find route based on SSRC, or will use separate destination
+        // addresses (and hence separate session groups) for each sender.
+        //
+        // Router caches results, so consecutive packets from same stream are
+        // routed without hashmap lookups.
+        sess = session_router_.find_session(
+            packet->has_source_id(), packet->source_id(),
+            packet->udp() ? packet->udp()->src_addr : address::SocketAddr());
     } else {
         // If routing is disabled, we can only have zero or one session.
         roc_panic_if_not(sessions_.size() == 0 || sessions_.size() == 1);
@@ -375,9 +404,18 @@ ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
             address::socket_addr_to_str(src_address).c_str(),
             address::socket_addr_to_str(dst_address).c_str());
 
-    core::SharedPtr<ReceiverSession> sess =
-        new (arena_) ReceiverSession(sess_config, source_config_.common, encoding_map_,
-                                     packet_factory_, frame_factory_, arena_);
+    core::SharedPtr<ReceiverSession> sess;
+
+    if (session_pool_) {
+        // Take session prepared in background, if any.
+        sess = session_pool_->acquire(sess_config);
+    }
+
+    if (!sess) {
+        sess = new (arena_)
+            ReceiverSession(sess_config, source_config_.common, encoding_map_,
+                            packet_factory_, frame_factory_, stage_timer_, arena_);
+    }
 
     if (!sess || !sess->is_valid()) {
         roc_log(LogError, "session group: can't create session, initialization failed");
@@ -404,7 +442,17 @@ ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
         return status::StatusOK;
     }
 
-    mixer_.add_input(sess->frame_reader());
+    if (session_workers_) {
+        if (!session_workers_->add_session(sess)) {
+            roc_log(LogError,
+                    "session group: can't create session, can't add session to workers");
+            session_router_.remove_session(sess);
+            // TODO(gh-183): return status
+            return status::StatusOK;
+        }
+    } else {
+        mixer_.add_input(sess->frame_reader());
+    }
     sessions_.push_back(*sess);
 
     state_tracker_.add_active_sessions(+1);
@@ -415,11 +463,20 @@ ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
 void ReceiverSessionGroup::remove_session_(core::SharedPtr<ReceiverSession> sess) {
     roc_log(LogInfo, "session group: removing session");
 
-    mixer_.remove_input(sess->frame_reader());
+    if (session_workers_) {
+        session_workers_->remove_session(sess);
+    } else {
+        mixer_.remove_input(sess->frame_reader());
+    }
     sessions_.remove(*sess);
 
     session_router_.remove_session(sess);
     state_tracker_.add_active_sessions(-1);
+
+    if (session_pool_) {
+        // Destroy session in background.
+        session_pool_->release(sess);
+    }
 }
 
 void ReceiverSessionGroup::remove_all_sessions_() {
@@ -16,12 +16,15 @@
 #include "roc_audio/mixer.h"
 #include "roc_core/iarena.h"
 #include "roc_core/list.h"
+#include "roc_core/nested_timer.h"
 #include "roc_core/noncopyable.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/metrics.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session.h"
+#include "roc_pipeline/receiver_session_pool.h"
 #include "roc_pipeline/receiver_session_router.h"
+#include "roc_pipeline/receiver_session_workers.h"
 #include "roc_pipeline/state_tracker.h"
 #include "roc_rtcp/communicator.h"
 #include "roc_rtcp/composer.h"
@@ -48,10 +51,16 @@ namespace pipeline {
 class ReceiverSessionGroup : public core::NonCopyable<>, private rtcp::IParticipant {
 public:
     //! Initialize.
+    //! @remarks
+    //!  If @p session_workers is non-null, sessions are added to it instead
+    //!  of being added to @p mixer directly.
+    //!  @p stage_timer is passed to sessions, see ReceiverSession.
     ReceiverSessionGroup(const ReceiverSourceConfig& source_config,
                          const ReceiverSlotConfig& slot_config,
                          StateTracker& state_tracker,
                          audio::Mixer& mixer,
+                         ReceiverSessionWorkers* session_workers,
+                         core::NestedTimer* stage_timer,
                          const rtp::EncodingMap& encoding_map,
                          packet::PacketFactory& packet_factory,
                          audio::FrameFactory& frame_factory,
@@ -89,6 +98,11 @@ public:
     //! Get number of sessions in group.
     size_t num_sessions() const;
 
+    //! Recompute stage timing metrics of all sessions.
+    //! @remarks
+    //!  See ReceiverSession::update_timing_metrics().
+    void update_timing_metrics();
+
     //! Get slot metrics.
     //! @remarks
     //!  These metrics are for the whole slot.
@@ -138,6 +152,8 @@ private:
 
     StateTracker& state_tracker_;
     audio::Mixer& mixer_;
+    ReceiverSessionWorkers* session_workers_;
+    core::NestedTimer* stage_timer_;
 
     const rtp::EncodingMap& encoding_map_;
 
@@ -150,6 +166,8 @@ private:
     core::Optional<rtcp::Communicator> rtcp_communicator_;
     address::SocketAddr rtcp_inbound_addr_;
 
+    core::Optional<ReceiverSessionPool> session_pool_;
+
     core::List<ReceiverSession> sessions_;
     ReceiverSessionRouter session_router_;
 
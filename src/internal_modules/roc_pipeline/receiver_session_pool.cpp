@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/receiver_session_pool.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+ReceiverSessionPool::ReceiverSessionPool(size_t pool_size,
+                                         const ReceiverCommonConfig& common_config,
+                                         const rtp::EncodingMap& encoding_map,
+                                         packet::PacketFactory& packet_factory,
+                                         audio::FrameFactory& frame_factory,
+                                         core::NestedTimer* stage_timer,
+                                         core::IArena& arena)
+    : pool_size_(pool_size)
+    , common_config_(common_config)
+    , encoding_map_(encoding_map)
+    , packet_factory_(packet_factory)
+    , frame_factory_(frame_factory)
+    , stage_timer_(stage_timer)
+    , arena_(arena)
+    , has_spare_config_(false)
+    , spare_config_version_(0)
+    , failed_config_version_(0) {
+    roc_panic_if_msg(pool_size_ == 0, "session pool: pool size is zero");
+}
+
+ReceiverSessionPool::~ReceiverSessionPool() {
+    if (is_joinable()) {
+        roc_panic("session pool: attempt to call destructor"
+                  " before calling stop() and join()");
+    }
+}
+
+core::SharedPtr<ReceiverSession>
+ReceiverSessionPool::acquire(const ReceiverSessionConfig& session_config) {
+    if (!mutex_.try_lock()) {
+        return NULL;
+    }
+
+    core::SharedPtr<ReceiverSession> session;
+
+    if (has_spare_config_ && matches_(spare_config_, session_config)) {
+        session = spare_sessions_.front();
+        if (session) {
+            spare_sessions_.remove(*session);
+        }
+    } else {
+        // Configuration changed, old spares are useless.
+        while (core::SharedPtr<ReceiverSession> spare = spare_sessions_.front()) {
+            spare_sessions_.remove(*spare);
+            released_sessions_.push_back(*spare);
+        }
+
+        spare_config_ = session_config;
+        has_spare_config_ = true;
+        spare_config_version_++;
+    }
+
+    mutex_.unlock();
+
+    wake_sem_.post();
+
+    return session;
+}
+
+void ReceiverSessionPool::release(const core::SharedPtr<ReceiverSession>& session) {
+    roc_panic_if(!session);
+
+    if (!mutex_.try_lock()) {
+        return;
+    }
+
+    released_sessions_.push_back(*session);
+
+    mutex_.unlock();
+
+    wake_sem_.post();
+}
+
+size_t ReceiverSessionPool::num_spare() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return spare_sessions_.size();
+}
+
+void ReceiverSessionPool::stop() {
+    stop_ = true;
+    wake_sem_.post();
+}
+
+void ReceiverSessionPool::run() {
+    roc_log(LogDebug, "session pool: running background thread: pool_size=%lu",
+            (unsigned long)pool_size_);
+
+    while (!stop_) {
+        // Destroy released sessions first, to free memory for new ones.
+        if (process_released_()) {
+            continue;
+        }
+
+        if (process_spare_()) {
+            continue;
+        }
+
+        wake_sem_.wait();
+    }
+
+    roc_log(LogDebug, "session pool: exiting background thread");
+}
+
+bool ReceiverSessionPool::process_released_() {
+    core::SharedPtr<ReceiverSession> session;
+
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        session = released_sessions_.front();
+        if (session) {
+            released_sessions_.remove(*session);
+        }
+    }
+
+    // If this is the last reference, session is destroyed here.
+    return session != NULL;
+}
+
+bool ReceiverSessionPool::process_spare_() {
+    ReceiverSessionConfig session_config;
+    uint64_t config_version = 0;
+
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        if (!has_spare_config_ || spare_sessions_.size() >= pool_size_
+            || failed_config_version_ == spare_config_version_) {
+            return false;
+        }
+
+        session_config = spare_config_;
+        config_version = spare_config_version_;
+    }
+
+    core::SharedPtr<ReceiverSession> session =
+        new (arena_) ReceiverSession(session_config, common_config_, encoding_map_,
+                                     packet_factory_, frame_factory_, stage_timer_,
+                                     arena_);
+
+    core::Mutex::Lock lock(mutex_);
+
+    if (!session || !session->is_valid()) {
+        roc_log(LogError, "session pool: can't prepare spare session");
+        // Don't retry until configuration changes.
+        failed_config_version_ = config_version;
+        return false;
+    }
+
+    if (config_version != spare_config_version_) {
+        // Configuration changed while we were constructing session.
+        released_sessions_.push_back(*session);
+        return true;
+    }
+
+    spare_sessions_.push_back(*session);
+    return true;
+}
+
+bool ReceiverSessionPool::matches_(const ReceiverSessionConfig& a,
+                                   const ReceiverSessionConfig& b) {
+    return a.payload_type == b.payload_type
+        && a.fec_decoder.scheme == b.fec_decoder.scheme;
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/receiver_session_pool.h
+//! @brief Pool of receiver sessions.
+
+#ifndef ROC_PIPELINE_RECEIVER_SESSION_POOL_H_
+#define ROC_PIPELINE_RECEIVER_SESSION_POOL_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_core/atomic.h"
+#include "roc_core/iarena.h"
+#include "roc_core/list.h"
+#include "roc_core/mutex.h"
+#include "roc_core/nested_timer.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/thread.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/receiver_session.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Pool of receiver sessions.
+//!
+//! Moves construction and destruction of receiver sessions off the pipeline
+//! thread, so that mass reconnects don't stall audio of other sessions.
+//!
+//! Pool has a background thread that keeps a number of spare sessions,
+//! constructed in advance with the configuration of the last requested
+//! session. When a new session is needed, a spare one with matching
+//! configuration is taken from the pool, which doesn't involve allocations.
+//! Removed sessions are passed back to the pool and destroyed on background
+//! thread, and taken spares are replaced with new ones.
+//!
+//! Removed sessions are not reused, because their components keep stream
+//! state (queues, meters, timelines, resampler state); constructing a fresh
+//! session in background is as cheap for the pipeline thread as resetting
+//! an old one, and doesn't require every component to support reset.
+//!
+//! Sessions are considered matching if they have same payload type and FEC
+//! scheme; other session parameters are expected to be same for all sessions
+//! of the pool. Methods called from pipeline thread never block: if the pool
+//! is busy, acquire() returns null and release() does nothing, and the caller
+//! constructs or destroys session itself.
+class ReceiverSessionPool : public core::Thread {
+public:
+    //! Initialize.
+    //! @p pool_size defines how many spare sessions to keep.
+    //! Other parameters are passed to ReceiverSession.
+    ReceiverSessionPool(size_t pool_size,
+                        const ReceiverCommonConfig& common_config,
+                        const rtp::EncodingMap& encoding_map,
+                        packet::PacketFactory& packet_factory,
+                        audio::FrameFactory& frame_factory,
+                        core::NestedTimer* stage_timer,
+                        core::IArena& arena);
+
+    //! Deinitialize.
+    ~ReceiverSessionPool();
+
+    //! Get spare session.
+    //! @remarks
+    //!  Returns spare session constructed for matching @p session_config,
+    //!  or null if there is no such session. In the latter case, pool starts
+    //!  preparing spare sessions for @p session_config.
+    //!  Non-blocking operation.
+    core::SharedPtr<ReceiverSession> acquire(const ReceiverSessionConfig& session_config);
+
+    //! Pass session for destruction on background thread.
+    //! @remarks
+    //!  Session should be already removed from the pipeline.
+    //!  Non-blocking operation.
+    void release(const core::SharedPtr<ReceiverSession>& session);
+
+    //! Get number of spare sessions.
+    size_t num_spare() const;
+
+    //! Stop background thread.
+    //! Spare and released sessions are destroyed when pool is destroyed.
+    void stop();
+
+private:
+    virtual void run();
+
+    bool process_released_();
+    bool process_spare_();
+
+    static bool matches_(const ReceiverSessionConfig& a, const ReceiverSessionConfig& b);
+
+    const size_t pool_size_;
+
+    const ReceiverCommonConfig common_config_;
+    const rtp::EncodingMap& encoding_map_;
+    packet::PacketFactory& packet_factory_;
+    audio::FrameFactory& frame_factory_;
+    core::NestedTimer* stage_timer_;
+    core::IArena& arena_;
+
+    core::Mutex mutex_;
+
+    core::List<ReceiverSession> spare_sessions_;
+    core::List<ReceiverSession> released_sessions_;
+
+    ReceiverSessionConfig spare_config_;
+    bool has_spare_config_;
+    uint64_t spare_config_version_;
+    uint64_t failed_config_version_;
+
+    core::Semaphore wake_sem_;
+    core::Atomic<int> stop_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RECEIVER_SESSION_POOL_H_
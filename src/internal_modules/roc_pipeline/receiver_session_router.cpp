@@ -22,7 +22,9 @@ ReceiverSessionRouter::ReceiverSessionRouter(core::IArena& arena)
     , source_route_map_(arena)
     , address_route_map_(arena)
     , cname_route_map_(arena)
-    , session_route_map_(arena) {
+    , session_route_map_(arena)
+    , cache_hits_(0)
+    , cache_misses_(0) {
 }
 
 ReceiverSessionRouter::~ReceiverSessionRouter() {
@@ -35,7 +37,7 @@ size_t ReceiverSessionRouter::num_routes() {
 
 core::SharedPtr<ReceiverSession>
 ReceiverSessionRouter::find_by_source(packet::stream_source_t source_id) {
-    SourceNode* node = source_route_map_.find(source_id);
+    SourceNode* node = find_source_node_(source_id);
     if (!node) {
         return NULL;
     }
@@ -55,6 +57,44 @@ ReceiverSessionRouter::find_by_address(const address::SocketAddr& source_addr) {
     return node->route().session;
 }
 
+core::SharedPtr<ReceiverSession>
+ReceiverSessionRouter::find_session(bool has_source_id,
+                                    packet::stream_source_t source_id,
+                                    const address::SocketAddr& source_addr) {
+    CacheEntry& entry = cache_[cache_index_(has_source_id, source_id, source_addr)];
+
+    if (entry.valid && entry.has_source_id == has_source_id
+        && entry.source_id == source_id && entry.source_addr == source_addr) {
+        cache_hits_++;
+        return entry.session;
+    }
+
+    cache_misses_++;
+
+    core::SharedPtr<ReceiverSession> session =
+        lookup_session_(has_source_id, source_id, source_addr);
+
+    if (session) {
+        // Misses are not cached, because packet without session usually
+        // causes creation of a new session, which invalidates cache anyway.
+        entry.valid = true;
+        entry.has_source_id = has_source_id;
+        entry.source_id = source_id;
+        entry.source_addr = source_addr;
+        entry.session = session.get();
+    }
+
+    return session;
+}
+
+size_t ReceiverSessionRouter::num_cache_hits() const {
+    return cache_hits_;
+}
+
+size_t ReceiverSessionRouter::num_cache_misses() const {
+    return cache_misses_;
+}
+
 bool ReceiverSessionRouter::has_session(const core::SharedPtr<ReceiverSession>& session) {
     roc_panic_if(!session);
 
@@ -82,7 +122,9 @@ ReceiverSessionRouter::add_session(const core::SharedPtr<ReceiverSession>& sessi
         return status::StatusConflict;
     }
 
-    if (SourceNode* node = source_route_map_.find(source_id)) {
+    invalidate_cache_();
+
+    if (SourceNode* node = find_source_node_(source_id)) {
         Route& route = node->route();
 
         if (!route.source_addr && !route.session) {
@@ -157,7 +199,7 @@ status::StatusCode ReceiverSessionRouter::link_source(packet::stream_source_t so
     // Find routes for SSRC and CNAME.
     core::SharedPtr<Route> source_route, cname_route;
 
-    if (SourceNode* node = source_route_map_.find(source_id)) {
+    if (SourceNode* node = find_source_node_(source_id)) {
         source_route = &node->route();
     }
 
@@ -248,9 +290,11 @@ status::StatusCode ReceiverSessionRouter::link_source(packet::stream_source_t so
             return status::StatusNoMem;
         }
 
+        invalidate_cache_();
+
         cname_route->source_nodes.push_back(*node);
 
-        if (!source_route_map_.insert(*node)) {
+        if (!source_route_map_.insert(source_id, node.get())) {
             roc_log(LogError, "session router: allocation failed");
 
             cname_route->source_nodes.remove(*node);
@@ -266,7 +310,7 @@ status::StatusCode ReceiverSessionRouter::link_source(packet::stream_source_t so
 
 void ReceiverSessionRouter::unlink_source(packet::stream_source_t source_id) {
     // Find route for SSRC.
-    SourceNode* node = source_route_map_.find(source_id);
+    SourceNode* node = find_source_node_(source_id);
     if (!node) {
         // Nothing to remove.
         roc_log(LogTrace,
@@ -277,6 +321,8 @@ void ReceiverSessionRouter::unlink_source(packet::stream_source_t source_id) {
         return;
     }
 
+    invalidate_cache_();
+
     // Remember route before we remove SSRC node.
     Route& route = node->route();
 
@@ -284,7 +330,7 @@ void ReceiverSessionRouter::unlink_source(packet::stream_source_t source_id) {
     roc_log(LogDebug, "session router: unlinking SSRC: ssrc=%lu n_ssrcs=%lu",
             (unsigned long)source_id, (unsigned long)node->route().source_nodes.size());
 
-    source_route_map_.remove(*node);
+    source_route_map_.remove(source_id);
     route.source_nodes.remove(*node);
 
     // Check if it was main SSRC.
@@ -297,6 +343,51 @@ void ReceiverSessionRouter::unlink_source(packet::stream_source_t source_id) {
     collect_route_(route);
 }
 
+core::SharedPtr<ReceiverSession>
+ReceiverSessionRouter::lookup_session_(bool has_source_id,
+                                       packet::stream_source_t source_id,
+                                       const address::SocketAddr& source_addr) {
+    core::SharedPtr<ReceiverSession> session;
+
+    if (has_source_id) {
+        session = find_by_source(source_id);
+    }
+
+    if (!session && source_addr) {
+        session = find_by_address(source_addr);
+    }
+
+    return session;
+}
+
+size_t ReceiverSessionRouter::cache_index_(bool has_source_id,
+                                           packet::stream_source_t source_id,
+                                           const address::SocketAddr& source_addr) {
+    // Source id is random, so it's enough to distribute entries. Port helps
+    // when there are no source ids, which is rare.
+    const core::hashsum_t hash = core::hashsum_int(has_source_id ? source_id : 0)
+        ^ (core::hashsum_t)(source_addr ? source_addr.port() : 0);
+
+    return (size_t)(hash % CacheSize);
+}
+
+void ReceiverSessionRouter::invalidate_cache_() {
+    for (size_t n = 0; n < CacheSize; n++) {
+        cache_[n].valid = false;
+        cache_[n].session = NULL;
+    }
+}
+
+ReceiverSessionRouter::SourceNode*
+ReceiverSessionRouter::find_source_node_(packet::stream_source_t source_id) {
+    SourceNode** node = source_route_map_.find(source_id);
+    if (!node) {
+        return NULL;
+    }
+
+    return *node;
+}
+
 status::StatusCode
 ReceiverSessionRouter::relink_source_(packet::stream_source_t source_id,
                                       const char* cname) {
@@ -304,11 +395,13 @@ ReceiverSessionRouter::relink_source_(packet::stream_source_t source_id,
     roc_log(LogDebug, "session router: unlinking SSRC: ssrc=%lu",
             (unsigned long)source_id);
 
-    SourceNode* old_node = source_route_map_.find(source_id);
+    invalidate_cache_();
+
+    SourceNode* old_node = find_source_node_(source_id);
     roc_panic_if(!old_node);
     Route& old_route = old_node->route();
 
-    source_route_map_.remove(*old_node);
+    source_route_map_.remove(source_id);
     old_node->route().source_nodes.remove(*old_node);
 
     // Link SSRC to new route.
@@ -320,7 +413,7 @@ ReceiverSessionRouter::relink_source_(packet::stream_source_t source_id,
     if (old_route.has_main_source_id && old_route.main_source_id == source_id) {
         // If we're moving main SSRC from one route to another, we move session
         // and address too, because they are associated with this specific SSRC.
-        SourceNode* new_node = source_route_map_.find(source_id);
+        SourceNode* new_node = find_source_node_(source_id);
         roc_panic_if(!new_node);
         Route& new_route = new_node->route();
 
@@ -353,6 +446,8 @@ ReceiverSessionRouter::create_route_(const packet::stream_source_t source_id,
             (unsigned long)source_id, rtcp::cname_to_str(cname ? cname : "").c_str(),
             address::socket_addr_to_str(source_addr).c_str(), session ? 1 : 0);
 
+    invalidate_cache_();
+
     // Create route.
     core::SharedPtr<Route> route = new (route_pool_) Route(route_pool_);
     if (!route) {
@@ -373,7 +468,7 @@ ReceiverSessionRouter::create_route_(const packet::stream_source_t source_id,
 
         route->source_nodes.push_back(*node);
 
-        if (!source_route_map_.insert(*node)) {
+        if (!source_route_map_.insert(source_id, node)) {
             roc_log(LogError, "session router: allocation failed");
             remove_route_(route);
             return status::StatusNoMem;
@@ -430,12 +525,15 @@ void ReceiverSessionRouter::remove_route_(core::SharedPtr<Route> route) {
             address::socket_addr_to_str(route->source_addr).c_str(),
             route->session ? 1 : 0);
 
+    invalidate_cache_();
+
     // Remove SSRCs from mappings.
     while (!route->source_nodes.is_empty()) {
-        if (source_route_map_.contains(*route->source_nodes.back())) {
-            source_route_map_.remove(*route->source_nodes.back());
+        SourceNode* node = route->source_nodes.back().get();
+        if (find_source_node_(node->source_id) == node) {
+            source_route_map_.remove(node->source_id);
         }
-        route->source_nodes.remove(*route->source_nodes.back());
+        route->source_nodes.remove(*node);
     }
 
     // Remove CNAME from mappings.
@@ -467,6 +565,8 @@ status::StatusCode ReceiverSessionRouter::move_route_session_(Route& old_route,
                                                               Route& new_route) {
     roc_log(LogDebug, "session router: moving session to new route");
 
+    invalidate_cache_();
+
     // Move source address.
     if (address_route_map_.contains(old_route.address_node)) {
         address_route_map_.remove(old_route.address_node);
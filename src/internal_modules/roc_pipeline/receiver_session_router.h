@@ -14,6 +14,7 @@
 
 #include "roc_address/socket_addr.h"
 #include "roc_core/attributes.h"
+#include "roc_core/flat_hashmap.h"
 #include "roc_core/hashsum.h"
 #include "roc_core/iarena.h"
 #include "roc_core/list.h"
@@ -95,6 +96,27 @@ public:
     core::SharedPtr<ReceiverSession>
     find_by_address(const address::SocketAddr& source_addr);
 
+    //! Find registered session for packet from given sender's stream.
+    //! @remarks
+    //!  Same as find_by_source(), with fallback to find_by_address() if there is
+    //!  no session for the source id. Successful results are remembered in a small
+    //!  direct-mapped cache keyed by source id and source address, so that when
+    //!  consecutive packets come from the same stream, lookup costs a single
+    //!  entry comparison. Cache is invalidated on any route change.
+    //! @note
+    //!  @p source_id is ignored if @p has_source_id is false, and @p source_addr
+    //!  is ignored if it's empty.
+    core::SharedPtr<ReceiverSession>
+    find_session(bool has_source_id,
+                 packet::stream_source_t source_id,
+                 const address::SocketAddr& source_addr);
+
+    //! Get number of find_session() calls served from cache.
+    size_t num_cache_hits() const;
+
+    //! Get number of find_session() calls not served from cache.
+    size_t num_cache_misses() const;
+
     //! Check if there is a route for given session.
     //! @remarks
     //!  Will return false after session was removed via remove_session()
@@ -133,14 +155,13 @@ public:
     void unlink_source(packet::stream_source_t source_id);
 
 private:
-    enum { PreallocatedRoutes = 4, PreallocatedSources = 8 };
+    enum { PreallocatedRoutes = 4, PreallocatedSources = 8, CacheSize = 64 };
 
     struct Route;
 
     // Map route by source id (ssrc).
     // Allocated from pool.
     struct SourceNode : core::RefCounted<SourceNode, core::PoolAllocation>,
-                        core::HashmapNode<>,
                         core::ListNode<> {
         Route& parent_route;
         const packet::stream_source_t source_id;
@@ -154,20 +175,6 @@ private:
         Route& route() {
             return parent_route;
         }
-
-        packet::stream_source_t key() {
-            // Use source id as a key.
-            return source_id;
-        }
-
-        static core::hashsum_t key_hash(packet::stream_source_t source_id) {
-            return core::hashsum_int(source_id);
-        }
-
-        static bool key_equal(packet::stream_source_t source_id1,
-                              packet::stream_source_t source_id2) {
-            return source_id1 == source_id2;
-        }
     };
 
     // Map route by source address.
@@ -280,6 +287,36 @@ private:
         }
     };
 
+    // Entry of session lookup cache.
+    // Holds raw session pointer, which is valid until next route change,
+    // because route holds reference to session.
+    struct CacheEntry {
+        bool valid;
+        bool has_source_id;
+        packet::stream_source_t source_id;
+        address::SocketAddr source_addr;
+        ReceiverSession* session;
+
+        CacheEntry()
+            : valid(false)
+            , has_source_id(false)
+            , source_id(0)
+            , session(NULL) {
+        }
+    };
+
+    core::SharedPtr<ReceiverSession>
+    lookup_session_(bool has_source_id,
+                    packet::stream_source_t source_id,
+                    const address::SocketAddr& source_addr);
+
+    static size_t cache_index_(bool has_source_id,
+                               packet::stream_source_t source_id,
+                               const address::SocketAddr& source_addr);
+    void invalidate_cache_();
+
+    SourceNode* find_source_node_(packet::stream_source_t source_id);
+
     status::StatusCode relink_source_(packet::stream_source_t source_id,
                                       const char* cname);
 
@@ -302,10 +339,17 @@ private:
 
     // Mappings to find routes by different keys
     // Don't hold ownership to routes
-    core::Hashmap<SourceNode, PreallocatedRoutes, core::NoOwnership> source_route_map_;
+    // Source map is flat, because it's queried for every packet
+    core::FlatHashmap<packet::stream_source_t, SourceNode*, PreallocatedSources>
+        source_route_map_;
     core::Hashmap<AddressNode, PreallocatedRoutes, core::NoOwnership> address_route_map_;
     core::Hashmap<CnameNode, PreallocatedRoutes, core::NoOwnership> cname_route_map_;
     core::Hashmap<SessionNode, PreallocatedRoutes, core::NoOwnership> session_route_map_;
+
+    // Direct-mapped cache in front of mappings
+    CacheEntry cache_[CacheSize];
+    size_t cache_hits_;
+    size_t cache_misses_;
 };
 
 } // namespace pipeline
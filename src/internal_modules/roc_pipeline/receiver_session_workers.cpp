@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/receiver_session_workers.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+ReceiverSessionWorkers::Input::Input(const core::SharedPtr<ReceiverSession>& session,
+                                     const core::Slice<audio::sample_t>& buffer,
+                                     const audio::SampleSpec& sample_spec)
+    : session_(session)
+    , buffer_(buffer)
+    , sample_spec_(sample_spec)
+    , size_(0)
+    , pos_(0)
+    , status_(false)
+    , flags_(0)
+    , capture_ts_(0) {
+}
+
+const core::SharedPtr<ReceiverSession>& ReceiverSessionWorkers::Input::session() const {
+    return session_;
+}
+
+void ReceiverSessionWorkers::Input::prefetch(size_t n_samples) {
+    n_samples = std::min(n_samples, buffer_.capacity());
+    n_samples -= n_samples % sample_spec_.num_channels();
+
+    if (n_samples == 0) {
+        reset();
+        return;
+    }
+
+    audio::Frame frame(buffer_.data(), n_samples);
+
+    status_ = session_->frame_reader().read(frame);
+    flags_ = frame.flags();
+    capture_ts_ = frame.capture_timestamp();
+
+    size_ = n_samples;
+    pos_ = 0;
+}
+
+void ReceiverSessionWorkers::Input::reset() {
+    size_ = 0;
+    pos_ = 0;
+}
+
+bool ReceiverSessionWorkers::Input::read(audio::Frame& frame) {
+    if (pos_ == size_) {
+        // Nothing prefetched, or prefetched frame is fully consumed,
+        // read directly from session.
+        return session_->frame_reader().read(frame);
+    }
+
+    // Mixer may request smaller or larger frames than we have prefetched,
+    // if output frame is larger than mixer buffer. In this case, we return
+    // prefetched samples in pieces, and read the rest directly from session.
+    const size_t n_samples = frame.num_raw_samples();
+    const size_t n_copy = std::min(n_samples, size_ - pos_);
+
+    memcpy(frame.raw_samples(), buffer_.data() + pos_, n_copy * sizeof(audio::sample_t));
+
+    bool status = status_;
+    unsigned flags = flags_;
+    core::nanoseconds_t capture_ts = 0;
+
+    if (capture_ts_ != 0) {
+        capture_ts = capture_ts_ + sample_spec_.samples_overall_2_ns(pos_);
+    }
+
+    pos_ += n_copy;
+
+    if (n_copy < n_samples) {
+        audio::Frame rest_frame(frame.raw_samples() + n_copy, n_samples - n_copy);
+
+        if (session_->frame_reader().read(rest_frame)) {
+            status = true;
+            flags |= rest_frame.flags();
+        } else {
+            memset(rest_frame.raw_samples(), 0,
+                   rest_frame.num_raw_samples() * sizeof(audio::sample_t));
+        }
+    }
+
+    frame.set_flags(flags);
+    frame.set_capture_timestamp(capture_ts);
+
+    return status;
+}
+
+ReceiverSessionWorkers::Worker::Worker(ReceiverSessionWorkers& workers, size_t index)
+    : workers_(workers)
+    , index_(index)
+    , stop_(0) {
+}
+
+void ReceiverSessionWorkers::Worker::begin() {
+    begin_sem_.post();
+}
+
+void ReceiverSessionWorkers::Worker::stop() {
+    stop_ = 1;
+    begin_sem_.post();
+}
+
+void ReceiverSessionWorkers::Worker::run() {
+    roc_log(LogDebug, "session workers: starting worker thread: index=%lu",
+            (unsigned long)index_);
+
+    for (;;) {
+        begin_sem_.wait();
+
+        if (stop_) {
+            break;
+        }
+
+        workers_.prefetch_(index_);
+        workers_.end_sem_.post();
+    }
+
+    roc_log(LogDebug, "session workers: finishing worker thread: index=%lu",
+            (unsigned long)index_);
+}
+
+ReceiverSessionWorkers::ReceiverSessionWorkers(audio::Mixer& mixer,
+                                               audio::IFrameReader& mixer_reader,
+                                               size_t num_threads,
+                                               const audio::SampleSpec& sample_spec,
+                                               audio::FrameFactory& frame_factory,
+                                               core::IArena& arena)
+    : mixer_(mixer)
+    , mixer_reader_(mixer_reader)
+    , frame_factory_(frame_factory)
+    , arena_(arena)
+    , sample_spec_(sample_spec)
+    , num_workers_(0)
+    , prefetch_size_(0)
+    , valid_(false) {
+    roc_panic_if_msg(!sample_spec_.is_valid() || !sample_spec_.is_raw(),
+                     "session workers: required valid sample spec with raw format");
+
+    if (num_threads == 0 || num_threads > MaxThreads) {
+        roc_log(LogError,
+                "session workers: invalid number of threads:"
+                " got=%lu expected=[1; %lu]",
+                (unsigned long)num_threads, (unsigned long)MaxThreads);
+        return;
+    }
+
+    roc_log(LogDebug, "session workers: initializing: num_threads=%lu",
+            (unsigned long)num_threads);
+
+    for (; num_workers_ < num_threads; num_workers_++) {
+        Worker* worker = new (arena_) Worker(*this, num_workers_ + 1);
+        if (!worker) {
+            roc_log(LogError, "session workers: can't allocate worker");
+            return;
+        }
+
+        workers_[num_workers_] = worker;
+
+        if (!worker->start()) {
+            roc_log(LogError, "session workers: can't start worker thread");
+            arena_.destroy_object(*worker);
+            return;
+        }
+    }
+
+    valid_ = true;
+}
+
+ReceiverSessionWorkers::~ReceiverSessionWorkers() {
+    stop_workers_();
+    remove_all_inputs_();
+}
+
+bool ReceiverSessionWorkers::is_valid() const {
+    return valid_;
+}
+
+bool ReceiverSessionWorkers::add_session(const core::SharedPtr<ReceiverSession>& session) {
+    roc_panic_if(!is_valid());
+    roc_panic_if(!session);
+
+    core::Slice<audio::sample_t> buffer = frame_factory_.new_raw_buffer();
+    if (!buffer) {
+        roc_log(LogError, "session workers: can't allocate buffer for session");
+        return false;
+    }
+
+    Input* input = new (arena_) Input(session, buffer, sample_spec_);
+    if (!input) {
+        roc_log(LogError, "session workers: can't allocate input for session");
+        return false;
+    }
+
+    inputs_.push_back(*input);
+    mixer_.add_input(*input);
+
+    return true;
+}
+
+void ReceiverSessionWorkers::remove_session(
+    const core::SharedPtr<ReceiverSession>& session) {
+    roc_panic_if(!is_valid());
+
+    for (Input* input = inputs_.front(); input; input = inputs_.nextof(*input)) {
+        if (input->session() == session) {
+            mixer_.remove_input(*input);
+            inputs_.remove(*input);
+            arena_.destroy_object(*input);
+            return;
+        }
+    }
+
+    roc_panic("session workers: session not found");
+}
+
+bool ReceiverSessionWorkers::read(audio::Frame& frame) {
+    roc_panic_if(!is_valid());
+
+    // With zero or one session, there is nothing to parallelize.
+    if (inputs_.size() > 1) {
+        prefetch_size_ = frame.num_raw_samples();
+
+        for (size_t n = 0; n < num_workers_; n++) {
+            workers_[n]->begin();
+        }
+
+        // Calling thread processes its own part of sessions.
+        prefetch_(0);
+
+        // Wait until all workers finish, before mixing.
+        for (size_t n = 0; n < num_workers_; n++) {
+            end_sem_.wait();
+        }
+    }
+
+    const bool status = mixer_reader_.read(frame);
+
+    for (Input* input = inputs_.front(); input; input = inputs_.nextof(*input)) {
+        input->reset();
+    }
+
+    return status;
+}
+
+void ReceiverSessionWorkers::prefetch_(size_t worker_index) {
+    const size_t num_parts = num_workers_ + 1;
+
+    size_t input_index = 0;
+
+    for (Input* input = inputs_.front(); input;
+         input = inputs_.nextof(*input), input_index++) {
+        if (input_index % num_parts == worker_index) {
+            input->prefetch(prefetch_size_);
+        }
+    }
+}
+
+void ReceiverSessionWorkers::stop_workers_() {
+    for (size_t n = 0; n < num_workers_; n++) {
+        if (workers_[n]->is_joinable()) {
+            workers_[n]->stop();
+            workers_[n]->join();
+        }
+        arena_.destroy_object(*workers_[n]);
+    }
+
+    num_workers_ = 0;
+}
+
+void ReceiverSessionWorkers::remove_all_inputs_() {
+    while (Input* input = inputs_.back()) {
+        mixer_.remove_input(*input);
+        inputs_.remove(*input);
+        arena_.destroy_object(*input);
+    }
+}
+
+} // namespace pipeline
+} // namespace roc
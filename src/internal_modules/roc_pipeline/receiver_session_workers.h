@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/receiver_session_workers.h
+//! @brief Receiver session workers.
+
+#ifndef ROC_PIPELINE_RECEIVER_SESSION_WORKERS_H_
+#define ROC_PIPELINE_RECEIVER_SESSION_WORKERS_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/mixer.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/atomic.h"
+#include "roc_core/iarena.h"
+#include "roc_core/list.h"
+#include "roc_core/list_node.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/slice.h"
+#include "roc_core/thread.h"
+#include "roc_pipeline/receiver_session.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Receiver session workers.
+//!
+//! Processes receiver sessions in parallel on a pool of threads.
+//!
+//! When enabled, sessions are added here instead of being added directly to
+//! the mixer. Every session is wrapped into an input that is added to mixer.
+//!
+//! When a frame is requested from workers, they first read a frame from every
+//! session in parallel into per-session buffers. Sessions are partitioned
+//! between the calling thread and worker threads. After all sessions are
+//! processed (barrier), workers ask mixer to produce output frame, and mixer
+//! reads prefetched frames from inputs.
+//!
+//! All other operations on sessions (routing packets, refreshing, reclocking)
+//! are still performed on the calling thread, while worker threads are idle,
+//! so sessions are never accessed concurrently.
+class ReceiverSessionWorkers : public audio::IFrameReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @p num_threads defines number of threads, in addition to the calling one.
+    //! @p mixer_reader is used to produce output frame; it's either @p mixer
+    //! itself, or a reader wrapping it.
+    ReceiverSessionWorkers(audio::Mixer& mixer,
+                           audio::IFrameReader& mixer_reader,
+                           size_t num_threads,
+                           const audio::SampleSpec& sample_spec,
+                           audio::FrameFactory& frame_factory,
+                           core::IArena& arena);
+
+    ~ReceiverSessionWorkers();
+
+    //! Check if workers were succefully constructed.
+    bool is_valid() const;
+
+    //! Add session.
+    //! @remarks
+    //!  Adds session input to mixer.
+    ROC_ATTR_NODISCARD bool add_session(const core::SharedPtr<ReceiverSession>& session);
+
+    //! Remove session.
+    //! @remarks
+    //!  Removes session input from mixer.
+    void remove_session(const core::SharedPtr<ReceiverSession>& session);
+
+    //! Read audio frame.
+    //! @remarks
+    //!  Reads frames from all sessions in parallel and then mixes them.
+    virtual bool read(audio::Frame& frame);
+
+private:
+    struct InputTag;
+
+    // Per-session input of mixer.
+    // Holds frame prefetched by worker.
+    class Input : public audio::IFrameReader, public core::ListNode<InputTag> {
+    public:
+        Input(const core::SharedPtr<ReceiverSession>& session,
+              const core::Slice<audio::sample_t>& buffer,
+              const audio::SampleSpec& sample_spec);
+
+        const core::SharedPtr<ReceiverSession>& session() const;
+
+        // Read frame from session into buffer.
+        void prefetch(size_t n_samples);
+
+        // Forget prefetched frame.
+        void reset();
+
+        // Read prefetched frame, or read from session if there is
+        // no prefetched frame.
+        virtual bool read(audio::Frame& frame);
+
+    private:
+        core::SharedPtr<ReceiverSession> session_;
+        core::Slice<audio::sample_t> buffer_;
+
+        const audio::SampleSpec sample_spec_;
+
+        size_t size_;
+        size_t pos_;
+        bool status_;
+        unsigned flags_;
+        core::nanoseconds_t capture_ts_;
+    };
+
+    typedef core::List<Input, core::NoOwnership, core::ListNode<InputTag> > InputList;
+
+    class Worker : public core::Thread {
+    public:
+        Worker(ReceiverSessionWorkers& workers, size_t index);
+
+        // Start processing inputs.
+        void begin();
+
+        // Ask thread to exit.
+        void stop();
+
+    private:
+        virtual void run();
+
+        ReceiverSessionWorkers& workers_;
+        const size_t index_;
+
+        core::Semaphore begin_sem_;
+        core::Atomic<int> stop_;
+    };
+
+    void prefetch_(size_t worker_index);
+    void stop_workers_();
+    void remove_all_inputs_();
+
+    audio::Mixer& mixer_;
+    audio::IFrameReader& mixer_reader_;
+    audio::FrameFactory& frame_factory_;
+    core::IArena& arena_;
+
+    const audio::SampleSpec sample_spec_;
+
+    InputList inputs_;
+
+    enum { MaxThreads = 64 };
+
+    Worker* workers_[MaxThreads];
+    size_t num_workers_;
+
+    core::Semaphore end_sem_;
+    size_t prefetch_size_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RECEIVER_SESSION_WORKERS_H_
@@ -17,6 +17,9 @@ ReceiverSlot::ReceiverSlot(const ReceiverSourceConfig& source_config,
                            const ReceiverSlotConfig& slot_config,
                            StateTracker& state_tracker,
                            audio::Mixer& mixer,
+                           ReceiverSessionWorkers* session_workers,
+                           core::NestedTimer* stage_timer,
+                           const core::DurationHistogram* mixer_timing,
                            const rtp::EncodingMap& encoding_map,
                            packet::PacketFactory& packet_factory,
                            audio::FrameFactory& frame_factory,
@@ -28,10 +31,13 @@ ReceiverSlot::ReceiverSlot(const ReceiverSourceConfig& source_config,
                      slot_config,
                      state_tracker_,
                      mixer,
+                     session_workers,
+                     stage_timer,
                      encoding_map,
                      packet_factory,
                      frame_factory,
                      arena)
+    , mixer_timing_(mixer_timing)
     , valid_(false) {
     if (!session_group_.is_valid()) {
         return;
@@ -111,11 +117,51 @@ size_t ReceiverSlot::num_sessions() const {
 
 void ReceiverSlot::get_metrics(ReceiverSlotMetrics& slot_metrics,
                                ReceiverParticipantMetrics* party_metrics,
-                               size_t* party_count) const {
+                               size_t* party_count) {
     roc_panic_if(!is_valid());
 
+    update_timing_metrics_();
+    collect_metrics_(slot_metrics, party_metrics, party_count);
+}
+
+void ReceiverSlot::publish_metrics() {
+    roc_panic_if(!is_valid());
+
+    // Computing quantiles is not free, so do it only when someone
+    // actually reads published metrics.
+    if (metrics_snapshot_.check_and_clear_read()) {
+        update_timing_metrics_();
+    }
+
+    ReceiverSlotMetrics slot_metrics;
+    size_t party_count = ReceiverMetricsSnapshot::MaxParticipants;
+
+    collect_metrics_(slot_metrics, party_metrics_, &party_count);
+
+    metrics_snapshot_.store(slot_metrics, party_metrics_, party_count);
+}
+
+bool ReceiverSlot::read_metrics(ReceiverSlotMetrics& slot_metrics,
+                                ReceiverParticipantMetrics* party_metrics,
+                                size_t* party_count) const {
+    return metrics_snapshot_.load(slot_metrics, party_metrics, party_count);
+}
+
+void ReceiverSlot::update_timing_metrics_() {
+    if (mixer_timing_) {
+        mixer_timing_metrics_ = mixer_timing_->metrics();
+    }
+
+    session_group_.update_timing_metrics();
+}
+
+void ReceiverSlot::collect_metrics_(ReceiverSlotMetrics& slot_metrics,
+                                    ReceiverParticipantMetrics* party_metrics,
+                                    size_t* party_count) const {
     session_group_.get_slot_metrics(slot_metrics);
 
+    slot_metrics.mixer_timing = mixer_timing_metrics_;
+
     if (party_metrics || party_count) {
         session_group_.get_participant_metrics(party_metrics, party_count);
     }
@@ -16,11 +16,14 @@
 #include "roc_address/protocol.h"
 #include "roc_audio/frame_factory.h"
 #include "roc_audio/mixer.h"
+#include "roc_core/duration_histogram.h"
 #include "roc_core/iarena.h"
 #include "roc_core/list_node.h"
+#include "roc_core/nested_timer.h"
 #include "roc_core/ref_counted.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/metrics.h"
+#include "roc_pipeline/metrics_snapshot.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session_group.h"
 #include "roc_pipeline/state_tracker.h"
@@ -38,10 +41,16 @@ class ReceiverSlot : public core::RefCounted<ReceiverSlot, core::ArenaAllocation
                      public core::ListNode<> {
 public:
     //! Initialize.
+    //! @remarks
+    //!  @p stage_timer is passed to sessions, see ReceiverSession.
+    //!  If @p mixer_timing is non-null, it's reported in slot metrics.
     ReceiverSlot(const ReceiverSourceConfig& source_config,
                  const ReceiverSlotConfig& slot_config,
                  StateTracker& state_tracker,
                  audio::Mixer& mixer,
+                 ReceiverSessionWorkers* session_workers,
+                 core::NestedTimer* stage_timer,
+                 const core::DurationHistogram* mixer_timing,
                  const rtp::EncodingMap& encoding_map,
                  packet::PacketFactory& packet_factory,
                  audio::FrameFactory& frame_factory,
@@ -72,11 +81,34 @@ public:
     size_t num_sessions() const;
 
     //! Get metrics for slot and its participants.
+    //! @remarks
+    //!  Stage timing metrics are recomputed on every call.
     void get_metrics(ReceiverSlotMetrics& slot_metrics,
                      ReceiverParticipantMetrics* party_metrics,
-                     size_t* party_count) const;
+                     size_t* party_count);
+
+    //! Publish current metrics to snapshot.
+    //! @remarks
+    //!  Invoked by pipeline after processing each frame and task.
+    //!  Stage timing metrics are recomputed only if snapshot was read
+    //!  since previous publish, otherwise previous values are published.
+    void publish_metrics();
+
+    //! Read metrics from last published snapshot.
+    //! @remarks
+    //!  Unlike get_metrics(), can be called from any thread.
+    //! @returns
+    //!  false if snapshot doesn't contain all requested participants.
+    bool read_metrics(ReceiverSlotMetrics& slot_metrics,
+                      ReceiverParticipantMetrics* party_metrics,
+                      size_t* party_count) const;
 
 private:
+    void update_timing_metrics_();
+    void collect_metrics_(ReceiverSlotMetrics& slot_metrics,
+                          ReceiverParticipantMetrics* party_metrics,
+                          size_t* party_count) const;
+
     ReceiverEndpoint* create_source_endpoint_(address::Protocol proto,
                                               const address::SocketAddr& inbound_address,
                                               packet::IWriter* outbound_writer);
@@ -92,10 +124,16 @@ private:
     StateTracker& state_tracker_;
     ReceiverSessionGroup session_group_;
 
+    const core::DurationHistogram* mixer_timing_;
+    core::DurationMetrics mixer_timing_metrics_;
+
     core::Optional<ReceiverEndpoint> source_endpoint_;
     core::Optional<ReceiverEndpoint> repair_endpoint_;
     core::Optional<ReceiverEndpoint> control_endpoint_;
 
+    ReceiverMetricsSnapshot metrics_snapshot_;
+    ReceiverParticipantMetrics party_metrics_[ReceiverMetricsSnapshot::MaxParticipants];
+
     bool valid_;
 };
 
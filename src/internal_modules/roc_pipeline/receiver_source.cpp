@@ -37,6 +37,22 @@ ReceiverSource::ReceiverSource(const ReceiverSourceConfig& source_config,
     }
     frm_reader = mixer_.get();
 
+    if (source_config_.common.enable_stage_timing) {
+        mixer_timing_.reset(new (mixer_timing_)
+                                audio::TimingReader(*frm_reader, stage_timer_));
+        frm_reader = mixer_timing_.get();
+    }
+
+    if (source_config_.common.session_threads != 0) {
+        session_workers_.reset(new (session_workers_) ReceiverSessionWorkers(
+            *mixer_, *frm_reader, source_config_.common.session_threads,
+            source_config_.common.output_sample_spec, frame_factory_, arena_));
+        if (!session_workers_ || !session_workers_->is_valid()) {
+            return;
+        }
+        frm_reader = session_workers_.get();
+    }
+
     if (!source_config_.common.output_sample_spec.is_raw()) {
         const audio::SampleSpec in_spec(
             source_config_.common.output_sample_spec.sample_rate(),
@@ -79,9 +95,19 @@ ReceiverSlot* ReceiverSource::create_slot(const ReceiverSlotConfig& slot_config)
 
     roc_log(LogInfo, "receiver source: adding slot");
 
-    core::SharedPtr<ReceiverSlot> slot =
-        new (arena_) ReceiverSlot(source_config_, slot_config, state_tracker_, *mixer_,
-                                  encoding_map_, packet_factory_, frame_factory_, arena_);
+    // Without workers, sessions are read by mixer on the same thread, so they
+    // share timer with it, and mixer timing excludes time of session stages.
+    // With workers, sessions are read in parallel before mixing and each
+    // session uses its own timer.
+    core::NestedTimer* stage_timer = session_workers_ ? NULL : &stage_timer_;
+
+    const core::DurationHistogram* mixer_timing =
+        mixer_timing_ ? &mixer_timing_->histogram() : NULL;
+
+    core::SharedPtr<ReceiverSlot> slot = new (arena_)
+        ReceiverSlot(source_config_, slot_config, state_tracker_, *mixer_,
+                     session_workers_.get(), stage_timer, mixer_timing, encoding_map_,
+                     packet_factory_, frame_factory_, arena_);
 
     if (!slot || !slot->is_valid()) {
         roc_log(LogError, "receiver source: can't create slot");
@@ -130,6 +156,15 @@ core::nanoseconds_t ReceiverSource::refresh(core::nanoseconds_t current_time) {
     return next_deadline;
 }
 
+void ReceiverSource::publish_metrics() {
+    roc_panic_if(!is_valid());
+
+    for (core::SharedPtr<ReceiverSlot> slot = slots_.front(); slot;
+         slot = slots_.nextof(*slot)) {
+        slot->publish_metrics();
+    }
+}
+
 sndio::ISink* ReceiverSource::to_sink() {
     return NULL;
 }
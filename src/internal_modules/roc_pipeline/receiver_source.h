@@ -17,12 +17,15 @@
 #include "roc_audio/mixer.h"
 #include "roc_audio/pcm_mapper_reader.h"
 #include "roc_audio/profiling_reader.h"
+#include "roc_audio/timing_reader.h"
 #include "roc_core/iarena.h"
+#include "roc_core/nested_timer.h"
 #include "roc_core/optional.h"
 #include "roc_core/stddefs.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/receiver_endpoint.h"
+#include "roc_pipeline/receiver_session_workers.h"
 #include "roc_pipeline/receiver_slot.h"
 #include "roc_pipeline/state_tracker.h"
 #include "roc_rtp/encoding_map.h"
@@ -72,6 +75,12 @@ public:
     //!  if there are no frames
     core::nanoseconds_t refresh(core::nanoseconds_t current_time);
 
+    //! Publish metrics of all slots.
+    //! @remarks
+    //!  Updates snapshots that can be read from any thread,
+    //!  see ReceiverSlot::read_metrics().
+    void publish_metrics();
+
     //! Cast IDevice to ISink.
     virtual sndio::ISink* to_sink();
 
@@ -126,6 +135,9 @@ private:
     StateTracker state_tracker_;
 
     core::Optional<audio::Mixer> mixer_;
+    core::NestedTimer stage_timer_;
+    core::Optional<audio::TimingReader> mixer_timing_;
+    core::Optional<ReceiverSessionWorkers> session_workers_;
     core::Optional<audio::ProfilingReader> profiler_;
     core::Optional<audio::PcmMapperReader> pcm_mapper_;
 
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/relay_endpoint.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parser.h"
+#include "roc_status/code_to_str.h"
+
+namespace roc {
+namespace pipeline {
+
+RelayEndpoint::RelayEndpoint(address::Protocol proto,
+                             StateTracker& state_tracker,
+                             IRelayRouter& router,
+                             const rtp::EncodingMap& encoding_map,
+                             const address::SocketAddr* outbound_address,
+                             packet::IWriter* outbound_writer,
+                             core::IArena& arena)
+    : proto_(proto)
+    , state_tracker_(state_tracker)
+    , router_(router)
+    , composer_(NULL)
+    , parser_(NULL)
+    , valid_(false) {
+    packet::IComposer* composer = NULL;
+    packet::IParser* parser = NULL;
+
+    switch (proto) {
+    case address::Proto_RTP:
+    case address::Proto_RTP_LDPC_Source:
+    case address::Proto_RTP_RS8M_Source:
+        rtp_composer_.reset(new (rtp_composer_) rtp::Composer(NULL));
+        if (!rtp_composer_) {
+            return;
+        }
+        composer = rtp_composer_.get();
+
+        rtp_parser_.reset(new (rtp_parser_) rtp::Parser(encoding_map, NULL));
+        if (!rtp_parser_) {
+            return;
+        }
+        parser = rtp_parser_.get();
+        break;
+    default:
+        break;
+    }
+
+    switch (proto) {
+    case address::Proto_RTP_LDPC_Source:
+        fec_composer_.reset(
+            new (arena)
+                fec::Composer<fec::LDPC_Source_PayloadID, fec::Source, fec::Footer>(
+                    composer),
+            arena);
+        fec_parser_.reset(
+            new (arena)
+                fec::Parser<fec::LDPC_Source_PayloadID, fec::Source, fec::Footer>(parser),
+            arena);
+        break;
+    case address::Proto_LDPC_Repair:
+        fec_composer_.reset(
+            new (arena)
+                fec::Composer<fec::LDPC_Repair_PayloadID, fec::Repair, fec::Header>(
+                    composer),
+            arena);
+        fec_parser_.reset(
+            new (arena)
+                fec::Parser<fec::LDPC_Repair_PayloadID, fec::Repair, fec::Header>(parser),
+            arena);
+        break;
+    case address::Proto_RTP_RS8M_Source:
+        fec_composer_.reset(
+            new (arena)
+                fec::Composer<fec::RS8M_PayloadID, fec::Source, fec::Footer>(composer),
+            arena);
+        fec_parser_.reset(
+            new (arena)
+                fec::Parser<fec::RS8M_PayloadID, fec::Source, fec::Footer>(parser),
+            arena);
+        break;
+    case address::Proto_RS8M_Repair:
+        fec_composer_.reset(
+            new (arena)
+                fec::Composer<fec::RS8M_PayloadID, fec::Repair, fec::Header>(composer),
+            arena);
+        fec_parser_.reset(
+            new (arena)
+                fec::Parser<fec::RS8M_PayloadID, fec::Repair, fec::Header>(parser),
+            arena);
+        break;
+    default:
+        break;
+    }
+
+    switch (proto) {
+    case address::Proto_RTP_LDPC_Source:
+    case address::Proto_LDPC_Repair:
+    case address::Proto_RTP_RS8M_Source:
+    case address::Proto_RS8M_Repair:
+        if (!fec_composer_ || !fec_parser_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        parser = fec_parser_.get();
+        break;
+    default:
+        break;
+    }
+
+    switch (proto) {
+    case address::Proto_RTCP:
+        rtcp_composer_.reset(new (rtcp_composer_) rtcp::Composer());
+        if (!rtcp_composer_) {
+            return;
+        }
+        composer = rtcp_composer_.get();
+
+        rtcp_parser_.reset(new (rtcp_parser_) rtcp::Parser());
+        if (!rtcp_parser_) {
+            return;
+        }
+        parser = rtcp_parser_.get();
+        break;
+    default:
+        break;
+    }
+
+    // For relay, both parser and composer are mandatory.
+    if (!composer || !parser) {
+        roc_log(LogError, "relay endpoint: unsupported protocol %s",
+                address::proto_to_str(proto));
+        return;
+    }
+
+    if (outbound_writer) {
+        shipper_.reset(new (shipper_) packet::Shipper(*composer, *outbound_writer,
+                                                      outbound_address));
+        if (!shipper_) {
+            return;
+        }
+    }
+
+    composer_ = composer;
+    parser_ = parser;
+
+    valid_ = true;
+}
+
+RelayEndpoint::~RelayEndpoint() {
+    // Keep pending packets counter balanced, otherwise relay thread
+    // would never go to sleep.
+    while (packet::PacketPtr packet = inbound_queue_.pop_front_exclusive()) {
+        state_tracker_.add_pending_packets(-1);
+    }
+}
+
+bool RelayEndpoint::is_valid() const {
+    return valid_;
+}
+
+address::Protocol RelayEndpoint::proto() const {
+    roc_panic_if(!is_valid());
+
+    return proto_;
+}
+
+packet::IComposer& RelayEndpoint::outbound_composer() {
+    roc_panic_if(!is_valid());
+
+    return *composer_;
+}
+
+packet::IWriter* RelayEndpoint::outbound_writer() {
+    roc_panic_if(!is_valid());
+
+    if (!shipper_) {
+        // Outbound packets are not supported.
+        return NULL;
+    }
+
+    return shipper_.get();
+}
+
+packet::IWriter& RelayEndpoint::inbound_writer() {
+    roc_panic_if(!is_valid());
+
+    return *this;
+}
+
+status::StatusCode RelayEndpoint::pull_packets(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
+    // It may return NULL either if the queue is empty or if the packets in the
+    // queue were added in a very short time or are being added currently. It's
+    // acceptable to consider such packets late and pull them next time.
+    while (packet::PacketPtr packet = inbound_queue_.try_pop_front_exclusive()) {
+        state_tracker_.add_pending_packets(-1);
+
+        if (!parser_->parse(*packet, packet->buffer())) {
+            roc_log(LogDebug, "relay endpoint: can't parse packet");
+            continue;
+        }
+
+        // Packet buffer already contains composed packet, so it can be
+        // forwarded as is, unless someone modifies its headers.
+        packet->add_flags(packet::Packet::FlagPrepared | packet::Packet::FlagComposed);
+
+        const status::StatusCode code = router_.route_packet(packet, current_time);
+        if (code != status::StatusOK) {
+            // Routing may fail for a single packet, e.g. when packet pool is
+            // exhausted while replicating it to outputs. Losing a packet is
+            // tolerable for relay, so drop it and proceed with next ones.
+            roc_log(LogDebug, "relay endpoint: can't route packet, dropping: status=%s",
+                    status::code_to_str(code));
+            continue;
+        }
+    }
+
+    return status::StatusOK;
+}
+
+// Implementation of inbound_writer().write()
+status::StatusCode RelayEndpoint::write(const packet::PacketPtr& packet) {
+    roc_panic_if(!is_valid());
+
+    roc_panic_if(!packet);
+
+    state_tracker_.add_pending_packets(+1);
+    inbound_queue_.push_back(*packet);
+
+    return status::StatusOK;
+}
+
+} // namespace pipeline
+} // namespace roc
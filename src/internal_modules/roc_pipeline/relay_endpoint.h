@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/relay_endpoint.h
+//! @brief Relay endpoint pipeline.
+
+#ifndef ROC_PIPELINE_RELAY_ENDPOINT_H_
+#define ROC_PIPELINE_RELAY_ENDPOINT_H_
+
+#include "roc_address/protocol.h"
+#include "roc_address/socket_addr.h"
+#include "roc_core/iarena.h"
+#include "roc_core/mpsc_queue.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_packet/icomposer.h"
+#include "roc_packet/iparser.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/shipper.h"
+#include "roc_pipeline/irelay_router.h"
+#include "roc_pipeline/state_tracker.h"
+#include "roc_rtcp/composer.h"
+#include "roc_rtcp/parser.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/encoding_map.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Relay endpoint sub-pipeline.
+//!
+//! Contains:
+//!  - a pipeline for parsing packets from single network endpoint
+//!  - a pipeline for composing packets for single network endpoint
+//!  - a reference to router to which parsed packets are passed
+//!
+//! Unlike sender and receiver endpoints, relay endpoint supports both
+//! directions for every protocol, because relay acts as a receiver on
+//! input side and as a sender on output side.
+class RelayEndpoint : public core::NonCopyable<>, private packet::IWriter {
+public:
+    //! Initialize.
+    //!  - @p outbound_address specifies destination address that is assigned to the
+    //!    outgoing packets; if NULL, packets should already have destination address
+    //!  - @p outbound_writer specifies destination writer to which packets are sent;
+    //!    if NULL, endpoint doesn't support outbound packets
+    RelayEndpoint(address::Protocol proto,
+                  StateTracker& state_tracker,
+                  IRelayRouter& router,
+                  const rtp::EncodingMap& encoding_map,
+                  const address::SocketAddr* outbound_address,
+                  packet::IWriter* outbound_writer,
+                  core::IArena& arena);
+
+    //! Deinitialize.
+    //! @remarks
+    //!  Drops packets that were written to inbound writer but not pulled.
+    //!  Inbound writer should not be used anymore at this point.
+    ~RelayEndpoint();
+
+    //! Check if pipeline was succefully constructed.
+    bool is_valid() const;
+
+    //! Get protocol.
+    address::Protocol proto() const;
+
+    //! Get composer for outbound packets.
+    packet::IComposer& outbound_composer();
+
+    //! Get writer for outbound packets.
+    //! @remarks
+    //!  Returns NULL if endpoint was created without outbound writer.
+    packet::IWriter* outbound_writer();
+
+    //! Get writer for inbound packets.
+    //! @remarks
+    //!  Packets passed to this writer will be pulled into pipeline.
+    //!  This writer is thread-safe and lock-free, packets can be written
+    //!  to it from netio thread.
+    packet::IWriter& inbound_writer();
+
+    //! Pull packets written to inbound writer into pipeline.
+    //! @remarks
+    //!  Parses enqueued packets and passes them to router. Packets that can't
+    //!  be parsed or routed are dropped.
+    ROC_ATTR_NODISCARD status::StatusCode pull_packets(core::nanoseconds_t current_time);
+
+private:
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
+
+    const address::Protocol proto_;
+
+    StateTracker& state_tracker_;
+    IRelayRouter& router_;
+
+    // Outbound packets sub-pipeline.
+    packet::IComposer* composer_;
+    core::Optional<rtp::Composer> rtp_composer_;
+    core::ScopedPtr<packet::IComposer> fec_composer_;
+    core::Optional<rtcp::Composer> rtcp_composer_;
+    core::Optional<packet::Shipper> shipper_;
+
+    // Inbound packets sub-pipeline.
+    packet::IParser* parser_;
+    core::Optional<rtp::Parser> rtp_parser_;
+    core::ScopedPtr<packet::IParser> fec_parser_;
+    core::Optional<rtcp::Parser> rtcp_parser_;
+    core::MpscQueue<packet::Packet> inbound_queue_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RELAY_ENDPOINT_H_
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/relay_input.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_pipeline/endpoint_helpers.h"
+
+namespace roc {
+namespace pipeline {
+
+RelayInput::RelayInput(const RelayConfig& config,
+                       StateTracker& state_tracker,
+                       const rtp::EncodingMap& encoding_map,
+                       packet::PacketFactory& packet_factory,
+                       core::IArena& arena)
+    : config_(config)
+    , state_tracker_(state_tracker)
+    , encoding_map_(encoding_map)
+    , packet_factory_(packet_factory)
+    , arena_(arena)
+    , fanout_(arena)
+    , has_source_(false)
+    , source_id_(0)
+    , has_mapping_(false)
+    , mapping_capture_ts_(0)
+    , mapping_stream_ts_(0)
+    , valid_(false) {
+    identity_.reset(new (identity_) rtp::Identity());
+    if (!identity_ || !identity_->is_valid()) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool RelayInput::is_valid() const {
+    return valid_;
+}
+
+RelayEndpoint* RelayInput::add_endpoint(address::Interface iface,
+                                        address::Protocol proto,
+                                        const address::SocketAddr& inbound_address,
+                                        packet::IWriter* outbound_writer) {
+    roc_panic_if(!is_valid());
+
+    roc_log(LogDebug, "relay input: adding %s endpoint %s",
+            address::interface_to_str(iface), address::proto_to_str(proto));
+
+    if (!validate_endpoint(iface, proto)) {
+        return NULL;
+    }
+
+    switch (iface) {
+    case address::Iface_AudioSource:
+        if (repair_endpoint_
+            && !validate_endpoint_pair_consistency(proto, repair_endpoint_->proto())) {
+            return NULL;
+        }
+        return create_endpoint_(source_endpoint_, proto, NULL);
+
+    case address::Iface_AudioRepair:
+        if (source_endpoint_
+            && !validate_endpoint_pair_consistency(source_endpoint_->proto(), proto)) {
+            return NULL;
+        }
+        return create_endpoint_(repair_endpoint_, proto, NULL);
+
+    case address::Iface_AudioControl: {
+        if (!outbound_writer) {
+            roc_log(LogError, "relay input: control endpoint requires outbound writer");
+            return NULL;
+        }
+
+        RelayEndpoint* endpoint =
+            create_endpoint_(control_endpoint_, proto, outbound_writer);
+        if (!endpoint) {
+            return NULL;
+        }
+
+        rtcp_inbound_addr_ = inbound_address;
+
+        rtcp_communicator_.reset(new (rtcp_communicator_) rtcp::Communicator(
+            config_.rtcp, *this, *endpoint->outbound_writer(),
+            endpoint->outbound_composer(), packet_factory_, arena_));
+        if (!rtcp_communicator_ || !rtcp_communicator_->is_valid()) {
+            rtcp_communicator_.reset();
+            return NULL;
+        }
+
+        return endpoint;
+    }
+
+    default:
+        break;
+    }
+
+    roc_log(LogError, "relay input: unsupported interface");
+    return NULL;
+}
+
+bool RelayInput::get_proto(address::Interface iface, address::Protocol& proto) const {
+    roc_panic_if(!is_valid());
+
+    const core::Optional<RelayEndpoint>* endpoint = NULL;
+
+    switch (iface) {
+    case address::Iface_AudioSource:
+        endpoint = &source_endpoint_;
+        break;
+    case address::Iface_AudioRepair:
+        endpoint = &repair_endpoint_;
+        break;
+    case address::Iface_AudioControl:
+        endpoint = &control_endpoint_;
+        break;
+    default:
+        break;
+    }
+
+    if (!endpoint || !*endpoint) {
+        return false;
+    }
+
+    proto = (*endpoint)->proto();
+    return true;
+}
+
+bool RelayInput::add_output(packet::IWriter& writer) {
+    roc_panic_if(!is_valid());
+
+    return fanout_.add_output(writer);
+}
+
+void RelayInput::remove_output(packet::IWriter& writer) {
+    roc_panic_if(!is_valid());
+
+    fanout_.remove_output(writer);
+}
+
+core::nanoseconds_t RelayInput::refresh(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    core::Optional<RelayEndpoint>* endpoints[] = {
+        &source_endpoint_,
+        &repair_endpoint_,
+        &control_endpoint_,
+    };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(endpoints); n++) {
+        if (*endpoints[n]) {
+            const status::StatusCode code =
+                (*endpoints[n])->pull_packets(current_time);
+            // TODO(gh-183): forward status
+            roc_panic_if(code != status::StatusOK);
+        }
+    }
+
+    if (rtcp_communicator_) {
+        // This will invoke IParticipant methods implemented by us,
+        // in particular query_recv_streams().
+        const status::StatusCode code =
+            rtcp_communicator_->generate_reports(current_time);
+        // TODO(gh-183): forward status
+        roc_panic_if(code != status::StatusOK);
+
+        return rtcp_communicator_->generation_deadline(current_time);
+    }
+
+    return 0;
+}
+
+status::StatusCode RelayInput::route_packet(const packet::PacketPtr& packet,
+                                            core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    if (packet->has_flags(packet::Packet::FlagControl)) {
+        if (!rtcp_communicator_) {
+            roc_panic("relay input: rtcp communicator is null");
+        }
+        // This will invoke IParticipant methods implemented by us.
+        return rtcp_communicator_->process_packet(packet, current_time);
+    }
+
+    if (packet->has_flags(packet::Packet::FlagAudio) && packet->rtp()) {
+        return route_source_packet_(packet);
+    }
+
+    return fanout_.write(packet);
+}
+
+rtcp::ParticipantInfo RelayInput::participant_info() {
+    rtcp::ParticipantInfo part_info;
+
+    part_info.cname = identity_->cname();
+    part_info.source_id = identity_->ssrc();
+
+    if (rtcp_inbound_addr_.multicast()) {
+        part_info.report_mode = rtcp::Report_ToAddress;
+        part_info.report_address = rtcp_inbound_addr_;
+    } else {
+        part_info.report_mode = rtcp::Report_Back;
+    }
+
+    return part_info;
+}
+
+void RelayInput::change_source_id() {
+    identity_->change_ssrc();
+}
+
+size_t RelayInput::num_recv_streams() {
+    if (source_meter_ && source_meter_->has_metrics() && source_meter_->has_encoding()) {
+        return 1;
+    }
+
+    return 0;
+}
+
+void RelayInput::query_recv_streams(rtcp::RecvReport* reports,
+                                    size_t n_reports,
+                                    core::nanoseconds_t report_time) {
+    roc_panic_if(!reports);
+
+    if (n_reports == 0 || num_recv_streams() == 0) {
+        return;
+    }
+
+    const packet::LinkMetrics& link_metrics = source_meter_->metrics();
+
+    rtcp::RecvReport& report = *reports;
+
+    report.receiver_cname = identity_->cname();
+    report.receiver_source_id = identity_->ssrc();
+    report.sender_source_id = source_id_;
+    report.report_timestamp = report_time;
+    report.sample_rate = source_meter_->encoding().sample_spec.sample_rate();
+    report.ext_first_seqnum = link_metrics.ext_first_seqnum;
+    report.ext_last_seqnum = link_metrics.ext_last_seqnum;
+    report.packet_count = link_metrics.total_packets;
+    report.cum_loss = link_metrics.lost_packets;
+    report.jitter = link_metrics.jitter;
+}
+
+status::StatusCode
+RelayInput::notify_recv_stream(packet::stream_source_t send_source_id,
+                               const rtcp::SendReport& send_report) {
+    if (!has_source_ || send_source_id != source_id_) {
+        return status::StatusOK;
+    }
+
+    // Remember mapping, to fill capture timestamps of forwarded packets.
+    // Outputs use them to generate their own sender reports.
+    has_mapping_ = true;
+    mapping_capture_ts_ = send_report.report_timestamp;
+    mapping_stream_ts_ = send_report.stream_timestamp;
+
+    if (timestamp_injector_) {
+        timestamp_injector_->update_mapping(mapping_capture_ts_, mapping_stream_ts_);
+    }
+
+    if (source_meter_) {
+        source_meter_->process_report(send_report);
+    }
+
+    return status::StatusOK;
+}
+
+void RelayInput::halt_recv_stream(packet::stream_source_t send_source_id) {
+    if (!has_source_ || send_source_id != source_id_) {
+        return;
+    }
+
+    roc_log(LogDebug, "relay input: upstream sender left: source_id=%lu",
+            (unsigned long)send_source_id);
+
+    has_mapping_ = false;
+}
+
+status::StatusCode RelayInput::route_source_packet_(const packet::PacketPtr& packet) {
+    if (!has_source_ || packet->rtp()->source_id != source_id_) {
+        reset_source_stream_(packet->rtp()->source_id);
+    }
+
+    status::StatusCode code = source_meter_->write(packet);
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    if (!timestamp_injector_ && source_meter_->has_encoding()) {
+        timestamp_injector_.reset(new (timestamp_injector_) rtp::TimestampInjector(
+            source_queue_, source_meter_->encoding().sample_spec));
+        if (!timestamp_injector_) {
+            return status::StatusNoMem;
+        }
+        if (has_mapping_) {
+            timestamp_injector_->update_mapping(mapping_capture_ts_, mapping_stream_ts_);
+        }
+    }
+
+    packet::IReader& reader = timestamp_injector_
+        ? (packet::IReader&)*timestamp_injector_
+        : (packet::IReader&)source_queue_;
+
+    packet::PacketPtr pp;
+    while ((code = reader.read(pp)) == status::StatusOK) {
+        if ((code = fanout_.write(pp)) != status::StatusOK) {
+            return code;
+        }
+    }
+
+    return code == status::StatusNoData ? status::StatusOK : code;
+}
+
+void RelayInput::reset_source_stream_(packet::stream_source_t source_id) {
+    if (has_source_) {
+        roc_log(LogInfo,
+                "relay input: upstream source changed: old_source_id=%lu new_source_id=%lu",
+                (unsigned long)source_id_, (unsigned long)source_id);
+    } else {
+        roc_log(LogInfo, "relay input: got upstream source: source_id=%lu",
+                (unsigned long)source_id);
+    }
+
+    has_source_ = true;
+    source_id_ = source_id;
+
+    has_mapping_ = false;
+    timestamp_injector_.reset();
+
+    source_meter_.reset();
+    source_meter_.reset(new (source_meter_) rtp::LinkMeter(encoding_map_));
+    source_meter_->set_writer(source_queue_);
+}
+
+RelayEndpoint* RelayInput::create_endpoint_(core::Optional<RelayEndpoint>& endpoint,
+                                            address::Protocol proto,
+                                            packet::IWriter* outbound_writer) {
+    if (endpoint) {
+        roc_log(LogError, "relay input: endpoint is already set");
+        return NULL;
+    }
+
+    endpoint.reset(new (endpoint) RelayEndpoint(proto, state_tracker_, *this,
+                                                encoding_map_, NULL, outbound_writer,
+                                                arena_));
+    if (!endpoint || !endpoint->is_valid()) {
+        roc_log(LogError, "relay input: can't create endpoint");
+        endpoint.reset();
+        return NULL;
+    }
+
+    return endpoint.get();
+}
+
+} // namespace pipeline
+} // namespace roc
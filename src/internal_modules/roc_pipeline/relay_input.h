@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/relay_input.h
+//! @brief Relay input.
+
+#ifndef ROC_PIPELINE_RELAY_INPUT_H_
+#define ROC_PIPELINE_RELAY_INPUT_H_
+
+#include "roc_address/interface.h"
+#include "roc_address/protocol.h"
+#include "roc_address/socket_addr.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_packet/fanout.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/irelay_router.h"
+#include "roc_pipeline/relay_endpoint.h"
+#include "roc_pipeline/state_tracker.h"
+#include "roc_rtcp/communicator.h"
+#include "roc_rtcp/iparticipant.h"
+#include "roc_rtp/encoding_map.h"
+#include "roc_rtp/identity.h"
+#include "roc_rtp/link_meter.h"
+#include "roc_rtp/timestamp_injector.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Relay input.
+//!
+//! Contains:
+//!  - endpoints that receive packets from upstream sender
+//!  - link meter and timestamp injector for upstream source stream
+//!  - RTCP communicator that sends receiver reports to upstream sender
+//!  - fanout that passes received packets to all relay outputs
+//!
+//! Packets are not decoded. After parsing, they are passed to outputs
+//! together with their original buffers.
+class RelayInput : public rtcp::IParticipant,
+                   public IRelayRouter,
+                   public core::NonCopyable<> {
+public:
+    //! Initialize.
+    RelayInput(const RelayConfig& config,
+               StateTracker& state_tracker,
+               const rtp::EncodingMap& encoding_map,
+               packet::PacketFactory& packet_factory,
+               core::IArena& arena);
+
+    //! Check if the input was succefully constructed.
+    bool is_valid() const;
+
+    //! Add endpoint.
+    //!  - @p inbound_address specifies address on which packets are received
+    //!  - @p outbound_writer is used to send RTCP reports, required only
+    //!    for control endpoint
+    RelayEndpoint* add_endpoint(address::Interface iface,
+                                address::Protocol proto,
+                                const address::SocketAddr& inbound_address,
+                                packet::IWriter* outbound_writer);
+
+    //! Get protocol of endpoint for given interface.
+    //! @returns
+    //!  false if there is no such endpoint.
+    bool get_proto(address::Interface iface, address::Protocol& proto) const;
+
+    //! Add writer that will receive copies of all inbound transport packets.
+    ROC_ATTR_NODISCARD bool add_output(packet::IWriter& writer);
+
+    //! Remove writer added by add_output().
+    void remove_output(packet::IWriter& writer);
+
+    //! Pull inbound packets, forward them to outputs, and generate reports.
+    //! @returns
+    //!  deadline (absolute time) when refresh should be invoked again
+    //!  to generate reports, or zero if there is no such deadline.
+    core::nanoseconds_t refresh(core::nanoseconds_t current_time);
+
+    //! Route parsed packet.
+    //! Invoked by endpoints.
+    virtual ROC_ATTR_NODISCARD status::StatusCode
+    route_packet(const packet::PacketPtr& packet, core::nanoseconds_t current_time);
+
+private:
+    // Implementation of rtcp::IParticipant interface.
+    // These methods are invoked by rtcp::Communicator.
+    virtual rtcp::ParticipantInfo participant_info();
+    virtual void change_source_id();
+    virtual size_t num_recv_streams();
+    virtual void query_recv_streams(rtcp::RecvReport* reports,
+                                    size_t n_reports,
+                                    core::nanoseconds_t report_time);
+    virtual status::StatusCode notify_recv_stream(packet::stream_source_t send_source_id,
+                                                  const rtcp::SendReport& send_report);
+    virtual void halt_recv_stream(packet::stream_source_t send_source_id);
+
+    status::StatusCode route_source_packet_(const packet::PacketPtr& packet);
+    void reset_source_stream_(packet::stream_source_t source_id);
+
+    RelayEndpoint* create_endpoint_(core::Optional<RelayEndpoint>& endpoint,
+                                    address::Protocol proto,
+                                    packet::IWriter* outbound_writer);
+
+    const RelayConfig config_;
+
+    StateTracker& state_tracker_;
+    const rtp::EncodingMap& encoding_map_;
+    packet::PacketFactory& packet_factory_;
+    core::IArena& arena_;
+
+    core::Optional<rtp::Identity> identity_;
+
+    core::Optional<RelayEndpoint> source_endpoint_;
+    core::Optional<RelayEndpoint> repair_endpoint_;
+    core::Optional<RelayEndpoint> control_endpoint_;
+
+    packet::Fanout fanout_;
+
+    // Upstream source stream.
+    bool has_source_;
+    packet::stream_source_t source_id_;
+    core::Optional<rtp::LinkMeter> source_meter_;
+    packet::Queue source_queue_;
+    core::Optional<rtp::TimestampInjector> timestamp_injector_;
+
+    // Last mapping reported by upstream sender.
+    bool has_mapping_;
+    core::nanoseconds_t mapping_capture_ts_;
+    packet::stream_timestamp_t mapping_stream_ts_;
+
+    core::Optional<rtcp::Communicator> rtcp_communicator_;
+    address::SocketAddr rtcp_inbound_addr_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RELAY_INPUT_H_
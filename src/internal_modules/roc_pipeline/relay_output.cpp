@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/relay_output.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_pipeline/endpoint_helpers.h"
+#include "roc_rtp/headers.h"
+
+namespace roc {
+namespace pipeline {
+
+RelayOutput::RelayOutput(const RelayConfig& config,
+                         StateTracker& state_tracker,
+                         const rtp::EncodingMap& encoding_map,
+                         packet::PacketFactory& packet_factory,
+                         core::IArena& arena)
+    : core::RefCounted<RelayOutput, core::ArenaAllocation>(arena)
+    , config_(config)
+    , state_tracker_(state_tracker)
+    , encoding_map_(encoding_map)
+    , packet_factory_(packet_factory)
+    , encoding_(NULL)
+    , rewrite_headers_(false)
+    , packet_count_(0)
+    , byte_count_(0)
+    , valid_(false) {
+    identity_.reset(new (identity_) rtp::Identity());
+    if (!identity_ || !identity_->is_valid()) {
+        return;
+    }
+
+    router_.reset(new (router_) packet::Router(arena));
+    if (!router_) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool RelayOutput::is_valid() const {
+    return valid_;
+}
+
+RelayEndpoint* RelayOutput::add_endpoint(address::Interface iface,
+                                         address::Protocol proto,
+                                         const address::SocketAddr& outbound_address,
+                                         packet::IWriter& outbound_writer) {
+    roc_panic_if(!is_valid());
+
+    roc_log(LogDebug, "relay output: adding %s endpoint %s",
+            address::interface_to_str(iface), address::proto_to_str(proto));
+
+    if (!validate_endpoint(iface, proto)) {
+        return NULL;
+    }
+
+    switch (iface) {
+    case address::Iface_AudioSource: {
+        if (repair_endpoint_
+            && !validate_endpoint_pair_consistency(proto, repair_endpoint_->proto())) {
+            return NULL;
+        }
+
+        RelayEndpoint* endpoint =
+            create_endpoint_(source_endpoint_, proto, outbound_address, outbound_writer);
+        if (!endpoint) {
+            return NULL;
+        }
+
+        if (!router_->add_route(*endpoint->outbound_writer(),
+                                packet::Packet::FlagAudio)) {
+            return NULL;
+        }
+
+        // Headers of bare RTP packets can be rewritten. With FEC, repair
+        // packets are calculated from source packets including headers.
+        rewrite_headers_ = (proto == address::Proto_RTP);
+
+        return endpoint;
+    }
+
+    case address::Iface_AudioRepair: {
+        if (source_endpoint_
+            && !validate_endpoint_pair_consistency(source_endpoint_->proto(), proto)) {
+            return NULL;
+        }
+
+        RelayEndpoint* endpoint =
+            create_endpoint_(repair_endpoint_, proto, outbound_address, outbound_writer);
+        if (!endpoint) {
+            return NULL;
+        }
+
+        if (!router_->add_route(*endpoint->outbound_writer(),
+                                packet::Packet::FlagRepair)) {
+            return NULL;
+        }
+
+        repair_replicator_.reset(new (repair_replicator_) rtp::Replicator(
+            *router_, NULL, packet_factory_));
+        if (!repair_replicator_ || !repair_replicator_->is_valid()) {
+            return NULL;
+        }
+
+        return endpoint;
+    }
+
+    case address::Iface_AudioControl: {
+        RelayEndpoint* endpoint = create_endpoint_(control_endpoint_, proto,
+                                                   outbound_address, outbound_writer);
+        if (!endpoint) {
+            return NULL;
+        }
+
+        rtcp_outbound_addr_ = outbound_address;
+
+        rtcp_communicator_.reset(new (rtcp_communicator_) rtcp::Communicator(
+            config_.rtcp, *this, *endpoint->outbound_writer(),
+            endpoint->outbound_composer(), packet_factory_, arena()));
+        if (!rtcp_communicator_ || !rtcp_communicator_->is_valid()) {
+            rtcp_communicator_.reset();
+            return NULL;
+        }
+
+        return endpoint;
+    }
+
+    default:
+        break;
+    }
+
+    roc_log(LogError, "relay output: unsupported interface");
+    return NULL;
+}
+
+bool RelayOutput::get_proto(address::Interface iface, address::Protocol& proto) const {
+    roc_panic_if(!is_valid());
+
+    const core::Optional<RelayEndpoint>* endpoint = NULL;
+
+    switch (iface) {
+    case address::Iface_AudioSource:
+        endpoint = &source_endpoint_;
+        break;
+    case address::Iface_AudioRepair:
+        endpoint = &repair_endpoint_;
+        break;
+    case address::Iface_AudioControl:
+        endpoint = &control_endpoint_;
+        break;
+    default:
+        break;
+    }
+
+    if (!endpoint || !*endpoint) {
+        return false;
+    }
+
+    proto = (*endpoint)->proto();
+    return true;
+}
+
+packet::IWriter& RelayOutput::input_writer() {
+    roc_panic_if(!is_valid());
+
+    return *this;
+}
+
+core::nanoseconds_t RelayOutput::refresh(core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    if (control_endpoint_) {
+        const status::StatusCode code = control_endpoint_->pull_packets(current_time);
+        // TODO(gh-183): forward status
+        roc_panic_if(code != status::StatusOK);
+    }
+
+    if (rtcp_communicator_) {
+        // This will invoke IParticipant methods implemented by us,
+        // in particular query_send_stream().
+        const status::StatusCode code =
+            rtcp_communicator_->generate_reports(current_time);
+        // TODO(gh-183): forward status
+        roc_panic_if(code != status::StatusOK);
+
+        return rtcp_communicator_->generation_deadline(current_time);
+    }
+
+    return 0;
+}
+
+void RelayOutput::get_metrics(SenderSlotMetrics& slot_metrics) const {
+    roc_panic_if(!is_valid());
+
+    slot_metrics.source_id = identity_->ssrc();
+    slot_metrics.num_participants =
+        rtcp_communicator_ ? rtcp_communicator_->total_streams() : 0;
+    slot_metrics.is_complete = source_endpoint_;
+}
+
+status::StatusCode RelayOutput::route_packet(const packet::PacketPtr& packet,
+                                             core::nanoseconds_t current_time) {
+    roc_panic_if(!is_valid());
+
+    if (!packet->has_flags(packet::Packet::FlagControl)) {
+        roc_log(LogDebug, "relay output: unexpected non-control packet");
+        return status::StatusOK;
+    }
+
+    if (!rtcp_communicator_) {
+        roc_panic("relay output: rtcp communicator is null");
+    }
+
+    // This will invoke IParticipant methods implemented by us.
+    return rtcp_communicator_->process_packet(packet, current_time);
+}
+
+// Implementation of input_writer().write()
+status::StatusCode RelayOutput::write(const packet::PacketPtr& packet) {
+    roc_panic_if(!is_valid());
+
+    if (packet->has_flags(packet::Packet::FlagAudio)) {
+        if (!source_endpoint_) {
+            return status::StatusOK;
+        }
+        return write_source_packet_(packet);
+    }
+
+    if (packet->has_flags(packet::Packet::FlagRepair)) {
+        if (!repair_replicator_) {
+            return status::StatusOK;
+        }
+        return repair_replicator_->write(packet);
+    }
+
+    return status::StatusOK;
+}
+
+rtcp::ParticipantInfo RelayOutput::participant_info() {
+    rtcp::ParticipantInfo part_info;
+
+    part_info.cname = identity_->cname();
+    part_info.source_id = identity_->ssrc();
+    part_info.report_mode = rtcp::Report_ToAddress;
+    part_info.report_address = rtcp_outbound_addr_;
+
+    return part_info;
+}
+
+void RelayOutput::change_source_id() {
+    identity_->change_ssrc();
+}
+
+bool RelayOutput::has_send_stream() {
+    // When packets are forwarded as is, they keep upstream SSRC, and there is
+    // no stream with our SSRC to report about.
+    if (!rewrite_headers_) {
+        return false;
+    }
+
+    return timestamp_extractor_ && timestamp_extractor_->has_mapping();
+}
+
+rtcp::SendReport RelayOutput::query_send_stream(core::nanoseconds_t report_time) {
+    roc_panic_if(!has_send_stream());
+
+    rtcp::SendReport report;
+    report.sender_cname = identity_->cname();
+    report.sender_source_id = identity_->ssrc();
+    report.report_timestamp = report_time;
+    report.stream_timestamp = timestamp_extractor_->get_mapping(report_time);
+    report.sample_rate = encoding_->sample_spec.sample_rate();
+    report.packet_count = packet_count_;
+    report.byte_count = byte_count_;
+
+    return report;
+}
+
+status::StatusCode RelayOutput::write_source_packet_(const packet::PacketPtr& packet) {
+    if (!packet->rtp()) {
+        return status::StatusOK;
+    }
+
+    if (!encoding_ || encoding_->payload_type != packet->rtp()->payload_type) {
+        const rtp::Encoding* encoding =
+            encoding_map_.find_by_pt(packet->rtp()->payload_type);
+        if (!encoding) {
+            roc_log(LogDebug, "relay output: dropping packet with unknown payload type");
+            return status::StatusOK;
+        }
+
+        if (encoding_ && encoding_->sample_spec != encoding->sample_spec) {
+            roc_log(LogDebug, "relay output: dropping packet with changed encoding");
+            return status::StatusOK;
+        }
+
+        encoding_ = encoding;
+    }
+
+    if (!source_replicator_) {
+        timestamp_extractor_.reset(new (timestamp_extractor_) rtp::TimestampExtractor(
+            *router_, encoding_->sample_spec));
+        if (!timestamp_extractor_) {
+            return status::StatusNoMem;
+        }
+
+        source_replicator_.reset(new (source_replicator_) rtp::Replicator(
+            *timestamp_extractor_, rewrite_headers_ ? identity_.get() : NULL,
+            packet_factory_));
+        if (!source_replicator_ || !source_replicator_->is_valid()) {
+            source_replicator_.reset();
+            return status::StatusNoMem;
+        }
+    }
+
+    if (rewrite_headers_ && packet->rtp()->header.size() != sizeof(rtp::Header)) {
+        // Composer can't rewrite headers with extensions or CSRCs.
+        roc_log(LogDebug, "relay output: dropping packet with unsupported rtp header");
+        return status::StatusOK;
+    }
+
+    const size_t payload_size = packet->rtp()->payload.size();
+
+    const status::StatusCode code = source_replicator_->write(packet);
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    // Count only packets that were actually sent, since counters are
+    // reported to receivers in RTCP sender reports.
+    packet_count_++;
+    byte_count_ += payload_size;
+
+    return status::StatusOK;
+}
+
+RelayEndpoint* RelayOutput::create_endpoint_(core::Optional<RelayEndpoint>& endpoint,
+                                             address::Protocol proto,
+                                             const address::SocketAddr& outbound_address,
+                                             packet::IWriter& outbound_writer) {
+    if (endpoint) {
+        roc_log(LogError, "relay output: endpoint is already set");
+        return NULL;
+    }
+
+    endpoint.reset(new (endpoint) RelayEndpoint(proto, state_tracker_, *this,
+                                                encoding_map_, &outbound_address,
+                                                &outbound_writer, arena()));
+    if (!endpoint || !endpoint->is_valid()) {
+        roc_log(LogError, "relay output: can't create endpoint");
+        endpoint.reset();
+        return NULL;
+    }
+
+    return endpoint.get();
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/relay_output.h
+//! @brief Relay output.
+
+#ifndef ROC_PIPELINE_RELAY_OUTPUT_H_
+#define ROC_PIPELINE_RELAY_OUTPUT_H_
+
+#include "roc_address/interface.h"
+#include "roc_address/protocol.h"
+#include "roc_address/socket_addr.h"
+#include "roc_core/iarena.h"
+#include "roc_core/list_node.h"
+#include "roc_core/optional.h"
+#include "roc_core/ref_counted.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/router.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/irelay_router.h"
+#include "roc_pipeline/metrics.h"
+#include "roc_pipeline/relay_endpoint.h"
+#include "roc_pipeline/state_tracker.h"
+#include "roc_rtcp/communicator.h"
+#include "roc_rtcp/iparticipant.h"
+#include "roc_rtp/encoding_map.h"
+#include "roc_rtp/identity.h"
+#include "roc_rtp/replicator.h"
+#include "roc_rtp/timestamp_extractor.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Relay output.
+//!
+//! Contains:
+//!  - endpoints that send packets to one downstream receiver
+//!  - replicators that copy packets received by relay input
+//!  - RTCP communicator that sends sender reports to downstream receiver
+//!
+//! If source endpoint uses bare RTP, every output gets independent RTP
+//! stream: SSRC is replaced with output's own SSRC, and seqnum and timestamp
+//! are shifted by random offsets. If FEC is used, packets are forwarded as
+//! is, because repair packets cover RTP headers of source packets.
+//!
+//! In RTCP, output always uses its own identity (SSRC and CNAME). When packets
+//! are forwarded as is, output doesn't send sender reports, because the stream
+//! doesn't belong to it.
+class RelayOutput : public core::RefCounted<RelayOutput, core::ArenaAllocation>,
+                    public core::ListNode<>,
+                    public rtcp::IParticipant,
+                    public IRelayRouter,
+                    private packet::IWriter {
+public:
+    //! Initialize.
+    RelayOutput(const RelayConfig& config,
+                StateTracker& state_tracker,
+                const rtp::EncodingMap& encoding_map,
+                packet::PacketFactory& packet_factory,
+                core::IArena& arena);
+
+    //! Check if the output was succefully constructed.
+    bool is_valid() const;
+
+    //! Add endpoint.
+    RelayEndpoint* add_endpoint(address::Interface iface,
+                                address::Protocol proto,
+                                const address::SocketAddr& outbound_address,
+                                packet::IWriter& outbound_writer);
+
+    //! Get protocol of endpoint for given interface.
+    //! @returns
+    //!  false if there is no such endpoint.
+    bool get_proto(address::Interface iface, address::Protocol& proto) const;
+
+    //! Get writer for packets received by relay input.
+    //! @remarks
+    //!  Packets are copied and sent to endpoints of the output.
+    packet::IWriter& input_writer();
+
+    //! Pull inbound control packets and generate reports.
+    //! @returns
+    //!  deadline (absolute time) when refresh should be invoked again
+    //!  to generate reports, or zero if there is no such deadline.
+    core::nanoseconds_t refresh(core::nanoseconds_t current_time);
+
+    //! Get metrics.
+    void get_metrics(SenderSlotMetrics& slot_metrics) const;
+
+    //! Route parsed packet.
+    //! Invoked by endpoints.
+    virtual ROC_ATTR_NODISCARD status::StatusCode
+    route_packet(const packet::PacketPtr& packet, core::nanoseconds_t current_time);
+
+private:
+    // Implementation of input_writer().write()
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
+
+    // Implementation of rtcp::IParticipant interface.
+    // These methods are invoked by rtcp::Communicator.
+    virtual rtcp::ParticipantInfo participant_info();
+    virtual void change_source_id();
+    virtual bool has_send_stream();
+    virtual rtcp::SendReport query_send_stream(core::nanoseconds_t report_time);
+
+    status::StatusCode write_source_packet_(const packet::PacketPtr& packet);
+
+    RelayEndpoint* create_endpoint_(core::Optional<RelayEndpoint>& endpoint,
+                                    address::Protocol proto,
+                                    const address::SocketAddr& outbound_address,
+                                    packet::IWriter& outbound_writer);
+
+    const RelayConfig config_;
+
+    StateTracker& state_tracker_;
+    const rtp::EncodingMap& encoding_map_;
+    packet::PacketFactory& packet_factory_;
+
+    core::Optional<rtp::Identity> identity_;
+
+    core::Optional<RelayEndpoint> source_endpoint_;
+    core::Optional<RelayEndpoint> repair_endpoint_;
+    core::Optional<RelayEndpoint> control_endpoint_;
+
+    core::Optional<packet::Router> router_;
+
+    // Source packets sub-pipeline, created when first packet arrives,
+    // because encoding is not known in advance.
+    const rtp::Encoding* encoding_;
+    core::Optional<rtp::TimestampExtractor> timestamp_extractor_;
+    core::Optional<rtp::Replicator> source_replicator_;
+    bool rewrite_headers_;
+
+    // Repair packets sub-pipeline.
+    core::Optional<rtp::Replicator> repair_replicator_;
+
+    // Statistics for sender reports.
+    uint64_t packet_count_;
+    uint64_t byte_count_;
+
+    core::Optional<rtcp::Communicator> rtcp_communicator_;
+    address::SocketAddr rtcp_outbound_addr_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_RELAY_OUTPUT_H_
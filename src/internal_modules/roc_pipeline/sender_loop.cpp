@@ -8,6 +8,7 @@
 
 #include "roc_pipeline/sender_loop.h"
 #include "roc_audio/resampler_map.h"
+#include "roc_core/fast_clock.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/thread.h"
@@ -110,8 +111,18 @@ SenderLoop::SenderLoop(IPipelineTaskScheduler& scheduler,
     }
 
     if (sink_config.enable_timing) {
-        ticker_.reset(new (ticker_)
-                          core::Ticker(sink_config.input_sample_spec.sample_rate()));
+        core::TickerConfig ticker_config;
+        ticker_config.enable_spinning = sink_config.enable_precise_timing;
+        if (sink_config.precise_timing_margin > 0) {
+            ticker_config.max_spin_margin = sink_config.precise_timing_margin;
+            ticker_config.spin_margin =
+                std::min(ticker_config.spin_margin, ticker_config.max_spin_margin);
+            ticker_config.min_spin_margin =
+                std::min(ticker_config.min_spin_margin, ticker_config.max_spin_margin);
+        }
+
+        ticker_.reset(new (ticker_) core::Ticker(
+            sink_config.input_sample_spec.sample_rate(), ticker_config));
         if (!ticker_) {
             return;
         }
@@ -130,6 +141,19 @@ sndio::ISink& SenderLoop::sink() {
     return *this;
 }
 
+bool SenderLoop::read_slot_metrics(SlotHandle slot,
+                                   SenderSlotMetrics& slot_metrics,
+                                   SenderParticipantMetrics* party_metrics,
+                                   size_t* party_count) const {
+    roc_panic_if(!is_valid());
+
+    if (!slot) {
+        roc_panic("sender loop: slot handle is null");
+    }
+
+    return ((SenderSlot*)slot)->read_metrics(slot_metrics, party_metrics, party_count);
+}
+
 sndio::ISink* SenderLoop::to_sink() {
     roc_panic_if(!is_valid());
 
@@ -239,13 +263,19 @@ void SenderLoop::write(audio::Frame& frame) {
     }
 
     // invokes process_subframe_imp() and process_task_imp()
-    if (!process_subframes_and_tasks(frame)) {
+    const bool success = process_subframes_and_tasks(frame);
+
+    // Publish once per frame rather than per sub-frame, because collecting
+    // metrics of all sessions isn't free.
+    sink_.publish_metrics();
+
+    if (!success) {
         return;
     }
 }
 
 core::nanoseconds_t SenderLoop::timestamp_imp() const {
-    return core::timestamp(core::ClockMonotonic);
+    return core::fast_timestamp();
 }
 
 uint64_t SenderLoop::tid_imp() const {
@@ -265,7 +295,13 @@ bool SenderLoop::process_task_imp(PipelineTask& basic_task) {
     Task& task = (Task&)basic_task;
 
     roc_panic_if_not(task.func_);
-    return (this->*(task.func_))(task);
+    const bool success = (this->*(task.func_))(task);
+
+    // Task may change slots configuration, make it visible to
+    // read_slot_metrics() without waiting for next frame.
+    sink_.publish_metrics();
+
+    return success;
 }
 
 bool SenderLoop::task_create_slot_(Task& task) {
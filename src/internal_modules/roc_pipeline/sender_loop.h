@@ -136,6 +136,19 @@ public:
     //!  Samples written to the sink are sent to remote peers.
     sndio::ISink& sink();
 
+    //! Get metrics of slot without waiting for pipeline.
+    //! @remarks
+    //!  Returns metrics published by pipeline after last processed frame or
+    //!  task. Unlike QuerySlot task, can be called from any thread and never
+    //!  blocks on pipeline. The slot should not be deleted concurrently.
+    //! @returns
+    //!  false if snapshot doesn't contain all requested participants; in this
+    //!  case, QuerySlot task can be used to get full metrics.
+    bool read_slot_metrics(SlotHandle slot,
+                           SenderSlotMetrics& slot_metrics,
+                           SenderParticipantMetrics* party_metrics,
+                           size_t* party_count) const;
+
 private:
     // Methods of sndio::ISink
     virtual sndio::ISink* to_sink();
@@ -11,6 +11,7 @@
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_fec/codec_map.h"
+#include "roc_status/code_to_str.h"
 
 namespace roc {
 namespace pipeline {
@@ -25,16 +26,28 @@ SenderSession::SenderSession(const SenderSinkConfig& sink_config,
     , encoding_map_(encoding_map)
     , packet_factory_(packet_factory)
     , frame_factory_(frame_factory)
+    , fec_loss_source_(0)
+    , has_fec_loss_source_(false)
+    , encoder_session_(NULL)
+    , stream_identity_(NULL)
+    , stream_ts_extractor_(NULL)
     , frame_writer_(NULL)
     , valid_(false) {
     identity_.reset(new (identity_) rtp::Identity());
     if (!identity_ || !identity_->is_valid()) {
         return;
     }
+    stream_identity_ = identity_.get();
 
     valid_ = true;
 }
 
+SenderSession::~SenderSession() {
+    if (encoder_session_ && replicator_) {
+        encoder_session_->packet_fanout_->remove_output(*replicator_);
+    }
+}
+
 bool SenderSession::is_valid() const {
     return valid_;
 }
@@ -44,7 +57,7 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
     roc_panic_if(!is_valid());
 
     roc_panic_if(!source_endpoint);
-    roc_panic_if(frame_writer_);
+    roc_panic_if(frame_writer_ || encoder_session_);
 
     const rtp::Encoding* pkt_encoding =
         encoding_map_.find_by_pt(sink_config_.payload_type);
@@ -63,6 +76,15 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
     }
     pkt_writer = router_.get();
 
+    if (sink_config_.enable_shared_encoding) {
+        // Other sessions may attach to fanout to receive copies of packets.
+        packet_fanout_.reset(new (packet_fanout_) packet::Fanout(arena_));
+        if (!packet_fanout_ || !packet_fanout_->add_output(*router_)) {
+            return false;
+        }
+        pkt_writer = packet_fanout_.get();
+    }
+
     if (!router_->add_route(source_endpoint->outbound_writer(),
                             packet::Packet::FlagAudio)) {
         return false;
@@ -100,6 +122,34 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return false;
         }
         pkt_writer = fec_writer_.get();
+
+        if (sink_config_.enable_stage_timing) {
+            fec_writer_timing_.reset(new (fec_writer_timing_)
+                                         packet::TimingWriter(*pkt_writer, stage_timer_));
+            pkt_writer = fec_writer_timing_.get();
+        }
+
+        if (sink_config_.fec_tuner.enable_tuning) {
+            fec::BlockTunerConfig tuner_config = sink_config_.fec_tuner;
+
+            // Don't let tuner exceed maximum block length supported by codec.
+            const size_t max_blen = fec_encoder_->max_block_length();
+            if (sink_config_.fec_writer.n_source_packets < max_blen) {
+                tuner_config.max_repair_packets =
+                    std::min(tuner_config.max_repair_packets,
+                             max_blen - sink_config_.fec_writer.n_source_packets);
+            }
+
+            fec_tuner_.reset(new (fec_tuner_)
+                                 fec::BlockTuner(tuner_config, sink_config_.fec_writer));
+            if (!fec_tuner_ || !fec_tuner_->is_valid()) {
+                return false;
+            }
+            if (!fec_writer_->resize(fec_tuner_->n_source_packets(),
+                                     fec_tuner_->n_repair_packets())) {
+                return false;
+            }
+        }
     }
 
     timestamp_extractor_.reset(new (timestamp_extractor_) rtp::TimestampExtractor(
@@ -108,6 +158,7 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
         return false;
     }
     pkt_writer = timestamp_extractor_.get();
+    stream_ts_extractor_ = timestamp_extractor_.get();
 
     payload_encoder_.reset(pkt_encoding->new_encoder(arena_, pkt_encoding->sample_spec),
                            arena_);
@@ -138,6 +189,12 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return false;
         }
         frm_writer = packetizer_.get();
+
+        if (sink_config_.enable_stage_timing) {
+            packetizer_timing_.reset(new (packetizer_timing_)
+                                         audio::TimingWriter(*frm_writer, stage_timer_));
+            frm_writer = packetizer_timing_.get();
+        }
     }
 
     if (pkt_encoding->sample_spec.channel_set()
@@ -157,6 +214,12 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return false;
         }
         frm_writer = channel_mapper_writer_.get();
+
+        if (sink_config_.enable_stage_timing) {
+            channel_mapper_timing_.reset(new (channel_mapper_timing_) audio::TimingWriter(
+                *frm_writer, stage_timer_));
+            frm_writer = channel_mapper_timing_.get();
+        }
     }
 
     if (sink_config_.latency.tuner_profile != audio::LatencyTunerProfile_Intact
@@ -184,6 +247,12 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return false;
         }
         frm_writer = resampler_writer_.get();
+
+        if (sink_config_.enable_stage_timing) {
+            resampler_timing_.reset(new (resampler_timing_)
+                                        audio::TimingWriter(*frm_writer, stage_timer_));
+            frm_writer = resampler_timing_.get();
+        }
     }
 
     feedback_monitor_.reset(new (feedback_monitor_) audio::FeedbackMonitor(
@@ -206,6 +275,106 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
     return true;
 }
 
+bool SenderSession::create_shared_transport_pipeline(SenderSession& encoder_session,
+                                                     SenderEndpoint* source_endpoint,
+                                                     SenderEndpoint* repair_endpoint) {
+    roc_panic_if(!is_valid());
+
+    roc_panic_if(!source_endpoint);
+    roc_panic_if(frame_writer_ || encoder_session_);
+    roc_panic_if(!encoder_session.can_share_encoding());
+
+    const rtp::Encoding* pkt_encoding =
+        encoding_map_.find_by_pt(sink_config_.payload_type);
+    if (!pkt_encoding) {
+        return false;
+    }
+
+    // Pipeline: chained packet writers from replicator to endpoint.
+    // Encoder session writes packets to replicator, and it the end they
+    // are written into endpoint outbound writers.
+    packet::IWriter* pkt_writer = NULL;
+
+    router_.reset(new (router_) packet::Router(arena_));
+    if (!router_) {
+        return false;
+    }
+    pkt_writer = router_.get();
+
+    if (!router_->add_route(source_endpoint->outbound_writer(),
+                            packet::Packet::FlagAudio)) {
+        return false;
+    }
+
+    if (repair_endpoint) {
+        if (!router_->add_route(repair_endpoint->outbound_writer(),
+                                packet::Packet::FlagRepair)) {
+            return false;
+        }
+
+        // Repair packets are computed from source packets including their
+        // RTP headers, so we can't rewrite headers and send same stream.
+        stream_identity_ = encoder_session.stream_identity_;
+        stream_ts_extractor_ = encoder_session.stream_ts_extractor_;
+
+        replicator_.reset(new (replicator_)
+                              rtp::Replicator(*pkt_writer, NULL, packet_factory_));
+    } else {
+        timestamp_extractor_.reset(new (timestamp_extractor_) rtp::TimestampExtractor(
+            *pkt_writer, pkt_encoding->sample_spec));
+        if (!timestamp_extractor_) {
+            return false;
+        }
+        pkt_writer = timestamp_extractor_.get();
+        stream_ts_extractor_ = timestamp_extractor_.get();
+
+        replicator_.reset(new (replicator_) rtp::Replicator(
+            *pkt_writer, identity_.get(), packet_factory_));
+    }
+
+    if (!replicator_ || !replicator_->is_valid()) {
+        return false;
+    }
+
+    if (!encoder_session.packet_fanout_->add_output(*replicator_)) {
+        return false;
+    }
+
+    encoder_session_ = &encoder_session;
+
+    return true;
+}
+
+bool SenderSession::can_share_encoding() const {
+    roc_panic_if(!is_valid());
+
+    return frame_writer_ && packet_fanout_;
+}
+
+void SenderSession::stop_shipping() {
+    roc_panic_if(!is_valid());
+
+    if (packet_fanout_ && router_ && packet_fanout_->has_output(*router_)) {
+        packet_fanout_->remove_output(*router_);
+    }
+
+    if (rtcp_communicator_) {
+        if (has_send_stream()) {
+            // Session won't be refreshed anymore, even if it continues encoding
+            // for other sessions, so tell receivers that stream is finished
+            // instead of letting them wait for report timeout.
+            const status::StatusCode code =
+                rtcp_communicator_->generate_goodbye(core::timestamp(core::ClockUnix));
+            if (code != status::StatusOK) {
+                roc_log(LogDebug, "sender session: can't send goodbye: status=%s",
+                        status::code_to_str(code));
+            }
+        }
+
+        rtcp_communicator_.reset();
+    }
+}
+
 bool SenderSession::create_control_pipeline(SenderEndpoint* control_endpoint) {
     roc_panic_if(!is_valid());
 
@@ -261,13 +430,35 @@ core::nanoseconds_t SenderSession::refresh(core::nanoseconds_t current_time) {
     return 0;
 }
 
+void SenderSession::update_timing_metrics() {
+    roc_panic_if(!is_valid());
+
+    if (resampler_timing_) {
+        resampler_timing_metrics_ = resampler_timing_->histogram().metrics();
+    }
+    if (channel_mapper_timing_) {
+        channel_mapper_timing_metrics_ = channel_mapper_timing_->histogram().metrics();
+    }
+    if (packetizer_timing_) {
+        packetizer_timing_metrics_ = packetizer_timing_->histogram().metrics();
+    }
+    if (fec_writer_timing_) {
+        fec_writer_timing_metrics_ = fec_writer_timing_->histogram().metrics();
+    }
+}
+
 void SenderSession::get_slot_metrics(SenderSlotMetrics& slot_metrics) const {
     roc_panic_if(!is_valid());
 
-    slot_metrics.source_id = identity_->ssrc();
+    slot_metrics.source_id = stream_identity_->ssrc();
     slot_metrics.num_participants =
         feedback_monitor_ ? feedback_monitor_->num_participants() : 0;
-    slot_metrics.is_complete = (frame_writer_ != NULL);
+    slot_metrics.is_complete = (frame_writer_ != NULL || encoder_session_ != NULL);
+
+    slot_metrics.resampler_timing = resampler_timing_metrics_;
+    slot_metrics.channel_mapper_timing = channel_mapper_timing_metrics_;
+    slot_metrics.packetizer_timing = packetizer_timing_metrics_;
+    slot_metrics.fec_writer_timing = fec_writer_timing_metrics_;
 }
 
 void SenderSession::get_participant_metrics(SenderParticipantMetrics* party_metrics,
@@ -290,8 +481,8 @@ void SenderSession::get_participant_metrics(SenderParticipantMetrics* party_metr
 rtcp::ParticipantInfo SenderSession::participant_info() {
     rtcp::ParticipantInfo part_info;
 
-    part_info.cname = identity_->cname();
-    part_info.source_id = identity_->ssrc();
+    part_info.cname = stream_identity_->cname();
+    part_info.source_id = stream_identity_->ssrc();
     part_info.report_mode = rtcp::Report_ToAddress;
     part_info.report_address = rtcp_outbound_addr_;
 
@@ -299,24 +490,36 @@ rtcp::ParticipantInfo SenderSession::participant_info() {
 }
 
 void SenderSession::change_source_id() {
-    identity_->change_ssrc();
+    if (stream_identity_ != identity_.get()) {
+        // Stream identity belongs to encoder session, and changing it would
+        // change SSRC of packets shipped by encoder session and all sessions
+        // sharing encoding with it. Collision is resolved by encoder session
+        // if it's detected there.
+        roc_log(LogDebug,
+                "sender session: ignoring ssrc collision for shared stream: ssrc=%lu",
+                (unsigned long)stream_identity_->ssrc());
+        return;
+    }
+
+    stream_identity_->change_ssrc();
 }
 
 bool SenderSession::has_send_stream() {
-    return timestamp_extractor_ && timestamp_extractor_->has_mapping();
+    return stream_ts_extractor_ && stream_ts_extractor_->has_mapping();
 }
 
 rtcp::SendReport SenderSession::query_send_stream(core::nanoseconds_t report_time) {
     roc_panic_if(!has_send_stream());
 
-    const audio::PacketizerMetrics& packet_metrics = packetizer_->metrics();
+    const audio::Packetizer& packetizer = packetizer_for_reports_();
+    const audio::PacketizerMetrics& packet_metrics = packetizer.metrics();
 
     rtcp::SendReport report;
-    report.sender_cname = identity_->cname();
-    report.sender_source_id = identity_->ssrc();
+    report.sender_cname = stream_identity_->cname();
+    report.sender_source_id = stream_identity_->ssrc();
     report.report_timestamp = report_time;
-    report.stream_timestamp = timestamp_extractor_->get_mapping(report_time);
-    report.sample_rate = packetizer_->sample_rate();
+    report.stream_timestamp = stream_ts_extractor_->get_mapping(report_time);
+    report.sample_rate = packetizer.sample_rate();
     report.packet_count = packet_metrics.packet_count;
     report.byte_count = packet_metrics.payload_count;
 
@@ -342,13 +545,24 @@ SenderSession::notify_send_stream(packet::stream_source_t recv_source_id,
         link_metrics.jitter = recv_report.jitter;
         link_metrics.rtt = recv_report.rtt;
 
-        feedback_monitor_->process_feedback(recv_source_id, latency_metrics,
-                                            link_metrics);
+        if (feedback_monitor_->process_feedback(recv_source_id, latency_metrics,
+                                                link_metrics)) {
+            update_fec_tuner_(recv_source_id);
+        }
     }
 
     return status::StatusOK;
 }
 
+const audio::Packetizer& SenderSession::packetizer_for_reports_() const {
+    // When encoding is shared, packets are produced by encoder session.
+    if (encoder_session_) {
+        return *encoder_session_->packetizer_;
+    }
+
+    return *packetizer_;
+}
+
 void SenderSession::start_feedback_monitor_() {
     if (!feedback_monitor_) {
         // Transport endpoint not created yet.
@@ -374,6 +588,47 @@ void SenderSession::start_feedback_monitor_() {
     feedback_monitor_->start();
 }
 
+void SenderSession::update_fec_tuner_(packet::stream_source_t recv_source_id) {
+    if (!fec_tuner_) {
+        // Adaptive FEC disabled.
+        return;
+    }
+
+    if (feedback_monitor_->num_participants() == 0) {
+        return;
+    }
+
+    if (!has_fec_loss_source_ || fec_loss_source_ != recv_source_id) {
+        // Counters of different receivers are unrelated.
+        fec_loss_estimator_.reset();
+        fec_loss_source_ = recv_source_id;
+        has_fec_loss_source_ = true;
+    }
+
+    // Use metrics from feedback monitor instead of raw report, because
+    // it substitutes packet counter if receiver doesn't report it.
+    const packet::LinkMetrics& link_metrics = feedback_monitor_->link_metrics(0);
+
+    if (!fec_loss_estimator_.has_new_packets(link_metrics.total_packets)) {
+        // No packets since previous report, so there is nothing to estimate,
+        // and zero loss would be a false clean sample for tuner.
+        return;
+    }
+
+    const float fract_loss =
+        fec_loss_estimator_.update(link_metrics.total_packets, link_metrics.lost_packets);
+
+    if (!fec_tuner_->update(fract_loss, core::timestamp(core::ClockMonotonic))) {
+        return;
+    }
+
+    // New size is applied by writer starting from next block.
+    if (!fec_writer_->resize(fec_tuner_->n_source_packets(),
+                             fec_tuner_->n_repair_packets())) {
+        roc_log(LogDebug, "sender session: can't apply fec block size from tuner");
+    }
+}
+
 status::StatusCode
 SenderSession::route_control_packet_(const packet::PacketPtr& packet,
                                      core::nanoseconds_t current_time) {
@@ -20,23 +20,30 @@
 #include "roc_audio/iresampler.h"
 #include "roc_audio/packetizer.h"
 #include "roc_audio/resampler_writer.h"
+#include "roc_audio/timing_writer.h"
 #include "roc_core/iarena.h"
+#include "roc_core/nested_timer.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/iblock_encoder.h"
 #include "roc_fec/writer.h"
+#include "roc_packet/fanout.h"
 #include "roc_packet/interleaver.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/router.h"
+#include "roc_packet/timing_writer.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/metrics.h"
 #include "roc_pipeline/sender_endpoint.h"
 #include "roc_rtcp/communicator.h"
 #include "roc_rtcp/composer.h"
 #include "roc_rtcp/iparticipant.h"
+#include "roc_rtcp/loss_estimator.h"
 #include "roc_rtp/encoding_map.h"
 #include "roc_rtp/identity.h"
+#include "roc_rtp/replicator.h"
 #include "roc_rtp/sequencer.h"
 #include "roc_rtp/timestamp_extractor.h"
 #include "roc_status/status_code.h"
@@ -58,6 +65,8 @@ public:
                   audio::FrameFactory& frame_factory,
                   core::IArena& arena);
 
+    ~SenderSession();
+
     //! Check if the session was succefully constructed.
     bool is_valid() const;
 
@@ -65,6 +74,35 @@ public:
     bool create_transport_pipeline(SenderEndpoint* source_endpoint,
                                    SenderEndpoint* repair_endpoint);
 
+    //! Create transport sub-pipeline that shares encoding with another session.
+    //! @remarks
+    //!  Instead of packetizing and encoding audio itself, session receives
+    //!  copies of packets produced by @p encoder_session and ships them to
+    //!  its own endpoints. Such session doesn't have frame writer.
+    //!  If FEC is disabled, RTP stream identifiers (SSRC, seqnum and timestamp
+    //!  bases) are rewritten for this session. Otherwise, packets are sent as is,
+    //!  because repair packets cover RTP headers, and session reports same
+    //!  stream identifiers as @p encoder_session.
+    //! @pre
+    //!  @p encoder_session should outlive this session and should return true
+    //!  from can_share_encoding().
+    bool create_shared_transport_pipeline(SenderSession& encoder_session,
+                                          SenderEndpoint* source_endpoint,
+                                          SenderEndpoint* repair_endpoint);
+
+    //! Check if other sessions can share encoding with this session.
+    //! @remarks
+    //!  True if shared encoding is enabled in config and the session has its
+    //!  own complete transport sub-pipeline.
+    bool can_share_encoding() const;
+
+    //! Stop shipping packets to own endpoints.
+    //! @remarks
+    //!  Sends RTCP goodbye to own control endpoint and stops RTCP exchange.
+    //!  Packets are still produced and passed to sessions that share
+    //!  encoding with this session.
+    void stop_shipping();
+
     //! Create control sub-pipeline.
     bool create_control_pipeline(SenderEndpoint* control_endpoint);
 
@@ -89,10 +127,17 @@ public:
     //!  if there are no frames
     core::nanoseconds_t refresh(core::nanoseconds_t current_time);
 
+    //! Recompute stage timing metrics.
+    //! @remarks
+    //!  Stage timing metrics returned by get_slot_metrics() are computed from
+    //!  histograms only by this method, because it's relatively expensive.
+    void update_timing_metrics();
+
     //! Get slot metrics.
     //! @remarks
     //!  These metrics are for the whole slot.
     //!  For metrics for specific participant, see get_participant_metrics().
+    //!  Stage timing metrics are from last update_timing_metrics() call.
     void get_slot_metrics(SenderSlotMetrics& slot_metrics) const;
 
     //! Get metrics for remote participants.
@@ -118,7 +163,10 @@ private:
     virtual status::StatusCode notify_send_stream(packet::stream_source_t recv_source_id,
                                                   const rtcp::RecvReport& recv_report);
 
+    const audio::Packetizer& packetizer_for_reports_() const;
+
     void start_feedback_monitor_();
+    void update_fec_tuner_(packet::stream_source_t recv_source_id);
 
     status::StatusCode route_control_packet_(const packet::PacketPtr& packet,
                                              core::nanoseconds_t current_time);
@@ -136,11 +184,16 @@ private:
     core::Optional<rtp::Sequencer> sequencer_;
 
     core::Optional<packet::Router> router_;
+    core::Optional<packet::Fanout> packet_fanout_;
 
     core::Optional<packet::Interleaver> interleaver_;
 
     core::ScopedPtr<fec::IBlockEncoder> fec_encoder_;
     core::Optional<fec::Writer> fec_writer_;
+    core::Optional<fec::BlockTuner> fec_tuner_;
+    rtcp::LossEstimator fec_loss_estimator_;
+    packet::stream_source_t fec_loss_source_;
+    bool has_fec_loss_source_;
 
     core::Optional<rtp::TimestampExtractor> timestamp_extractor_;
 
@@ -154,9 +207,30 @@ private:
 
     core::Optional<audio::FeedbackMonitor> feedback_monitor_;
 
+    core::NestedTimer stage_timer_;
+    core::Optional<audio::TimingWriter> resampler_timing_;
+    core::Optional<audio::TimingWriter> channel_mapper_timing_;
+    core::Optional<audio::TimingWriter> packetizer_timing_;
+    core::Optional<packet::TimingWriter> fec_writer_timing_;
+
+    core::DurationMetrics resampler_timing_metrics_;
+    core::DurationMetrics channel_mapper_timing_metrics_;
+    core::DurationMetrics packetizer_timing_metrics_;
+    core::DurationMetrics fec_writer_timing_metrics_;
+
     core::Optional<rtcp::Communicator> rtcp_communicator_;
     address::SocketAddr rtcp_outbound_addr_;
 
+    // Set if this session uses packets produced by another session.
+    SenderSession* encoder_session_;
+    core::Optional<rtp::Replicator> replicator_;
+
+    // Identity and timestamp mapping of the stream that is actually shipped
+    // by this session. When packets from encoder session are sent as is,
+    // they point to objects of encoder session.
+    rtp::Identity* stream_identity_;
+    rtp::TimestampExtractor* stream_ts_extractor_;
+
     audio::IFrameWriter* frame_writer_;
 
     bool valid_;
@@ -72,7 +72,8 @@ SenderSlot* SenderSink::create_slot(const SenderSlotConfig& slot_config) {
 
     core::SharedPtr<SenderSlot> slot =
         new (arena_) SenderSlot(sink_config_, slot_config, state_tracker_, encoding_map_,
-                                fanout_, packet_factory_, frame_factory_, arena_);
+                                fanout_, slots_, packet_factory_, frame_factory_,
+                                arena_);
 
     if (!slot || !slot->is_valid()) {
         roc_log(LogError, "sender sink: can't create slot");
@@ -89,6 +90,7 @@ void SenderSink::delete_slot(SenderSlot* slot) {
 
     roc_log(LogInfo, "sender sink: removing slot");
 
+    slot->deactivate();
     slots_.remove(*slot);
 }
 
@@ -124,6 +126,15 @@ core::nanoseconds_t SenderSink::refresh(core::nanoseconds_t current_time) {
     return next_deadline;
 }
 
+void SenderSink::publish_metrics() {
+    roc_panic_if(!is_valid());
+
+    for (core::SharedPtr<SenderSlot> slot = slots_.front(); slot;
+         slot = slots_.nextof(*slot)) {
+        slot->publish_metrics();
+    }
+}
+
 sndio::ISink* SenderSink::to_sink() {
     return this;
 }
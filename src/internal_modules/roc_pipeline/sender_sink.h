@@ -72,6 +72,12 @@ public:
     //!  if there are no frames
     core::nanoseconds_t refresh(core::nanoseconds_t current_time);
 
+    //! Publish metrics of all slots.
+    //! @remarks
+    //!  Updates snapshots that can be read from any thread,
+    //!  see SenderSlot::read_metrics().
+    void publish_metrics();
+
     //! Cast IDevice to ISink.
     virtual sndio::ISink* to_sink();
 
@@ -19,14 +19,17 @@ SenderSlot::SenderSlot(const SenderSinkConfig& sink_config,
                        StateTracker& state_tracker,
                        const rtp::EncodingMap& encoding_map,
                        audio::Fanout& fanout,
+                       core::List<SenderSlot>& peer_slots,
                        packet::PacketFactory& packet_factory,
                        audio::FrameFactory& frame_factory,
                        core::IArena& arena)
     : core::RefCounted<SenderSlot, core::ArenaAllocation>(arena)
     , sink_config_(sink_config)
     , fanout_(fanout)
+    , peer_slots_(peer_slots)
     , state_tracker_(state_tracker)
     , session_(sink_config, encoding_map, packet_factory, frame_factory, arena)
+    , active_(false)
     , valid_(false) {
     if (!session_.is_valid()) {
         return;
@@ -38,6 +41,8 @@ SenderSlot::SenderSlot(const SenderSinkConfig& sink_config,
 SenderSlot::~SenderSlot() {
     if (session_.frame_writer() && fanout_.has_output(*session_.frame_writer())) {
         fanout_.remove_output(*session_.frame_writer());
+    }
+    if (active_) {
         state_tracker_.add_active_sessions(-1);
     }
 }
@@ -46,6 +51,19 @@ bool SenderSlot::is_valid() const {
     return valid_;
 }
 
+void SenderSlot::deactivate() {
+    roc_panic_if(!is_valid());
+
+    // Frame writer is kept in fanout until slot is destroyed, because
+    // slots sharing encoding with us may still hold a reference to us.
+    session_.stop_shipping();
+
+    if (active_) {
+        state_tracker_.add_active_sessions(-1);
+        active_ = false;
+    }
+}
+
 SenderEndpoint* SenderSlot::add_endpoint(address::Interface iface,
                                          address::Protocol proto,
                                          const address::SocketAddr& outbound_address,
@@ -90,17 +108,19 @@ SenderEndpoint* SenderSlot::add_endpoint(address::Interface iface,
         if (source_endpoint_
             && (repair_endpoint_
                 || sink_config_.fec_encoder.scheme == packet::FEC_None)) {
-            if (!session_.create_transport_pipeline(source_endpoint_.get(),
-                                                    repair_endpoint_.get())) {
+            if (!create_transport_pipeline_()) {
                 return NULL;
             }
         }
         if (session_.frame_writer()) {
             if (!fanout_.has_output(*session_.frame_writer())) {
                 fanout_.add_output(*session_.frame_writer());
-                state_tracker_.add_active_sessions(+1);
             }
         }
+        if ((session_.frame_writer() || encoder_slot_) && !active_) {
+            state_tracker_.add_active_sessions(+1);
+            active_ = true;
+        }
         break;
 
     case address::Iface_AudioControl:
@@ -144,9 +164,39 @@ core::nanoseconds_t SenderSlot::refresh(core::nanoseconds_t current_time) {
 
 void SenderSlot::get_metrics(SenderSlotMetrics& slot_metrics,
                              SenderParticipantMetrics* party_metrics,
-                             size_t* party_count) const {
+                             size_t* party_count) {
+    roc_panic_if(!is_valid());
+
+    session_.update_timing_metrics();
+    collect_metrics_(slot_metrics, party_metrics, party_count);
+}
+
+void SenderSlot::publish_metrics() {
     roc_panic_if(!is_valid());
 
+    // Computing quantiles is not free, so do it only when someone
+    // actually reads published metrics.
+    if (metrics_snapshot_.check_and_clear_read()) {
+        session_.update_timing_metrics();
+    }
+
+    SenderSlotMetrics slot_metrics;
+    size_t party_count = SenderMetricsSnapshot::MaxParticipants;
+
+    collect_metrics_(slot_metrics, party_metrics_, &party_count);
+
+    metrics_snapshot_.store(slot_metrics, party_metrics_, party_count);
+}
+
+bool SenderSlot::read_metrics(SenderSlotMetrics& slot_metrics,
+                              SenderParticipantMetrics* party_metrics,
+                              size_t* party_count) const {
+    return metrics_snapshot_.load(slot_metrics, party_metrics, party_count);
+}
+
+void SenderSlot::collect_metrics_(SenderSlotMetrics& slot_metrics,
+                                  SenderParticipantMetrics* party_metrics,
+                                  size_t* party_count) const {
     session_.get_slot_metrics(slot_metrics);
 
     if (party_metrics || party_count) {
@@ -154,6 +204,51 @@ void SenderSlot::get_metrics(SenderSlotMetrics& slot_metrics,
     }
 }
 
+bool SenderSlot::create_transport_pipeline_() {
+    if (sink_config_.enable_shared_encoding) {
+        if (SenderSlot* encoder_slot = find_encoder_slot_()) {
+            roc_log(LogDebug, "sender slot: sharing encoding with another slot");
+
+            if (!session_.create_shared_transport_pipeline(encoder_slot->session_,
+                                                           source_endpoint_.get(),
+                                                           repair_endpoint_.get())) {
+                return false;
+            }
+
+            encoder_slot_ = encoder_slot;
+            return true;
+        }
+    }
+
+    return session_.create_transport_pipeline(source_endpoint_.get(),
+                                              repair_endpoint_.get());
+}
+
+SenderSlot* SenderSlot::find_encoder_slot_() {
+    for (core::SharedPtr<SenderSlot> slot = peer_slots_.front(); slot;
+         slot = peer_slots_.nextof(*slot)) {
+        if (slot.get() == this || !slot->session_.can_share_encoding()) {
+            continue;
+        }
+
+        // Packets can be shared only if they're produced for the same protocols.
+        if (slot->source_endpoint_->proto() != source_endpoint_->proto()) {
+            continue;
+        }
+        if (!!slot->repair_endpoint_ != !!repair_endpoint_) {
+            continue;
+        }
+        if (repair_endpoint_
+            && slot->repair_endpoint_->proto() != repair_endpoint_->proto()) {
+            continue;
+        }
+
+        return slot.get();
+    }
+
+    return NULL;
+}
+
 SenderEndpoint*
 SenderSlot::create_source_endpoint_(address::Protocol proto,
                                     const address::SocketAddr& outbound_address,
@@ -17,12 +17,15 @@
 #include "roc_audio/fanout.h"
 #include "roc_audio/frame_factory.h"
 #include "roc_core/iarena.h"
+#include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/ref_counted.h"
+#include "roc_core/shared_ptr.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/metrics.h"
+#include "roc_pipeline/metrics_snapshot.h"
 #include "roc_pipeline/sender_endpoint.h"
 #include "roc_pipeline/sender_session.h"
 #include "roc_pipeline/state_tracker.h"
@@ -35,6 +38,10 @@ namespace pipeline {
 //! Contains:
 //!  - one or more related sender endpoints, one per each type
 //!  - one session associated with those endpoints
+//!
+//! If shared encoding is enabled, session of the slot may use packets
+//! produced by session of another slot (leader), instead of encoding
+//! audio itself. Slot holds a reference to its leader.
 class SenderSlot : public core::RefCounted<SenderSlot, core::ArenaAllocation>,
                    public core::ListNode<> {
 public:
@@ -44,6 +51,7 @@ public:
                StateTracker& state_tracker,
                const rtp::EncodingMap& encoding_map,
                audio::Fanout& fanout,
+               core::List<SenderSlot>& peer_slots,
                packet::PacketFactory& packet_factory,
                audio::FrameFactory& frame_factory,
                core::IArena& arena);
@@ -53,6 +61,13 @@ public:
     //! Check if the slot was successfully constructed.
     bool is_valid() const;
 
+    //! Deactivate slot before removing it from sink.
+    //! @remarks
+    //!  Slot sends RTCP goodbye and stops sending packets to its endpoints.
+    //!  If other slots share encoding with this slot, it continues producing
+    //!  packets for them until they're removed.
+    void deactivate();
+
     //! Add endpoint.
     SenderEndpoint* add_endpoint(address::Interface iface,
                                  address::Protocol proto,
@@ -66,11 +81,33 @@ public:
     core::nanoseconds_t refresh(core::nanoseconds_t current_time);
 
     //! Get metrics for slot and its participants.
+    //! @remarks
+    //!  Stage timing metrics are recomputed on every call.
     void get_metrics(SenderSlotMetrics& slot_metrics,
                      SenderParticipantMetrics* party_metrics,
-                     size_t* party_count) const;
+                     size_t* party_count);
+
+    //! Publish current metrics to snapshot.
+    //! @remarks
+    //!  Invoked by pipeline after processing each frame and task.
+    //!  Stage timing metrics are recomputed only if snapshot was read
+    //!  since previous publish, otherwise previous values are published.
+    void publish_metrics();
+
+    //! Read metrics from last published snapshot.
+    //! @remarks
+    //!  Unlike get_metrics(), can be called from any thread.
+    //! @returns
+    //!  false if snapshot doesn't contain all requested participants.
+    bool read_metrics(SenderSlotMetrics& slot_metrics,
+                      SenderParticipantMetrics* party_metrics,
+                      size_t* party_count) const;
 
 private:
+    void collect_metrics_(SenderSlotMetrics& slot_metrics,
+                          SenderParticipantMetrics* party_metrics,
+                          size_t* party_count) const;
+
     SenderEndpoint* create_source_endpoint_(address::Protocol proto,
                                             const address::SocketAddr& outbound_address,
                                             packet::IWriter& outbound_writer);
@@ -81,17 +118,30 @@ private:
                                              const address::SocketAddr& outbound_address,
                                              packet::IWriter& outbound_writer);
 
+    bool create_transport_pipeline_();
+    SenderSlot* find_encoder_slot_();
+
     const SenderSinkConfig sink_config_;
 
     audio::Fanout& fanout_;
+    core::List<SenderSlot>& peer_slots_;
 
     core::Optional<SenderEndpoint> source_endpoint_;
     core::Optional<SenderEndpoint> repair_endpoint_;
     core::Optional<SenderEndpoint> control_endpoint_;
 
     StateTracker& state_tracker_;
+
+    // Slot which session encodes packets for our session.
+    // Declared before session, so that session is destroyed first.
+    core::SharedPtr<SenderSlot> encoder_slot_;
+
     SenderSession session_;
 
+    bool active_;
+    SenderMetricsSnapshot metrics_snapshot_;
+    SenderParticipantMetrics party_metrics_[SenderMetricsSnapshot::MaxParticipants];
+
     bool valid_;
 };
 
@@ -14,7 +14,8 @@ namespace pipeline {
 
 StateTracker::StateTracker()
     : active_sessions_(0)
-    , pending_packets_(0) {
+    , pending_packets_(0)
+    , waiters_(0) {
 }
 
 sndio::DeviceState StateTracker::get_state() const {
@@ -48,6 +49,34 @@ size_t StateTracker::num_pending_packets() const {
 void StateTracker::add_pending_packets(int increment) {
     const long result = pending_packets_ += increment;
     roc_panic_if(result < 0);
+
+    // Wake up waiter only when counter becomes non-zero, so that in the
+    // common case when no one waits this costs a single atomic load.
+    if (increment > 0 && result == increment && waiters_ != 0) {
+        wait_sem_.post();
+    }
+}
+
+bool StateTracker::wait_pending_packets(core::nanoseconds_t deadline) {
+    waiters_++;
+
+    // If counter becomes non-zero after this check, add_pending_packets()
+    // will see non-zero waiters and post semaphore.
+    if (pending_packets_ == 0) {
+        if (deadline != 0) {
+            (void)wait_sem_.timed_wait(deadline);
+        } else {
+            wait_sem_.wait();
+        }
+    }
+
+    waiters_--;
+
+    return pending_packets_ != 0;
+}
+
+void StateTracker::interrupt_wait() {
+    wait_sem_.post();
 }
 
 } // namespace pipeline
@@ -14,7 +14,9 @@
 
 #include "roc_core/atomic.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
 #include "roc_sndio/device_state.h"
 
 namespace roc {
@@ -47,9 +49,24 @@ public:
     //! Add/subtract to pending packets counter.
     void add_pending_packets(int increment);
 
+    //! Block until there are pending packets.
+    //! @remarks
+    //!  Returns when pending packets counter becomes non-zero, when @p deadline
+    //!  expires, or when interrupt_wait() is called. Deadline is an absolute
+    //!  time in ClockMonotonic domain, or zero for no deadline.
+    //! @returns
+    //!  true if there are pending packets.
+    bool wait_pending_packets(core::nanoseconds_t deadline);
+
+    //! Wake up thread blocked in wait_pending_packets().
+    void interrupt_wait();
+
 private:
     core::Atomic<int> active_sessions_;
     core::Atomic<int> pending_packets_;
+
+    core::Atomic<int> waiters_;
+    core::Semaphore wait_sem_;
 };
 
 } // namespace pipeline
@@ -681,6 +681,13 @@ void Communicator::generate_goodbye_payload_(Builder& bld) {
     }
     // Add BYE.
     generate_goodbye_(bld);
+
+    // BYE doesn't have per-stream blocks, so single packet covers all
+    // streams of current destination address.
+    if (bld.is_ok()) {
+        cur_pkt_send_stream_ = send_stream_count_ - send_stream_index_;
+        cur_pkt_recv_stream_ = recv_stream_count_ - recv_stream_index_;
+    }
 }
 
 void Communicator::generate_standard_report_(Builder& bld) {
@@ -34,5 +34,14 @@ float LossEstimator::update(const uint64_t total_packets, const int64_t lost_pac
     return fract_loss;
 }
 
+bool LossEstimator::has_new_packets(const uint64_t total_packets) const {
+    return total_packets > prev_total_;
+}
+
+void LossEstimator::reset() {
+    prev_total_ = 0;
+    prev_lost_ = 0;
+}
+
 } // namespace rtcp
 } // namespace roc
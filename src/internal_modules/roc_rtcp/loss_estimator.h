@@ -29,6 +29,17 @@ public:
     //! probably negative dues to duplicates.
     float update(uint64_t total_packets, int64_t lost_packets);
 
+    //! Check if @p total_packets has grown since previous update.
+    //! @remarks
+    //!  If it hasn't, update() can't estimate loss and returns zero.
+    bool has_new_packets(uint64_t total_packets) const;
+
+    //! Forget previous counters.
+    //! @remarks
+    //!  Should be called when counters start from another base, e.g.
+    //!  when reports start coming from another receiver.
+    void reset();
+
 private:
     uint64_t prev_total_;
     int64_t prev_lost_;
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtp/replicator.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+// Get slice of new buffer that has same position as given slice of old buffer.
+core::Slice<uint8_t> rebase_slice(const core::Slice<uint8_t>& slice,
+                                  const core::Slice<uint8_t>& old_buffer,
+                                  const core::Slice<uint8_t>& new_buffer) {
+    if (!slice) {
+        return slice;
+    }
+
+    const size_t offset = size_t(slice.data() - old_buffer.data());
+    roc_panic_if_msg(offset + slice.size() > old_buffer.size(),
+                     "rtp replicator: packet field is out of buffer bounds");
+
+    return new_buffer.subslice(offset, offset + slice.size());
+}
+
+} // namespace
+
+Replicator::Replicator(packet::IWriter& writer,
+                       const Identity* identity,
+                       packet::PacketFactory& packet_factory)
+    : writer_(writer)
+    , identity_(identity)
+    , packet_factory_(packet_factory)
+    , seqnum_shift_(0)
+    , stream_ts_shift_(0)
+    , valid_(false) {
+    if (identity_) {
+        // Start with random RTP seqnum and timestamp, as required by RFC 3550.
+        seqnum_shift_ =
+            (packet::seqnum_t)core::fast_random_range(0, packet::seqnum_t(-1));
+        stream_ts_shift_ = (packet::stream_timestamp_t)core::fast_random_range(
+            0, packet::stream_timestamp_t(-1));
+    }
+
+    valid_ = true;
+}
+
+bool Replicator::is_valid() const {
+    return valid_;
+}
+
+status::StatusCode Replicator::write(const packet::PacketPtr& packet) {
+    roc_panic_if(!is_valid());
+
+    if (!packet) {
+        roc_panic("rtp replicator: unexpected null packet");
+    }
+
+    if (!packet->buffer()) {
+        roc_panic("rtp replicator: unexpected packet without buffer");
+    }
+
+    packet::PacketPtr copy = copy_packet_(*packet);
+    if (!copy) {
+        return status::StatusNoMem;
+    }
+
+    if (identity_) {
+        rewrite_packet_(*copy);
+    }
+
+    return writer_.write(copy);
+}
+
+packet::PacketPtr Replicator::copy_packet_(const packet::Packet& packet) {
+    packet::PacketPtr copy = packet_factory_.new_packet();
+    if (!copy) {
+        roc_log(LogError, "rtp replicator: can't allocate packet");
+        return NULL;
+    }
+
+    const core::Slice<uint8_t>& old_buffer = packet.buffer();
+
+    if (!identity_ && packet.has_flags(packet::Packet::FlagComposed)) {
+        // Packet won't be modified by anyone, no need to copy bytes.
+        copy->set_buffer(old_buffer);
+        copy_meta_(packet, *copy, old_buffer, old_buffer);
+        return copy;
+    }
+
+    core::Slice<uint8_t> buffer = packet_factory_.new_packet_buffer();
+    if (!buffer) {
+        roc_log(LogError, "rtp replicator: can't allocate buffer");
+        return NULL;
+    }
+
+    if (buffer.capacity() < old_buffer.size()) {
+        roc_log(LogError,
+                "rtp replicator: packet buffer is too small:"
+                " required=%lu available=%lu",
+                (unsigned long)old_buffer.size(), (unsigned long)buffer.capacity());
+        return NULL;
+    }
+
+    buffer.reslice(0, old_buffer.size());
+    memcpy(buffer.data(), old_buffer.data(), old_buffer.size());
+
+    copy->set_buffer(buffer);
+    copy_meta_(packet, *copy, old_buffer, buffer);
+
+    return copy;
+}
+
+void Replicator::copy_meta_(const packet::Packet& packet,
+                            packet::Packet& copy,
+                            const core::Slice<uint8_t>& old_buffer,
+                            const core::Slice<uint8_t>& new_buffer) {
+    // UDP header is filled separately for every destination.
+    unsigned flags = packet.flags() & ~unsigned(packet::Packet::FlagUDP);
+
+    if (identity_) {
+        // RTP header will be rewritten and should be composed again.
+        flags &= ~unsigned(packet::Packet::FlagComposed);
+    }
+
+    copy.add_flags(flags);
+
+    if (packet.rtp()) {
+        packet::RTP& rtp = *copy.rtp();
+        rtp = *packet.rtp();
+        rtp.header = rebase_slice(rtp.header, old_buffer, new_buffer);
+        rtp.payload = rebase_slice(rtp.payload, old_buffer, new_buffer);
+        rtp.padding = rebase_slice(rtp.padding, old_buffer, new_buffer);
+    }
+
+    if (packet.fec()) {
+        packet::FEC& fec = *copy.fec();
+        fec = *packet.fec();
+        fec.payload_id = rebase_slice(fec.payload_id, old_buffer, new_buffer);
+        fec.payload = rebase_slice(fec.payload, old_buffer, new_buffer);
+    }
+}
+
+void Replicator::rewrite_packet_(packet::Packet& packet) {
+    packet::RTP* rtp = packet.rtp();
+    if (!rtp) {
+        roc_panic("rtp replicator: can't rewrite non-rtp packet");
+    }
+
+    if (packet.fec()) {
+        roc_panic("rtp replicator: can't rewrite fec packet");
+    }
+
+    // Identity can change SSRC in case of collision, so we read SSRC
+    // from it each time.
+    rtp->source_id = identity_->ssrc();
+    rtp->seqnum = packet::seqnum_t(rtp->seqnum + seqnum_shift_);
+    rtp->stream_timestamp =
+        packet::stream_timestamp_t(rtp->stream_timestamp + stream_ts_shift_);
+}
+
+} // namespace rtp
+} // namespace roc
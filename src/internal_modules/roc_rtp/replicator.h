@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtp/replicator.h
+//! @brief RTP packet replicator.
+
+#ifndef ROC_RTP_REPLICATOR_H_
+#define ROC_RTP_REPLICATOR_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/units.h"
+#include "roc_rtp/identity.h"
+
+namespace roc {
+namespace rtp {
+
+//! RTP packet replicator.
+//!
+//! Makes a copy of every packet, optionally rewrites its RTP stream
+//! identifiers, and passes the copy to the output writer.
+//!
+//! Used to send packets produced by one sender pipeline to another
+//! destination, without packetizing and encoding audio again.
+//!
+//! If @p identity is provided, replicator rewrites SSRC with the one from
+//! identity, and shifts seqnum and timestamp by random offsets, so that
+//! every destination gets independent stream, as required by RFC 3550.
+//! Rewritten packets are marked as not composed, so that RTP header is
+//! composed again by the shipper. Header rewriting can't be used when
+//! packets are protected by FEC, because repair packets cover RTP headers
+//! of source packets.
+//!
+//! If @p identity is null, packets are copied as is. If packet is already
+//! composed, its buffer is not modified anymore, so the copy shares buffer
+//! with the original packet instead of copying bytes.
+class Replicator : public packet::IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!  - @p writer is used to write copied packets
+    //!  - @p identity defines SSRC for copied packets, may be null
+    //!  - @p packet_factory is used to allocate copies
+    Replicator(packet::IWriter& writer,
+               const Identity* identity,
+               packet::PacketFactory& packet_factory);
+
+    //! Check if was constructed successfully.
+    bool is_valid() const;
+
+    //! Write packet.
+    //! @remarks
+    //!  Writes copy of @p packet to output writer.
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
+
+private:
+    packet::PacketPtr copy_packet_(const packet::Packet& packet);
+    void copy_meta_(const packet::Packet& packet,
+                    packet::Packet& copy,
+                    const core::Slice<uint8_t>& old_buffer,
+                    const core::Slice<uint8_t>& new_buffer);
+    void rewrite_packet_(packet::Packet& packet);
+
+    packet::IWriter& writer_;
+    const Identity* identity_;
+    packet::PacketFactory& packet_factory_;
+
+    packet::seqnum_t seqnum_shift_;
+    packet::stream_timestamp_t stream_ts_shift_;
+
+    bool valid_;
+};
+
+} // namespace rtp
+} // namespace roc
+
+#endif // ROC_RTP_REPLICATOR_H_
@@ -63,6 +63,11 @@ void BackendMap::register_backends_() {
     wav_backend_.reset(new (wav_backend_) WavBackend);
     add_backend_(wav_backend_.get());
 
+#ifdef ROC_TARGET_POSIX
+    pipe_backend_.reset(new (pipe_backend_) PipeBackend);
+    add_backend_(pipe_backend_.get());
+#endif // ROC_TARGET_POSIX
+
 #ifdef ROC_TARGET_SOX
     sox_backend_.reset(new (sox_backend_) SoxBackend);
     add_backend_(sox_backend_.get());
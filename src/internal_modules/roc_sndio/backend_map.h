@@ -18,6 +18,10 @@
 #include "roc_sndio/driver.h"
 #include "roc_sndio/ibackend.h"
 
+#ifdef ROC_TARGET_POSIX
+#include "roc_sndio/pipe_backend.h"
+#endif // ROC_TARGET_POSIX
+
 #ifdef ROC_TARGET_PULSEAUDIO
 #include "roc_sndio/pulseaudio_backend.h"
 #endif // ROC_TARGET_PULSEAUDIO
@@ -83,6 +87,10 @@ private:
 
     core::Optional<WavBackend> wav_backend_;
 
+#ifdef ROC_TARGET_POSIX
+    core::Optional<PipeBackend> pipe_backend_;
+#endif // ROC_TARGET_POSIX
+
     core::Array<IBackend*, MaxBackends> backends_;
     core::Array<DriverInfo, MaxDrivers> drivers_;
 };
@@ -7,7 +7,9 @@
  */
 
 #include "roc_sndio/pump.h"
+#include "roc_core/atomic_ops.h"
 #include "roc_core/log.h"
+#include "roc_core/panic.h"
 
 namespace roc {
 namespace sndio {
@@ -18,7 +20,8 @@ Pump::Pump(core::IPool& buffer_pool,
            ISink& sink,
            core::nanoseconds_t frame_length,
            const audio::SampleSpec& sample_spec,
-           Mode mode)
+           Mode mode,
+           size_t pipeline_depth)
     : frame_factory_(buffer_pool)
     , main_source_(source)
     , backup_source_(backup_source)
@@ -26,7 +29,17 @@ Pump::Pump(core::IPool& buffer_pool,
     , sample_spec_(sample_spec)
     , n_bufs_(0)
     , oneshot_(mode == ModeOneshot)
-    , stop_(0) {
+    , stop_(0)
+    , pipeline_depth_(pipeline_depth)
+    , pipeline_buffers_(pipeline_arena_)
+    , write_pos_(WritePosition())
+    , write_pos_ver_(0)
+    , read_pos_(0)
+    , reader_buffer_(0)
+    , has_reader_buffer_(false)
+    , n_stalls_(0)
+    , n_overruns_(0)
+    , valid_(false) {
     size_t frame_size = sample_spec_.ns_2_samples_overall(frame_length);
     if (frame_size == 0) {
         roc_log(LogError, "pump: frame size cannot be 0");
@@ -47,15 +60,64 @@ Pump::Pump(core::IPool& buffer_pool,
     }
 
     frame_buffer_.reslice(0, frame_size);
+
+    if (pipeline_depth_ != 0 && !init_pipeline_(frame_size)) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool Pump::init_pipeline_(size_t frame_size) {
+    if (!pipeline_buffers_.grow(pipeline_depth_)) {
+        roc_log(LogError, "pump: can't allocate pipeline buffers");
+        return false;
+    }
+
+    // One more slot for eof marker.
+    filled_queue_.reset(new (filled_queue_) core::SpscRingBuffer<QueuedFrame>(
+        pipeline_arena_, pipeline_depth_ + 1));
+    free_queue_.reset(new (free_queue_)
+                          core::SpscRingBuffer<size_t>(pipeline_arena_, pipeline_depth_));
+
+    if (!filled_queue_->is_valid() || !free_queue_->is_valid()) {
+        roc_log(LogError, "pump: can't allocate pipeline queues");
+        return false;
+    }
+
+    for (size_t n = 0; n < pipeline_depth_; n++) {
+        core::Slice<audio::sample_t> buffer = frame_factory_.new_raw_buffer();
+        if (!buffer) {
+            roc_log(LogError, "pump: can't allocate pipeline buffer");
+            return false;
+        }
+        buffer.reslice(0, frame_size);
+
+        if (!pipeline_buffers_.push_back(buffer) || !free_queue_->push_back(n)) {
+            roc_log(LogError, "pump: can't allocate pipeline buffer");
+            return false;
+        }
+    }
+
+    roc_log(LogDebug, "pump: enabled pipelined mode: depth=%lu",
+            (unsigned long)pipeline_depth_);
+
+    return true;
 }
 
 bool Pump::is_valid() const {
-    return frame_buffer_;
+    return valid_;
 }
 
 bool Pump::run() {
+    roc_panic_if(!valid_);
+
     roc_log(LogDebug, "pump: starting main loop");
 
+    if (pipeline_depth_ != 0 && !start_pipeline_()) {
+        return false;
+    }
+
     ISource* current_source = &main_source_;
 
     while (!stop_) {
@@ -90,7 +152,13 @@ bool Pump::run() {
         }
 
         // read frame
-        if (!transfer_frame_(*current_source)) {
+        const bool ok = pipeline_depth_ != 0 ? enqueue_frame_(*current_source)
+                                             : transfer_frame_(*current_source);
+        if (!ok) {
+            if (stop_) {
+                break;
+            }
+
             roc_log(LogDebug, "pump: got eof from source");
 
             if (current_source == backup_source_) {
@@ -106,15 +174,176 @@ bool Pump::run() {
         }
     }
 
+    if (pipeline_depth_ != 0) {
+        stop_pipeline_();
+    }
+
     roc_log(LogDebug, "pump: exiting main loop, wrote %lu buffers from main source",
             (unsigned long)n_bufs_);
 
+    if (pipeline_depth_ != 0) {
+        roc_log(LogDebug, "pump: pipeline stats: stalls=%llu overruns=%llu",
+                (unsigned long long)num_stalls(), (unsigned long long)num_overruns());
+    }
+
     return !stop_;
 }
 
 bool Pump::transfer_frame_(ISource& current_source) {
     audio::Frame frame(frame_buffer_.data(), frame_buffer_.size());
 
+    if (!read_frame_(current_source, frame)) {
+        return false;
+    }
+
+    const core::nanoseconds_t playback_ts = write_frame_(frame);
+
+    current_source.reclock(playback_ts);
+
+    return true;
+}
+
+bool Pump::enqueue_frame_(ISource& current_source) {
+    // tell source playback time of the last frame read, computed from playback
+    // time of the last frame written plus duration of frames still in queue
+    WritePosition write_pos;
+    core::seqlock_version_t ver = 0;
+    if (write_pos_.try_load_v(write_pos, ver) && ver != write_pos_ver_) {
+        write_pos_ver_ = ver;
+        current_source.reclock(
+            write_pos.playback_ts
+            + sample_spec_.stream_timestamp_delta_2_ns(
+                packet::stream_timestamp_diff(read_pos_, write_pos.stream_pos)));
+    }
+
+    if (!has_reader_buffer_) {
+        while (!free_queue_->pop_front(reader_buffer_)) {
+            if (stop_) {
+                return false;
+            }
+
+            if (current_source.has_clock()) {
+                // can't block clocked source, read frame and drop it
+                core::AtomicOps::fetch_add_relaxed(n_overruns_, (uint64_t)1);
+
+                audio::Frame frame(frame_buffer_.data(), frame_buffer_.size());
+                return read_frame_(current_source, frame);
+            }
+
+            free_sem_.wait();
+        }
+        has_reader_buffer_ = true;
+    }
+
+    audio::Frame frame(pipeline_buffers_[reader_buffer_].data(),
+                       pipeline_buffers_[reader_buffer_].size());
+
+    if (!read_frame_(current_source, frame)) {
+        // keep buffer for next read
+        return false;
+    }
+
+    read_pos_ += frame.duration();
+
+    QueuedFrame queued_frame;
+    queued_frame.buffer_index = reader_buffer_;
+    queued_frame.flags = frame.flags();
+    queued_frame.duration = frame.duration();
+    queued_frame.capture_ts = frame.capture_timestamp();
+    queued_frame.eof = false;
+
+    if (!filled_queue_->push_back(queued_frame)) {
+        // number of buffers is less than queue size
+        roc_panic("pump: filled queue overflow");
+    }
+    filled_sem_.post();
+
+    has_reader_buffer_ = false;
+
+    return true;
+}
+
+void Pump::dequeue_frames_() {
+    roc_log(LogDebug, "pump: starting writer loop");
+
+    WritePosition write_pos;
+    write_pos.stream_pos = 0;
+    write_pos.playback_ts = 0;
+
+    bool stalled = false;
+
+    while (!stop_) {
+        QueuedFrame queued_frame;
+
+        if (!filled_queue_->pop_front(queued_frame)) {
+            if (sink_.has_clock() && !stalled) {
+                core::AtomicOps::fetch_add_relaxed(n_stalls_, (uint64_t)1);
+                stalled = true;
+            }
+            filled_sem_.wait();
+            continue;
+        }
+
+        stalled = false;
+
+        if (queued_frame.eof) {
+            break;
+        }
+
+        audio::Frame frame(pipeline_buffers_[queued_frame.buffer_index].data(),
+                           pipeline_buffers_[queued_frame.buffer_index].size());
+        frame.set_flags(queued_frame.flags);
+        frame.set_duration(queued_frame.duration);
+        frame.set_capture_timestamp(queued_frame.capture_ts);
+
+        write_pos.playback_ts = write_frame_(frame);
+        write_pos.stream_pos += queued_frame.duration;
+
+        write_pos_.exclusive_store(write_pos);
+
+        if (!free_queue_->push_back(queued_frame.buffer_index)) {
+            // queue size is equal to number of buffers
+            roc_panic("pump: free queue overflow");
+        }
+        free_sem_.post();
+    }
+
+    roc_log(LogDebug, "pump: exiting writer loop");
+}
+
+bool Pump::start_pipeline_() {
+    writer_thread_.reset(new (writer_thread_) WriterThread(*this));
+
+    if (!writer_thread_->start()) {
+        roc_log(LogError, "pump: can't start writer thread");
+        writer_thread_.reset();
+        return false;
+    }
+
+    return true;
+}
+
+void Pump::stop_pipeline_() {
+    // let writer drain queue and exit
+    // if stop() was called, writer exits without draining
+    QueuedFrame queued_frame;
+    queued_frame.buffer_index = 0;
+    queued_frame.flags = 0;
+    queued_frame.duration = 0;
+    queued_frame.capture_ts = 0;
+    queued_frame.eof = true;
+
+    if (!filled_queue_->push_back(queued_frame)) {
+        // queue has one extra slot for eof marker
+        roc_panic("pump: filled queue overflow");
+    }
+    filled_sem_.post();
+
+    writer_thread_->join();
+    writer_thread_.reset();
+}
+
+bool Pump::read_frame_(ISource& current_source, audio::Frame& frame) {
     // if source has clock, here we block on it
     if (!current_source.read(frame)) {
         return false;
@@ -142,30 +371,51 @@ bool Pump::transfer_frame_(ISource& current_source) {
         frame.set_capture_timestamp(core::timestamp(core::ClockUnix) - capture_latency);
     }
 
+    return true;
+}
+
+core::nanoseconds_t Pump::write_frame_(audio::Frame& frame) {
     // if sink has clock, here we block on it
     // note that either source or sink has clock, but not both
     sink_.write(frame);
 
-    {
-        // tell source what is playback time of first sample of last read frame
-        // we add sink latency to take into account playback buffer size
-        // we subtract frame size because we already wrote the whole frame into
-        // playback buffer, and should take it into account too
-        core::nanoseconds_t playback_latency = 0;
+    // compute what is playback time of first sample of last written frame
+    // we add sink latency to take into account playback buffer size
+    // we subtract frame size because we already wrote the whole frame into
+    // playback buffer, and should take it into account too
+    core::nanoseconds_t playback_latency = 0;
 
-        if (sink_.has_latency()) {
-            playback_latency =
-                sink_.latency() - sample_spec_.stream_timestamp_2_ns(frame.duration());
-        }
-
-        current_source.reclock(core::timestamp(core::ClockUnix) + playback_latency);
+    if (sink_.has_latency()) {
+        playback_latency =
+            sink_.latency() - sample_spec_.stream_timestamp_2_ns(frame.duration());
     }
 
-    return true;
+    return core::timestamp(core::ClockUnix) + playback_latency;
 }
 
 void Pump::stop() {
     stop_ = 1;
+
+    if (pipeline_depth_ != 0) {
+        filled_sem_.post();
+        free_sem_.post();
+    }
+}
+
+uint64_t Pump::num_stalls() const {
+    return core::AtomicOps::load_relaxed(n_stalls_);
+}
+
+uint64_t Pump::num_overruns() const {
+    return core::AtomicOps::load_relaxed(n_overruns_);
+}
+
+Pump::WriterThread::WriterThread(Pump& pump)
+    : pump_(pump) {
+}
+
+void Pump::WriterThread::run() {
+    pump_.dequeue_frames_();
 }
 
 } // namespace sndio
@@ -15,12 +15,20 @@
 #include "roc_audio/frame_factory.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
 #include "roc_core/atomic.h"
 #include "roc_core/attributes.h"
+#include "roc_core/heap_arena.h"
 #include "roc_core/ipool.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/seqlock.h"
 #include "roc_core/slice.h"
+#include "roc_core/spsc_ring_buffer.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
 #include "roc_packet/units.h"
 #include "roc_sndio/isink.h"
 #include "roc_sndio/isource.h"
@@ -31,6 +39,16 @@ namespace sndio {
 //! Audio pump.
 //! @remarks
 //!  Reads frames from source and writes them to sink.
+//!
+//!  By default, reading and writing happen synchronously on the thread that
+//!  called run(). If pipeline depth is non-zero, writing is moved to a separate
+//!  thread, connected with the reading thread by a queue of the given number of
+//!  frames, so that a slow write doesn't delay the next read and vice versa.
+//!
+//!  In pipelined mode, if the source has clock and the queue is full, the frame
+//!  is dropped instead of blocking the source (an overrun). If the sink has clock
+//!  and the queue is empty, the writer waits for the next frame (a stall). If
+//!  neither has clock, the reader and the writer just wait for each other.
 class Pump : public core::NonCopyable<> {
 public:
     //! Pump mode.
@@ -43,13 +61,16 @@ public:
     };
 
     //! Initialize.
+    //! @remarks
+    //!  If @p pipeline_depth is zero, pipelined mode is disabled.
     Pump(core::IPool& buffer_pool,
          ISource& source,
          ISource* backup_source,
          ISink& sink,
          core::nanoseconds_t frame_length,
          const audio::SampleSpec& sample_spec,
-         Mode mode);
+         Mode mode,
+         size_t pipeline_depth);
 
     //! Check if the object was successfulyl constructed.
     bool is_valid() const;
@@ -65,8 +86,53 @@ public:
     //!  May be called from any thread.
     void stop();
 
+    //! Get number of times the writer waited for a frame while sink has clock.
+    //! Non-zero only in pipelined mode.
+    uint64_t num_stalls() const;
+
+    //! Get number of frames dropped because the queue was full while source
+    //! has clock. Non-zero only in pipelined mode.
+    uint64_t num_overruns() const;
+
 private:
+    // Frame passed from reader to writer in pipelined mode.
+    struct QueuedFrame {
+        size_t buffer_index;
+        unsigned flags;
+        packet::stream_timestamp_t duration;
+        core::nanoseconds_t capture_ts;
+        bool eof;
+    };
+
+    // Position of the last frame written in pipelined mode.
+    struct WritePosition {
+        // Total duration of frames written so far.
+        packet::stream_timestamp_t stream_pos;
+        // Playback time of the last frame written.
+        core::nanoseconds_t playback_ts;
+    };
+
+    class WriterThread : public core::Thread {
+    public:
+        explicit WriterThread(Pump& pump);
+
+    private:
+        virtual void run();
+
+        Pump& pump_;
+    };
+
+    bool init_pipeline_(size_t frame_size);
+
     bool transfer_frame_(ISource& current_source);
+    bool enqueue_frame_(ISource& current_source);
+    void dequeue_frames_();
+
+    bool read_frame_(ISource& current_source, audio::Frame& frame);
+    core::nanoseconds_t write_frame_(audio::Frame& frame);
+
+    bool start_pipeline_();
+    void stop_pipeline_();
 
     audio::FrameFactory frame_factory_;
 
@@ -82,6 +148,28 @@ private:
     const bool oneshot_;
 
     core::Atomic<int> stop_;
+
+    const size_t pipeline_depth_;
+
+    core::HeapArena pipeline_arena_;
+    core::Array<core::Slice<audio::sample_t> > pipeline_buffers_;
+    core::Optional<core::SpscRingBuffer<QueuedFrame> > filled_queue_;
+    core::Optional<core::SpscRingBuffer<size_t> > free_queue_;
+    core::Semaphore filled_sem_;
+    core::Semaphore free_sem_;
+
+    core::Seqlock<WritePosition> write_pos_;
+    core::seqlock_version_t write_pos_ver_;
+    packet::stream_timestamp_t read_pos_;
+    size_t reader_buffer_;
+    bool has_reader_buffer_;
+
+    core::Optional<WriterThread> writer_thread_;
+
+    uint64_t n_stalls_;
+    uint64_t n_overruns_;
+
+    bool valid_;
 };
 
 } // namespace sndio
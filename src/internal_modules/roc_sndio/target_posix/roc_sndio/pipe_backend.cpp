@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/pipe_backend.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_sndio/pipe_sink.h"
+#include "roc_sndio/pipe_source.h"
+
+namespace roc {
+namespace sndio {
+
+PipeBackend::PipeBackend() {
+}
+
+void PipeBackend::discover_drivers(core::Array<DriverInfo, MaxDrivers>& driver_list) {
+    if (!driver_list.push_back(
+            DriverInfo("raw", DriverType_File,
+                       DriverFlag_SupportsSink | DriverFlag_SupportsSource, this))) {
+        roc_panic("pipe backend: can't add driver");
+    }
+}
+
+IDevice* PipeBackend::open_device(DeviceType device_type,
+                                  DriverType driver_type,
+                                  const char* driver,
+                                  const char* path,
+                                  const Config& config,
+                                  core::IArena& arena) {
+    if (driver_type != DriverType_File) {
+        return NULL;
+    }
+
+    // raw stream has no header, so it can't be auto-detected
+    if (!driver || strcmp(driver, "raw") != 0) {
+        return NULL;
+    }
+
+    switch (device_type) {
+    case DeviceType_Sink: {
+        core::ScopedPtr<PipeSink> sink(new (arena) PipeSink(arena, config), arena);
+        if (!sink || !sink->is_valid()) {
+            roc_log(LogDebug, "pipe backend: can't construct sink: path=%s", path);
+            return NULL;
+        }
+
+        if (!sink->open(path)) {
+            roc_log(LogDebug, "pipe backend: open failed: path=%s", path);
+            return NULL;
+        }
+
+        return sink.release();
+    } break;
+
+    case DeviceType_Source: {
+        core::ScopedPtr<PipeSource> source(new (arena) PipeSource(arena, config), arena);
+        if (!source || !source->is_valid()) {
+            roc_log(LogDebug, "pipe backend: can't construct source: path=%s", path);
+            return NULL;
+        }
+
+        if (!source->open(path)) {
+            roc_log(LogDebug, "pipe backend: open failed: path=%s", path);
+            return NULL;
+        }
+
+        return source.release();
+    } break;
+
+    default:
+        break;
+    }
+
+    roc_panic("pipe backend: invalid device type");
+}
+
+const char* PipeBackend::name() const {
+    return "pipe";
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/pipe_backend.h
+//! @brief Raw PCM pipe backend.
+
+#ifndef ROC_SNDIO_PIPE_BACKEND_H_
+#define ROC_SNDIO_PIPE_BACKEND_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_sndio/ibackend.h"
+
+namespace roc {
+namespace sndio {
+
+//! Raw PCM pipe backend.
+//! @remarks
+//!  Reads and writes headerless PCM stream from stdin/stdout, FIFOs, or
+//!  files. Since the stream has no header, driver is never auto-detected
+//!  and should be requested explicitly using "raw" format. Stream
+//!  encoding is defined by sample spec from config.
+class PipeBackend : public IBackend, core::NonCopyable<> {
+public:
+    PipeBackend();
+
+    //! Append supported drivers to the list.
+    virtual void discover_drivers(core::Array<DriverInfo, MaxDrivers>& driver_list);
+
+    //! Create and open a sink or source.
+    virtual IDevice* open_device(DeviceType device_type,
+                                 DriverType driver_type,
+                                 const char* driver,
+                                 const char* path,
+                                 const Config& config,
+                                 core::IArena& arena);
+
+    //! Returns name of backend.
+    virtual const char* name() const;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_PIPE_BACKEND_H_
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "roc_audio/pcm_format.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_sndio/pipe_sink.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+// Minimum size of block written to output at once.
+// Matches default pipe capacity on Linux.
+enum { MinBlockSize = 64 * 1024 };
+
+} // namespace
+
+PipeSink::PipeSink(core::IArena& arena, const Config& config)
+    : sample_bits_(0)
+    , direct_copy_(false)
+    , block_(arena)
+    , block_bit_pos_(0)
+    , fd_(-1)
+    , close_fd_(false)
+    , failed_(false)
+    , valid_(false) {
+    if (config.latency != 0) {
+        roc_log(LogError, "pipe sink: setting io latency not supported");
+        return;
+    }
+
+    sample_spec_ = config.sample_spec;
+
+    sample_spec_.use_defaults(audio::Sample_RawFormat, audio::ChanLayout_Surround,
+                              audio::ChanOrder_Smpte, audio::ChanMask_Surround_Stereo,
+                              44100);
+
+    if (!sample_spec_.is_valid()
+        || sample_spec_.sample_format() != audio::SampleFormat_Pcm) {
+        roc_log(LogError, "pipe sink: invalid io encoding: %s",
+                audio::sample_spec_to_str(sample_spec_).c_str());
+        return;
+    }
+
+    pcm_mapper_.reset(new (pcm_mapper_) audio::PcmMapper(
+        audio::Sample_RawFormat, sample_spec_.pcm_format()));
+
+    sample_bits_ = pcm_mapper_->output_bit_count(1);
+
+    direct_copy_ = audio::pcm_format_traits(sample_spec_.pcm_format()).canon_id
+        == audio::pcm_format_traits(audio::Sample_RawFormat).canon_id;
+
+    // Block holds whole number of samples for all channels, and at least one frame.
+    const size_t unit_size = pcm_mapper_->output_byte_count(sample_spec_.num_channels());
+    size_t block_size = pcm_mapper_->output_byte_count(
+        sample_spec_.ns_2_samples_overall(config.frame_length));
+    if (block_size < MinBlockSize) {
+        block_size = MinBlockSize;
+    }
+    block_size = (block_size + unit_size - 1) / unit_size * unit_size;
+
+    if (!block_.resize(block_size)) {
+        roc_log(LogError, "pipe sink: can't allocate block: size=%lu",
+                (unsigned long)block_size);
+        return;
+    }
+
+    valid_ = true;
+}
+
+PipeSink::~PipeSink() {
+    close_();
+}
+
+bool PipeSink::is_valid() const {
+    return valid_;
+}
+
+bool PipeSink::open(const char* path) {
+    roc_panic_if(!valid_);
+
+    if (!open_(path)) {
+        return false;
+    }
+
+    return true;
+}
+
+ISink* PipeSink::to_sink() {
+    return this;
+}
+
+ISource* PipeSink::to_source() {
+    return NULL;
+}
+
+DeviceType PipeSink::type() const {
+    return DeviceType_Sink;
+}
+
+DeviceState PipeSink::state() const {
+    return DeviceState_Active;
+}
+
+void PipeSink::pause() {
+    // no-op
+}
+
+bool PipeSink::resume() {
+    return true;
+}
+
+bool PipeSink::restart() {
+    return true;
+}
+
+audio::SampleSpec PipeSink::sample_spec() const {
+    if (fd_ == -1) {
+        roc_panic("pipe sink: not opened");
+    }
+
+    return audio::SampleSpec(sample_spec_.sample_rate(), audio::Sample_RawFormat,
+                             sample_spec_.channel_set());
+}
+
+core::nanoseconds_t PipeSink::latency() const {
+    return 0;
+}
+
+bool PipeSink::has_latency() const {
+    return false;
+}
+
+bool PipeSink::has_clock() const {
+    return false;
+}
+
+void PipeSink::write(audio::Frame& frame) {
+    if (fd_ == -1) {
+        roc_panic("pipe sink: not opened");
+    }
+
+    if (failed_) {
+        return;
+    }
+
+    const audio::sample_t* frame_data = frame.raw_samples();
+    const size_t frame_size = frame.num_raw_samples();
+
+    size_t frame_pos = 0;
+
+    while (frame_pos < frame_size) {
+        size_t n_samples = (block_.size() * 8 - block_bit_pos_) / sample_bits_;
+
+        if (n_samples == 0) {
+            if (!flush_block_(false)) {
+                failed_ = true;
+                return;
+            }
+            continue;
+        }
+
+        if (n_samples > frame_size - frame_pos) {
+            n_samples = frame_size - frame_pos;
+        }
+
+        if (direct_copy_ && block_bit_pos_ % 8 == 0) {
+            memcpy(block_.data() + block_bit_pos_ / 8, frame_data + frame_pos,
+                   n_samples * sizeof(audio::sample_t));
+            block_bit_pos_ += n_samples * sample_bits_;
+        } else {
+            size_t frame_bit_pos = frame_pos * sizeof(audio::sample_t) * 8;
+            pcm_mapper_->map(frame_data, frame_size * sizeof(audio::sample_t),
+                             frame_bit_pos, block_.data(), block_.size(), block_bit_pos_,
+                             n_samples);
+        }
+
+        frame_pos += n_samples;
+    }
+}
+
+bool PipeSink::flush_block_(bool partial) {
+    // Incomplete byte is written only when flushing partial block on close,
+    // otherwise it's kept until the rest of its bits are mapped.
+    const size_t n_bytes = partial ? (block_bit_pos_ + 7) / 8 : block_bit_pos_ / 8;
+
+    size_t pos = 0;
+
+    while (pos < n_bytes) {
+        const ssize_t ret = ::write(fd_, block_.data() + pos, n_bytes - pos);
+
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            roc_log(LogError, "pipe sink: write(): %s",
+                    core::errno_to_str(errno).c_str());
+            return false;
+        }
+
+        pos += (size_t)ret;
+    }
+
+    if (partial || block_bit_pos_ % 8 == 0) {
+        block_bit_pos_ = 0;
+    } else {
+        block_[0] = block_[n_bytes];
+        block_bit_pos_ %= 8;
+    }
+
+    return true;
+}
+
+bool PipeSink::open_(const char* path) {
+    if (fd_ != -1) {
+        roc_panic("pipe sink: already opened");
+    }
+
+    if (!path || strcmp(path, "-") == 0) {
+        fd_ = STDOUT_FILENO;
+        close_fd_ = false;
+    } else {
+        fd_ = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd_ == -1) {
+            roc_log(LogDebug, "pipe sink: open(): path=%s: %s", path,
+                    core::errno_to_str(errno).c_str());
+            return false;
+        }
+        close_fd_ = true;
+    }
+
+#ifdef F_SETPIPE_SZ
+    struct stat st;
+    if (fstat(fd_, &st) == 0 && S_ISFIFO(st.st_mode)) {
+        // Grow pipe buffer to fit the whole block, so that we can enqueue
+        // a block while reader is processing previous one.
+        // Fails if block is larger than allowed for user, that's ok.
+        (void)fcntl(fd_, F_SETPIPE_SZ, (int)block_.size());
+    }
+#endif
+
+    roc_log(LogInfo,
+            "pipe sink: opened output: path=%s encoding=%s block_size=%lu direct=%d",
+            path ? path : "-", audio::sample_spec_to_str(sample_spec_).c_str(),
+            (unsigned long)block_.size(), (int)direct_copy_);
+
+    return true;
+}
+
+void PipeSink::close_() {
+    if (fd_ == -1) {
+        return;
+    }
+
+    if (!failed_ && block_bit_pos_ != 0) {
+        (void)flush_block_(true);
+    }
+
+    if (close_fd_ && ::close(fd_) != 0) {
+        roc_log(LogError, "pipe sink: close(): %s", core::errno_to_str(errno).c_str());
+    }
+
+    fd_ = -1;
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/pipe_sink.h
+//! @brief Raw PCM pipe sink.
+
+#ifndef ROC_SNDIO_PIPE_SINK_H_
+#define ROC_SNDIO_PIPE_SINK_H_
+
+#include "roc_audio/pcm_mapper.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/stddefs.h"
+#include "roc_sndio/config.h"
+#include "roc_sndio/isink.h"
+
+namespace roc {
+namespace sndio {
+
+//! Raw PCM pipe sink.
+//! @remarks
+//!  Writes headerless PCM stream to stdout, FIFO, or file.
+//!
+//!  Stream encoding is defined by sample spec from config. Samples are
+//!  mapped from frame directly into block, and data is written in large
+//!  blocks, aligned to whole samples for all channels.
+class PipeSink : public ISink, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PipeSink(core::IArena& arena, const Config& config);
+
+    virtual ~PipeSink();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Open output file or pipe.
+    //!
+    //! @b Parameters
+    //!  - @p path is output file or FIFO path, "-" for stdout.
+    bool open(const char* path);
+
+    //! Cast IDevice to ISink.
+    virtual ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual ISource* to_source();
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the sink.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the sink.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the sink supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the sink has own clock.
+    virtual bool has_clock() const;
+
+    //! Write audio frame.
+    virtual void write(audio::Frame& frame);
+
+private:
+    bool open_(const char* path);
+    void close_();
+
+    bool flush_block_(bool partial);
+
+    audio::SampleSpec sample_spec_;
+
+    core::Optional<audio::PcmMapper> pcm_mapper_;
+    size_t sample_bits_;
+    bool direct_copy_;
+
+    core::Array<uint8_t> block_;
+    size_t block_bit_pos_;
+
+    int fd_;
+    bool close_fd_;
+    bool failed_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_PIPE_SINK_H_
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "roc_audio/pcm_format.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_sndio/pipe_source.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+// Minimum size of block read from input at once.
+// Matches default pipe capacity on Linux.
+enum { MinBlockSize = 64 * 1024 };
+
+} // namespace
+
+PipeSource::PipeSource(core::IArena& arena, const Config& config)
+    : sample_bits_(0)
+    , direct_copy_(false)
+    , block_(arena)
+    , block_len_(0)
+    , block_bit_pos_(0)
+    , fd_(-1)
+    , close_fd_(false)
+    , seekable_(false)
+    , eof_(false)
+    , valid_(false) {
+    if (config.latency != 0) {
+        roc_log(LogError, "pipe source: setting io latency not supported");
+        return;
+    }
+
+    sample_spec_ = config.sample_spec;
+
+    sample_spec_.use_defaults(audio::Sample_RawFormat, audio::ChanLayout_Surround,
+                              audio::ChanOrder_Smpte, audio::ChanMask_Surround_Stereo,
+                              44100);
+
+    if (!sample_spec_.is_valid()
+        || sample_spec_.sample_format() != audio::SampleFormat_Pcm) {
+        roc_log(LogError, "pipe source: invalid io encoding: %s",
+                audio::sample_spec_to_str(sample_spec_).c_str());
+        return;
+    }
+
+    pcm_mapper_.reset(new (pcm_mapper_) audio::PcmMapper(
+        sample_spec_.pcm_format(), audio::Sample_RawFormat));
+
+    sample_bits_ = pcm_mapper_->input_bit_count(1);
+
+    direct_copy_ = audio::pcm_format_traits(sample_spec_.pcm_format()).canon_id
+        == audio::pcm_format_traits(audio::Sample_RawFormat).canon_id;
+
+    // Block holds whole number of samples for all channels, and at least one frame.
+    const size_t unit_size = pcm_mapper_->input_byte_count(sample_spec_.num_channels());
+    size_t block_size = pcm_mapper_->input_byte_count(
+        sample_spec_.ns_2_samples_overall(config.frame_length));
+    if (block_size < MinBlockSize) {
+        block_size = MinBlockSize;
+    }
+    block_size = (block_size + unit_size - 1) / unit_size * unit_size;
+
+    if (!block_.resize(block_size)) {
+        roc_log(LogError, "pipe source: can't allocate block: size=%lu",
+                (unsigned long)block_size);
+        return;
+    }
+
+    valid_ = true;
+}
+
+PipeSource::~PipeSource() {
+    close_();
+}
+
+bool PipeSource::is_valid() const {
+    return valid_;
+}
+
+bool PipeSource::open(const char* path) {
+    roc_panic_if(!valid_);
+
+    if (!open_(path)) {
+        return false;
+    }
+
+    return true;
+}
+
+ISink* PipeSource::to_sink() {
+    return NULL;
+}
+
+ISource* PipeSource::to_source() {
+    return this;
+}
+
+DeviceType PipeSource::type() const {
+    return DeviceType_Source;
+}
+
+DeviceState PipeSource::state() const {
+    return DeviceState_Active;
+}
+
+void PipeSource::pause() {
+    // no-op
+}
+
+bool PipeSource::resume() {
+    return true;
+}
+
+bool PipeSource::restart() {
+    if (fd_ == -1) {
+        roc_panic("pipe source: not opened");
+    }
+
+    roc_log(LogDebug, "pipe source: restarting");
+
+    if (!seekable_) {
+        roc_log(LogError, "pipe source: can't restart non-seekable input");
+        return false;
+    }
+
+    if (lseek(fd_, 0, SEEK_SET) != 0) {
+        roc_log(LogError, "pipe source: lseek(): %s", core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    block_len_ = 0;
+    block_bit_pos_ = 0;
+    eof_ = false;
+
+    return true;
+}
+
+audio::SampleSpec PipeSource::sample_spec() const {
+    if (fd_ == -1) {
+        roc_panic("pipe source: not opened");
+    }
+
+    return audio::SampleSpec(sample_spec_.sample_rate(), audio::Sample_RawFormat,
+                             sample_spec_.channel_set());
+}
+
+core::nanoseconds_t PipeSource::latency() const {
+    return 0;
+}
+
+bool PipeSource::has_latency() const {
+    return false;
+}
+
+bool PipeSource::has_clock() const {
+    return false;
+}
+
+void PipeSource::reclock(core::nanoseconds_t timestamp) {
+    // no-op
+}
+
+bool PipeSource::read(audio::Frame& frame) {
+    if (fd_ == -1) {
+        roc_panic("pipe source: not opened");
+    }
+
+    audio::sample_t* frame_data = frame.raw_samples();
+    const size_t frame_size = frame.num_raw_samples();
+
+    size_t frame_pos = 0;
+
+    while (frame_pos < frame_size) {
+        size_t n_samples = (block_len_ * 8 - block_bit_pos_) / sample_bits_;
+
+        if (n_samples == 0) {
+            if (eof_ || !fill_block_()) {
+                break;
+            }
+            continue;
+        }
+
+        if (n_samples > frame_size - frame_pos) {
+            n_samples = frame_size - frame_pos;
+        }
+
+        if (direct_copy_ && block_bit_pos_ % 8 == 0) {
+            memcpy(frame_data + frame_pos, block_.data() + block_bit_pos_ / 8,
+                   n_samples * sizeof(audio::sample_t));
+            block_bit_pos_ += n_samples * sample_bits_;
+        } else {
+            size_t frame_bit_pos = frame_pos * sizeof(audio::sample_t) * 8;
+            pcm_mapper_->map(block_.data(), block_len_, block_bit_pos_, frame_data,
+                             frame_size * sizeof(audio::sample_t), frame_bit_pos,
+                             n_samples);
+        }
+
+        frame_pos += n_samples;
+    }
+
+    if (frame_pos == 0) {
+        return false;
+    }
+
+    if (frame_pos < frame_size) {
+        memset(frame_data + frame_pos, 0,
+               (frame_size - frame_pos) * sizeof(audio::sample_t));
+    }
+
+    return true;
+}
+
+bool PipeSource::fill_block_() {
+    // Move incomplete sample to the beginning of the block.
+    const size_t tail_pos = block_bit_pos_ / 8;
+    const size_t tail_len = block_len_ - tail_pos;
+
+    if (tail_len != 0) {
+        memmove(block_.data(), block_.data() + tail_pos, tail_len);
+    }
+
+    block_len_ = tail_len;
+    block_bit_pos_ %= 8;
+
+    // Single read() returns as much as is available, up to the block size,
+    // so that we don't wait until the whole block is filled.
+    for (;;) {
+        const ssize_t ret =
+            ::read(fd_, block_.data() + block_len_, block_.size() - block_len_);
+
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            roc_log(LogError, "pipe source: read(): %s",
+                    core::errno_to_str(errno).c_str());
+            eof_ = true;
+            return false;
+        }
+
+        if (ret == 0) {
+            roc_log(LogDebug, "pipe source: got eof from input");
+            eof_ = true;
+            return false;
+        }
+
+        block_len_ += (size_t)ret;
+        return true;
+    }
+}
+
+bool PipeSource::open_(const char* path) {
+    if (fd_ != -1) {
+        roc_panic("pipe source: already opened");
+    }
+
+    if (!path || strcmp(path, "-") == 0) {
+        fd_ = STDIN_FILENO;
+        close_fd_ = false;
+    } else {
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ == -1) {
+            roc_log(LogDebug, "pipe source: open(): path=%s: %s", path,
+                    core::errno_to_str(errno).c_str());
+            return false;
+        }
+        close_fd_ = true;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) == 0) {
+        seekable_ = S_ISREG(st.st_mode);
+
+#ifdef F_SETPIPE_SZ
+        if (S_ISFIFO(st.st_mode)) {
+            // Grow pipe buffer to fit the whole block, so that writer can
+            // enqueue a block while we're processing previous one.
+            // Fails if block is larger than allowed for user, that's ok.
+            (void)fcntl(fd_, F_SETPIPE_SZ, (int)block_.size());
+        }
+#endif
+    }
+
+    roc_log(LogInfo,
+            "pipe source: opened input: path=%s encoding=%s block_size=%lu direct=%d",
+            path ? path : "-", audio::sample_spec_to_str(sample_spec_).c_str(),
+            (unsigned long)block_.size(), (int)direct_copy_);
+
+    return true;
+}
+
+void PipeSource::close_() {
+    if (fd_ == -1) {
+        return;
+    }
+
+    if (close_fd_ && ::close(fd_) != 0) {
+        roc_log(LogError, "pipe source: close(): %s", core::errno_to_str(errno).c_str());
+    }
+
+    fd_ = -1;
+}
+
+} // namespace sndio
+} // namespace roc
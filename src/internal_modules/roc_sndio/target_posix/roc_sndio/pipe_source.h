@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/pipe_source.h
+//! @brief Raw PCM pipe source.
+
+#ifndef ROC_SNDIO_PIPE_SOURCE_H_
+#define ROC_SNDIO_PIPE_SOURCE_H_
+
+#include "roc_audio/pcm_mapper.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/stddefs.h"
+#include "roc_sndio/config.h"
+#include "roc_sndio/isource.h"
+
+namespace roc {
+namespace sndio {
+
+//! Raw PCM pipe source.
+//! @remarks
+//!  Reads headerless PCM stream from stdin, FIFO, or file.
+//!
+//!  Stream encoding is defined by sample spec from config. Data is read
+//!  in large blocks, aligned to whole samples for all channels, and samples
+//!  are mapped from block directly into frame.
+class PipeSource : public ISource, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PipeSource(core::IArena& arena, const Config& config);
+
+    virtual ~PipeSource();
+
+    //! Check if the object was successfully constructed.
+    bool is_valid() const;
+
+    //! Open input file or pipe.
+    //!
+    //! @b Parameters
+    //!  - @p path is input file or FIFO path, "-" for stdin.
+    bool open(const char* path);
+
+    //! Cast IDevice to ISink.
+    virtual ISink* to_sink();
+
+    //! Cast IDevice to ISink.
+    virtual ISource* to_source();
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Get device state.
+    virtual DeviceState state() const;
+
+    //! Pause reading.
+    virtual void pause();
+
+    //! Resume paused reading.
+    virtual bool resume();
+
+    //! Restart reading from the beginning.
+    virtual bool restart();
+
+    //! Get sample specification of the source.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get latency of the source.
+    virtual core::nanoseconds_t latency() const;
+
+    //! Check if the source supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the source has own clock.
+    virtual bool has_clock() const;
+
+    //! Adjust source clock to match consumer clock.
+    virtual void reclock(core::nanoseconds_t timestamp);
+
+    //! Read frame.
+    virtual bool read(audio::Frame& frame);
+
+private:
+    bool open_(const char* path);
+    void close_();
+
+    bool fill_block_();
+
+    audio::SampleSpec sample_spec_;
+
+    core::Optional<audio::PcmMapper> pcm_mapper_;
+    size_t sample_bits_;
+    bool direct_copy_;
+
+    core::Array<uint8_t> block_;
+    size_t block_len_;
+    size_t block_bit_pos_;
+
+    int fd_;
+    bool close_fd_;
+    bool seekable_;
+    bool eof_;
+
+    bool valid_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_PIPE_SOURCE_H_
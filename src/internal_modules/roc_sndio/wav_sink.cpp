@@ -16,8 +16,16 @@
 namespace roc {
 namespace sndio {
 
+namespace {
+
+// Mapped file is grown at least by this size.
+const size_t MinMapGrowth = 1024 * 1024;
+
+} // namespace
+
 WavSink::WavSink(core::IArena& arena, const Config& config)
-    : output_file_(NULL)
+    : mapped_pos_(0)
+    , output_file_(NULL)
     , valid_(false) {
     if (config.latency != 0) {
         roc_log(LogError, "wav sink: setting io latency not supported");
@@ -90,7 +98,7 @@ bool WavSink::restart() {
 }
 
 audio::SampleSpec WavSink::sample_spec() const {
-    if (!output_file_) {
+    if (!output_file_ && !mapped_file_.is_open()) {
         roc_panic("wav sink: not opened");
     }
 
@@ -110,7 +118,7 @@ bool WavSink::has_clock() const {
 }
 
 void WavSink::write(audio::Frame& frame) {
-    if (!output_file_) {
+    if (!output_file_ && !mapped_file_.is_open()) {
         roc_panic("wav sink: not opened");
     }
 
@@ -118,60 +126,117 @@ void WavSink::write(audio::Frame& frame) {
     size_t n_samples = frame.num_raw_samples();
 
     if (n_samples > 0) {
-        if (fseek(output_file_, 0, SEEK_SET)) {
-            roc_log(LogError, "wav sink: failed to seek to the beginning of the file: %s",
-                    core::errno_to_str(errno).c_str());
+        if (mapped_file_.is_open()) {
+            write_mapped_(samples, n_samples);
+        } else {
+            write_stream_(samples, n_samples);
         }
+    }
+}
 
-        const WavHeader::WavHeaderData& wav_header =
-            header_->update_and_get_header(n_samples);
-        if (fwrite(&wav_header, sizeof(wav_header), 1, output_file_) != 1) {
-            roc_log(LogError, "wav sink: failed to write header: %s",
-                    core::errno_to_str(errno).c_str());
-        }
+void WavSink::write_mapped_(const audio::sample_t* samples, size_t n_samples) {
+    const size_t n_bytes = n_samples * sizeof(audio::sample_t);
 
-        if (fseek(output_file_, 0, SEEK_END)) {
-            roc_log(LogError,
-                    "wav sink: failed to seek to append position of the file: %s",
-                    core::errno_to_str(errno).c_str());
+    if (mapped_pos_ + n_bytes > mapped_file_.size()) {
+        // grow exponentially, but not less than by minimum step
+        size_t new_size = mapped_file_.size() + mapped_file_.size() / 2;
+        if (new_size < mapped_file_.size() + MinMapGrowth) {
+            new_size = mapped_file_.size() + MinMapGrowth;
         }
-
-        if (fwrite(samples, sizeof(audio::sample_t), n_samples, output_file_)
-            != n_samples) {
-            roc_log(LogError, "wav sink: failed to write samples: %s",
-                    core::errno_to_str(errno).c_str());
+        if (new_size < mapped_pos_ + n_bytes) {
+            new_size = mapped_pos_ + n_bytes;
         }
 
-        if (fflush(output_file_)) {
-            roc_log(LogError, "wav sink: failed to flush data to the file: %s",
-                    core::errno_to_str(errno).c_str());
+        if (!mapped_file_.resize(new_size)) {
+            roc_log(LogError, "wav sink: failed to grow output file");
+            return;
         }
     }
+
+    memcpy(mapped_file_.data() + mapped_pos_, samples, n_bytes);
+    mapped_pos_ += n_bytes;
+
+    const WavHeader::WavHeaderData& wav_header =
+        header_->update_and_get_header(n_samples / header_->num_channels());
+    memcpy(mapped_file_.data(), &wav_header, sizeof(wav_header));
+}
+
+void WavSink::write_stream_(const audio::sample_t* samples, size_t n_samples) {
+    if (fseek(output_file_, 0, SEEK_SET)) {
+        roc_log(LogError, "wav sink: failed to seek to the beginning of the file: %s",
+                core::errno_to_str(errno).c_str());
+    }
+
+    const WavHeader::WavHeaderData& wav_header =
+        header_->update_and_get_header(n_samples / header_->num_channels());
+    if (fwrite(&wav_header, sizeof(wav_header), 1, output_file_) != 1) {
+        roc_log(LogError, "wav sink: failed to write header: %s",
+                core::errno_to_str(errno).c_str());
+    }
+
+    if (fseek(output_file_, 0, SEEK_END)) {
+        roc_log(LogError, "wav sink: failed to seek to append position of the file: %s",
+                core::errno_to_str(errno).c_str());
+    }
+
+    if (fwrite(samples, sizeof(audio::sample_t), n_samples, output_file_)
+        != n_samples) {
+        roc_log(LogError, "wav sink: failed to write samples: %s",
+                core::errno_to_str(errno).c_str());
+    }
+
+    if (fflush(output_file_)) {
+        roc_log(LogError, "wav sink: failed to flush data to the file: %s",
+                core::errno_to_str(errno).c_str());
+    }
 }
 
 bool WavSink::open_(const char* path) {
-    if (output_file_) {
+    if (output_file_ || mapped_file_.is_open()) {
         roc_panic("wav sink: already opened");
     }
 
-    output_file_ = fopen(path, "w");
-    if (!output_file_) {
-        roc_log(LogDebug, "wav sink: can't open output file: %s",
-                core::errno_to_str(errno).c_str());
-        return false;
+    if (mapped_file_.open_write(path)) {
+        if (!mapped_file_.resize(MinMapGrowth)) {
+            roc_log(LogDebug, "wav sink: can't allocate output file");
+            mapped_file_.close();
+            return false;
+        }
+
+        const WavHeader::WavHeaderData& wav_header = header_->update_and_get_header(0);
+        memcpy(mapped_file_.data(), &wav_header, sizeof(wav_header));
+        mapped_pos_ = sizeof(wav_header);
+    } else {
+        // not a regular file, fallback to stdio
+        output_file_ = fopen(path, "w");
+        if (!output_file_) {
+            roc_log(LogDebug, "wav sink: can't open output file: %s",
+                    core::errno_to_str(errno).c_str());
+            return false;
+        }
     }
 
     roc_log(LogInfo,
             "wav sink: opened output file:"
-            " path=%s out_bits=%lu out_rate=%lu out_ch=%lu",
+            " path=%s out_bits=%lu out_rate=%lu out_ch=%lu mapped=%d",
             path, (unsigned long)header_->bits_per_sample(),
             (unsigned long)header_->sample_rate(),
-            (unsigned long)header_->num_channels());
+            (unsigned long)header_->num_channels(), (int)mapped_file_.is_open());
 
     return true;
 }
 
 void WavSink::close_() {
+    if (mapped_file_.is_open()) {
+        roc_log(LogDebug, "wav sink: closing output file");
+
+        // cut off space allocated in advance
+        if (!mapped_file_.resize(mapped_pos_)) {
+            roc_log(LogError, "wav sink: can't truncate output file");
+        }
+        mapped_file_.close();
+    }
+
     if (!output_file_) {
         return;
     }
@@ -15,6 +15,7 @@
 #include "roc_audio/sample_spec.h"
 #include "roc_core/array.h"
 #include "roc_core/iarena.h"
+#include "roc_core/mapped_file.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/stddefs.h"
@@ -30,6 +31,10 @@ namespace sndio {
 //! WAV sink.
 //! @remarks
 //!  Writes samples to output file.
+//!
+//!  Regular files are memory-mapped and grown in large steps with disk space
+//!  allocated in advance, so that writing a frame is a memory copy. Other
+//!  files, like pipes, are written using buffered stdio.
 class WavSink : public ISink, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -89,8 +94,14 @@ private:
     bool open_(const char* path);
     void close_();
 
+    void write_mapped_(const audio::sample_t* samples, size_t n_samples);
+    void write_stream_(const audio::sample_t* samples, size_t n_samples);
+
     audio::SampleSpec sample_spec_;
 
+    core::MappedFile mapped_file_;
+    size_t mapped_pos_;
+
     FILE* output_file_;
     core::Optional<WavHeader> header_;
 
@@ -7,6 +7,8 @@
  */
 
 #include "roc_sndio/wav_source.h"
+#include "roc_audio/pcm_format.h"
+#include "roc_audio/sample_format.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 
@@ -16,6 +18,10 @@ namespace sndio {
 WavSource::WavSource(core::IArena& arena, const Config& config)
     : file_opened_(false)
     , eof_(false)
+    , mapped_direct_copy_(false)
+    , mapped_data_begin_(0)
+    , mapped_data_end_(0)
+    , mapped_data_pos_(0)
     , valid_(false) {
     if (config.latency != 0) {
         roc_log(LogError, "wav source: setting io latency not supported");
@@ -79,7 +85,9 @@ bool WavSource::restart() {
 
     roc_log(LogDebug, "wav source: restarting");
 
-    if (!drwav_seek_to_pcm_frame(&wav_, 0)) {
+    if (mapped_pcm_mapper_) {
+        mapped_data_pos_ = mapped_data_begin_;
+    } else if (!drwav_seek_to_pcm_frame(&wav_, 0)) {
         roc_log(LogError, "wav source: seek failed when restarting");
         return false;
     }
@@ -128,6 +136,54 @@ bool WavSource::read(audio::Frame& frame) {
         return false;
     }
 
+    if (mapped_pcm_mapper_) {
+        return read_mapped_(frame);
+    }
+
+    return read_decoded_(frame);
+}
+
+bool WavSource::read_mapped_(audio::Frame& frame) {
+    audio::sample_t* frame_data = frame.raw_samples();
+    const size_t frame_size = frame.num_raw_samples();
+
+    size_t n_samples = mapped_pcm_mapper_->input_sample_count(mapped_data_end_
+                                                              - mapped_data_pos_);
+    if (n_samples > frame_size) {
+        n_samples = frame_size;
+    }
+
+    if (n_samples == 0) {
+        roc_log(LogDebug, "wav source: got eof from input file");
+        eof_ = true;
+        return false;
+    }
+
+    const uint8_t* mapped_data = mapped_file_.data() + mapped_data_pos_;
+    const size_t mapped_size = mapped_pcm_mapper_->input_byte_count(n_samples);
+
+    if (mapped_direct_copy_) {
+        memcpy(frame_data, mapped_data, mapped_size);
+    } else {
+        size_t in_off = 0, out_off = 0;
+        mapped_pcm_mapper_->map(mapped_data, mapped_size, in_off, frame_data,
+                                frame_size * sizeof(audio::sample_t), out_off,
+                                n_samples);
+    }
+
+    mapped_data_pos_ += mapped_size;
+
+    if (n_samples < frame_size) {
+        roc_log(LogDebug, "wav source: got eof from input file");
+        eof_ = true;
+        memset(frame_data + n_samples, 0,
+               (frame_size - n_samples) * sizeof(audio::sample_t));
+    }
+
+    return true;
+}
+
+bool WavSource::read_decoded_(audio::Frame& frame) {
     audio::sample_t* frame_data = frame.raw_samples();
     size_t frame_left = frame.num_raw_samples();
 
@@ -164,19 +220,88 @@ bool WavSource::open_(const char* path) {
         roc_panic("wav source: already opened");
     }
 
-    if (!drwav_init_file(&wav_, path, NULL)) {
-        roc_log(LogDebug, "wav sink: can't open input file: %s",
-                core::errno_to_str(errno).c_str());
-        return false;
+    if (mapped_file_.open_read(path)) {
+        // parse header from mapping
+        if (!drwav_init_memory(&wav_, mapped_file_.data(), mapped_file_.size(),
+                               NULL)) {
+            roc_log(LogDebug, "wav source: can't parse input file: path=%s", path);
+            mapped_file_.close();
+            return false;
+        }
+        file_opened_ = true;
+
+        if (!open_mapped_()) {
+            // samples will be decoded by dr_wav from mapping
+            mapped_pcm_mapper_.reset();
+        }
+    } else {
+        // not a regular file, fallback to stdio
+        if (!drwav_init_file(&wav_, path, NULL)) {
+            roc_log(LogDebug, "wav source: can't open input file: %s",
+                    core::errno_to_str(errno).c_str());
+            return false;
+        }
+        file_opened_ = true;
     }
 
     roc_log(LogInfo,
             "wav source: opened input file:"
-            " path=%s in_bits=%lu in_rate=%lu in_ch=%lu",
+            " path=%s in_bits=%lu in_rate=%lu in_ch=%lu mapped=%d direct=%d",
             path, (unsigned long)wav_.bitsPerSample, (unsigned long)wav_.sampleRate,
-            (unsigned long)wav_.channels);
+            (unsigned long)wav_.channels, (int)mapped_file_.is_open(),
+            (int)mapped_direct_copy_);
+
+    return true;
+}
+
+bool WavSource::open_mapped_() {
+    audio::PcmFormat in_format = audio::PcmFormat_Invalid;
+
+    if (wav_.translatedFormatTag == DR_WAVE_FORMAT_PCM) {
+        switch (wav_.bitsPerSample) {
+        case 8:
+            in_format = audio::PcmFormat_UInt8;
+            break;
+        case 16:
+            in_format = audio::PcmFormat_SInt16_Le;
+            break;
+        case 24:
+            in_format = audio::PcmFormat_SInt24_Le;
+            break;
+        case 32:
+            in_format = audio::PcmFormat_SInt32_Le;
+            break;
+        }
+    } else if (wav_.translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+        switch (wav_.bitsPerSample) {
+        case 32:
+            in_format = audio::PcmFormat_Float32_Le;
+            break;
+        case 64:
+            in_format = audio::PcmFormat_Float64_Le;
+            break;
+        }
+    }
+
+    if (in_format == audio::PcmFormat_Invalid
+        || wav_.fmt.blockAlign != wav_.channels * wav_.bitsPerSample / 8) {
+        return false;
+    }
+
+    mapped_pcm_mapper_.reset(new (mapped_pcm_mapper_)
+                                 audio::PcmMapper(in_format, audio::Sample_RawFormat));
+
+    mapped_direct_copy_ = audio::pcm_format_traits(in_format).canon_id
+        == audio::pcm_format_traits(audio::Sample_RawFormat).canon_id;
+
+    mapped_data_begin_ = (size_t)wav_.dataChunkDataPos;
+    mapped_data_end_ = mapped_data_begin_ + (size_t)wav_.dataChunkDataSize;
+    if (mapped_data_end_ > mapped_file_.size()) {
+        // header may be not updated if file wasn't closed properly
+        mapped_data_end_ = mapped_file_.size();
+    }
+    mapped_data_pos_ = mapped_data_begin_;
 
-    file_opened_ = true;
     return true;
 }
 
@@ -187,6 +312,9 @@ void WavSource::close_() {
 
     file_opened_ = false;
     drwav_uninit(&wav_);
+
+    mapped_pcm_mapper_.reset();
+    mapped_file_.close();
 }
 
 } // namespace sndio
@@ -14,10 +14,13 @@
 
 #include <dr_wav.h>
 
+#include "roc_audio/pcm_mapper.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_core/array.h"
 #include "roc_core/iarena.h"
+#include "roc_core/mapped_file.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/string_buffer.h"
 #include "roc_packet/units.h"
@@ -28,6 +31,11 @@ namespace roc {
 namespace sndio {
 
 //! WAV source.
+//! @remarks
+//!  Regular files are memory-mapped. If samples are stored in raw sample
+//!  format, they are copied from the mapping into frames as is; other PCM
+//!  formats are converted straight from the mapping using PcmMapper.
+//!  Other files, like pipes, and other encodings are decoded by dr_wav.
 class WavSource : public ISource, private core::NonCopyable<> {
 public:
     //! Initialize.
@@ -88,12 +96,23 @@ public:
 
 private:
     bool open_(const char* path);
+    bool open_mapped_();
     void close_();
 
+    bool read_mapped_(audio::Frame& frame);
+    bool read_decoded_(audio::Frame& frame);
+
     drwav wav_;
     bool file_opened_;
     bool eof_;
 
+    core::MappedFile mapped_file_;
+    core::Optional<audio::PcmMapper> mapped_pcm_mapper_;
+    bool mapped_direct_copy_;
+    size_t mapped_data_begin_;
+    size_t mapped_data_end_;
+    size_t mapped_data_pos_;
+
     bool valid_;
 };
 
@@ -600,6 +600,114 @@ typedef enum roc_resampler_profile {
     ROC_RESAMPLER_PROFILE_LOW = 3
 } roc_resampler_profile;
 
+/** Thread scheduler.
+ *
+ * Defines scheduling policy of a thread.
+ *
+ * \see roc_thread_policy
+ */
+typedef enum roc_thread_scheduler {
+    /** Default scheduler.
+     * Scheduler is not changed and is inherited from the creating thread.
+     */
+    ROC_THREAD_SCHEDULER_DEFAULT = 0,
+
+    /** Real-time first-in first-out scheduler (SCHED_FIFO).
+     * Usually requires elevated privileges.
+     */
+    ROC_THREAD_SCHEDULER_FIFO = 1,
+
+    /** Real-time round-robin scheduler (SCHED_RR).
+     * Usually requires elevated privileges.
+     */
+    ROC_THREAD_SCHEDULER_RR = 2
+} roc_thread_scheduler;
+
+/** Thread policy.
+ *
+ * Defines scheduling parameters of an internal thread.
+ *
+ * If some of the parameters can't be applied, e.g. due to insufficient privileges
+ * or lack of support on the platform, an error is logged and the thread continues
+ * with default parameters.
+ *
+ * It is safe to memset() this struct with zeros to get a default policy, which
+ * doesn't change anything.
+ *
+ * \see roc_context_config
+ */
+typedef struct roc_thread_policy {
+    /** Thread scheduler.
+     *
+     * If zero, scheduler is not changed.
+     */
+    roc_thread_scheduler scheduler;
+
+    /** Real-time priority.
+     *
+     * Allowed only with real-time schedulers, should be zero with
+     * ROC_THREAD_SCHEDULER_DEFAULT. Should be in range [1; 99] on Linux.
+     *
+     * If zero, maximum priority allowed for the scheduler is used.
+     */
+    int priority;
+
+    /** Nice level.
+     *
+     * Should be in range [-20; 19]. Negative values usually require elevated
+     * privileges. Currently supported only on Linux.
+     *
+     * If zero, nice level is not changed.
+     */
+    int nice;
+
+    /** CPU affinity mask.
+     *
+     * N-th bit enables N-th CPU. Currently supported only on Linux.
+     *
+     * If zero, affinity is not changed.
+     */
+    unsigned long long cpu_mask;
+} roc_thread_policy;
+
+/** Memory allocator.
+ *
+ * Allows to route all memory allocated by context and objects attached to it to
+ * application's own allocator, e.g. NUMA-local pool, huge-page arena, or real-time
+ * heap.
+ *
+ * Functions should be thread-safe, because they can be invoked from user threads
+ * and from internal threads of context.
+ *
+ * It is safe to memset() this struct with zeros, which means that default allocator
+ * is used.
+ *
+ * \see roc_context_config
+ */
+typedef struct roc_allocator {
+    /** Allocate memory.
+     *
+     * Should return pointer to at least \p size bytes, aligned at least as memory
+     * returned by malloc(), or NULL on failure. \p arg is set to \c arg field of
+     * this struct.
+     *
+     * If NULL, default allocator is used.
+     */
+    void* (*allocate)(size_t size, void* arg);
+
+    /** Deallocate memory.
+     *
+     * Should free memory returned by \c allocate. \p arg is set to \c arg field of
+     * this struct.
+     *
+     * Should be NULL if and only if \c allocate is NULL.
+     */
+    void (*deallocate)(void* ptr, void* arg);
+
+    /** Opaque argument passed to \c allocate and \c deallocate. */
+    void* arg;
+} roc_allocator;
+
 /** Context configuration.
  *
  * It is safe to memset() this struct with zeros to get a default config. It is also
@@ -625,6 +733,87 @@ typedef struct roc_context_config {
      * If zero, default value is used.
      */
     unsigned int max_frame_size;
+
+    /** Scheduling policy of network thread.
+     *
+     * Network thread is created by context and performs all network I/O.
+     *
+     * If zero, default policy is used.
+     */
+    roc_thread_policy network_thread;
+
+    /** Scheduling policy of control thread.
+     *
+     * Control thread is created by context and performs background control tasks,
+     * like signaling protocols and processing of pipeline tasks.
+     *
+     * If zero, default policy is used.
+     */
+    roc_thread_policy control_thread;
+
+    /** Number of network packets to preallocate.
+     *
+     * If non-zero, memory for this number of packets is allocated and pre-faulted
+     * when context is opened, so that first sessions and traffic bursts don't
+     * cause allocations and page faults on real-time threads.
+     *
+     * If zero, memory is allocated on demand.
+     */
+    unsigned int prealloc_packets;
+
+    /** Number of audio frames to preallocate.
+     *
+     * If non-zero, memory for this number of intermediate internal frames is
+     * allocated and pre-faulted when context is opened.
+     *
+     * If zero, memory is allocated on demand.
+     */
+    unsigned int prealloc_frames;
+
+    /** Lock preallocated memory in RAM.
+     *
+     * If non-zero, memory preallocated according to \c prealloc_packets and
+     * \c prealloc_frames is locked using mlock(), so that it's never paged out.
+     * Locked memory is mapped from system in separate regular pages, bypassing
+     * \c allocator and \c huge_pages.
+     * Usually requires elevated privileges or increased memlock limit.
+     * If locking fails, context can't be opened.
+     */
+    int lock_memory;
+
+    /** Disable growing of preallocated memory.
+     *
+     * If non-zero, when memory preallocated according to \c prealloc_packets or
+     * \c prealloc_frames is exhausted, new packets or frames are dropped instead
+     * of allocating more memory. This guarantees allocation-free operation, but
+     * requires choosing preallocation sizes carefully. Maximum number of packets
+     * and frames used at the same time is logged when context is closed, and can
+     * be retrieved using roc_context_query().
+     */
+    int fixed_pools;
+
+    /** Back packet and frame pools with huge pages.
+     *
+     * If non-zero, memory for packet and frame pools is mapped using huge pages,
+     * which reduces TLB misses when many sessions are active. On Linux, explicit
+     * huge pages are used if they are reserved in system (vm.nr_hugepages),
+     * otherwise transparent huge pages are requested. On other platforms, regular
+     * pages are used. Pool memory is never allocated using \c allocator.
+     * Not applied to memory locked according to \c lock_memory.
+     *
+     * If zero, pools use same memory as the rest of context.
+     */
+    int huge_pages;
+
+    /** Memory allocator.
+     *
+     * If set, all memory of context and objects attached to it, including packet
+     * and frame pools, is allocated using provided functions. Memory usage can be
+     * retrieved using roc_context_query().
+     *
+     * If zero, default allocator is used.
+     */
+    roc_allocator allocator;
 } roc_context_config;
 
 /** Sender configuration.
@@ -793,6 +982,16 @@ typedef struct roc_sender_config {
      * If zero, default value is used (if latency tuning is enabled on sender).
      */
     unsigned long long latency_tolerance;
+
+    /** Enable timing of pipeline stages.
+     *
+     * If non-zero, sender measures time spent in resampler, channel mapper,
+     * packetizer, and FEC writer, and reports it in \ref roc_sender_metrics.
+     * Measurements add small overhead per frame and per packet.
+     *
+     * If zero, timing is disabled.
+     */
+    int enable_stage_timing;
 } roc_sender_config;
 
 /** Receiver configuration.
@@ -910,6 +1109,17 @@ typedef struct roc_receiver_config {
      * If zero, default value is used. If negative, the check is disabled.
      */
     long long choppy_playback_timeout;
+
+    /** Enable timing of pipeline stages.
+     *
+     * If non-zero, receiver measures time spent in depacketizer, FEC reader,
+     * channel mapper, resampler, and mixer, and reports it in
+     * \ref roc_connection_metrics and \ref roc_receiver_metrics.
+     * Measurements add small overhead per frame and per packet.
+     *
+     * If zero, timing is disabled.
+     */
+    int enable_stage_timing;
 } roc_receiver_config;
 
 /** Interface configuration.
@@ -15,6 +15,7 @@
 #define ROC_CONTEXT_H_
 
 #include "roc/config.h"
+#include "roc/metrics.h"
 #include "roc/platform.h"
 
 #ifdef __cplusplus
@@ -96,6 +97,28 @@ ROC_API int roc_context_register_encoding(roc_context* context,
                                           int encoding_id,
                                           const roc_media_encoding* encoding);
 
+/** Query context metrics.
+ *
+ * Reads memory usage of the context and all objects attached to it, and writes it
+ * into the provided struct.
+ *
+ * Can be used to verify memory budget, or to choose preallocation sizes for
+ * \c fixed_pools mode in \ref roc_context_config.
+ *
+ * **Parameters**
+ *  - \p context should point to an opened context
+ *  - \p metrics defines a struct where to write metrics
+ *
+ * **Returns**
+ *  - returns zero if the metrics were successfully retrieved
+ *  - returns a negative value if the arguments are invalid
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownership of \p metrics; it may be safely deallocated
+ *    after the function returns
+ */
+ROC_API int roc_context_query(roc_context* context, roc_context_metrics* metrics);
+
 /** Close the context.
  *
  * Stops any started background threads, deinitializes and deallocates the context.
@@ -138,6 +138,32 @@ ROC_API void roc_log_set_level(roc_log_level level);
  */
 ROC_API void roc_log_set_handler(roc_log_handler handler, void* argument);
 
+/** Enable or disable asynchronous logging.
+ *
+ * If \p enabled is non-zero, messages are formatted on the calling thread, put into
+ * a lock-free queue, and passed to the handler (or printed to stderr) from a background
+ * thread. Threads producing logs never block on output or on each other. If the queue
+ * is full, messages are dropped, and the number of dropped messages is periodically
+ * logged.
+ *
+ * If \p enabled is zero, messages are passed to the handler from the calling thread.
+ * The function blocks until messages enqueued before the call are passed to the
+ * handler. By default asynchronous logging is disabled.
+ *
+ * When the process exits normally (by returning from \c main() or calling \c exit()),
+ * enqueued messages are delivered and the background thread is stopped. After that,
+ * asynchronous logging can't be enabled again.
+ *
+ * **Returns**
+ *  - returns zero if the mode was successfully changed
+ *  - returns a negative value if the background thread can't be started
+ *
+ * **Thread safety**
+ *
+ * Can be used concurrently.
+ */
+ROC_API int roc_log_set_async(int enabled);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
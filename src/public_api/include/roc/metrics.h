@@ -20,6 +20,33 @@
 extern "C" {
 #endif
 
+/** Timing of a pipeline stage.
+ *
+ * Summarizes distribution of time spent in one stage of processing pipeline,
+ * like resampler or FEC decoder, per one invocation (typically per frame or
+ * per packet). Allows to find out which stage doesn't fit into frame deadline.
+ *
+ * Collected only if \ref roc_sender_config.enable_stage_timing or
+ * \ref roc_receiver_config.enable_stage_timing is set. Otherwise, or if the
+ * stage is not used, all fields are zero.
+ *
+ * Values are computed from histogram and have precision about 12%.
+ * All values are in nanoseconds.
+ */
+typedef struct roc_stage_timing {
+    /** Median time. */
+    unsigned long long p50;
+
+    /** 99th percentile of time. */
+    unsigned long long p99;
+
+    /** 99.9th percentile of time. */
+    unsigned long long p999;
+
+    /** Maximum time. */
+    unsigned long long max;
+} roc_stage_timing;
+
 /** Metrics for a single connection between sender and receiver.
  *
  * On receiver, represents one connected sender. Similarly, on sender
@@ -43,6 +70,30 @@ typedef struct roc_connection_metrics {
      * May be zero initially, until enough statistics is accumulated.
      */
     unsigned long long e2e_latency;
+
+    /** Time spent in depacketizer, per frame.
+     *
+     * Includes decoding of packets. Filled only on receiver.
+     */
+    roc_stage_timing depacketizer_timing;
+
+    /** Time spent in FEC reader, per packet.
+     *
+     * Includes restoring lost packets. Filled only on receiver.
+     */
+    roc_stage_timing fec_reader_timing;
+
+    /** Time spent in channel mapper, per frame.
+     *
+     * Filled only on receiver.
+     */
+    roc_stage_timing channel_mapper_timing;
+
+    /** Time spent in resampler, per frame.
+     *
+     * Filled only on receiver.
+     */
+    roc_stage_timing resampler_timing;
 } roc_connection_metrics;
 
 /** Receiver metrics.
@@ -57,6 +108,14 @@ typedef struct roc_receiver_metrics {
      * When there are no connections, receiver produces silence.
      */
     unsigned int connection_count;
+
+    /** Time spent in mixer, per frame.
+     *
+     * Mixer is shared by all slots of the receiver. If connections are
+     * processed without additional threads, time spent in per-connection
+     * stages is excluded.
+     */
+    roc_stage_timing mixer_timing;
 } roc_receiver_metrics;
 
 /** Sender metrics.
@@ -78,8 +137,74 @@ typedef struct roc_sender_metrics {
      * connections, one per each discovered receiver.
      */
     unsigned int connection_count;
+
+    /** Time spent in resampler, per frame. */
+    roc_stage_timing resampler_timing;
+
+    /** Time spent in channel mapper, per frame. */
+    roc_stage_timing channel_mapper_timing;
+
+    /** Time spent in packetizer, per frame.
+     *
+     * Includes encoding of packets.
+     */
+    roc_stage_timing packetizer_timing;
+
+    /** Time spent in FEC writer, per packet.
+     *
+     * Includes generating repair packets.
+     */
+    roc_stage_timing fec_writer_timing;
 } roc_sender_metrics;
 
+/** Memory pool metrics.
+ *
+ * Describes usage of one of the context memory pools.
+ */
+typedef struct roc_pool_metrics {
+    /** Number of currently used objects. */
+    unsigned long long num_used;
+
+    /** Maximum number of objects used at the same time.
+     *
+     * Can be used to choose preallocation sizes in \ref roc_context_config.
+     */
+    unsigned long long max_used;
+
+    /** Number of objects that can be used without allocating more memory. */
+    unsigned long long capacity;
+} roc_pool_metrics;
+
+/** Context metrics.
+ *
+ * Describes memory usage of context and all objects attached to it.
+ */
+typedef struct roc_context_metrics {
+    /** Number of currently allocated memory blocks. */
+    unsigned long long allocated_blocks;
+
+    /** Number of currently allocated bytes.
+     *
+     * Includes allocator overhead.
+     */
+    unsigned long long allocated_bytes;
+
+    /** Maximum number of bytes allocated at the same time. */
+    unsigned long long max_allocated_bytes;
+
+    /** Number of failed allocations. */
+    unsigned long long failed_allocations;
+
+    /** Usage of network packets pool. */
+    roc_pool_metrics packet_pool;
+
+    /** Usage of network packet buffers pool. */
+    roc_pool_metrics packet_buffer_pool;
+
+    /** Usage of audio frame buffers pool. */
+    roc_pool_metrics frame_buffer_pool;
+} roc_context_metrics;
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
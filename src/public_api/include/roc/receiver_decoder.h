@@ -48,7 +48,7 @@ extern "C" {
  *   and control packets).
  *
  * - The per-interface streams of encoded packets are iteratively pushed to the decoder
- *   using roc_receiver_decoder_push_packet().
+ *   using roc_receiver_decoder_push_packet() or roc_receiver_decoder_push_packets().
  *
  * - The audio stream is iteratively popped from the decoder using
  *   roc_receiver_decoder_pop_frame(). User should push all available packets to all
@@ -196,6 +196,42 @@ ROC_API int roc_receiver_decoder_push_packet(roc_receiver_decoder* decoder,
                                              roc_interface iface,
                                              const roc_packet* packet);
 
+/** Write multiple packets to decoder.
+ *
+ * Same as roc_receiver_decoder_push_packet(), but adds an array of packets to the
+ * interface queue in one call. Arguments are checked and interface is resolved once
+ * per call instead of once per packet, which reduces overhead when the user delivers
+ * packets in bursts, e.g. from a userspace network stack.
+ *
+ * Packets are pushed in order. Failure of one packet doesn't prevent pushing the
+ * rest of them.
+ *
+ * **Parameters**
+ *  - \p decoder should point to an opened decoder
+ *  - \p packets should point to an array of \p packets_count initialized packets;
+ *    each should contain pointer to a buffer and it's size; the buffers are fully
+ *    copied into decoder
+ *  - \p statuses should be either NULL or point to an array of \p packets_count
+ *    elements; for each packet, zero is written if the packet was successfully copied
+ *    to decoder, and a negative value otherwise
+ *
+ * **Returns**
+ *  - returns zero if all packets were successfully copied to decoder
+ *  - returns a negative value if at least one packet was not copied; see \p statuses
+ *  - returns a negative value if the interface is not activated
+ *  - returns a negative value if the decoder, interface, or packets array are invalid;
+ *    in this case no packets are copied
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownership of \p packets and \p statuses; they may be
+ *    safely deallocated after the function returns
+ */
+ROC_API int roc_receiver_decoder_push_packets(roc_receiver_decoder* decoder,
+                                              roc_interface iface,
+                                              const roc_packet* packets,
+                                              size_t packets_count,
+                                              int* statuses);
+
 /** Read feedback packet from decoder.
  *
  * Removes encoded feedback packet from control interface queue and returns it
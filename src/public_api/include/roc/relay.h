@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * \file roc/relay.h
+ * \brief Roc relay.
+ */
+
+#ifndef ROC_RELAY_H_
+#define ROC_RELAY_H_
+
+#include "roc/config.h"
+#include "roc/context.h"
+#include "roc/endpoint.h"
+#include "roc/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Relay peer.
+ *
+ * Relay gets the network packets from a sender and forwards them to multiple receivers,
+ * without decoding audio stream.
+ *
+ * **Context**
+ *
+ * Relay is automatically attached to a context when opened and detached from it when
+ * closed. The user should not close the context until the relay is closed.
+ *
+ * Packet reception and sending is performed in the context network worker threads.
+ * Forwarding is performed on a dedicated thread of the relay, which wakes up when
+ * new packets arrive or when it's time to generate RTCP reports.
+ *
+ * **Life cycle**
+ *
+ * - A relay is created using roc_relay_open().
+ *
+ * - The relay binds its input interfaces to local endpoints using roc_relay_bind(),
+ *   allowing sender to send packets to them.
+ *
+ * - The relay connects its output slots to remote receiver endpoints using
+ *   roc_relay_connect(). Every packet received on input is forwarded to all outputs.
+ *
+ * - The relay is destroyed using roc_relay_close().
+ *
+ * **Slots, interfaces, and endpoints**
+ *
+ * Relay has a single input and one or multiple output **slots**. Input consists of
+ * interfaces bound to local endpoints. Each output slot consists of interfaces connected
+ * to remote endpoints of a single receiver. Slots are numbered from zero and are created
+ * automatically.
+ *
+ * Supported interface configurations:
+ *
+ *   - Bind \ref ROC_INTERFACE_AUDIO_SOURCE, \ref ROC_INTERFACE_AUDIO_REPAIR (optionally,
+ *     for FEC), and \ref ROC_INTERFACE_AUDIO_CONTROL (optionally, for control messages)
+ *     to local endpoints.
+ *   - Connect the same interfaces of each output slot to remote endpoints. Source and
+ *     repair interfaces should use the same protocols as corresponding input interfaces.
+ *
+ * Slots can be removed using roc_relay_unlink(). Removing a slot also removes all its
+ * interfaces.
+ *
+ * **RTCP**
+ *
+ * Relay acts as an RTP translator. Each output uses its own SSRC and CNAME in RTCP.
+ * If relay rewrites RTP headers (when FEC is not used), output sends sender reports
+ * for the rewritten stream. Receiver reports from receivers are consumed by relay.
+ *
+ * **Thread safety**
+ *
+ * Can be used concurrently.
+ */
+typedef struct roc_relay roc_relay;
+
+/** Open a new relay.
+ *
+ * Allocates and initializes a new relay, and attaches it to the context.
+ *
+ * **Parameters**
+ *  - \p context should point to an opened context
+ *  - \p result should point to an unitialized roc_relay pointer
+ *
+ * **Returns**
+ *  - returns zero if the relay was successfully created
+ *  - returns a negative value if the arguments are invalid
+ *  - returns a negative value on resource allocation failure
+ *
+ * **Ownership**
+ *  - passes the ownership of \p result to the user; the user is responsible to call
+ *    roc_relay_close() to free it
+ *  - attaches created relay to \p context; the user should not close context
+ *    before closing relay
+ */
+ROC_API int roc_relay_open(roc_context* context, roc_relay** result);
+
+/** Bind the relay input interface to a local endpoint.
+ *
+ * Checks that the endpoint is valid and supported by the interface, allocates
+ * a new ingoing port, and binds it to the local endpoint.
+ *
+ * Each input interface can be bound only once.
+ *
+ * If \p endpoint has explicitly set zero port, the relay is bound to a randomly
+ * chosen ephemeral port. If the function succeeds, the actual port to which the
+ * relay was bound is written back to \p endpoint.
+ *
+ * **Parameters**
+ *  - \p relay should point to an opened relay
+ *  - \p iface specifies the relay interface
+ *  - \p endpoint specifies the relay endpoint
+ *
+ * **Returns**
+ *  - returns zero if the relay was successfully bound to a port
+ *  - returns a negative value if the arguments are invalid
+ *  - returns a negative value if the address can't be bound
+ *  - returns a negative value on resource allocation failure
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownership of \p endpoint; it may be safely deallocated
+ *    after the function returns
+ */
+ROC_API int roc_relay_bind(roc_relay* relay, roc_interface iface, roc_endpoint* endpoint);
+
+/** Connect the relay output interface to a remote endpoint.
+ *
+ * Checks that the endpoint is valid and supported by the interface, allocates
+ * a new outgoing port, and connects it to the remote endpoint.
+ *
+ * Each slot's interface can be connected only once. Source and repair interfaces
+ * should be bound on input before they are connected on output.
+ *
+ * Automatically initializes slot with given index if it's used first time.
+ *
+ * If an error happens during connect, the slot is kept. The user may retry connecting
+ * the interface or remove the slot using roc_relay_unlink().
+ *
+ * **Parameters**
+ *  - \p relay should point to an opened relay
+ *  - \p slot specifies the output slot
+ *  - \p iface specifies the relay interface
+ *  - \p endpoint specifies the receiver endpoint
+ *
+ * **Returns**
+ *  - returns zero if the relay was successfully connected
+ *  - returns a negative value if the arguments are invalid
+ *  - returns a negative value on resource allocation failure
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownership of \p endpoint; it may be safely deallocated
+ *    after the function returns
+ */
+ROC_API int roc_relay_connect(roc_relay* relay,
+                              roc_slot slot,
+                              roc_interface iface,
+                              const roc_endpoint* endpoint);
+
+/** Delete relay output slot.
+ *
+ * Disconnects and removes all slot interfaces and removes the slot.
+ *
+ * After unlinking the slot, it can be re-created again by re-using slot index.
+ *
+ * **Parameters**
+ *  - \p relay should point to an opened relay
+ *  - \p slot specifies the output slot
+ *
+ * **Returns**
+ *  - returns zero if the slot was successfully removed
+ *  - returns a negative value if the arguments are invalid
+ *  - returns a negative value if the slot does not exist
+ */
+ROC_API int roc_relay_unlink(roc_relay* relay, roc_slot slot);
+
+/** Close the relay.
+ *
+ * Deinitializes and deallocates the relay, and detaches it from the context. The user
+ * should ensure that nobody uses the relay during and after this call. If this
+ * function fails, the relay is kept opened and attached to the context.
+ *
+ * **Parameters**
+ *  - \p relay should point to an opened relay
+ *
+ * **Returns**
+ *  - returns zero if the relay was successfully closed
+ *  - returns a negative value if the arguments are invalid
+ *
+ * **Ownership**
+ *  - ends the user ownership of \p relay; it can't be used anymore after the
+ *    function returns
+ */
+ROC_API int roc_relay_close(roc_relay* relay);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* ROC_RELAY_H_ */
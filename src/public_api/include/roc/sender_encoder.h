@@ -51,8 +51,9 @@ extern "C" {
  *   accumulates them in internal queue.
  *
  * - The packet stream is iteratively popped from the encoder internal queue using
- *   roc_sender_encoder_pop_packet(). User should retrieve all available packets from all
- *   activated interfaces every time after pushing a frame.
+ *   roc_sender_encoder_pop_packet() or roc_sender_encoder_pop_packets(). User should
+ *   retrieve all available packets from all activated interfaces every time after
+ *   pushing a frame.
  *
  * - User is responsible for delivering packets to \ref roc_receiver_decoder and pushing
  *   them to appropriate interfaces of decoder.
@@ -253,6 +254,45 @@ ROC_API int roc_sender_encoder_pop_packet(roc_sender_encoder* encoder,
                                           roc_interface iface,
                                           roc_packet* packet);
 
+/** Read multiple packets from encoder.
+ *
+ * Same as roc_sender_encoder_pop_packet(), but removes up to \p packets_count packets
+ * from interface queue in one call. Queue is locked once per call instead of once per
+ * packet, which reduces overhead when the user sends packets in bursts, e.g. via a
+ * userspace network stack.
+ *
+ * If the buffer of some packet is too small, that packet is dropped and the rest
+ * of the packets are still returned.
+ *
+ * **Parameters**
+ *  - \p encoder should point to an opened encoder
+ *  - \p packets should point to an array of initialized packets; each should contain
+ *    pointer to a buffer and it's size; packet bytes are copied to user's buffers and
+ *    the size fields are updated with the actual packet sizes
+ *  - \p packets_count should point to the number of elements in \p packets; it's
+ *    updated with the number of packets removed from the queue
+ *  - \p statuses should be either NULL or point to an array of the same size as
+ *    \p packets; for each removed packet, zero is written if the packet was
+ *    successfully copied, and a negative value otherwise
+ *
+ * **Returns**
+ *  - returns zero if at least one packet was removed and all removed packets were
+ *    successfully copied from encoder
+ *  - returns a negative value if there are no more packets for this interface
+ *  - returns a negative value if at least one packet was not copied; see \p statuses
+ *  - returns a negative value if the interface is not activated
+ *  - returns a negative value if the arguments are invalid
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownership of \p packets, \p packets_count, and
+ *    \p statuses; they may be safely deallocated after the function returns
+ */
+ROC_API int roc_sender_encoder_pop_packets(roc_sender_encoder* encoder,
+                                           roc_interface iface,
+                                           roc_packet* packets,
+                                           size_t* packets_count,
+                                           int* statuses);
+
 /** Close encoder.
  *
  * Deinitializes and deallocates the encoder, and detaches it from the context. The user
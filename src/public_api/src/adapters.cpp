@@ -49,6 +49,74 @@ bool context_config_from_user(node::ContextConfig& out, const roc_context_config
         out.max_frame_size = in.max_frame_size;
     }
 
+    out.prealloc_packets = in.prealloc_packets;
+    out.prealloc_frames = in.prealloc_frames;
+    out.lock_memory = in.lock_memory != 0;
+    out.fixed_pools = in.fixed_pools != 0;
+    out.huge_pages = in.huge_pages != 0;
+
+    if ((in.allocator.allocate != NULL) != (in.allocator.deallocate != NULL)) {
+        roc_log(LogError,
+                "bad configuration: invalid roc_context_config.allocator:"
+                " allocate and deallocate should be both set or both null");
+        return false;
+    }
+
+    out.alloc_func = in.allocator.allocate;
+    out.dealloc_func = in.allocator.deallocate;
+    out.alloc_arg = in.allocator.arg;
+
+    if (!thread_policy_from_user(out.network_thread, in.network_thread)) {
+        roc_log(LogError,
+                "bad configuration: invalid roc_context_config.network_thread:"
+                " should be zero or valid policy");
+        return false;
+    }
+
+    if (!thread_policy_from_user(out.control_thread, in.control_thread)) {
+        roc_log(LogError,
+                "bad configuration: invalid roc_context_config.control_thread:"
+                " should be zero or valid policy");
+        return false;
+    }
+
+    return true;
+}
+
+ROC_ATTR_NO_SANITIZE_UB
+bool thread_policy_from_user(core::ThreadPolicy& out, const roc_thread_policy& in) {
+    switch (enum_from_user(in.scheduler)) {
+    case ROC_THREAD_SCHEDULER_DEFAULT:
+        out.scheduler = core::ThreadSched_Default;
+        break;
+
+    case ROC_THREAD_SCHEDULER_FIFO:
+        out.scheduler = core::ThreadSched_Fifo;
+        break;
+
+    case ROC_THREAD_SCHEDULER_RR:
+        out.scheduler = core::ThreadSched_RoundRobin;
+        break;
+
+    default:
+        return false;
+    }
+
+    if (in.priority < 0 || in.priority > 99) {
+        return false;
+    }
+    if (out.scheduler == core::ThreadSched_Default && in.priority != 0) {
+        return false;
+    }
+    out.priority = in.priority;
+
+    if (in.nice < -20 || in.nice > 19) {
+        return false;
+    }
+    out.nice = in.nice;
+
+    out.cpu_mask = (uint64_t)in.cpu_mask;
+
     return true;
 }
 
@@ -107,6 +175,7 @@ bool sender_config_from_user(node::Context& context,
     out.enable_auto_cts = true;
 
     out.enable_interleaving = in.packet_interleaving;
+    out.enable_stage_timing = (in.enable_stage_timing != 0);
 
     if (!fec_encoding_from_user(out.fec_encoder.scheme, in.fec_encoding)) {
         roc_log(LogError,
@@ -185,6 +254,7 @@ bool receiver_config_from_user(node::Context&,
 
     out.common.enable_timing = false;
     out.common.enable_auto_reclock = true;
+    out.common.enable_stage_timing = (in.enable_stage_timing != 0);
 
     if (!sample_spec_from_user(out.common.output_sample_spec, in.frame_encoding, false)) {
         roc_log(LogError,
@@ -604,6 +674,13 @@ bool proto_to_user(roc_protocol& out, address::Protocol in) {
     return false;
 }
 
+void stage_timing_to_user(roc_stage_timing& out, const core::DurationMetrics& in) {
+    out.p50 = (unsigned long long)in.p50;
+    out.p99 = (unsigned long long)in.p99;
+    out.p999 = (unsigned long long)in.p999;
+    out.max = (unsigned long long)in.max;
+}
+
 ROC_ATTR_NO_SANITIZE_UB
 void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_metrics,
                                    void* slot_arg) {
@@ -612,6 +689,8 @@ void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_met
     memset(&out, 0, sizeof(out));
 
     out.connection_count = (unsigned)slot_metrics.num_participants;
+
+    stage_timing_to_user(out.mixer_timing, slot_metrics.mixer_timing);
 }
 
 ROC_ATTR_NO_SANITIZE_UB
@@ -626,6 +705,11 @@ void receiver_participant_metrics_to_user(
     if (party_metrics.latency.e2e_latency > 0) {
         out.e2e_latency = (unsigned long long)party_metrics.latency.e2e_latency;
     }
+
+    stage_timing_to_user(out.depacketizer_timing, party_metrics.depacketizer_timing);
+    stage_timing_to_user(out.fec_reader_timing, party_metrics.fec_reader_timing);
+    stage_timing_to_user(out.channel_mapper_timing, party_metrics.channel_mapper_timing);
+    stage_timing_to_user(out.resampler_timing, party_metrics.resampler_timing);
 }
 
 ROC_ATTR_NO_SANITIZE_UB
@@ -636,6 +720,11 @@ void sender_slot_metrics_to_user(const pipeline::SenderSlotMetrics& slot_metrics
     memset(&out, 0, sizeof(out));
 
     out.connection_count = (unsigned)slot_metrics.num_participants;
+
+    stage_timing_to_user(out.resampler_timing, slot_metrics.resampler_timing);
+    stage_timing_to_user(out.channel_mapper_timing, slot_metrics.channel_mapper_timing);
+    stage_timing_to_user(out.packetizer_timing, slot_metrics.packetizer_timing);
+    stage_timing_to_user(out.fec_writer_timing, slot_metrics.fec_writer_timing);
 }
 
 ROC_ATTR_NO_SANITIZE_UB
@@ -652,6 +741,29 @@ void sender_participant_metrics_to_user(
     }
 }
 
+namespace {
+
+void pool_metrics_to_user(roc_pool_metrics& out, const node::ContextPoolMetrics& in) {
+    out.num_used = (unsigned long long)in.num_used;
+    out.max_used = (unsigned long long)in.max_used;
+    out.capacity = (unsigned long long)in.capacity;
+}
+
+} // namespace
+
+void context_metrics_to_user(roc_context_metrics& out, const node::ContextMetrics& in) {
+    memset(&out, 0, sizeof(out));
+
+    out.allocated_blocks = (unsigned long long)in.memory.num_allocations;
+    out.allocated_bytes = (unsigned long long)in.memory.num_bytes;
+    out.max_allocated_bytes = (unsigned long long)in.memory.max_bytes;
+    out.failed_allocations = (unsigned long long)in.memory.num_failures;
+
+    pool_metrics_to_user(out.packet_pool, in.packet_pool);
+    pool_metrics_to_user(out.packet_buffer_pool, in.packet_buffer_pool);
+    pool_metrics_to_user(out.frame_buffer_pool, in.frame_buffer_pool);
+}
+
 ROC_ATTR_NO_SANITIZE_UB
 LogLevel log_level_from_user(roc_log_level in) {
     switch (enum_from_user(in)) {
@@ -23,6 +23,8 @@ namespace api {
 
 bool context_config_from_user(node::ContextConfig& out, const roc_context_config& in);
 
+bool thread_policy_from_user(core::ThreadPolicy& out, const roc_thread_policy& in);
+
 bool sender_config_from_user(node::Context& context,
                              pipeline::SenderSinkConfig& out,
                              const roc_sender_config& in);
@@ -61,6 +63,8 @@ bool interface_from_user(address::Interface& out, const roc_interface& in);
 bool proto_from_user(address::Protocol& out, const roc_protocol& in);
 bool proto_to_user(roc_protocol& out, address::Protocol in);
 
+void stage_timing_to_user(roc_stage_timing& out, const core::DurationMetrics& in);
+
 void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_metrics,
                                    void* slot_arg);
 void receiver_participant_metrics_to_user(
@@ -75,6 +79,8 @@ void sender_participant_metrics_to_user(
     size_t party_index,
     void* party_arg);
 
+void context_metrics_to_user(roc_context_metrics& out, const node::ContextMetrics& in);
+
 LogLevel log_level_from_user(roc_log_level level);
 roc_log_level log_level_to_user(LogLevel level);
 
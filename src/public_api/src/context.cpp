@@ -102,6 +102,24 @@ int roc_context_register_encoding(roc_context* context,
     return 0;
 }
 
+int roc_context_query(roc_context* context, roc_context_metrics* metrics) {
+    if (!context) {
+        roc_log(LogError, "roc_context_query(): invalid arguments: context is null");
+        return -1;
+    }
+
+    if (!metrics) {
+        roc_log(LogError, "roc_context_query(): invalid arguments: metrics is null");
+        return -1;
+    }
+
+    node::Context* imp_context = (node::Context*)context;
+
+    api::context_metrics_to_user(*metrics, imp_context->get_metrics());
+
+    return 0;
+}
+
 int roc_context_close(roc_context* context) {
     if (!context) {
         roc_log(LogError, "roc_context_close(): invalid arguments: context is null");
@@ -46,3 +46,15 @@ void roc_log_set_handler(roc_log_handler handler, void* argument) {
         core::Logger::instance().set_handler(NULL, NULL, 0);
     }
 }
+
+int roc_log_set_async(int enabled) {
+    if (enabled) {
+        if (!core::Logger::instance().enable_async()) {
+            return -1;
+        }
+    } else {
+        core::Logger::instance().disable_async();
+    }
+
+    return 0;
+}
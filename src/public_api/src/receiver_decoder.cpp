@@ -20,6 +20,60 @@
 
 using namespace roc;
 
+namespace {
+
+// Maximum number of packets passed to decoder node in one call.
+enum { MaxBatchSize = 64 };
+
+// Validate user packet and copy it into newly allocated packet.
+// On failure, logs error prefixed with function name and returns NULL.
+packet::PacketPtr packet_from_user(packet::PacketFactory& factory,
+                                   const roc_packet& packet,
+                                   const char* func_name) {
+    if (!packet.bytes) {
+        roc_log(LogError, "%s: invalid arguments: packet bytes buffer is null",
+                func_name);
+        return NULL;
+    }
+
+    if (packet.bytes_size == 0) {
+        roc_log(LogError, "%s: invalid arguments: packet bytes count is zero",
+                func_name);
+        return NULL;
+    }
+
+    core::BufferPtr imp_buffer = factory.new_packet_buffer();
+    if (!imp_buffer) {
+        roc_log(LogError, "%s: can't allocate buffer of requested size", func_name);
+        return NULL;
+    }
+
+    if (imp_buffer->size() < packet.bytes_size) {
+        roc_log(LogError,
+                "%s: provided packet exceeds maximum packet size"
+                " (see roc_context_config): provided=%lu maximum=%lu",
+                func_name, (unsigned long)packet.bytes_size,
+                (unsigned long)imp_buffer->size());
+        return NULL;
+    }
+
+    core::Slice<uint8_t> imp_slice(*imp_buffer, 0, packet.bytes_size);
+    memcpy(imp_slice.data(), packet.bytes, packet.bytes_size);
+
+    packet::PacketPtr imp_packet = factory.new_packet();
+    if (!imp_packet) {
+        roc_log(LogError, "%s: can't allocate packet", func_name);
+        return NULL;
+    }
+
+    imp_packet->add_flags(packet::Packet::FlagUDP);
+    imp_packet->set_buffer(imp_slice);
+
+    return imp_packet;
+}
+
+} // namespace
+
 int roc_receiver_decoder_open(roc_context* context,
                               const roc_receiver_config* config,
                               roc_receiver_decoder** result) {
@@ -164,63 +218,115 @@ int roc_receiver_decoder_push_packet(roc_receiver_decoder* decoder,
         return -1;
     }
 
-    if (!packet->bytes) {
-        roc_log(LogError,
-                "roc_receiver_decoder_push_packet(): invalid arguments:"
-                " packet bytes buffer is null");
+    packet::PacketPtr imp_packet = packet_from_user(
+        imp_decoder->packet_factory(), *packet, "roc_receiver_decoder_push_packet()");
+    if (!imp_packet) {
         return -1;
     }
 
-    if (packet->bytes_size == 0) {
+    const status::StatusCode code = imp_decoder->write_packet(imp_iface, imp_packet);
+    if (code != status::StatusOK) {
+        // TODO(gh-183): forward status code to user
         roc_log(LogError,
-                "roc_receiver_decoder_push_packet(): invalid arguments:"
-                " packet bytes count is zero");
+                "roc_receiver_decoder_push_packet():"
+                " can't write packet to decoder: status=%s",
+                status::code_to_str(code));
+
         return -1;
     }
 
-    core::BufferPtr imp_buffer = imp_decoder->packet_factory().new_packet_buffer();
-    if (!imp_buffer) {
+    return 0;
+}
+
+int roc_receiver_decoder_push_packets(roc_receiver_decoder* decoder,
+                                      roc_interface iface,
+                                      const roc_packet* packets,
+                                      size_t packets_count,
+                                      int* statuses) {
+    if (!decoder) {
         roc_log(LogError,
-                "roc_receiver_decoder_push_packet():"
-                " can't allocate buffer of requested size");
+                "roc_receiver_decoder_push_packets(): invalid arguments:"
+                " decoder is null");
         return -1;
     }
 
-    if (imp_buffer->size() < packet->bytes_size) {
+    node::ReceiverDecoder* imp_decoder = (node::ReceiverDecoder*)decoder;
+
+    address::Interface imp_iface;
+    if (!api::interface_from_user(imp_iface, iface)) {
         roc_log(LogError,
-                "roc_receiver_decoder_push_packet():"
-                " provided packet exceeds maximum packet size (see roc_context_config):"
-                " provided=%lu maximum=%lu",
-                (unsigned long)packet->bytes_size, (unsigned long)imp_buffer->size());
+                "roc_receiver_decoder_push_packets(): invalid arguments:"
+                " bad interface");
         return -1;
     }
 
-    core::Slice<uint8_t> imp_slice(*imp_buffer, 0, packet->bytes_size);
-    memcpy(imp_slice.data(), packet->bytes, packet->bytes_size);
-
-    packet::PacketPtr imp_packet = imp_decoder->packet_factory().new_packet();
-    if (!imp_packet) {
+    if (!packets && packets_count != 0) {
         roc_log(LogError,
-                "roc_receiver_decoder_push_packet():"
-                " can't allocate packet");
+                "roc_receiver_decoder_push_packets(): invalid arguments:"
+                " packets array is null");
         return -1;
     }
 
-    imp_packet->add_flags(packet::Packet::FlagUDP);
-    imp_packet->set_buffer(imp_slice);
+    packet::PacketFactory& imp_factory = imp_decoder->packet_factory();
 
-    const status::StatusCode code = imp_decoder->write_packet(imp_iface, imp_packet);
-    if (code != status::StatusOK) {
-        // TODO(gh-183): forward status code to user
-        roc_log(LogError,
-                "roc_receiver_decoder_push_packet():"
-                " can't write packet to decoder: status=%s",
-                status::code_to_str(code));
+    packet::PacketPtr imp_packets[MaxBatchSize];
+    status::StatusCode imp_codes[MaxBatchSize];
+    size_t imp_indices[MaxBatchSize];
 
-        return -1;
+    int result = 0;
+
+    for (size_t batch_pos = 0; batch_pos < packets_count; batch_pos += MaxBatchSize) {
+        size_t batch_size = packets_count - batch_pos;
+        if (batch_size > MaxBatchSize) {
+            batch_size = MaxBatchSize;
+        }
+
+        size_t n_imp_packets = 0;
+
+        for (size_t n = batch_pos; n < batch_pos + batch_size; n++) {
+            if (statuses) {
+                statuses[n] = -1;
+            }
+
+            packet::PacketPtr imp_packet = packet_from_user(
+                imp_factory, packets[n], "roc_receiver_decoder_push_packets()");
+            if (!imp_packet) {
+                roc_log(LogError,
+                        "roc_receiver_decoder_push_packets(): can't push packet #%lu",
+                        (unsigned long)n);
+                result = -1;
+                continue;
+            }
+
+            imp_packets[n_imp_packets] = imp_packet;
+            imp_indices[n_imp_packets] = n;
+            n_imp_packets++;
+        }
+
+        if (n_imp_packets == 0) {
+            continue;
+        }
+
+        const status::StatusCode code = imp_decoder->write_packets(
+            imp_iface, imp_packets, n_imp_packets, imp_codes);
+        if (code != status::StatusOK) {
+            // TODO(gh-183): forward status code to user
+            roc_log(LogError,
+                    "roc_receiver_decoder_push_packets():"
+                    " can't write packets to decoder: status=%s",
+                    status::code_to_str(code));
+            result = -1;
+        }
+
+        for (size_t n = 0; n < n_imp_packets; n++) {
+            if (statuses && imp_codes[n] == status::StatusOK) {
+                statuses[imp_indices[n]] = 0;
+            }
+            imp_packets[n] = NULL;
+        }
     }
 
-    return 0;
+    return result;
 }
 
 int roc_receiver_decoder_pop_feedback_packet(roc_receiver_decoder* decoder,
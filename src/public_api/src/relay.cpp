@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc/relay.h"
+
+#include "adapters.h"
+
+#include "roc_core/log.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_node/relay.h"
+
+using namespace roc;
+
+int roc_relay_open(roc_context* context, roc_relay** result) {
+    roc_log(LogInfo, "roc_relay_open(): opening relay");
+
+    if (!result) {
+        roc_log(LogError, "roc_relay_open(): invalid arguments: result is null");
+        return -1;
+    }
+
+    if (!context) {
+        roc_log(LogError, "roc_relay_open(): invalid arguments: context is null");
+        return -1;
+    }
+
+    node::Context* imp_context = (node::Context*)context;
+
+    pipeline::RelayConfig imp_config;
+    imp_config.deduce_defaults();
+
+    core::ScopedPtr<node::Relay> imp_relay(
+        new (imp_context->arena()) node::Relay(*imp_context, imp_config),
+        imp_context->arena());
+
+    if (!imp_relay) {
+        roc_log(LogError, "roc_relay_open(): can't allocate relay");
+        return -1;
+    }
+
+    if (!imp_relay->is_valid()) {
+        roc_log(LogError, "roc_relay_open(): can't initialize relay");
+        return -1;
+    }
+
+    *result = (roc_relay*)imp_relay.release();
+    return 0;
+}
+
+int roc_relay_bind(roc_relay* relay, roc_interface iface, roc_endpoint* endpoint) {
+    if (!relay) {
+        roc_log(LogError, "roc_relay_bind(): invalid arguments: relay is null");
+        return -1;
+    }
+
+    node::Relay* imp_relay = (node::Relay*)relay;
+
+    if (!endpoint) {
+        roc_log(LogError, "roc_relay_bind(): invalid arguments: endpoint is null");
+        return -1;
+    }
+
+    address::EndpointUri& imp_endpoint = *(address::EndpointUri*)endpoint;
+
+    address::Interface imp_iface;
+    if (!api::interface_from_user(imp_iface, iface)) {
+        roc_log(LogError, "roc_relay_bind(): invalid arguments: bad interface");
+        return -1;
+    }
+
+    if (!imp_relay->bind(imp_iface, imp_endpoint)) {
+        roc_log(LogError, "roc_relay_bind(): operation failed");
+        return -1;
+    }
+
+    return 0;
+}
+
+int roc_relay_connect(roc_relay* relay,
+                      roc_slot slot,
+                      roc_interface iface,
+                      const roc_endpoint* endpoint) {
+    if (!relay) {
+        roc_log(LogError, "roc_relay_connect(): invalid arguments: relay is null");
+        return -1;
+    }
+
+    node::Relay* imp_relay = (node::Relay*)relay;
+
+    if (!endpoint) {
+        roc_log(LogError, "roc_relay_connect(): invalid arguments: endpoint is null");
+        return -1;
+    }
+
+    const address::EndpointUri& imp_endpoint = *(const address::EndpointUri*)endpoint;
+
+    address::Interface imp_iface;
+    if (!api::interface_from_user(imp_iface, iface)) {
+        roc_log(LogError, "roc_relay_connect(): invalid arguments: bad interface");
+        return -1;
+    }
+
+    if (!imp_relay->connect(slot, imp_iface, imp_endpoint)) {
+        roc_log(LogError, "roc_relay_connect(): operation failed");
+        return -1;
+    }
+
+    return 0;
+}
+
+int roc_relay_unlink(roc_relay* relay, roc_slot slot) {
+    if (!relay) {
+        roc_log(LogError, "roc_relay_unlink(): invalid arguments: relay is null");
+        return -1;
+    }
+
+    node::Relay* imp_relay = (node::Relay*)relay;
+
+    if (!imp_relay->unlink(slot)) {
+        roc_log(LogError, "roc_relay_unlink(): operation failed");
+        return -1;
+    }
+
+    return 0;
+}
+
+int roc_relay_close(roc_relay* relay) {
+    if (!relay) {
+        roc_log(LogError, "roc_relay_close(): invalid arguments: relay is null");
+        return -1;
+    }
+
+    node::Relay* imp_relay = (node::Relay*)relay;
+    imp_relay->context().arena().destroy_object(*imp_relay);
+
+    roc_log(LogInfo, "roc_relay_close(): closed relay");
+
+    return 0;
+}
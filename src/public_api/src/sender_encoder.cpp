@@ -19,6 +19,13 @@
 
 using namespace roc;
 
+namespace {
+
+// Maximum number of packets requested from encoder node in one call.
+enum { MaxBatchSize = 64 };
+
+} // namespace
+
 int roc_sender_encoder_open(roc_context* context,
                             const roc_sender_config* config,
                             roc_sender_encoder** result) {
@@ -328,6 +335,119 @@ int roc_sender_encoder_pop_packet(roc_sender_encoder* encoder,
     return 0;
 }
 
+int roc_sender_encoder_pop_packets(roc_sender_encoder* encoder,
+                                   roc_interface iface,
+                                   roc_packet* packets,
+                                   size_t* packets_count,
+                                   int* statuses) {
+    if (!encoder) {
+        roc_log(LogError,
+                "roc_sender_encoder_pop_packets(): invalid arguments:"
+                " encoder is null");
+        return -1;
+    }
+
+    node::SenderEncoder* imp_encoder = (node::SenderEncoder*)encoder;
+
+    address::Interface imp_iface;
+    if (!api::interface_from_user(imp_iface, iface)) {
+        roc_log(LogError,
+                "roc_sender_encoder_pop_packets(): invalid arguments:"
+                " bad interface");
+        return -1;
+    }
+
+    if (!packets_count) {
+        roc_log(LogError,
+                "roc_sender_encoder_pop_packets(): invalid arguments:"
+                " packets count is null");
+        return -1;
+    }
+
+    if (!packets && *packets_count != 0) {
+        roc_log(LogError,
+                "roc_sender_encoder_pop_packets(): invalid arguments:"
+                " packets array is null");
+        return -1;
+    }
+
+    for (size_t n = 0; n < *packets_count; n++) {
+        if (!packets[n].bytes) {
+            roc_log(LogError,
+                    "roc_sender_encoder_pop_packets(): invalid arguments:"
+                    " packet #%lu bytes buffer is null",
+                    (unsigned long)n);
+            return -1;
+        }
+    }
+
+    const size_t max_packets = *packets_count;
+    *packets_count = 0;
+
+    packet::PacketPtr imp_packets[MaxBatchSize];
+
+    int result = 0;
+
+    while (*packets_count < max_packets) {
+        size_t batch_size = max_packets - *packets_count;
+        if (batch_size > MaxBatchSize) {
+            batch_size = MaxBatchSize;
+        }
+
+        size_t n_imp_packets = 0;
+        const status::StatusCode code =
+            imp_encoder->read_packets(imp_iface, imp_packets, batch_size, n_imp_packets);
+        if (code != status::StatusOK) {
+            // TODO(gh-183): forward status code to user
+            if (code != status::StatusNoData) {
+                roc_log(LogError,
+                        "roc_sender_encoder_pop_packets():"
+                        " can't read packets from encoder: status=%s",
+                        status::code_to_str(code));
+            }
+            break;
+        }
+
+        for (size_t n = 0; n < n_imp_packets; n++) {
+            roc_packet& packet = packets[*packets_count];
+            const core::Slice<uint8_t>& imp_buffer = imp_packets[n]->buffer();
+
+            if (packet.bytes_size < imp_buffer.size()) {
+                roc_log(LogError,
+                        "roc_sender_encoder_pop_packets():"
+                        " not enough space in provided packet #%lu:"
+                        " provided=%lu needed=%lu",
+                        (unsigned long)*packets_count, (unsigned long)packet.bytes_size,
+                        (unsigned long)imp_buffer.size());
+                if (statuses) {
+                    statuses[*packets_count] = -1;
+                }
+                result = -1;
+            } else {
+                memcpy(packet.bytes, imp_buffer.data(), imp_buffer.size());
+                packet.bytes_size = imp_buffer.size();
+                if (statuses) {
+                    statuses[*packets_count] = 0;
+                }
+            }
+
+            imp_packets[n] = NULL;
+            (*packets_count)++;
+        }
+
+        if (n_imp_packets < batch_size) {
+            // Queue is drained.
+            break;
+        }
+    }
+
+    if (*packets_count == 0) {
+        return -1;
+    }
+
+    return result;
+}
+
 int roc_sender_encoder_close(roc_sender_encoder* encoder) {
     if (!encoder) {
         roc_log(LogError,
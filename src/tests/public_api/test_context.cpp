@@ -8,6 +8,7 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_core/atomic.h"
 #include "roc_core/stddefs.h"
 
 #include "roc/context.h"
@@ -17,6 +18,30 @@
 namespace roc {
 namespace api {
 
+namespace {
+
+struct TestAllocator {
+    core::Atomic<int> n_allocs;
+    core::Atomic<int> n_deallocs;
+
+    TestAllocator()
+        : n_allocs(0)
+        , n_deallocs(0) {
+    }
+};
+
+void* test_allocate(size_t size, void* arg) {
+    ((TestAllocator*)arg)->n_allocs++;
+    return malloc(size);
+}
+
+void test_deallocate(void* ptr, void* arg) {
+    ((TestAllocator*)arg)->n_deallocs++;
+    free(ptr);
+}
+
+} // namespace
+
 TEST_GROUP(context) {};
 
 TEST(context, open_close) {
@@ -44,6 +69,126 @@ TEST(context, close_null) {
     LONGS_EQUAL(-1, roc_context_close(NULL));
 }
 
+TEST(context, custom_allocator) {
+    TestAllocator allocator;
+
+    roc_context_config context_config;
+    memset(&context_config, 0, sizeof(context_config));
+    context_config.allocator.allocate = test_allocate;
+    context_config.allocator.deallocate = test_deallocate;
+    context_config.allocator.arg = &allocator;
+
+    roc_context* context = NULL;
+    CHECK(roc_context_open(&context_config, &context) == 0);
+    CHECK(context);
+
+    const int n_context_allocs = allocator.n_allocs;
+
+    {
+        roc_receiver_config receiver_config;
+        memset(&receiver_config, 0, sizeof(receiver_config));
+        receiver_config.frame_encoding.rate = 44100;
+        receiver_config.frame_encoding.format = ROC_FORMAT_PCM_FLOAT32;
+        receiver_config.frame_encoding.channels = ROC_CHANNEL_LAYOUT_STEREO;
+
+        roc_receiver* receiver = NULL;
+        CHECK(roc_receiver_open(context, &receiver_config, &receiver) == 0);
+        CHECK(receiver);
+
+        // receiver memory is allocated from context allocator
+        CHECK(allocator.n_allocs > n_context_allocs);
+
+        LONGS_EQUAL(0, roc_receiver_close(receiver));
+    }
+
+    LONGS_EQUAL(0, roc_context_close(context));
+
+    CHECK(allocator.n_allocs > 0);
+    LONGS_EQUAL((int)allocator.n_allocs, (int)allocator.n_deallocs);
+}
+
+TEST(context, custom_allocator_invalid) {
+    TestAllocator allocator;
+
+    roc_context_config context_config;
+    memset(&context_config, 0, sizeof(context_config));
+    context_config.allocator.allocate = test_allocate;
+    context_config.allocator.arg = &allocator;
+
+    roc_context* context = NULL;
+    LONGS_EQUAL(-1, roc_context_open(&context_config, &context));
+    CHECK(!context);
+
+    context_config.allocator.allocate = NULL;
+    context_config.allocator.deallocate = test_deallocate;
+
+    LONGS_EQUAL(-1, roc_context_open(&context_config, &context));
+    CHECK(!context);
+
+    LONGS_EQUAL(0, (int)allocator.n_allocs);
+}
+
+TEST(context, query) {
+    roc_context_config context_config;
+    memset(&context_config, 0, sizeof(context_config));
+
+    roc_context* context = NULL;
+    CHECK(roc_context_open(&context_config, &context) == 0);
+    CHECK(context);
+
+    roc_context_metrics metrics;
+    memset(&metrics, 0, sizeof(metrics));
+    LONGS_EQUAL(0, roc_context_query(context, &metrics));
+
+    const unsigned long long initial_bytes = metrics.allocated_bytes;
+
+    {
+        roc_sender_config sender_config;
+        memset(&sender_config, 0, sizeof(sender_config));
+        sender_config.frame_encoding.rate = 44100;
+        sender_config.frame_encoding.format = ROC_FORMAT_PCM_FLOAT32;
+        sender_config.frame_encoding.channels = ROC_CHANNEL_LAYOUT_STEREO;
+        sender_config.packet_encoding = ROC_PACKET_ENCODING_AVP_L16_STEREO;
+
+        roc_sender* sender = NULL;
+        CHECK(roc_sender_open(context, &sender_config, &sender) == 0);
+        CHECK(sender);
+
+        memset(&metrics, 0, sizeof(metrics));
+        LONGS_EQUAL(0, roc_context_query(context, &metrics));
+
+        CHECK(metrics.allocated_blocks > 0);
+        CHECK(metrics.allocated_bytes > initial_bytes);
+        CHECK(metrics.max_allocated_bytes >= metrics.allocated_bytes);
+        CHECK(metrics.frame_buffer_pool.max_used >= metrics.frame_buffer_pool.num_used);
+        LONGS_EQUAL(0, metrics.failed_allocations);
+
+        LONGS_EQUAL(0, roc_sender_close(sender));
+    }
+
+    memset(&metrics, 0, sizeof(metrics));
+    LONGS_EQUAL(0, roc_context_query(context, &metrics));
+
+    CHECK(metrics.max_allocated_bytes > initial_bytes);
+
+    LONGS_EQUAL(0, roc_context_close(context));
+}
+
+TEST(context, query_null) {
+    roc_context_config context_config;
+    memset(&context_config, 0, sizeof(context_config));
+
+    roc_context* context = NULL;
+    CHECK(roc_context_open(&context_config, &context) == 0);
+    CHECK(context);
+
+    roc_context_metrics metrics;
+    LONGS_EQUAL(-1, roc_context_query(NULL, &metrics));
+    LONGS_EQUAL(-1, roc_context_query(context, NULL));
+
+    LONGS_EQUAL(0, roc_context_close(context));
+}
+
 TEST(context, reference_counting) {
     roc_context_config context_config;
     memset(&context_config, 0, sizeof(context_config));
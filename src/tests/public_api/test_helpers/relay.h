@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ROC_PUBLIC_API_TEST_HELPERS_RELAY_H_
+#define ROC_PUBLIC_API_TEST_HELPERS_RELAY_H_
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/context.h"
+#include "test_helpers/utils.h"
+
+#include "roc/context.h"
+#include "roc/endpoint.h"
+#include "roc/relay.h"
+
+namespace roc {
+namespace api {
+namespace test {
+
+class Relay {
+public:
+    Relay(Context& context, unsigned flags)
+        : relay_(NULL)
+        , source_endp_(NULL)
+        , repair_endp_(NULL)
+        , control_endp_(NULL)
+        , flags_(flags) {
+        CHECK(roc_relay_open(context.get(), &relay_) == 0);
+        CHECK(relay_);
+    }
+
+    ~Relay() {
+        if (source_endp_) {
+            CHECK(roc_endpoint_deallocate(source_endp_) == 0);
+        }
+        if (repair_endp_) {
+            CHECK(roc_endpoint_deallocate(repair_endp_) == 0);
+        }
+        if (control_endp_) {
+            CHECK(roc_endpoint_deallocate(control_endp_) == 0);
+        }
+
+        CHECK(roc_relay_close(relay_) == 0);
+    }
+
+    void bind() {
+        if (flags_ & FlagRS8M) {
+            bind_(ROC_INTERFACE_AUDIO_SOURCE, "rtp+rs8m://127.0.0.1:0", source_endp_);
+            bind_(ROC_INTERFACE_AUDIO_REPAIR, "rs8m://127.0.0.1:0", repair_endp_);
+        } else if (flags_ & FlagLDPC) {
+            bind_(ROC_INTERFACE_AUDIO_SOURCE, "rtp+ldpc://127.0.0.1:0", source_endp_);
+            bind_(ROC_INTERFACE_AUDIO_REPAIR, "ldpc://127.0.0.1:0", repair_endp_);
+        } else {
+            bind_(ROC_INTERFACE_AUDIO_SOURCE, "rtp://127.0.0.1:0", source_endp_);
+        }
+
+        if (flags_ & FlagRTCP) {
+            bind_(ROC_INTERFACE_AUDIO_CONTROL, "rtcp://127.0.0.1:0", control_endp_);
+        }
+    }
+
+    void connect(roc_slot slot,
+                 const roc_endpoint* receiver_source_endp,
+                 const roc_endpoint* receiver_repair_endp,
+                 const roc_endpoint* receiver_control_endp) {
+        CHECK(roc_relay_connect(relay_, slot, ROC_INTERFACE_AUDIO_SOURCE,
+                                receiver_source_endp)
+              == 0);
+
+        if ((flags_ & FlagRS8M) || (flags_ & FlagLDPC)) {
+            CHECK(roc_relay_connect(relay_, slot, ROC_INTERFACE_AUDIO_REPAIR,
+                                    receiver_repair_endp)
+                  == 0);
+        }
+
+        if (flags_ & FlagRTCP) {
+            CHECK(roc_relay_connect(relay_, slot, ROC_INTERFACE_AUDIO_CONTROL,
+                                    receiver_control_endp)
+                  == 0);
+        }
+    }
+
+    void unlink(roc_slot slot) {
+        CHECK(roc_relay_unlink(relay_, slot) == 0);
+    }
+
+    const roc_endpoint* source_endpoint() const {
+        return source_endp_;
+    }
+
+    const roc_endpoint* repair_endpoint() const {
+        return repair_endp_;
+    }
+
+    const roc_endpoint* control_endpoint() const {
+        return control_endp_;
+    }
+
+private:
+    void bind_(roc_interface iface, const char* uri, roc_endpoint*& endp) {
+        CHECK(roc_endpoint_allocate(&endp) == 0);
+        CHECK(roc_endpoint_set_uri(endp, uri) == 0);
+
+        CHECK(roc_relay_bind(relay_, iface, endp) == 0);
+    }
+
+    roc_relay* relay_;
+
+    roc_endpoint* source_endp_;
+    roc_endpoint* repair_endp_;
+    roc_endpoint* control_endp_;
+
+    const unsigned flags_;
+};
+
+} // namespace test
+} // namespace api
+} // namespace roc
+
+#endif // ROC_PUBLIC_API_TEST_HELPERS_RELAY_H_
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/log.h"
+#include "roc_core/thread.h"
+
+#include "roc/log.h"
+
+namespace roc {
+namespace api {
+
+namespace {
+
+struct Messages {
+    size_t count;
+    bool from_caller_thread;
+};
+
+void handler(const roc_log_message* message, void* argument) {
+    Messages& messages = *(Messages*)argument;
+
+    if (strstr(message->text, "test message")) {
+        messages.count++;
+        messages.from_caller_thread = message->tid == core::Thread::get_tid();
+    }
+}
+
+} // namespace
+
+TEST_GROUP(log) {
+    LogLevel level;
+
+    void setup() {
+        level = core::Logger::instance().get_level();
+    }
+
+    void teardown() {
+        core::Logger::instance().set_level(level);
+        roc_log_set_handler(NULL, NULL);
+    }
+};
+
+TEST(log, async) {
+    Messages messages;
+    memset(&messages, 0, sizeof(messages));
+
+    roc_log_set_handler(&handler, &messages);
+    roc_log_set_level(ROC_LOG_INFO);
+
+    CHECK(roc_log_set_async(1) == 0);
+
+    for (int n = 0; n < 10; n++) {
+        roc_log(LogInfo, "test message %d", n);
+    }
+
+    // waits until enqueued messages are delivered
+    CHECK(roc_log_set_async(0) == 0);
+
+    UNSIGNED_LONGS_EQUAL(10, messages.count);
+    CHECK(!messages.from_caller_thread);
+
+    roc_log(LogInfo, "test message");
+
+    UNSIGNED_LONGS_EQUAL(11, messages.count);
+    CHECK(messages.from_caller_thread);
+}
+
+TEST(log, async_repeated) {
+    CHECK(roc_log_set_async(1) == 0);
+    CHECK(roc_log_set_async(1) == 0);
+
+    CHECK(roc_log_set_async(0) == 0);
+    CHECK(roc_log_set_async(0) == 0);
+}
+
+} // namespace api
+} // namespace roc
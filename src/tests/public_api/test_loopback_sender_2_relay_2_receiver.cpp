@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/context.h"
+#include "test_helpers/receiver.h"
+#include "test_helpers/relay.h"
+#include "test_helpers/sender.h"
+
+#include "roc_fec/codec_map.h"
+
+#include "roc/config.h"
+
+namespace roc {
+namespace api {
+
+TEST_GROUP(loopback_sender_2_relay_2_receiver) {
+    roc_sender_config sender_conf;
+    roc_receiver_config receiver_conf;
+
+    float sample_step;
+
+    void setup() {
+        sample_step = 1. / 32768.;
+    }
+
+    void init_config(unsigned flags) {
+        memset(&sender_conf, 0, sizeof(sender_conf));
+        sender_conf.frame_encoding.rate = test::SampleRate;
+        sender_conf.frame_encoding.format = ROC_FORMAT_PCM_FLOAT32;
+        sender_conf.frame_encoding.channels = ROC_CHANNEL_LAYOUT_STEREO;
+        sender_conf.packet_encoding = ROC_PACKET_ENCODING_AVP_L16_STEREO;
+        sender_conf.packet_length =
+            test::PacketSamples * 1000000000ull / test::SampleRate;
+        sender_conf.clock_source = ROC_CLOCK_SOURCE_INTERNAL;
+
+        if (flags & test::FlagRS8M) {
+            sender_conf.fec_encoding = ROC_FEC_ENCODING_RS8M;
+            sender_conf.fec_block_source_packets = test::SourcePackets;
+            sender_conf.fec_block_repair_packets = test::RepairPackets;
+        } else {
+            sender_conf.fec_encoding = ROC_FEC_ENCODING_DISABLE;
+        }
+
+        memset(&receiver_conf, 0, sizeof(receiver_conf));
+        receiver_conf.frame_encoding.rate = test::SampleRate;
+        receiver_conf.frame_encoding.format = ROC_FORMAT_PCM_FLOAT32;
+        receiver_conf.frame_encoding.channels = ROC_CHANNEL_LAYOUT_STEREO;
+        receiver_conf.clock_source = ROC_CLOCK_SOURCE_INTERNAL;
+        receiver_conf.latency_tuner_profile = ROC_LATENCY_TUNER_PROFILE_INTACT;
+        receiver_conf.target_latency = test::Latency * 1000000000ull / test::SampleRate;
+        receiver_conf.no_playback_timeout =
+            test::Timeout * 1000000000ull / test::SampleRate;
+    }
+
+    bool is_rs8m_supported() {
+        return fec::CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8);
+    }
+};
+
+TEST(loopback_sender_2_relay_2_receiver, bare_rtp) {
+    enum { Flags = 0, FrameChans = 2 };
+
+    init_config(Flags);
+
+    test::Context context;
+
+    test::Receiver receiver(context, receiver_conf, sample_step, FrameChans,
+                            test::FrameSamples, Flags);
+
+    receiver.bind();
+
+    test::Relay relay(context, Flags);
+
+    relay.bind();
+    relay.connect(0, receiver.source_endpoint(), receiver.repair_endpoint(),
+                  receiver.control_endpoint());
+
+    test::Sender sender(context, sender_conf, sample_step, FrameChans, test::FrameSamples,
+                        Flags);
+
+    sender.connect(relay.source_endpoint(), relay.repair_endpoint(), NULL);
+
+    CHECK(sender.start());
+    receiver.receive();
+    sender.stop();
+    sender.join();
+}
+
+TEST(loopback_sender_2_relay_2_receiver, rtp_rtcp) {
+    enum { Flags = test::FlagRTCP, FrameChans = 2 };
+
+    init_config(Flags);
+
+    test::Context context;
+
+    test::Receiver receiver(context, receiver_conf, sample_step, FrameChans,
+                            test::FrameSamples, Flags);
+
+    receiver.bind();
+
+    test::Relay relay(context, Flags);
+
+    relay.bind();
+    relay.connect(0, receiver.source_endpoint(), receiver.repair_endpoint(),
+                  receiver.control_endpoint());
+
+    test::Sender sender(context, sender_conf, sample_step, FrameChans, test::FrameSamples,
+                        Flags);
+
+    sender.connect(relay.source_endpoint(), relay.repair_endpoint(),
+                   relay.control_endpoint());
+
+    CHECK(sender.start());
+    receiver.receive();
+    sender.stop();
+    sender.join();
+}
+
+TEST(loopback_sender_2_relay_2_receiver, rs8m) {
+    if (!is_rs8m_supported()) {
+        return;
+    }
+
+    enum { Flags = test::FlagRS8M, FrameChans = 2 };
+
+    init_config(Flags);
+
+    test::Context context;
+
+    test::Receiver receiver(context, receiver_conf, sample_step, FrameChans,
+                            test::FrameSamples, Flags);
+
+    receiver.bind();
+
+    test::Relay relay(context, Flags);
+
+    relay.bind();
+    relay.connect(0, receiver.source_endpoint(), receiver.repair_endpoint(),
+                  receiver.control_endpoint());
+
+    test::Sender sender(context, sender_conf, sample_step, FrameChans, test::FrameSamples,
+                        Flags);
+
+    sender.connect(relay.source_endpoint(), relay.repair_endpoint(), NULL);
+
+    CHECK(sender.start());
+    receiver.receive();
+    sender.stop();
+    sender.join();
+}
+
+TEST(loopback_sender_2_relay_2_receiver, multiple_receivers) {
+    enum { Flags = test::FlagRTCP, FrameChans = 2 };
+
+    init_config(Flags);
+
+    test::Context context;
+
+    test::Receiver receiver_1(context, receiver_conf, sample_step, FrameChans,
+                              test::FrameSamples, Flags);
+    test::Receiver receiver_2(context, receiver_conf, sample_step, FrameChans,
+                              test::FrameSamples, Flags);
+
+    receiver_1.bind();
+    receiver_2.bind();
+
+    test::Relay relay(context, Flags);
+
+    relay.bind();
+    relay.connect(0, receiver_1.source_endpoint(), receiver_1.repair_endpoint(),
+                  receiver_1.control_endpoint());
+    relay.connect(1, receiver_2.source_endpoint(), receiver_2.repair_endpoint(),
+                  receiver_2.control_endpoint());
+
+    test::Sender sender(context, sender_conf, sample_step, FrameChans, test::FrameSamples,
+                        Flags);
+
+    sender.connect(relay.source_endpoint(), relay.repair_endpoint(),
+                   relay.control_endpoint());
+
+    CHECK(receiver_1.start());
+    CHECK(receiver_2.start());
+    CHECK(sender.start());
+    receiver_1.join();
+    receiver_2.join();
+    sender.stop();
+    sender.join();
+
+    relay.unlink(0);
+    relay.unlink(1);
+}
+
+} // namespace api
+} // namespace roc
@@ -214,6 +214,121 @@ TEST(receiver_decoder, push_packet_args) {
     LONGS_EQUAL(0, roc_receiver_decoder_close(decoder));
 }
 
+TEST(receiver_decoder, push_packets_args) {
+    roc_receiver_decoder* decoder = NULL;
+    CHECK(roc_receiver_decoder_open(context, &receiver_config, &decoder) == 0);
+
+    CHECK(
+        roc_receiver_decoder_activate(decoder, ROC_INTERFACE_AUDIO_SOURCE, ROC_PROTO_RTP)
+        == 0);
+
+    uint8_t bytes[256] = {};
+
+    roc_packet packets[4];
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
+        packets[n].bytes = bytes;
+        packets[n].bytes_size = ROC_ARRAY_SIZE(bytes);
+    }
+
+    int statuses[ROC_ARRAY_SIZE(packets)] = {};
+
+    { // null decoder
+        CHECK(roc_receiver_decoder_push_packets(NULL, ROC_INTERFACE_AUDIO_SOURCE,
+                                                packets, ROC_ARRAY_SIZE(packets),
+                                                statuses)
+              == -1);
+    }
+
+    { // bad interface
+        CHECK(roc_receiver_decoder_push_packets(decoder, (roc_interface)-1, packets,
+                                                ROC_ARRAY_SIZE(packets), statuses)
+              == -1);
+    }
+
+    { // inactive interface
+        CHECK(roc_receiver_decoder_push_packets(decoder, ROC_INTERFACE_AUDIO_REPAIR,
+                                                packets, ROC_ARRAY_SIZE(packets),
+                                                statuses)
+              == -1);
+        for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
+            LONGS_EQUAL(-1, statuses[n]);
+        }
+    }
+
+    { // null packets, non-zero packet count
+        CHECK(roc_receiver_decoder_push_packets(decoder, ROC_INTERFACE_AUDIO_SOURCE,
+                                                NULL, ROC_ARRAY_SIZE(packets), statuses)
+              == -1);
+    }
+
+    { // zero packet count
+        CHECK(roc_receiver_decoder_push_packets(decoder, ROC_INTERFACE_AUDIO_SOURCE,
+                                                NULL, 0, NULL)
+              == 0);
+    }
+
+    { // null statuses
+        CHECK(roc_receiver_decoder_push_packets(decoder, ROC_INTERFACE_AUDIO_SOURCE,
+                                                packets, ROC_ARRAY_SIZE(packets), NULL)
+              == 0);
+    }
+
+    { // all good
+        CHECK(roc_receiver_decoder_push_packets(decoder, ROC_INTERFACE_AUDIO_SOURCE,
+                                                packets, ROC_ARRAY_SIZE(packets),
+                                                statuses)
+              == 0);
+        for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
+            LONGS_EQUAL(0, statuses[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, roc_receiver_decoder_close(decoder));
+}
+
+TEST(receiver_decoder, push_packets_statuses) {
+    roc_receiver_decoder* decoder = NULL;
+    CHECK(roc_receiver_decoder_open(context, &receiver_config, &decoder) == 0);
+
+    CHECK(
+        roc_receiver_decoder_activate(decoder, ROC_INTERFACE_AUDIO_SOURCE, ROC_PROTO_RTP)
+        == 0);
+
+    uint8_t bytes[256] = {};
+    float large_bytes[20000] = {};
+
+    // more than fits into one internal batch
+    roc_packet packets[150];
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
+        packets[n].bytes = bytes;
+        packets[n].bytes_size = ROC_ARRAY_SIZE(bytes);
+    }
+
+    // null bytes
+    packets[10].bytes = NULL;
+    // zero byte count
+    packets[70].bytes_size = 0;
+    // large byte count
+    packets[149].bytes = large_bytes;
+    packets[149].bytes_size = ROC_ARRAY_SIZE(large_bytes);
+
+    int statuses[ROC_ARRAY_SIZE(packets)] = {};
+
+    CHECK(roc_receiver_decoder_push_packets(decoder, ROC_INTERFACE_AUDIO_SOURCE, packets,
+                                            ROC_ARRAY_SIZE(packets), statuses)
+          == -1);
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
+        if (n == 10 || n == 70 || n == 149) {
+            LONGS_EQUAL(-1, statuses[n]);
+        } else {
+            LONGS_EQUAL(0, statuses[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, roc_receiver_decoder_close(decoder));
+}
+
 TEST(receiver_decoder, pop_feedback_packet_args) {
     int n_iter = 0;
 
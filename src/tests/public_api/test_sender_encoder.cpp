@@ -350,5 +350,174 @@ TEST(sender_encoder, pop_packet_args) {
     LONGS_EQUAL(0, roc_sender_encoder_close(encoder));
 }
 
+TEST(sender_encoder, pop_packets_args) {
+    roc_sender_encoder* encoder = NULL;
+    CHECK(roc_sender_encoder_open(context, &sender_config, &encoder) == 0);
+
+    CHECK(roc_sender_encoder_activate(encoder, ROC_INTERFACE_AUDIO_SOURCE, ROC_PROTO_RTP)
+          == 0);
+
+    for (size_t n_frame = 0; n_frame < 4; n_frame++) {
+        float samples[8192] = {};
+        roc_frame frame;
+        frame.samples = samples;
+        frame.samples_size = ROC_ARRAY_SIZE(samples);
+        CHECK(roc_sender_encoder_push_frame(encoder, &frame) == 0);
+    }
+
+    uint8_t bytes[4][8192] = {};
+
+    roc_packet packets[4];
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
+        packets[n].bytes = bytes[n];
+        packets[n].bytes_size = ROC_ARRAY_SIZE(bytes[n]);
+    }
+
+    int statuses[ROC_ARRAY_SIZE(packets)] = {};
+
+    { // null encoder
+        size_t count = ROC_ARRAY_SIZE(packets);
+        CHECK(roc_sender_encoder_pop_packets(NULL, ROC_INTERFACE_AUDIO_SOURCE, packets,
+                                             &count, statuses)
+              == -1);
+    }
+
+    { // bad interface
+        size_t count = ROC_ARRAY_SIZE(packets);
+        CHECK(roc_sender_encoder_pop_packets(encoder, (roc_interface)-1, packets, &count,
+                                             statuses)
+              == -1);
+    }
+
+    { // unactivated interface
+        size_t count = ROC_ARRAY_SIZE(packets);
+        CHECK(roc_sender_encoder_pop_packets(encoder, ROC_INTERFACE_AUDIO_REPAIR, packets,
+                                             &count, statuses)
+              == -1);
+        LONGS_EQUAL(0, count);
+    }
+
+    { // null count
+        CHECK(roc_sender_encoder_pop_packets(encoder, ROC_INTERFACE_AUDIO_SOURCE, packets,
+                                             NULL, statuses)
+              == -1);
+    }
+
+    { // null packets, non-zero count
+        size_t count = ROC_ARRAY_SIZE(packets);
+        CHECK(roc_sender_encoder_pop_packets(encoder, ROC_INTERFACE_AUDIO_SOURCE, NULL,
+                                             &count, statuses)
+              == -1);
+    }
+
+    { // null bytes in one of packets
+        roc_packet bad_packets[2];
+        bad_packets[0] = packets[0];
+        bad_packets[1].bytes = NULL;
+        bad_packets[1].bytes_size = 100;
+        size_t count = ROC_ARRAY_SIZE(bad_packets);
+        CHECK(roc_sender_encoder_pop_packets(encoder, ROC_INTERFACE_AUDIO_SOURCE,
+                                             bad_packets, &count, statuses)
+              == -1);
+    }
+
+    { // zero count
+        size_t count = 0;
+        CHECK(roc_sender_encoder_pop_packets(encoder, ROC_INTERFACE_AUDIO_SOURCE, packets,
+                                             &count, statuses)
+              == -1);
+        LONGS_EQUAL(0, count);
+    }
+
+    { // small byte count in one of packets
+        packets[1].bytes_size = 10;
+
+        size_t count = ROC_ARRAY_SIZE(packets);
+        CHECK(roc_sender_encoder_pop_packets(encoder, ROC_INTERFACE_AUDIO_SOURCE, packets,
+                                             &count, statuses)
+              == -1);
+        LONGS_EQUAL(ROC_ARRAY_SIZE(packets), count);
+
+        LONGS_EQUAL(0, statuses[0]);
+        LONGS_EQUAL(-1, statuses[1]);
+        LONGS_EQUAL(0, statuses[2]);
+        LONGS_EQUAL(0, statuses[3]);
+
+        packets[1].bytes_size = ROC_ARRAY_SIZE(bytes[1]);
+    }
+
+    { // all good
+        size_t count = ROC_ARRAY_SIZE(packets);
+        CHECK(roc_sender_encoder_pop_packets(encoder, ROC_INTERFACE_AUDIO_SOURCE, packets,
+                                             &count, NULL)
+              == 0);
+        LONGS_EQUAL(ROC_ARRAY_SIZE(packets), count);
+
+        for (size_t n = 0; n < count; n++) {
+            CHECK(packets[n].bytes == bytes[n]);
+            CHECK(packets[n].bytes_size > 0);
+            CHECK(packets[n].bytes_size < ROC_ARRAY_SIZE(bytes[n]));
+        }
+    }
+
+    LONGS_EQUAL(0, roc_sender_encoder_close(encoder));
+}
+
+TEST(sender_encoder, pop_packets_drain) {
+    enum { NumFrames = 10 };
+
+    size_t n_single = 0, n_batch = 0;
+
+    for (int batch = 0; batch < 2; batch++) {
+        roc_sender_encoder* encoder = NULL;
+        CHECK(roc_sender_encoder_open(context, &sender_config, &encoder) == 0);
+
+        CHECK(roc_sender_encoder_activate(encoder, ROC_INTERFACE_AUDIO_SOURCE,
+                                          ROC_PROTO_RTP)
+              == 0);
+
+        for (size_t n_frame = 0; n_frame < NumFrames; n_frame++) {
+            float samples[8192] = {};
+            roc_frame frame;
+            frame.samples = samples;
+            frame.samples_size = ROC_ARRAY_SIZE(samples);
+            CHECK(roc_sender_encoder_push_frame(encoder, &frame) == 0);
+        }
+
+        for (;;) {
+            uint8_t bytes[3][8192];
+            roc_packet packets[3];
+            for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
+                packets[n].bytes = bytes[n];
+                packets[n].bytes_size = ROC_ARRAY_SIZE(bytes[n]);
+            }
+
+            if (batch) {
+                size_t count = ROC_ARRAY_SIZE(packets);
+                if (roc_sender_encoder_pop_packets(encoder, ROC_INTERFACE_AUDIO_SOURCE,
+                                                   packets, &count, NULL)
+                    != 0) {
+                    LONGS_EQUAL(0, count);
+                    break;
+                }
+                CHECK(count > 0);
+                n_batch += count;
+            } else {
+                if (roc_sender_encoder_pop_packet(encoder, ROC_INTERFACE_AUDIO_SOURCE,
+                                                  &packets[0])
+                    != 0) {
+                    break;
+                }
+                n_single++;
+            }
+        }
+
+        LONGS_EQUAL(0, roc_sender_encoder_close(encoder));
+    }
+
+    CHECK(n_single > 0);
+    LONGS_EQUAL(n_single, n_batch);
+}
+
 } // namespace api
 } // namespace roc
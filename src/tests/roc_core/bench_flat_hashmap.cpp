@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/fast_random.h"
+#include "roc_core/flat_hashmap.h"
+#include "roc_core/hashmap.h"
+#include "roc_core/hashsum.h"
+#include "roc_core/heap_arena.h"
+
+namespace roc {
+namespace core {
+namespace {
+
+enum { MaxElems = 10000, NumLookups = 1024 };
+
+HeapArena arena;
+
+struct Object : HashmapNode<> {
+    uint32_t id;
+
+    uint32_t key() const {
+        return id;
+    }
+
+    static hashsum_t key_hash(uint32_t key) {
+        return hashsum_int(key);
+    }
+
+    static bool key_equal(uint32_t key1, uint32_t key2) {
+        return key1 == key2;
+    }
+};
+
+// Keys are random, like SSRCs, and lookups are performed in random order,
+// so that accessed memory is not sequential.
+struct Keys {
+    uint32_t elems[MaxElems];
+    uint32_t lookups[NumLookups];
+
+    Keys() {
+        for (size_t n = 0; n < MaxElems; n++) {
+            elems[n] = (uint32_t)fast_random_range(0, (uint32_t)-1);
+        }
+    }
+
+    void init_lookups(size_t n_elems) {
+        for (size_t n = 0; n < NumLookups; n++) {
+            lookups[n] = elems[fast_random_range(0, (uint32_t)n_elems - 1)];
+        }
+    }
+};
+
+Keys keys;
+
+void BM_Hashmap_Find(benchmark::State& state) {
+    const size_t n_elems = (size_t)state.range(0);
+
+    Object* objects = new Object[n_elems];
+    Hashmap<Object, 0, NoOwnership>* hashmap = new Hashmap<Object, 0, NoOwnership>(arena);
+
+    for (size_t n = 0; n < n_elems; n++) {
+        objects[n].id = keys.elems[n];
+        if (!hashmap->find(objects[n].id) && !hashmap->insert(objects[n])) {
+            state.SkipWithError("insert failed");
+        }
+    }
+
+    keys.init_lookups(n_elems);
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        Object* obj = hashmap->find(keys.lookups[n++ % NumLookups]);
+        benchmark::DoNotOptimize(obj);
+    }
+
+    delete hashmap;
+    delete[] objects;
+}
+
+BENCHMARK(BM_Hashmap_Find)->RangeMultiplier(10)->Range(10, MaxElems);
+
+void BM_FlatHashmap_Find(benchmark::State& state) {
+    const size_t n_elems = (size_t)state.range(0);
+
+    FlatHashmap<uint32_t, void*>* hashmap = new FlatHashmap<uint32_t, void*>(arena);
+
+    for (size_t n = 0; n < n_elems; n++) {
+        if (!hashmap->contains(keys.elems[n]) && !hashmap->insert(keys.elems[n], NULL)) {
+            state.SkipWithError("insert failed");
+        }
+    }
+
+    keys.init_lookups(n_elems);
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        void** value = hashmap->find(keys.lookups[n++ % NumLookups]);
+        benchmark::DoNotOptimize(value);
+    }
+
+    delete hashmap;
+}
+
+BENCHMARK(BM_FlatHashmap_Find)->RangeMultiplier(10)->Range(10, MaxElems);
+
+void BM_Hashmap_InsertRemove(benchmark::State& state) {
+    const size_t n_elems = (size_t)state.range(0);
+
+    Object* objects = new Object[n_elems];
+    Hashmap<Object, 0, NoOwnership>* hashmap = new Hashmap<Object, 0, NoOwnership>(arena);
+
+    for (size_t n = 0; n < n_elems; n++) {
+        objects[n].id = (uint32_t)n;
+    }
+
+    while (state.KeepRunning()) {
+        for (size_t n = 0; n < n_elems; n++) {
+            if (!hashmap->insert(objects[n])) {
+                state.SkipWithError("insert failed");
+            }
+        }
+        for (size_t n = 0; n < n_elems; n++) {
+            hashmap->remove(objects[n]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * (int64_t)n_elems);
+
+    delete hashmap;
+    delete[] objects;
+}
+
+BENCHMARK(BM_Hashmap_InsertRemove)->RangeMultiplier(10)->Range(10, MaxElems);
+
+void BM_FlatHashmap_InsertRemove(benchmark::State& state) {
+    const size_t n_elems = (size_t)state.range(0);
+
+    FlatHashmap<uint32_t, void*>* hashmap = new FlatHashmap<uint32_t, void*>(arena);
+
+    while (state.KeepRunning()) {
+        for (size_t n = 0; n < n_elems; n++) {
+            if (!hashmap->insert((uint32_t)n, NULL)) {
+                state.SkipWithError("insert failed");
+            }
+        }
+        for (size_t n = 0; n < n_elems; n++) {
+            hashmap->remove((uint32_t)n);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * (int64_t)n_elems);
+
+    delete hashmap;
+}
+
+BENCHMARK(BM_FlatHashmap_InsertRemove)->RangeMultiplier(10)->Range(10, MaxElems);
+
+} // namespace
+} // namespace core
+} // namespace roc
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/async_log_writer.h"
+#include "roc_core/atomic.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/log.h"
+#include "roc_core/mutex.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { MaxMessages = 4000, NumThreads = 4, NumThreadMessages = 500 };
+
+HeapArena arena;
+
+// Collects messages passed from background thread.
+class Collector {
+public:
+    Collector()
+        : n_messages_(0)
+        , n_reports_(0)
+        , blocked_(false) {
+    }
+
+    static void handler(const LogMessage& msg, void* arg) {
+        ((Collector*)arg)->handle_(msg);
+    }
+
+    void block() {
+        blocked_ = true;
+    }
+
+    void unblock() {
+        blocked_ = false;
+    }
+
+    size_t num_messages() {
+        Mutex::Lock lock(mutex_);
+        return n_messages_;
+    }
+
+    size_t num_reports() {
+        Mutex::Lock lock(mutex_);
+        return n_reports_;
+    }
+
+    int line(size_t n) {
+        Mutex::Lock lock(mutex_);
+        roc_panic_if(n >= n_messages_);
+        return lines_[n];
+    }
+
+    uint64_t tid(size_t n) {
+        Mutex::Lock lock(mutex_);
+        roc_panic_if(n >= n_messages_);
+        return tids_[n];
+    }
+
+private:
+    void handle_(const LogMessage& msg) {
+        while (blocked_) {
+            sleep_for(ClockMonotonic, Microsecond * 100);
+        }
+
+        Mutex::Lock lock(mutex_);
+
+        if (strstr(msg.text, "dropped")) {
+            n_reports_++;
+            return;
+        }
+
+        roc_panic_if(n_messages_ >= MaxMessages);
+        lines_[n_messages_] = msg.line;
+        tids_[n_messages_] = msg.tid;
+        n_messages_++;
+    }
+
+    Mutex mutex_;
+    size_t n_messages_;
+    size_t n_reports_;
+    int lines_[MaxMessages];
+    uint64_t tids_[MaxMessages];
+    Atomic<int> blocked_;
+};
+
+LogMessage make_message(int line) {
+    LogMessage msg;
+    msg.level = LogInfo;
+    msg.module = "test";
+    msg.file = __FILE__;
+    msg.line = line;
+    msg.time = timestamp(ClockUnix);
+    msg.tid = Thread::get_tid();
+    msg.text = "text";
+    return msg;
+}
+
+void logger_handler(const LogMessage& msg, void** args) {
+    Collector::handler(msg, args[0]);
+}
+
+class WriterThread : public Thread {
+public:
+    explicit WriterThread(AsyncLogWriter& writer)
+        : writer_(writer)
+        , n_written_(0) {
+    }
+
+    size_t num_written() const {
+        return n_written_;
+    }
+
+private:
+    virtual void run() {
+        for (int n = 0; n < NumThreadMessages; n++) {
+            if (writer_.write(make_message(n))) {
+                n_written_++;
+            }
+        }
+    }
+
+    AsyncLogWriter& writer_;
+    size_t n_written_;
+};
+
+} // namespace
+
+TEST_GROUP(async_log_writer) {};
+
+TEST(async_log_writer, write_flush) {
+    Collector collector;
+
+    AsyncLogConfig config;
+    AsyncLogWriter writer(config, &Collector::handler, &collector, arena);
+    CHECK(writer.is_valid());
+    CHECK(writer.start());
+
+    for (int n = 0; n < 100; n++) {
+        CHECK(writer.write(make_message(n)));
+    }
+
+    writer.flush();
+
+    UNSIGNED_LONGS_EQUAL(100, collector.num_messages());
+    UNSIGNED_LONGS_EQUAL(0, writer.num_dropped());
+
+    // messages of one thread are delivered in order
+    for (size_t n = 0; n < 100; n++) {
+        LONGS_EQUAL(n, collector.line(n));
+    }
+
+    writer.stop();
+    writer.join();
+
+    UNSIGNED_LONGS_EQUAL(0, collector.num_reports());
+}
+
+TEST(async_log_writer, overflow) {
+    enum { LaneSize = 10 };
+
+    Collector collector;
+
+    AsyncLogConfig config;
+    config.num_lanes = 1;
+    config.lane_size = LaneSize;
+
+    AsyncLogWriter writer(config, &Collector::handler, &collector, arena);
+    CHECK(writer.is_valid());
+    CHECK(writer.start());
+
+    // background thread will be stuck in handler on first message,
+    // so lane can't hold more than its size
+    collector.block();
+
+    size_t n_written = 0;
+    for (int n = 0; n < LaneSize * 3; n++) {
+        if (writer.write(make_message(n))) {
+            n_written++;
+        }
+    }
+
+    CHECK(writer.num_dropped() > 0);
+    CHECK(n_written <= LaneSize + 1);
+
+    collector.unblock();
+    writer.flush();
+
+    UNSIGNED_LONGS_EQUAL(n_written, collector.num_messages());
+
+    // drops are reported at least on exit
+    writer.stop();
+    writer.join();
+
+    CHECK(collector.num_reports() > 0);
+}
+
+TEST(async_log_writer, concurrent) {
+    Collector collector;
+
+    AsyncLogConfig config;
+    AsyncLogWriter writer(config, &Collector::handler, &collector, arena);
+    CHECK(writer.is_valid());
+    CHECK(writer.start());
+
+    WriterThread* threads[NumThreads];
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n] = new WriterThread(writer);
+        CHECK(threads[n]->start());
+    }
+
+    size_t n_written = 0;
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n]->join();
+        n_written += threads[n]->num_written();
+    }
+
+    writer.flush();
+
+    UNSIGNED_LONGS_EQUAL(NumThreads * NumThreadMessages,
+                         n_written + writer.num_dropped());
+    UNSIGNED_LONGS_EQUAL(n_written, collector.num_messages());
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        delete threads[n];
+    }
+
+    writer.stop();
+    writer.join();
+}
+
+TEST(async_log_writer, logger) {
+    Collector collector;
+
+    void* args[] = { &collector };
+    Logger::instance().set_handler(&logger_handler, args, 1);
+
+    const LogLevel level = Logger::instance().get_level();
+    Logger::instance().set_level(LogInfo);
+
+    CHECK(Logger::instance().enable_async());
+
+    for (int n = 0; n < 10; n++) {
+        roc_log(LogInfo, "test message %d", n);
+    }
+    roc_log(LogDebug, "filtered message");
+
+    // waits until messages are delivered
+    Logger::instance().disable_async();
+
+    UNSIGNED_LONGS_EQUAL(10, collector.num_messages());
+    UNSIGNED_LONGS_EQUAL(0, Logger::instance().num_dropped());
+
+    roc_log(LogInfo, "sync message");
+
+    UNSIGNED_LONGS_EQUAL(11, collector.num_messages());
+    CHECK(collector.tid(10) == Thread::get_tid());
+
+    Logger::instance().set_level(level);
+    Logger::instance().set_handler(NULL, NULL, 0);
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/counting_arena.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/limited_arena.h"
+
+namespace roc {
+namespace core {
+
+// clang-format off
+TEST_GROUP(counting_arena) {
+    void setup() {
+        core::HeapArena::set_guards(0);
+    }
+    void teardown() {
+        core::HeapArena::set_guards(core::HeapArena_DefaultGuards);
+    }
+};
+// clang-format on
+
+TEST(counting_arena, counters) {
+    HeapArena heap_arena;
+
+    {
+        CountingArena arena(heap_arena);
+
+        LONGS_EQUAL(0, arena.num_allocations());
+        LONGS_EQUAL(0, arena.num_bytes());
+        LONGS_EQUAL(0, arena.max_bytes());
+
+        void* pointer0 = arena.allocate(128);
+        CHECK(pointer0);
+
+        const size_t size0 = arena.allocated_size(pointer0);
+        CHECK(size0 >= 128);
+
+        LONGS_EQUAL(1, arena.num_allocations());
+        LONGS_EQUAL(size0, arena.num_bytes());
+        LONGS_EQUAL(size0, arena.max_bytes());
+
+        void* pointer1 = arena.allocate(256);
+        CHECK(pointer1);
+
+        const size_t size1 = arena.allocated_size(pointer1);
+        CHECK(size1 >= 256);
+
+        LONGS_EQUAL(2, arena.num_allocations());
+        LONGS_EQUAL(size0 + size1, arena.num_bytes());
+        LONGS_EQUAL(size0 + size1, arena.max_bytes());
+
+        arena.deallocate(pointer0);
+
+        LONGS_EQUAL(1, arena.num_allocations());
+        LONGS_EQUAL(size1, arena.num_bytes());
+        LONGS_EQUAL(size0 + size1, arena.max_bytes());
+
+        arena.deallocate(pointer1);
+
+        LONGS_EQUAL(0, arena.num_allocations());
+        LONGS_EQUAL(0, arena.num_bytes());
+        LONGS_EQUAL(size0 + size1, arena.max_bytes());
+
+        LONGS_EQUAL(0, arena.num_failures());
+    }
+}
+
+TEST(counting_arena, failures) {
+    HeapArena heap_arena;
+    MemoryLimiter memory_limiter("test", 256);
+
+    {
+        LimitedArena limited_arena(heap_arena, memory_limiter);
+        CountingArena arena(limited_arena);
+
+        void* pointer0 = arena.allocate(128);
+        CHECK(pointer0);
+
+        CHECK(arena.allocate(128) == NULL);
+        CHECK(arena.allocate(128) == NULL);
+
+        LONGS_EQUAL(1, arena.num_allocations());
+        LONGS_EQUAL(2, arena.num_failures());
+
+        arena.deallocate(pointer0);
+
+        LONGS_EQUAL(0, arena.num_allocations());
+        LONGS_EQUAL(0, arena.num_bytes());
+    }
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/custom_arena.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+struct TestAllocator {
+    int n_allocs;
+    int n_deallocs;
+    bool fail;
+
+    TestAllocator()
+        : n_allocs(0)
+        , n_deallocs(0)
+        , fail(false) {
+    }
+};
+
+void* test_allocate(size_t size, void* arg) {
+    TestAllocator& allocator = *(TestAllocator*)arg;
+    if (allocator.fail) {
+        return NULL;
+    }
+    allocator.n_allocs++;
+    return malloc(size);
+}
+
+void test_deallocate(void* ptr, void* arg) {
+    TestAllocator& allocator = *(TestAllocator*)arg;
+    allocator.n_deallocs++;
+    free(ptr);
+}
+
+} // namespace
+
+TEST_GROUP(custom_arena) {};
+
+TEST(custom_arena, allocate_deallocate) {
+    TestAllocator allocator;
+
+    {
+        CustomArena arena(test_allocate, test_deallocate, &allocator);
+
+        void* pointer0 = arena.allocate(128);
+        CHECK(pointer0);
+        memset(pointer0, 0xff, 128);
+
+        void* pointer1 = arena.allocate(64);
+        CHECK(pointer1);
+        memset(pointer1, 0xff, 64);
+
+        LONGS_EQUAL(2, allocator.n_allocs);
+        LONGS_EQUAL(0, allocator.n_deallocs);
+        LONGS_EQUAL(2, arena.num_allocations());
+
+        arena.deallocate(pointer0);
+        arena.deallocate(pointer1);
+
+        LONGS_EQUAL(2, allocator.n_allocs);
+        LONGS_EQUAL(2, allocator.n_deallocs);
+        LONGS_EQUAL(0, arena.num_allocations());
+    }
+}
+
+TEST(custom_arena, allocated_size) {
+    TestAllocator allocator;
+
+    {
+        CustomArena arena(test_allocate, test_deallocate, &allocator);
+
+        CHECK(arena.compute_allocated_size(128) > 128);
+
+        void* pointer0 = arena.allocate(128);
+        CHECK(pointer0);
+
+        LONGS_EQUAL(arena.compute_allocated_size(128), arena.allocated_size(pointer0));
+
+        arena.deallocate(pointer0);
+    }
+}
+
+TEST(custom_arena, allocation_failure) {
+    TestAllocator allocator;
+    allocator.fail = true;
+
+    {
+        CustomArena arena(test_allocate, test_deallocate, &allocator);
+
+        CHECK(arena.allocate(128) == NULL);
+
+        LONGS_EQUAL(0, allocator.n_allocs);
+        LONGS_EQUAL(0, arena.num_allocations());
+    }
+}
+
+} // namespace core
+} // namespace roc
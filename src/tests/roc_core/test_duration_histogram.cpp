@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/duration_histogram.h"
+#include "roc_core/nested_timer.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// Checks that quantile is not less than actual value and exceeds it
+// by not more than bucket width.
+void check_quantile(nanoseconds_t actual, nanoseconds_t expected) {
+    CHECK(actual >= expected);
+    CHECK(actual <= expected + expected / 8 + (1 << DurationHistogram::ResolutionBits));
+}
+
+} // namespace
+
+TEST_GROUP(duration_histogram) {};
+
+TEST(duration_histogram, empty) {
+    DurationHistogram hist;
+
+    UNSIGNED_LONGS_EQUAL(0, hist.count());
+    LONGS_EQUAL(0, hist.max());
+    LONGS_EQUAL(0, hist.quantile(0.5));
+
+    const DurationMetrics metrics = hist.metrics();
+
+    UNSIGNED_LONGS_EQUAL(0, metrics.count);
+    LONGS_EQUAL(0, metrics.p50);
+    LONGS_EQUAL(0, metrics.p99);
+    LONGS_EQUAL(0, metrics.p999);
+    LONGS_EQUAL(0, metrics.max);
+}
+
+TEST(duration_histogram, single) {
+    DurationHistogram hist;
+
+    hist.add(Microsecond * 5);
+
+    UNSIGNED_LONGS_EQUAL(1, hist.count());
+    LONGS_EQUAL(Microsecond * 5, hist.max());
+
+    // quantiles are clamped to max
+    LONGS_EQUAL(Microsecond * 5, hist.quantile(0));
+    LONGS_EQUAL(Microsecond * 5, hist.quantile(0.5));
+    LONGS_EQUAL(Microsecond * 5, hist.quantile(1));
+}
+
+TEST(duration_histogram, quantiles) {
+    DurationHistogram hist;
+
+    // 1us .. 1000us
+    for (nanoseconds_t n = 1; n <= 1000; n++) {
+        hist.add(n * Microsecond);
+    }
+
+    UNSIGNED_LONGS_EQUAL(1000, hist.count());
+    LONGS_EQUAL(1000 * Microsecond, hist.max());
+
+    check_quantile(hist.quantile(0.5), 500 * Microsecond);
+    check_quantile(hist.quantile(0.99), 990 * Microsecond);
+    check_quantile(hist.quantile(0.999), 999 * Microsecond);
+
+    const DurationMetrics metrics = hist.metrics();
+
+    UNSIGNED_LONGS_EQUAL(1000, metrics.count);
+    LONGS_EQUAL(hist.quantile(0.5), metrics.p50);
+    LONGS_EQUAL(hist.quantile(0.99), metrics.p99);
+    LONGS_EQUAL(hist.quantile(0.999), metrics.p999);
+    LONGS_EQUAL(1000 * Microsecond, metrics.max);
+}
+
+TEST(duration_histogram, outlier) {
+    DurationHistogram hist;
+
+    for (int n = 0; n < 999; n++) {
+        hist.add(10 * Microsecond);
+    }
+    hist.add(20 * Millisecond);
+
+    check_quantile(hist.quantile(0.5), 10 * Microsecond);
+    check_quantile(hist.quantile(0.99), 10 * Microsecond);
+    LONGS_EQUAL(20 * Millisecond, hist.quantile(1));
+    LONGS_EQUAL(20 * Millisecond, hist.max());
+}
+
+TEST(duration_histogram, small_and_large) {
+    DurationHistogram hist;
+
+    // below resolution
+    hist.add(0);
+    hist.add(1);
+    hist.add(-100);
+
+    // above last bucket
+    hist.add(Minute);
+
+    UNSIGNED_LONGS_EQUAL(4, hist.count());
+    LONGS_EQUAL(Minute, hist.max());
+
+    CHECK(hist.quantile(0.5) <= (1 << DurationHistogram::ResolutionBits));
+    LONGS_EQUAL(Minute, hist.quantile(1));
+}
+
+TEST(duration_histogram, metrics_match_quantiles) {
+    enum { NumIters = 50 };
+
+    DurationHistogram hist;
+
+    // mix of short, long, and out-of-range durations
+    for (int iter = 0; iter < NumIters; iter++) {
+        for (int n = 0; n < iter * 7 + 1; n++) {
+            hist.add((n % 13) * Microsecond);
+        }
+        for (int n = 0; n < iter % 5; n++) {
+            hist.add((iter + 1) * Millisecond);
+        }
+        if (iter % 17 == 0) {
+            hist.add(Minute);
+        }
+
+        const DurationMetrics metrics = hist.metrics();
+
+        UNSIGNED_LONGS_EQUAL(hist.count(), metrics.count);
+        LONGS_EQUAL(hist.max(), metrics.max);
+        LONGS_EQUAL(hist.quantile(0.5), metrics.p50);
+        LONGS_EQUAL(hist.quantile(0.99), metrics.p99);
+        LONGS_EQUAL(hist.quantile(0.999), metrics.p999);
+    }
+}
+
+TEST(duration_histogram, reset) {
+    DurationHistogram hist;
+
+    hist.add(Millisecond);
+    hist.reset();
+
+    UNSIGNED_LONGS_EQUAL(0, hist.count());
+    LONGS_EQUAL(0, hist.max());
+    LONGS_EQUAL(0, hist.quantile(0.99));
+}
+
+TEST(duration_histogram, nested_timer) {
+    NestedTimer timer;
+
+    NestedTimer::Scope outer;
+    NestedTimer::Scope inner;
+
+    timer.begin(outer);
+    sleep_for(ClockMonotonic, Millisecond);
+
+    timer.begin(inner);
+    sleep_for(ClockMonotonic, Millisecond * 50);
+    const nanoseconds_t inner_time = timer.end(inner);
+
+    const nanoseconds_t outer_time = timer.end(outer);
+
+    CHECK(inner_time >= Millisecond * 50);
+    CHECK(outer_time >= Millisecond);
+
+    // time of inner scope is excluded from outer scope
+    CHECK(outer_time < inner_time);
+}
+
+} // namespace core
+} // namespace roc
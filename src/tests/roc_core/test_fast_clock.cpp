@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/fast_clock.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// Allowed difference between fast clock and monotonic clock.
+// Generous, because thread may be preempted between reading clocks.
+const nanoseconds_t Epsilon = 5 * Millisecond;
+
+void check_tracks_monotonic(FastClock& clock) {
+    for (size_t n = 0; n < 5; n++) {
+        const nanoseconds_t before = timestamp(ClockMonotonic);
+        const nanoseconds_t ts = clock.now();
+        const nanoseconds_t after = timestamp(ClockMonotonic);
+
+        CHECK(ts >= before - Epsilon);
+        CHECK(ts <= after + Epsilon);
+
+        // cross re-anchoring interval
+        sleep_for(ClockMonotonic, 30 * Millisecond);
+    }
+}
+
+void check_never_decreases(FastClock& clock, nanoseconds_t duration) {
+    const nanoseconds_t deadline = timestamp(ClockMonotonic) + duration;
+
+    nanoseconds_t prev = clock.now();
+
+    while (timestamp(ClockMonotonic) < deadline) {
+        for (size_t n = 0; n < 1000; n++) {
+            const nanoseconds_t ts = clock.now();
+            CHECK(ts >= prev);
+            prev = ts;
+        }
+    }
+}
+
+class NowThread : public Thread {
+public:
+    NowThread(FastClock& clock, nanoseconds_t duration)
+        : clock_(clock)
+        , duration_(duration) {
+    }
+
+private:
+    virtual void run() {
+        check_never_decreases(clock_, duration_);
+    }
+
+    FastClock& clock_;
+    nanoseconds_t duration_;
+};
+
+} // namespace
+
+TEST_GROUP(fast_clock) {};
+
+TEST(fast_clock, monotonic) {
+    FastClock clock(FastClock_Monotonic);
+
+    LONGS_EQUAL(FastClock_Monotonic, clock.source());
+
+    check_tracks_monotonic(clock);
+}
+
+TEST(fast_clock, tsc) {
+    FastClock clock(FastClock_Tsc);
+
+    if (FastClock::tsc_supported()) {
+        LONGS_EQUAL(FastClock_Tsc, clock.source());
+    } else {
+        LONGS_EQUAL(FastClock_Monotonic, clock.source());
+    }
+
+    check_tracks_monotonic(clock);
+}
+
+TEST(fast_clock, advances) {
+    FastClock clock(FastClock_Auto);
+
+    CHECK(clock.source() == FastClock_Tsc || clock.source() == FastClock_Monotonic);
+
+    const nanoseconds_t start = clock.now();
+
+    sleep_for(ClockMonotonic, Millisecond);
+
+    CHECK(clock.now() - start >= Millisecond - Epsilon / 10);
+}
+
+TEST(fast_clock, never_decreases) {
+    enum { NumThreads = 4 };
+
+    // re-anchor very often, so that test crosses many re-anchors
+    FastClock clock(FastClock_Auto, 10 * Microsecond);
+
+    NowThread* threads[NumThreads];
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n] = new NowThread(clock, 100 * Millisecond);
+        CHECK(threads[n]->start());
+    }
+
+    check_never_decreases(clock, 100 * Millisecond);
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n]->join();
+        delete threads[n];
+    }
+}
+
+TEST(fast_clock, default_instance) {
+    const nanoseconds_t before = timestamp(ClockMonotonic);
+    const nanoseconds_t ts = fast_timestamp();
+    const nanoseconds_t after = timestamp(ClockMonotonic);
+
+    CHECK(ts >= before - Epsilon);
+    CHECK(ts <= after + Epsilon);
+}
+
+} // namespace core
+} // namespace roc
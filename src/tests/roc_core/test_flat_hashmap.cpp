@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/flat_hashmap.h"
+#include "roc_core/hashsum.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/noop_arena.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// All keys land into few slots, to test probing and removal.
+struct CollidingTraits {
+    static hashsum_t key_hash(const uint32_t& key) {
+        return key % 3;
+    }
+
+    static bool key_equal(const uint32_t& key1, const uint32_t& key2) {
+        return key1 == key2;
+    }
+};
+
+// All keys land into last slots, to test probing wrap-around.
+struct WrappingTraits {
+    static hashsum_t key_hash(const uint32_t& key) {
+        return (hashsum_t)-1 - (key % 2);
+    }
+
+    static bool key_equal(const uint32_t& key1, const uint32_t& key2) {
+        return key1 == key2;
+    }
+};
+
+int num_values = 0;
+
+struct Value {
+    int n;
+
+    Value(int n)
+        : n(n) {
+        num_values++;
+    }
+
+    Value(const Value& other)
+        : n(other.n) {
+        num_values++;
+    }
+
+    ~Value() {
+        num_values--;
+    }
+};
+
+} // namespace
+
+TEST_GROUP(flat_hashmap) {
+    HeapArena arena;
+};
+
+TEST(flat_hashmap, empty) {
+    FlatHashmap<uint32_t, int> hashmap(arena);
+
+    LONGS_EQUAL(0, hashmap.size());
+    LONGS_EQUAL(0, hashmap.capacity());
+    CHECK(hashmap.is_empty());
+
+    CHECK(hashmap.find(123) == NULL);
+    CHECK(!hashmap.contains(123));
+    CHECK(!hashmap.remove(123));
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(flat_hashmap, insert_find_remove) {
+    FlatHashmap<uint32_t, int> hashmap(arena);
+
+    CHECK(hashmap.insert(1, 10));
+    CHECK(hashmap.insert(2, 20));
+    CHECK(hashmap.insert(3, 30));
+
+    LONGS_EQUAL(3, hashmap.size());
+    CHECK(!hashmap.is_empty());
+
+    CHECK(hashmap.find(1));
+    CHECK(hashmap.find(2));
+    CHECK(hashmap.find(3));
+    CHECK(!hashmap.find(4));
+
+    LONGS_EQUAL(10, *hashmap.find(1));
+    LONGS_EQUAL(20, *hashmap.find(2));
+    LONGS_EQUAL(30, *hashmap.find(3));
+
+    *hashmap.find(2) = 200;
+    LONGS_EQUAL(200, *hashmap.find(2));
+
+    CHECK(hashmap.remove(2));
+    CHECK(!hashmap.remove(2));
+
+    LONGS_EQUAL(2, hashmap.size());
+    CHECK(hashmap.find(1));
+    CHECK(!hashmap.find(2));
+    CHECK(hashmap.find(3));
+
+    CHECK(hashmap.remove(1));
+    CHECK(hashmap.remove(3));
+
+    LONGS_EQUAL(0, hashmap.size());
+    CHECK(hashmap.is_empty());
+}
+
+TEST(flat_hashmap, grow) {
+    enum { NumElems = 10000 };
+
+    FlatHashmap<uint32_t, uint32_t> hashmap(arena);
+
+    for (uint32_t n = 0; n < NumElems; n++) {
+        CHECK(hashmap.insert(n * 7, n));
+        CHECK(hashmap.size() <= hashmap.capacity());
+    }
+
+    LONGS_EQUAL(NumElems, hashmap.size());
+
+    // only one array is allocated at a time
+    LONGS_EQUAL(1, arena.num_allocations());
+
+    for (uint32_t n = 0; n < NumElems; n++) {
+        CHECK(hashmap.find(n * 7));
+        LONGS_EQUAL(n, *hashmap.find(n * 7));
+        CHECK(!hashmap.find(n * 7 + 1));
+    }
+
+    for (uint32_t n = 0; n < NumElems; n += 2) {
+        CHECK(hashmap.remove(n * 7));
+    }
+
+    LONGS_EQUAL(NumElems / 2, hashmap.size());
+
+    for (uint32_t n = 0; n < NumElems; n++) {
+        CHECK(hashmap.contains(n * 7) == (n % 2 == 1));
+    }
+}
+
+TEST(flat_hashmap, reserve) {
+    FlatHashmap<uint32_t, int> hashmap(arena);
+
+    CHECK(hashmap.reserve(100));
+    CHECK(hashmap.capacity() >= 100);
+    LONGS_EQUAL(1, arena.num_allocations());
+
+    const size_t capacity = hashmap.capacity();
+
+    for (uint32_t n = 0; n < capacity; n++) {
+        CHECK(hashmap.insert(n, (int)n));
+    }
+
+    // no reallocation
+    LONGS_EQUAL(capacity, hashmap.capacity());
+
+    // smaller reserve is no-op
+    CHECK(hashmap.reserve(10));
+    LONGS_EQUAL(capacity, hashmap.capacity());
+}
+
+TEST(flat_hashmap, embedded_capacity) {
+    enum { Capacity = 10 };
+
+    FlatHashmap<uint32_t, int, Capacity> hashmap(arena);
+
+    CHECK(hashmap.capacity() >= Capacity);
+
+    for (uint32_t n = 0; n < Capacity; n++) {
+        CHECK(hashmap.insert(n, (int)n));
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+
+    while (hashmap.size() < hashmap.capacity()) {
+        CHECK(hashmap.insert((uint32_t)hashmap.size(), 0));
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+
+    CHECK(hashmap.insert((uint32_t)hashmap.size(), 0));
+
+    LONGS_EQUAL(1, arena.num_allocations());
+
+    for (uint32_t n = 0; n < Capacity; n++) {
+        LONGS_EQUAL(n, *hashmap.find(n));
+    }
+}
+
+TEST(flat_hashmap, allocation_failure) {
+    FlatHashmap<uint32_t, int> hashmap(NoopArena);
+
+    CHECK(!hashmap.insert(1, 10));
+    CHECK(!hashmap.reserve(1));
+
+    LONGS_EQUAL(0, hashmap.size());
+    CHECK(!hashmap.find(1));
+}
+
+TEST(flat_hashmap, allocation_failure_embedded) {
+    FlatHashmap<uint32_t, int, 5> hashmap(NoopArena);
+
+    const size_t capacity = hashmap.capacity();
+
+    for (uint32_t n = 0; n < capacity; n++) {
+        CHECK(hashmap.insert(n, (int)n));
+    }
+
+    CHECK(!hashmap.insert((uint32_t)capacity, 0));
+
+    LONGS_EQUAL(capacity, hashmap.size());
+
+    for (uint32_t n = 0; n < capacity; n++) {
+        LONGS_EQUAL(n, *hashmap.find(n));
+    }
+}
+
+TEST(flat_hashmap, collisions) {
+    enum { NumElems = 50 };
+
+    FlatHashmap<uint32_t, uint32_t, 0, CollidingTraits> hashmap(arena);
+
+    for (uint32_t n = 0; n < NumElems; n++) {
+        CHECK(hashmap.insert(n, n * 10));
+    }
+
+    // remove from the middle of clusters, remaining keys should stay reachable
+    for (uint32_t n = 0; n < NumElems; n += 3) {
+        CHECK(hashmap.remove(n));
+    }
+
+    for (uint32_t n = 0; n < NumElems; n++) {
+        if (n % 3 == 0) {
+            CHECK(!hashmap.find(n));
+        } else {
+            CHECK(hashmap.find(n));
+            LONGS_EQUAL(n * 10, *hashmap.find(n));
+        }
+    }
+
+    // reinsert removed keys
+    for (uint32_t n = 0; n < NumElems; n += 3) {
+        CHECK(hashmap.insert(n, n * 10));
+    }
+
+    for (uint32_t n = 0; n < NumElems; n++) {
+        LONGS_EQUAL(n * 10, *hashmap.find(n));
+    }
+}
+
+TEST(flat_hashmap, wrap_around) {
+    FlatHashmap<uint32_t, uint32_t, 8, WrappingTraits> hashmap(arena);
+
+    for (uint32_t n = 0; n < 6; n++) {
+        CHECK(hashmap.insert(n, n));
+    }
+
+    for (uint32_t n = 0; n < 6; n++) {
+        CHECK(hashmap.remove(n));
+
+        for (uint32_t k = n + 1; k < 6; k++) {
+            CHECK(hashmap.find(k));
+            LONGS_EQUAL(k, *hashmap.find(k));
+        }
+    }
+
+    CHECK(hashmap.is_empty());
+}
+
+TEST(flat_hashmap, value_lifetime) {
+    {
+        FlatHashmap<uint32_t, Value> hashmap(arena);
+
+        for (uint32_t n = 0; n < 100; n++) {
+            CHECK(hashmap.insert(n, Value((int)n)));
+        }
+
+        LONGS_EQUAL(100, num_values);
+
+        for (uint32_t n = 0; n < 50; n++) {
+            CHECK(hashmap.remove(n));
+        }
+
+        LONGS_EQUAL(50, num_values);
+
+        for (uint32_t n = 50; n < 100; n++) {
+            LONGS_EQUAL((int)n, hashmap.find(n)->n);
+        }
+
+        hashmap.clear();
+
+        LONGS_EQUAL(0, num_values);
+        CHECK(hashmap.is_empty());
+
+        CHECK(hashmap.insert(1, Value(1)));
+        LONGS_EQUAL(1, num_values);
+    }
+
+    LONGS_EQUAL(0, num_values);
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/huge_page_arena.h"
+#include "roc_core/slab_pool.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+struct TestObject {
+    char data[256];
+};
+
+} // namespace
+
+TEST_GROUP(huge_page_arena) {};
+
+TEST(huge_page_arena, allocate_deallocate) {
+    HugePageArena arena;
+
+    CHECK(arena.page_size() > 0);
+    CHECK(arena.page_capacity() < arena.page_size());
+
+    void* pointer0 = arena.allocate(128);
+    CHECK(pointer0);
+    memset(pointer0, 0xff, 128);
+
+    void* pointer1 = arena.allocate(arena.page_size());
+    CHECK(pointer1);
+    memset(pointer1, 0xff, arena.page_size());
+
+    LONGS_EQUAL(2, arena.num_allocations());
+
+    arena.deallocate(pointer0);
+    arena.deallocate(pointer1);
+
+    LONGS_EQUAL(0, arena.num_allocations());
+    LONGS_EQUAL(0, arena.num_hugetlb_allocations());
+}
+
+TEST(huge_page_arena, page_alignment) {
+    HugePageArena arena;
+
+    void* pointer = arena.allocate(128);
+    CHECK(pointer);
+
+    // chunk starts at page boundary, data follows header
+    const size_t offset = (size_t)pointer % arena.page_size();
+    CHECK(offset > 0);
+    CHECK(offset == arena.page_size() - arena.page_capacity());
+    CHECK((size_t)pointer % sizeof(AlignMax) == 0);
+
+    arena.deallocate(pointer);
+}
+
+TEST(huge_page_arena, allocated_size) {
+    HugePageArena arena;
+
+    LONGS_EQUAL(arena.page_size(), arena.compute_allocated_size(1));
+    LONGS_EQUAL(arena.page_size(), arena.compute_allocated_size(arena.page_capacity()));
+    LONGS_EQUAL(arena.page_size() * 2,
+                arena.compute_allocated_size(arena.page_capacity() + 1));
+
+    void* pointer = arena.allocate(arena.page_capacity());
+    CHECK(pointer);
+
+    LONGS_EQUAL(arena.page_size(), arena.allocated_size(pointer));
+
+    arena.deallocate(pointer);
+}
+
+TEST(huge_page_arena, slab_pool) {
+    enum { NumObjects = 1000 };
+
+    HugePageArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena, sizeof(TestObject),
+                                  arena.page_capacity() / 2, arena.page_capacity());
+
+        void* objects[NumObjects] = {};
+
+        for (size_t n = 0; n < NumObjects; n++) {
+            objects[n] = pool.allocate();
+            CHECK(objects[n]);
+            memset(objects[n], 0xff, sizeof(TestObject));
+        }
+
+        // every slab fits single page
+        CHECK(arena.num_allocations() > 0);
+        CHECK(arena.num_allocations()
+              <= NumObjects * sizeof(TestObject) / (arena.page_capacity() / 2) + 1);
+
+        for (size_t n = 0; n < NumObjects; n++) {
+            pool.deallocate(objects[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+} // namespace core
+} // namespace roc
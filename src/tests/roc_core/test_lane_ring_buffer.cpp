@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/lane_ring_buffer.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+HeapArena arena;
+
+} // namespace
+
+TEST_GROUP(lane_ring_buffer) {};
+
+TEST(lane_ring_buffer, key_selects_lane) {
+    enum { NumLanes = 4, LaneSize = 10 };
+
+    LaneRingBuffer<int> lb(arena, NumLanes, LaneSize);
+    CHECK(lb.is_valid());
+    UNSIGNED_LONGS_EQUAL(NumLanes, lb.num_lanes());
+
+    for (int n = 0; n < NumLanes * 2; n++) {
+        CHECK(lb.push(n, (uint64_t)n));
+    }
+
+    for (size_t lane = 0; lane < NumLanes; lane++) {
+        int value = -1;
+
+        CHECK(lb.pop(lane, value));
+        LONGS_EQUAL(lane, value);
+
+        CHECK(lb.pop(lane, value));
+        LONGS_EQUAL(lane + NumLanes, value);
+
+        CHECK(!lb.pop(lane, value));
+    }
+}
+
+TEST(lane_ring_buffer, order_within_lane) {
+    enum { NumLanes = 3, LaneSize = 10, Key = 5 };
+
+    LaneRingBuffer<int> lb(arena, NumLanes, LaneSize);
+    CHECK(lb.is_valid());
+
+    for (int n = 0; n < LaneSize; n++) {
+        CHECK(lb.push(n, Key));
+    }
+
+    const size_t lane = Key % NumLanes;
+
+    for (int n = 0; n < LaneSize; n++) {
+        int value = -1;
+        CHECK(lb.pop(lane, value));
+        LONGS_EQUAL(n, value);
+    }
+
+    int value = -1;
+    CHECK(!lb.pop(lane, value));
+}
+
+TEST(lane_ring_buffer, full_lane) {
+    enum { NumLanes = 2, LaneSize = 5 };
+
+    LaneRingBuffer<int> lb(arena, NumLanes, LaneSize);
+    CHECK(lb.is_valid());
+
+    for (int n = 0; n < LaneSize; n++) {
+        CHECK(lb.push(n, 0));
+    }
+
+    // selected lane is full, other lanes are not used
+    CHECK(!lb.push(100, 0));
+
+    int value = -1;
+    CHECK(!lb.pop(1, value));
+
+    // other key still works
+    CHECK(lb.push(200, 1));
+    CHECK(lb.pop(1, value));
+    LONGS_EQUAL(200, value);
+}
+
+} // namespace core
+} // namespace roc
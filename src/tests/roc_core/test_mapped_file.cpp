@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/mapped_file.h"
+#include "roc_core/temp_file.h"
+
+namespace roc {
+namespace core {
+
+TEST_GROUP(mapped_file) {};
+
+TEST(mapped_file, write_read) {
+    enum { Size1 = 100, Size2 = 100000, Size3 = 5000 };
+
+    TempFile file("test.bin");
+
+    {
+        MappedFile mapped_file;
+        CHECK(mapped_file.open_write(file.path()));
+        CHECK(mapped_file.is_open());
+
+        // initially empty
+        CHECK(!mapped_file.data());
+        UNSIGNED_LONGS_EQUAL(0, mapped_file.size());
+
+        CHECK(mapped_file.resize(Size1));
+        CHECK(mapped_file.data());
+        UNSIGNED_LONGS_EQUAL(Size1, mapped_file.size());
+
+        for (size_t n = 0; n < Size1; n++) {
+            mapped_file.data()[n] = uint8_t(n);
+        }
+
+        // data is preserved when growing
+        CHECK(mapped_file.resize(Size2));
+        UNSIGNED_LONGS_EQUAL(Size2, mapped_file.size());
+
+        for (size_t n = Size1; n < Size2; n++) {
+            mapped_file.data()[n] = uint8_t(n);
+        }
+
+        // and when shrinking
+        CHECK(mapped_file.resize(Size3));
+        UNSIGNED_LONGS_EQUAL(Size3, mapped_file.size());
+
+        mapped_file.close();
+        CHECK(!mapped_file.is_open());
+    }
+
+    {
+        MappedFile mapped_file;
+        CHECK(mapped_file.open_read(file.path()));
+        UNSIGNED_LONGS_EQUAL(Size3, mapped_file.size());
+
+        for (size_t n = 0; n < Size3; n++) {
+            UNSIGNED_LONGS_EQUAL(uint8_t(n), mapped_file.data()[n]);
+        }
+    }
+}
+
+TEST(mapped_file, read_empty) {
+    TempFile file("test.bin");
+
+    {
+        MappedFile mapped_file;
+        CHECK(mapped_file.open_write(file.path()));
+    }
+
+    MappedFile mapped_file;
+    CHECK(mapped_file.open_read(file.path()));
+    CHECK(!mapped_file.data());
+    UNSIGNED_LONGS_EQUAL(0, mapped_file.size());
+}
+
+TEST(mapped_file, read_missing) {
+    MappedFile mapped_file;
+    CHECK(!mapped_file.open_read("/nonexistent/test.bin"));
+    CHECK(!mapped_file.is_open());
+}
+
+} // namespace core
+} // namespace roc
@@ -480,6 +480,164 @@ TEST(slab_pool, embedded_capacity_reuse) {
     LONGS_EQUAL(0, arena.num_allocations());
 }
 
+TEST(slab_pool, preallocate) {
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+
+        CHECK(pool.preallocate(10, 0));
+
+        LONGS_EQUAL(1, arena.num_allocations());
+        CHECK(pool.capacity() >= 10);
+
+        void* pointers[20] = {};
+
+        for (int n = 0; n < 10; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+
+        LONGS_EQUAL(1, arena.num_allocations());
+
+        // pool is not fixed and can grow
+        for (int n = 10; n < 20; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+
+        CHECK(arena.num_allocations() > 1);
+
+        for (int n = 0; n < 20; n++) {
+            pool.deallocate(pointers[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, preallocate_fixed_capacity) {
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+
+        CHECK(pool.preallocate(10, SlabPool_FixedCapacity));
+
+        const size_t capacity = pool.capacity();
+        CHECK(capacity >= 10);
+
+        void* pointers[20] = {};
+
+        for (size_t n = 0; n < capacity; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+
+        // pool can't grow
+        CHECK(!pool.allocate());
+        CHECK(!pool.reserve(capacity + 1));
+
+        LONGS_EQUAL(1, arena.num_allocations());
+        UNSIGNED_LONGS_EQUAL(capacity, pool.capacity());
+
+        // released slot can be reused
+        pool.deallocate(pointers[0]);
+        pointers[0] = pool.allocate();
+        CHECK(pointers[0]);
+
+        for (size_t n = 0; n < capacity; n++) {
+            pool.deallocate(pointers[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, preallocate_after_use) {
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+
+        void* memory = pool.allocate();
+        CHECK(memory);
+        memset(memory, 0x11, sizeof(TestObject));
+
+        CHECK(pool.preallocate(10, 0));
+        CHECK(pool.capacity() >= 10);
+
+        // used slot is not touched
+        for (size_t n = 0; n < sizeof(TestObject); n++) {
+            LONGS_EQUAL(0x11, ((unsigned char*)memory)[n]);
+        }
+
+        pool.deallocate(memory);
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, preallocate_lock_memory) {
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+
+        // locking may be not permitted in test environment
+        if (!pool.preallocate(4, SlabPool_LockMemory | SlabPool_FixedCapacity)) {
+            return;
+        }
+
+        CHECK(pool.capacity() >= 4);
+
+        // locked slabs are mapped from OS, not from arena
+        LONGS_EQUAL(0, arena.num_allocations());
+
+        void* memory = pool.allocate();
+        CHECK(memory);
+        pool.deallocate(memory);
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, usage) {
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+
+        UNSIGNED_LONGS_EQUAL(0, pool.num_used());
+        UNSIGNED_LONGS_EQUAL(0, pool.max_used());
+
+        void* pointers[5] = {};
+
+        for (int n = 0; n < 5; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+
+        UNSIGNED_LONGS_EQUAL(5, pool.num_used());
+        UNSIGNED_LONGS_EQUAL(5, pool.max_used());
+        CHECK(pool.capacity() >= 5);
+
+        for (int n = 0; n < 3; n++) {
+            pool.deallocate(pointers[n]);
+        }
+
+        // high-water mark is kept
+        UNSIGNED_LONGS_EQUAL(2, pool.num_used());
+        UNSIGNED_LONGS_EQUAL(5, pool.max_used());
+
+        for (int n = 3; n < 5; n++) {
+            pool.deallocate(pointers[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
 TEST(slab_pool, guard_object) {
     TestArena arena;
     SlabPool<TestObject, 1> pool("test", arena);
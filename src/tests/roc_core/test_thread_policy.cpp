@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/atomic.h"
+#include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+class TestThread : public Thread {
+public:
+    TestThread()
+        : ran_(0) {
+    }
+
+    bool ran() const {
+        return ran_;
+    }
+
+private:
+    virtual void run() {
+        ran_ = 1;
+    }
+
+    Atomic<int> ran_;
+};
+
+} // namespace
+
+TEST_GROUP(thread_policy) {};
+
+TEST(thread_policy, parse_empty) {
+    ThreadPolicy policy;
+
+    CHECK(parse_thread_policy("", policy));
+    CHECK(policy.is_default());
+}
+
+TEST(thread_policy, parse_all) {
+    ThreadPolicy policy;
+
+    CHECK(parse_thread_policy("sched=fifo,prio=50,nice=-5,cpus=1", policy));
+
+    LONGS_EQUAL(ThreadSched_Fifo, policy.scheduler);
+    LONGS_EQUAL(50, policy.priority);
+    LONGS_EQUAL(-5, policy.nice);
+    CHECK(policy.cpu_mask == 0x2);
+    CHECK(!policy.is_default());
+
+    CHECK(parse_thread_policy("sched=rr", policy));
+    LONGS_EQUAL(ThreadSched_RoundRobin, policy.scheduler);
+    // other fields are kept
+    LONGS_EQUAL(50, policy.priority);
+
+    CHECK(parse_thread_policy("sched=default,prio=0", policy));
+    LONGS_EQUAL(ThreadSched_Default, policy.scheduler);
+    LONGS_EQUAL(0, policy.priority);
+}
+
+TEST(thread_policy, parse_cpus) {
+    ThreadPolicy policy;
+
+    CHECK(parse_thread_policy("cpus=0-3+6", policy));
+    CHECK(policy.cpu_mask == 0x4f);
+
+    CHECK(parse_thread_policy("cpus=5+1", policy));
+    CHECK(policy.cpu_mask == 0x22);
+
+    CHECK(parse_thread_policy("cpus=63", policy));
+    CHECK(policy.cpu_mask == ((uint64_t)1 << 63));
+}
+
+TEST(thread_policy, parse_error) {
+    ThreadPolicy policy;
+    policy.nice = 3;
+
+    CHECK(!parse_thread_policy(NULL, policy));
+    CHECK(!parse_thread_policy("fifo", policy));
+    CHECK(!parse_thread_policy("sched=", policy));
+    CHECK(!parse_thread_policy("sched=idle", policy));
+    CHECK(!parse_thread_policy("prio=abc", policy));
+    CHECK(!parse_thread_policy("prio=100", policy));
+    CHECK(!parse_thread_policy("nice=-21", policy));
+    CHECK(!parse_thread_policy("nice=20", policy));
+    CHECK(!parse_thread_policy("cpus=", policy));
+    CHECK(!parse_thread_policy("cpus=64", policy));
+    CHECK(!parse_thread_policy("cpus=3-1", policy));
+    CHECK(!parse_thread_policy("cpus=1+", policy));
+    CHECK(!parse_thread_policy("foo=1", policy));
+    CHECK(!parse_thread_policy("nice=1,foo=1", policy));
+
+    // priority without real-time scheduler
+    CHECK(!parse_thread_policy("prio=10", policy));
+    CHECK(!parse_thread_policy("sched=default,prio=10", policy));
+
+    // policy is not modified on error
+    LONGS_EQUAL(3, policy.nice);
+}
+
+TEST(thread_policy, apply_default) {
+    ThreadPolicy policy;
+
+    CHECK(Thread::apply_policy(policy));
+}
+
+TEST(thread_policy, apply_priority_without_scheduler) {
+    ThreadPolicy policy;
+    policy.priority = 10;
+
+    CHECK(!policy.is_default());
+    CHECK(!Thread::apply_policy(policy));
+}
+
+TEST(thread_policy, start_with_policy) {
+    // Policy that can't be applied doesn't prevent thread from running.
+    ThreadPolicy policy;
+    policy.scheduler = ThreadSched_Fifo;
+    policy.priority = 1;
+
+    TestThread thread;
+    thread.set_policy(policy);
+
+    CHECK(thread.start());
+    thread.join();
+
+    CHECK(thread.ran());
+}
+
+} // namespace core
+} // namespace roc
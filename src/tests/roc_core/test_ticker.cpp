@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/fast_clock.h"
+#include "roc_core/ticker.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// Ticker measures time using fast_timestamp(), so tests use it too.
+
+// One tick is one microsecond.
+const Ticker::ticks_t Freq = Second / Microsecond;
+
+enum { NumWaits = 20 };
+
+} // namespace
+
+TEST_GROUP(ticker) {};
+
+TEST(ticker, wait) {
+    Ticker ticker(Freq);
+
+    const nanoseconds_t start = fast_timestamp();
+
+    ticker.start();
+
+    for (size_t n = 1; n <= NumWaits; n++) {
+        ticker.wait(n * 500);
+
+        CHECK(fast_timestamp() - start >= nanoseconds_t(n) * 500 * Microsecond);
+    }
+
+    CHECK(ticker.elapsed() >= NumWaits * 500);
+    LONGS_EQUAL(0, ticker.spin_margin());
+}
+
+TEST(ticker, wait_spinning) {
+    TickerConfig config;
+    config.enable_spinning = true;
+
+    Ticker ticker(Freq, config);
+
+    const nanoseconds_t start = fast_timestamp();
+
+    ticker.start();
+
+    for (size_t n = 1; n <= NumWaits; n++) {
+        ticker.wait(n * 500);
+
+        CHECK(fast_timestamp() - start >= nanoseconds_t(n) * 500 * Microsecond);
+
+        CHECK(ticker.spin_margin() >= config.min_spin_margin);
+        CHECK(ticker.spin_margin() <= config.max_spin_margin);
+    }
+
+    CHECK(ticker.elapsed() >= NumWaits * 500);
+}
+
+TEST(ticker, spin_margin_limits) {
+    { // initial margin is clamped to limits
+        TickerConfig config;
+        config.enable_spinning = true;
+        config.spin_margin = Second;
+        config.min_spin_margin = 10 * Microsecond;
+        config.max_spin_margin = 50 * Microsecond;
+
+        Ticker ticker(Freq, config);
+        LONGS_EQUAL(50 * Microsecond, ticker.spin_margin());
+    }
+    { // margin stays within limits while waiting
+        TickerConfig config;
+        config.enable_spinning = true;
+        config.spin_margin = 0;
+        config.min_spin_margin = 10 * Microsecond;
+        config.max_spin_margin = 50 * Microsecond;
+
+        Ticker ticker(Freq, config);
+        LONGS_EQUAL(10 * Microsecond, ticker.spin_margin());
+
+        for (size_t n = 1; n <= NumWaits; n++) {
+            ticker.wait(n * 200);
+
+            CHECK(ticker.spin_margin() >= config.min_spin_margin);
+            CHECK(ticker.spin_margin() <= config.max_spin_margin);
+        }
+    }
+}
+
+TEST(ticker, wait_past_deadline) {
+    TickerConfig config;
+    config.enable_spinning = true;
+
+    Ticker ticker(Freq, config);
+
+    ticker.start();
+    sleep_for(ClockMonotonic, Millisecond);
+
+    const nanoseconds_t margin = ticker.spin_margin();
+
+    // Deadline already passed, should return immediately
+    // and shouldn't update margin.
+    ticker.wait(100);
+
+    LONGS_EQUAL(margin, ticker.spin_margin());
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/fast_clock.h"
+#include "roc_core/temp_file.h"
+#include "roc_core/thread.h"
+#include "roc_core/trace_dumper.h"
+#include "roc_core/tracer.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { MaxEvents = 100 };
+
+void drain(Tracer& tracer) {
+    TraceEvent events[MaxEvents];
+    while (tracer.read(events, MaxEvents) != 0) {
+    }
+}
+
+size_t read_file(const char* path, char* buf, size_t bufsz) {
+    FILE* fp = fopen(path, "r");
+    CHECK(fp);
+    const size_t len = fread(buf, 1, bufsz - 1, fp);
+    buf[len] = '\0';
+    fclose(fp);
+    return len;
+}
+
+} // namespace
+
+TEST_GROUP(tracer) {
+    void setup() {
+        CHECK(Tracer::instance().enable());
+        drain(Tracer::instance());
+    }
+
+    void teardown() {
+        Tracer::instance().disable();
+        drain(Tracer::instance());
+    }
+};
+
+TEST(tracer, add_read) {
+    Tracer& tracer = Tracer::instance();
+
+    const nanoseconds_t start = timestamp(ClockMonotonic);
+
+    tracer.add_instant("instant1");
+    tracer.add_complete("complete", fast_timestamp());
+    tracer.add_instant("instant2");
+
+    TraceEvent events[MaxEvents];
+    UNSIGNED_LONGS_EQUAL(3, tracer.read(events, MaxEvents));
+    UNSIGNED_LONGS_EQUAL(0, tracer.read(events, MaxEvents));
+
+    // events of one thread are read in order
+    STRCMP_EQUAL("instant1", events[0].name);
+    STRCMP_EQUAL("complete", events[1].name);
+    STRCMP_EQUAL("instant2", events[2].name);
+
+    LONGS_EQUAL(TracePhase_Instant, events[0].phase);
+    LONGS_EQUAL(TracePhase_Complete, events[1].phase);
+    LONGS_EQUAL(TracePhase_Instant, events[2].phase);
+
+    for (size_t n = 0; n < 3; n++) {
+        CHECK(events[n].tid == Thread::get_tid());
+        CHECK(events[n].time >= start);
+        CHECK(events[n].duration >= 0);
+        if (n > 0) {
+            CHECK(events[n].time >= events[n - 1].time);
+        }
+    }
+}
+
+TEST(tracer, partial_read) {
+    Tracer& tracer = Tracer::instance();
+
+    for (int n = 0; n < 10; n++) {
+        tracer.add_instant("instant");
+    }
+
+    TraceEvent events[MaxEvents];
+    UNSIGNED_LONGS_EQUAL(4, tracer.read(events, 4));
+    UNSIGNED_LONGS_EQUAL(6, tracer.read(events, MaxEvents));
+}
+
+TEST(tracer, scope) {
+    Tracer& tracer = Tracer::instance();
+
+    const nanoseconds_t start = fast_timestamp();
+
+    {
+        TraceScope outer_scope("outer");
+        { TraceScope inner_scope("inner"); }
+    }
+
+    const nanoseconds_t end = fast_timestamp();
+
+    TraceEvent events[MaxEvents];
+    UNSIGNED_LONGS_EQUAL(2, tracer.read(events, MaxEvents));
+
+    // events are added when scopes end
+    STRCMP_EQUAL("inner", events[0].name);
+    STRCMP_EQUAL("outer", events[1].name);
+
+    LONGS_EQUAL(TracePhase_Complete, events[0].phase);
+    LONGS_EQUAL(TracePhase_Complete, events[1].phase);
+
+    // inner scope is within outer scope
+    CHECK(events[1].time >= start);
+    CHECK(events[0].time >= events[1].time);
+    CHECK(events[0].time + events[0].duration <= events[1].time + events[1].duration);
+    CHECK(events[1].time + events[1].duration <= end);
+}
+
+TEST(tracer, disabled) {
+    Tracer& tracer = Tracer::instance();
+
+    tracer.disable();
+    CHECK(!tracer.is_enabled());
+
+    { TraceScope scope("scope"); }
+
+    TraceEvent events[MaxEvents];
+    UNSIGNED_LONGS_EQUAL(0, tracer.read(events, MaxEvents));
+
+    // event is recorded if tracing was disabled inside scope
+    CHECK(tracer.enable());
+    {
+        TraceScope scope("scope");
+        tracer.disable();
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, tracer.read(events, MaxEvents));
+}
+
+TEST(tracer, overflow) {
+    Tracer& tracer = Tracer::instance();
+
+    const uint64_t dropped = tracer.num_dropped();
+
+    // more than all lanes can hold
+    const size_t n_events = TraceConfig().num_lanes * TraceConfig().lane_size + 10;
+
+    for (size_t n = 0; n < n_events; n++) {
+        tracer.add_instant("instant");
+    }
+
+    CHECK(tracer.num_dropped() > dropped);
+}
+
+TEST(tracer, dumper) {
+    TempFile file("trace.json");
+
+    {
+        TraceDumperConfig config;
+        config.flush_interval = Millisecond;
+
+        TraceDumper dumper(file.path(), config, Tracer::instance());
+        CHECK(dumper.is_valid());
+        CHECK(dumper.start());
+
+        Tracer::instance().add_instant("test_instant");
+        Tracer::instance().add_complete("test_scope", fast_timestamp() - Microsecond * 5);
+
+        dumper.stop();
+        dumper.join();
+    }
+
+    char buf[4096];
+    read_file(file.path(), buf, sizeof(buf));
+
+    CHECK(strncmp(buf, "{\"traceEvents\":[", 16) == 0);
+    CHECK(strstr(buf, "\"name\":\"test_instant\",\"ph\":\"i\""));
+    CHECK(strstr(buf, "\"name\":\"test_scope\",\"ph\":\"X\""));
+    CHECK(strstr(buf, "\"dur\":"));
+    CHECK(strstr(buf, "\n]}\n"));
+}
+
+TEST(tracer, dumper_empty) {
+    TempFile file("trace.json");
+
+    {
+        TraceDumper dumper(file.path(), TraceDumperConfig(), Tracer::instance());
+        CHECK(dumper.is_valid());
+        CHECK(dumper.start());
+
+        dumper.stop();
+        dumper.join();
+    }
+
+    char buf[4096];
+    read_file(file.path(), buf, sizeof(buf));
+
+    STRCMP_EQUAL("{\"traceEvents\":[\n]}\n", buf);
+}
+
+} // namespace core
+} // namespace roc
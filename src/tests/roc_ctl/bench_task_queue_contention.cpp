@@ -19,12 +19,19 @@ namespace {
 enum {
     NumScheduleIterations = 2000000,
     NumScheduleAfterIterations = 20000,
+    NumRescheduleIterations = 200000,
+    NumDelayedTasks = 5000,
     NumThreads = 8,
     BatchSize = 1000
 };
 
 const core::nanoseconds_t MaxDelay = 100 * core::Millisecond;
 
+// Random delay from 1 to 10 seconds.
+core::nanoseconds_t random_long_delay() {
+    return core::Millisecond * core::nanoseconds_t(core::fast_random_range(1000, 10000));
+}
+
 class NoopExecutor : public ControlTaskExecutor<NoopExecutor> {
 public:
     class Task : public ControlTask {
@@ -105,6 +112,42 @@ BENCHMARK_REGISTER_F(BM_QueueContention, ScheduleAt)
     ->Iterations(NumScheduleAfterIterations)
     ->Unit(benchmark::kMicrosecond);
 
+// Every thread keeps NumDelayedTasks sleeping tasks in queue and re-schedules
+// random ones with new deadlines, like periodic tasks of many endpoints do.
+BENCHMARK_DEFINE_F(BM_QueueContention, RescheduleAt)(benchmark::State& state) {
+    NoopExecutor::Task* tasks = new NoopExecutor::Task[NumDelayedTasks];
+
+    const core::nanoseconds_t start = core::timestamp(core::ClockMonotonic);
+
+    for (int n = 0; n < NumDelayedTasks; n++) {
+        queue.schedule_at(tasks[n], start + random_long_delay(), executor, &completer);
+    }
+
+    while (state.KeepRunningBatch(BatchSize)) {
+        for (int n = 0; n < BatchSize; n++) {
+            const size_t n_task = core::fast_random_range(0, NumDelayedTasks - 1);
+
+            queue.schedule_at(tasks[n_task], start + random_long_delay(), executor,
+                              &completer);
+        }
+    }
+
+    for (int n = 0; n < NumDelayedTasks; n++) {
+        queue.async_cancel(tasks[n]);
+    }
+
+    for (int n = 0; n < NumDelayedTasks; n++) {
+        queue.wait(tasks[n]);
+    }
+
+    delete[] tasks;
+}
+
+BENCHMARK_REGISTER_F(BM_QueueContention, RescheduleAt)
+    ->ThreadRange(1, NumThreads)
+    ->Iterations(NumRescheduleIterations)
+    ->Unit(benchmark::kMicrosecond);
+
 } // namespace
 } // namespace ctl
 } // namespace roc
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/macro_helpers.h"
+#include "roc_core/time.h"
+#include "roc_ctl/control_task.h"
+#include "roc_ctl/control_task_executor.h"
+#include "roc_ctl/control_task_wheel.h"
+
+namespace roc {
+namespace ctl {
+
+// Declared as friend by ControlTask.
+struct ControlTaskWheelTestAccess {
+    static void set_deadline(ControlTask& task, core::nanoseconds_t deadline) {
+        task.effective_deadline_ = deadline;
+    }
+};
+
+namespace {
+
+// Wheel geometry, see ControlTaskWheel.
+// Tick is 1ms, every level has 64 slots.
+const core::nanoseconds_t Tick = core::Millisecond;
+
+const core::nanoseconds_t Level1Span = Tick * 64;
+const core::nanoseconds_t Level2Span = Level1Span * 64;
+const core::nanoseconds_t Level3Span = Level2Span * 64;
+const core::nanoseconds_t WheelSpan = Level3Span * 64;
+
+class TestExecutor : public ControlTaskExecutor<TestExecutor> {
+public:
+    class Task : public ControlTask {
+    public:
+        Task()
+            : ControlTask(&TestExecutor::do_task_) {
+        }
+    };
+
+private:
+    ControlTaskResult do_task_(ControlTask&) {
+        return ControlTaskSuccess;
+    }
+};
+
+void insert(ControlTaskWheel& wheel, ControlTask& task, core::nanoseconds_t deadline) {
+    ControlTaskWheelTestAccess::set_deadline(task, deadline);
+    wheel.insert(task);
+}
+
+// Check that wheel asks to be checked exactly at given times, that nothing
+// expires before them, and that task expires exactly at its deadline.
+void check_cascade(ControlTaskWheel& wheel,
+                   ControlTask& task,
+                   const core::nanoseconds_t* wakeups,
+                   size_t n_wakeups,
+                   core::nanoseconds_t deadline) {
+    for (size_t n = 0; n < n_wakeups; n++) {
+        LONGS_EQUAL(wakeups[n], wheel.next_deadline());
+
+        POINTERS_EQUAL(NULL, wheel.pop_expired(wakeups[n] - 1));
+        POINTERS_EQUAL(NULL, wheel.pop_expired(wakeups[n]));
+
+        CHECK(wheel.contains(task));
+    }
+
+    LONGS_EQUAL(deadline, wheel.next_deadline());
+
+    POINTERS_EQUAL(NULL, wheel.pop_expired(deadline - 1));
+    POINTERS_EQUAL(&task, wheel.pop_expired(deadline));
+
+    CHECK(!wheel.contains(task));
+    UNSIGNED_LONGS_EQUAL(0, wheel.size());
+    LONGS_EQUAL(-1, wheel.next_deadline());
+}
+
+} // namespace
+
+TEST_GROUP(control_task_wheel) {};
+
+TEST(control_task_wheel, level0) {
+    ControlTaskWheel wheel(0);
+
+    TestExecutor::Task task;
+    const core::nanoseconds_t deadline = Tick * 10 + Tick / 2;
+
+    insert(wheel, task, deadline);
+    UNSIGNED_LONGS_EQUAL(1, wheel.size());
+
+    check_cascade(wheel, task, NULL, 0, deadline);
+}
+
+TEST(control_task_wheel, level1) {
+    ControlTaskWheel wheel(0);
+
+    TestExecutor::Task task;
+    // tick 100: level 1, slot 1
+    const core::nanoseconds_t deadline = Tick * 100 + Tick / 2;
+
+    insert(wheel, task, deadline);
+
+    const core::nanoseconds_t wakeups[] = {
+        Level1Span, // level 1 -> level 0
+    };
+
+    check_cascade(wheel, task, wakeups, ROC_ARRAY_SIZE(wakeups), deadline);
+}
+
+TEST(control_task_wheel, level2) {
+    ControlTaskWheel wheel(0);
+
+    TestExecutor::Task task;
+    // tick 5000: level 2, slot 1; then level 1, slot 14
+    const core::nanoseconds_t deadline = Tick * 5000 + Tick / 2;
+
+    insert(wheel, task, deadline);
+
+    const core::nanoseconds_t wakeups[] = {
+        Level2Span,                   // level 2 -> level 1
+        Level2Span + Level1Span * 14, // level 1 -> level 0
+    };
+
+    check_cascade(wheel, task, wakeups, ROC_ARRAY_SIZE(wakeups), deadline);
+}
+
+TEST(control_task_wheel, level3) {
+    ControlTaskWheel wheel(0);
+
+    TestExecutor::Task task;
+    // tick 300000: level 3, slot 1; then level 2, slot 9; then level 1, slot 15
+    const core::nanoseconds_t deadline = Tick * 300000 + Tick / 4;
+
+    insert(wheel, task, deadline);
+
+    const core::nanoseconds_t wakeups[] = {
+        Level3Span,                                    // level 3 -> level 2
+        Level3Span + Level2Span * 9,                   // level 2 -> level 1
+        Level3Span + Level2Span * 9 + Level1Span * 15, // level 1 -> level 0
+    };
+
+    check_cascade(wheel, task, wakeups, ROC_ARRAY_SIZE(wakeups), deadline);
+}
+
+TEST(control_task_wheel, overflow) {
+    ControlTaskWheel wheel(0);
+
+    TestExecutor::Task task;
+    // tick 18000000: beyond the whole wheel; after it turns around,
+    // level 3, slot 4; then level 2, slot 42; then level 1, slot 34
+    const core::nanoseconds_t deadline = Tick * 18000000 + Tick / 2;
+
+    CHECK(deadline > WheelSpan);
+
+    insert(wheel, task, deadline);
+
+    const core::nanoseconds_t wakeups[] = {
+        // overflow -> level 3
+        WheelSpan,
+        // level 3 -> level 2
+        WheelSpan + Level3Span * 4,
+        // level 2 -> level 1
+        WheelSpan + Level3Span * 4 + Level2Span * 42,
+        // level 1 -> level 0
+        WheelSpan + Level3Span * 4 + Level2Span * 42 + Level1Span * 34,
+    };
+
+    check_cascade(wheel, task, wakeups, ROC_ARRAY_SIZE(wakeups), deadline);
+}
+
+TEST(control_task_wheel, all_levels_in_order) {
+    enum { NumTasks = 6 };
+
+    ControlTaskWheel wheel(0);
+
+    TestExecutor::Task tasks[NumTasks];
+
+    // level 0, 1, 2, 3, and overflow, inserted in reverse order;
+    // two tasks share one slot of level 3
+    const core::nanoseconds_t deadlines[NumTasks] = {
+        Tick * 3,          Tick * 700,        Tick * 9000,
+        Tick * 300000 + 1, Tick * 300000 + 2, Tick * 18000000,
+    };
+
+    for (size_t n = NumTasks; n > 0; n--) {
+        insert(wheel, tasks[n - 1], deadlines[n - 1]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumTasks, wheel.size());
+
+    // nothing expired right before first deadline
+    POINTERS_EQUAL(NULL, wheel.pop_expired(deadlines[0] - 1));
+
+    // single large jump expires everything, in order of deadlines
+    for (size_t n = 0; n < NumTasks; n++) {
+        POINTERS_EQUAL(&tasks[n], wheel.pop_expired(deadlines[NumTasks - 1]));
+    }
+
+    POINTERS_EQUAL(NULL, wheel.pop_expired(deadlines[NumTasks - 1]));
+    UNSIGNED_LONGS_EQUAL(0, wheel.size());
+}
+
+TEST(control_task_wheel, non_zero_start) {
+    // start in the middle of level 3 revolution
+    const core::nanoseconds_t start = Level3Span * 3 + Level2Span * 5 + Tick * 7;
+
+    ControlTaskWheel wheel(start);
+
+    TestExecutor::Task task;
+    // crosses boundary of level 3 slot
+    const core::nanoseconds_t deadline = Level3Span * 4 + Level2Span * 2 + Tick / 2;
+
+    insert(wheel, task, deadline);
+
+    const core::nanoseconds_t wakeups[] = {
+        Level3Span * 4,                  // level 3 -> level 2
+        Level3Span * 4 + Level2Span * 2, // level 2 -> level 0
+    };
+
+    check_cascade(wheel, task, wakeups, ROC_ARRAY_SIZE(wakeups), deadline);
+}
+
+TEST(control_task_wheel, remove_cascaded) {
+    ControlTaskWheel wheel(0);
+
+    TestExecutor::Task task1, task2;
+
+    insert(wheel, task1, Tick * 5000);
+    insert(wheel, task2, Tick * 5001);
+
+    // cascade both tasks from level 2 to level 1
+    POINTERS_EQUAL(NULL, wheel.pop_expired(Level2Span));
+
+    wheel.remove(task1);
+    CHECK(!wheel.contains(task1));
+    UNSIGNED_LONGS_EQUAL(1, wheel.size());
+
+    POINTERS_EQUAL(NULL, wheel.pop_expired(Tick * 5001 - 1));
+    POINTERS_EQUAL(&task2, wheel.pop_expired(Tick * 5001));
+
+    UNSIGNED_LONGS_EQUAL(0, wheel.size());
+    LONGS_EQUAL(-1, wheel.next_deadline());
+}
+
+} // namespace ctl
+} // namespace roc
@@ -1399,5 +1399,94 @@ TEST(task_queue, no_starvation) {
     executor.check_all_unblocked();
 }
 
+TEST(task_queue, schedule_at_spread) {
+    enum { NumTasks = 30, Stride = 37 };
+
+    TestExecutor executor;
+
+    ControlTaskQueue queue;
+    CHECK(queue.is_valid());
+
+    TestExecutor::Task tasks[NumTasks];
+    TestCompleter completers[NumTasks];
+
+    // Task that should be executed n-th.
+    size_t order[NumTasks];
+
+    executor.block();
+
+    const core::nanoseconds_t now = core::timestamp(core::ClockMonotonic);
+
+    // Deadlines are shuffled and span multiple levels of timing wheel.
+    for (size_t n = 0; n < NumTasks; n++) {
+        const size_t pos = (n * Stride) % NumTasks;
+        const core::nanoseconds_t delay =
+            core::Millisecond + core::Millisecond * 5 * core::nanoseconds_t(pos);
+
+        order[pos] = n;
+
+        completers[n].expect_success(true);
+        completers[n].expect_cancelled(false);
+        completers[n].expect_n_calls(1);
+
+        executor.set_nth_result(n, true);
+        queue.schedule_at(tasks[n], now + delay, executor, &completers[n]);
+    }
+
+    for (size_t n = 0; n < NumTasks; n++) {
+        executor.unblock_one();
+
+        const size_t idx = order[n];
+
+        CHECK(completers[idx].wait_called() == &tasks[idx]);
+
+        UNSIGNED_LONGS_EQUAL(n + 1, executor.num_tasks());
+        CHECK(executor.nth_task(n) == &tasks[idx]);
+
+        CHECK(tasks[idx].succeeded());
+    }
+
+    executor.check_all_unblocked();
+}
+
+TEST(task_queue, schedule_at_distant_and_cancel) {
+    enum { NumTasks = 5 };
+
+    TestExecutor executor;
+
+    ControlTaskQueue queue;
+    CHECK(queue.is_valid());
+
+    TestExecutor::Task tasks[NumTasks];
+    TestCompleter completers[NumTasks];
+
+    // From nearest to beyond the whole timing wheel.
+    const core::nanoseconds_t delays[NumTasks] = {
+        core::Millisecond * 50, core::Second, core::Second * 10, core::Hour,
+        core::Hour * 10,
+    };
+
+    for (size_t n = 0; n < NumTasks; n++) {
+        completers[n].expect_success(false);
+        completers[n].expect_cancelled(true);
+        completers[n].expect_n_calls(1);
+
+        queue.schedule_at(tasks[n], now_plus_delay(delays[n]), executor, &completers[n]);
+    }
+
+    for (size_t n = 0; n < NumTasks; n++) {
+        queue.async_cancel(tasks[n]);
+    }
+
+    for (size_t n = 0; n < NumTasks; n++) {
+        CHECK(completers[n].wait_called() == &tasks[n]);
+
+        CHECK(!tasks[n].succeeded());
+        CHECK(tasks[n].cancelled());
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, executor.num_tasks());
+}
+
 } // namespace ctl
 } // namespace roc
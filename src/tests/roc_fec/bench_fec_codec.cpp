@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "test_helpers/bench_params.h"
+
+#include "roc_core/array.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_fec/codec_map.h"
+#include "roc_packet/fec_scheme_to_str.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// --------
+// Overview
+// --------
+//
+// These benchmarks measure raw block encoder and decoder throughput for every
+// codec registered in CodecMap, without packet composition and parsing.
+//
+// Every iteration processes one FEC block. Benchmarks are parameterized with:
+//
+//  - scheme  -  FEC scheme (packet::FecScheme)
+//  - sblen   -  number of source packets in block
+//  - rblen   -  number of repair packets in block
+//  - psize   -  payload size of every packet, in bytes
+//  - loss    -  loss pattern (decoder only), see test::LossPattern
+//
+// --------------
+// Output columns
+// --------------
+//
+// Time             -  wall clock time per block
+// CPU              -  CPU time per block
+// Iterations       -  number of blocks
+// bytes_per_second -  source payload bytes processed per second
+// failed           -  fraction of blocks that couldn't be encoded (encoder),
+//                     or couldn't be fully repaired (decoder)
+//
+// Label contains scheme name. Only schemes enabled in build are benchmarked.
+
+const size_t MaxPayloadSize = 2048;
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, MaxPayloadSize);
+
+class BM_FecCodec : public benchmark::Fixture {
+public:
+    BM_FecCodec()
+        : buffers_(arena) {
+    }
+
+    // Returns false and reports error if scheme is not supported.
+    bool init(benchmark::State& state) {
+        config_.scheme = (packet::FecScheme)state.range(0);
+        sblen_ = (size_t)state.range(1);
+        rblen_ = (size_t)state.range(2);
+        psize_ = (size_t)state.range(3);
+
+        if (!CodecMap::instance().is_supported(config_.scheme)) {
+            state.SkipWithError("fec scheme not supported");
+            return false;
+        }
+
+        encoder_.reset(CodecMap::instance().new_encoder(config_, packet_factory, arena),
+                       arena);
+        decoder_.reset(CodecMap::instance().new_decoder(config_, packet_factory, arena),
+                       arena);
+
+        if (!encoder_ || !decoder_) {
+            state.SkipWithError("can't create fec codec");
+            return false;
+        }
+
+        if (sblen_ + rblen_ > encoder_->max_block_length()) {
+            state.SkipWithError("block length not supported by fec scheme");
+            return false;
+        }
+
+        if (!buffers_.resize(sblen_ + rblen_)) {
+            state.SkipWithError("can't allocate buffers");
+            return false;
+        }
+
+        for (size_t i = 0; i < sblen_ + rblen_; i++) {
+            buffers_[i] = packet_factory.new_packet_buffer();
+            if (!buffers_[i]) {
+                state.SkipWithError("can't allocate buffers");
+                return false;
+            }
+            buffers_[i].reslice(0, psize_);
+            if (i < sblen_) {
+                for (size_t j = 0; j < psize_; j++) {
+                    buffers_[i].data()[j] = (uint8_t)core::fast_random_range(0, 0xff);
+                }
+            }
+        }
+
+        state.SetLabel(packet::fec_scheme_to_str(config_.scheme));
+
+        return true;
+    }
+
+    bool encode_block() {
+        if (!encoder_->begin(sblen_, rblen_, psize_)) {
+            return false;
+        }
+
+        for (size_t i = 0; i < sblen_ + rblen_; i++) {
+            encoder_->set(i, buffers_[i]);
+        }
+
+        encoder_->fill();
+        encoder_->end();
+
+        return true;
+    }
+
+    bool decode_block(test::LossPattern pattern) {
+        if (!decoder_->begin(sblen_, rblen_, psize_)) {
+            return false;
+        }
+
+        for (size_t i = 0; i < sblen_ + rblen_; i++) {
+            if (!test::is_lost(pattern, i, sblen_, rblen_)) {
+                decoder_->set(i, buffers_[i]);
+            }
+        }
+
+        bool repaired = true;
+
+        for (size_t i = 0; i < sblen_; i++) {
+            core::Slice<uint8_t> buf = decoder_->repair(i);
+            benchmark::DoNotOptimize(buf.data());
+            if (!buf) {
+                repaired = false;
+            }
+        }
+
+        decoder_->end();
+
+        return repaired;
+    }
+
+    void set_counters(benchmark::State& state, size_t n_failed) {
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(sblen_)
+                                * int64_t(psize_));
+        state.counters["failed"] = state.iterations() != 0
+            ? double(n_failed) / double(state.iterations())
+            : 0;
+    }
+
+private:
+    CodecConfig config_;
+
+    core::ScopedPtr<IBlockEncoder> encoder_;
+    core::ScopedPtr<IBlockDecoder> decoder_;
+
+    core::Array<core::Slice<uint8_t> > buffers_;
+
+    size_t sblen_;
+    size_t rblen_;
+    size_t psize_;
+};
+
+void apply_encoder_args(benchmark::internal::Benchmark* bench) {
+    test::apply_bench_params(bench, false);
+}
+
+void apply_decoder_args(benchmark::internal::Benchmark* bench) {
+    test::apply_bench_params(bench, true);
+}
+
+BENCHMARK_DEFINE_F(BM_FecCodec, Encode)(benchmark::State& state) {
+    if (!init(state)) {
+        return;
+    }
+
+    size_t n_failed = 0;
+
+    while (state.KeepRunning()) {
+        if (!encode_block()) {
+            n_failed++;
+        }
+    }
+
+    set_counters(state, n_failed);
+}
+
+BENCHMARK_REGISTER_F(BM_FecCodec, Encode)
+    ->Apply(apply_encoder_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(BM_FecCodec, Decode)(benchmark::State& state) {
+    if (!init(state)) {
+        return;
+    }
+
+    const test::LossPattern pattern = (test::LossPattern)state.range(4);
+
+    if (!encode_block()) {
+        state.SkipWithError("can't encode block");
+        return;
+    }
+
+    size_t n_failed = 0;
+
+    while (state.KeepRunning()) {
+        if (!decode_block(pattern)) {
+            n_failed++;
+        }
+    }
+
+    set_counters(state, n_failed);
+}
+
+BENCHMARK_REGISTER_F(BM_FecCodec, Decode)
+    ->Apply(apply_decoder_args)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "test_helpers/bench_params.h"
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parser.h"
+#include "roc_fec/reader.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/fec_scheme_to_str.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/queue.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/encoding_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// --------
+// Overview
+// --------
+//
+// These benchmarks measure throughput of the full FEC path, as it's used by
+// sender and receiver pipelines:
+//
+//  - source packets are prepared using RTP + FECFRAME composer
+//  - fec::Writer encodes repair packets and composes all packets
+//  - packets are dropped according to loss pattern, and the rest are
+//    re-parsed into new packets, like it happens on receiver
+//  - fec::Reader restores lost packets and returns source packets
+//
+// Every iteration processes one FEC block. Parameters are the same as
+// in bench_fec_codec.cpp (scheme, sblen, rblen, psize, loss).
+//
+// --------------
+// Output columns
+// --------------
+//
+// Time             -  wall clock time per block
+// CPU              -  CPU time per block
+// Iterations       -  number of blocks
+// bytes_per_second -  source payload bytes processed per second
+// lost             -  fraction of source packets that were not restored
+
+const size_t MaxBufferSize = 2048;
+
+const unsigned SourceID = 555;
+const unsigned PayloadType = rtp::PayloadType_L16_Stereo;
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, MaxBufferSize);
+
+rtp::EncodingMap encoding_map(arena);
+rtp::Parser rtp_parser(encoding_map, NULL);
+rtp::Composer rtp_composer(NULL);
+
+Parser<RS8M_PayloadID, Source, Footer> rs8m_source_parser(&rtp_parser);
+Parser<RS8M_PayloadID, Repair, Header> rs8m_repair_parser(NULL);
+Parser<LDPC_Source_PayloadID, Source, Footer> ldpc_source_parser(&rtp_parser);
+Parser<LDPC_Repair_PayloadID, Repair, Header> ldpc_repair_parser(NULL);
+
+Composer<RS8M_PayloadID, Source, Footer> rs8m_source_composer(&rtp_composer);
+Composer<RS8M_PayloadID, Repair, Header> rs8m_repair_composer(NULL);
+Composer<LDPC_Source_PayloadID, Source, Footer> ldpc_source_composer(&rtp_composer);
+Composer<LDPC_Repair_PayloadID, Repair, Header> ldpc_repair_composer(NULL);
+
+// Emulates network between writer and reader.
+// Drops packets according to loss pattern, and re-parses the rest into
+// new packets, putting them into source and repair queues.
+class LossyNetwork : public packet::IWriter, public core::NonCopyable<> {
+public:
+    LossyNetwork(packet::IParser& source_parser,
+                 packet::IParser& repair_parser,
+                 test::LossPattern pattern)
+        : source_parser_(source_parser)
+        , repair_parser_(repair_parser)
+        , pattern_(pattern) {
+    }
+
+    packet::IReader& source_reader() {
+        return source_queue_;
+    }
+
+    packet::IReader& repair_reader() {
+        return repair_queue_;
+    }
+
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const packet::PacketPtr& pp) {
+        const packet::FEC& fec = *pp->fec();
+
+        if (test::is_lost(pattern_, fec.encoding_symbol_id, fec.source_block_length,
+                          fec.block_length - fec.source_block_length)) {
+            return status::StatusOK;
+        }
+
+        const bool is_repair = pp->has_flags(packet::Packet::FlagRepair);
+
+        packet::PacketPtr new_pp = packet_factory.new_packet();
+        if (!new_pp) {
+            return status::StatusNoMem;
+        }
+
+        if (!(is_repair ? repair_parser_ : source_parser_)
+                 .parse(*new_pp, pp->buffer())) {
+            return status::StatusUnknown;
+        }
+        new_pp->set_buffer(pp->buffer());
+
+        return is_repair ? repair_queue_.write(new_pp) : source_queue_.write(new_pp);
+    }
+
+private:
+    packet::IParser& source_parser_;
+    packet::IParser& repair_parser_;
+
+    const test::LossPattern pattern_;
+
+    packet::Queue source_queue_;
+    packet::Queue repair_queue_;
+};
+
+class BM_FecWriterReader : public benchmark::Fixture {
+public:
+    bool init(benchmark::State& state) {
+        codec_config_.scheme = (packet::FecScheme)state.range(0);
+        writer_config_.n_source_packets = (size_t)state.range(1);
+        writer_config_.n_repair_packets = (size_t)state.range(2);
+        fec_payload_size_ = (size_t)state.range(3);
+
+        if (!CodecMap::instance().is_supported(codec_config_.scheme)) {
+            state.SkipWithError("fec scheme not supported");
+            return false;
+        }
+
+        if (!source_parser_() || !repair_parser_() || !source_composer_()
+            || !repair_composer_()) {
+            state.SkipWithError("no packet format for fec scheme");
+            return false;
+        }
+
+        if (fec_payload_size_ <= sizeof(rtp::Header)) {
+            state.SkipWithError("payload size too small");
+            return false;
+        }
+
+        encoder_.reset(
+            CodecMap::instance().new_encoder(codec_config_, packet_factory, arena), arena);
+        decoder_.reset(
+            CodecMap::instance().new_decoder(codec_config_, packet_factory, arena), arena);
+
+        if (!encoder_ || !decoder_) {
+            state.SkipWithError("can't create fec codec");
+            return false;
+        }
+
+        if (writer_config_.n_source_packets + writer_config_.n_repair_packets
+            > encoder_->max_block_length()) {
+            state.SkipWithError("block length not supported by fec scheme");
+            return false;
+        }
+
+        network_.reset(new (network_)
+                           LossyNetwork(*source_parser_(), *repair_parser_(),
+                                        (test::LossPattern)state.range(4)));
+
+        writer_.reset(new (writer_) Writer(writer_config_, codec_config_.scheme,
+                                           *encoder_, *network_, *source_composer_(),
+                                           *repair_composer_(), packet_factory, arena));
+
+        reader_.reset(new (reader_) Reader(reader_config_, codec_config_.scheme,
+                                           *decoder_, network_->source_reader(),
+                                           network_->repair_reader(), rtp_parser,
+                                           packet_factory, arena));
+
+        if (!writer_->is_valid() || !reader_->is_valid()) {
+            state.SkipWithError("can't create fec writer or reader");
+            return false;
+        }
+
+        seqnum_ = 0;
+
+        state.SetLabel(packet::fec_scheme_to_str(codec_config_.scheme));
+
+        return true;
+    }
+
+    void deinit() {
+        reader_.reset();
+        writer_.reset();
+        network_.reset();
+        decoder_.reset();
+        encoder_.reset();
+    }
+
+    bool write_block() {
+        for (size_t i = 0; i < writer_config_.n_source_packets; i++) {
+            packet::PacketPtr pp = new_source_packet_();
+            if (!pp) {
+                return false;
+            }
+            if (writer_->write(pp) != status::StatusOK) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t read_block() {
+        size_t n_read = 0;
+
+        while (n_read < writer_config_.n_source_packets) {
+            packet::PacketPtr pp;
+            if (reader_->read(pp) != status::StatusOK || !pp) {
+                break;
+            }
+            benchmark::DoNotOptimize(pp->rtp()->payload.data());
+            n_read++;
+        }
+
+        return n_read;
+    }
+
+    void set_counters(benchmark::State& state, size_t n_lost) {
+        const int64_t n_packets =
+            int64_t(state.iterations()) * int64_t(writer_config_.n_source_packets);
+
+        state.SetBytesProcessed(n_packets * int64_t(fec_payload_size_));
+        state.counters["lost"] = n_packets != 0 ? double(n_lost) / double(n_packets) : 0;
+    }
+
+private:
+    packet::PacketPtr new_source_packet_() {
+        const size_t rtp_payload_size = fec_payload_size_ - sizeof(rtp::Header);
+
+        packet::PacketPtr pp = packet_factory.new_packet();
+        if (!pp) {
+            return NULL;
+        }
+
+        core::Slice<uint8_t> bp = packet_factory.new_packet_buffer();
+        if (!bp) {
+            return NULL;
+        }
+
+        if (!source_composer_()->prepare(*pp, bp, rtp_payload_size)) {
+            return NULL;
+        }
+        pp->set_buffer(bp);
+
+        pp->add_flags(packet::Packet::FlagAudio | packet::Packet::FlagPrepared);
+
+        pp->rtp()->source_id = SourceID;
+        pp->rtp()->payload_type = PayloadType;
+        pp->rtp()->seqnum = seqnum_;
+        pp->rtp()->stream_timestamp = packet::stream_timestamp_t(seqnum_ * 10);
+
+        memset(pp->rtp()->payload.data(), (int)seqnum_, rtp_payload_size);
+
+        seqnum_++;
+
+        return pp;
+    }
+
+    // Packet format is defined per scheme, like in pipeline endpoints.
+    // Returns NULL if there is no packet format for scheme.
+    packet::IParser* source_parser_() {
+        switch (codec_config_.scheme) {
+        case packet::FEC_ReedSolomon_M8:
+            return &rs8m_source_parser;
+        case packet::FEC_LDPC_Staircase:
+            return &ldpc_source_parser;
+        default:
+            return NULL;
+        }
+    }
+
+    packet::IParser* repair_parser_() {
+        switch (codec_config_.scheme) {
+        case packet::FEC_ReedSolomon_M8:
+            return &rs8m_repair_parser;
+        case packet::FEC_LDPC_Staircase:
+            return &ldpc_repair_parser;
+        default:
+            return NULL;
+        }
+    }
+
+    packet::IComposer* source_composer_() {
+        switch (codec_config_.scheme) {
+        case packet::FEC_ReedSolomon_M8:
+            return &rs8m_source_composer;
+        case packet::FEC_LDPC_Staircase:
+            return &ldpc_source_composer;
+        default:
+            return NULL;
+        }
+    }
+
+    packet::IComposer* repair_composer_() {
+        switch (codec_config_.scheme) {
+        case packet::FEC_ReedSolomon_M8:
+            return &rs8m_repair_composer;
+        case packet::FEC_LDPC_Staircase:
+            return &ldpc_repair_composer;
+        default:
+            return NULL;
+        }
+    }
+
+    CodecConfig codec_config_;
+    WriterConfig writer_config_;
+    ReaderConfig reader_config_;
+
+    size_t fec_payload_size_;
+
+    core::ScopedPtr<IBlockEncoder> encoder_;
+    core::ScopedPtr<IBlockDecoder> decoder_;
+
+    core::Optional<LossyNetwork> network_;
+    core::Optional<Writer> writer_;
+    core::Optional<Reader> reader_;
+
+    packet::seqnum_t seqnum_;
+};
+
+void apply_writer_reader_args(benchmark::internal::Benchmark* bench) {
+    test::apply_bench_params(bench, true);
+}
+
+BENCHMARK_DEFINE_F(BM_FecWriterReader, WriteRead)(benchmark::State& state) {
+    if (!init(state)) {
+        return;
+    }
+
+    size_t n_lost = 0;
+
+    while (state.KeepRunning()) {
+        if (!write_block()) {
+            state.SkipWithError("can't write block");
+            break;
+        }
+        n_lost += (size_t)state.range(1) - read_block();
+    }
+
+    set_counters(state, n_lost);
+    deinit();
+}
+
+BENCHMARK_REGISTER_F(BM_FecWriterReader, WriteRead)
+    ->Apply(apply_writer_reader_args)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
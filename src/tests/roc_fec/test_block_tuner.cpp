@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/time.h"
+#include "roc_fec/block_tuner.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t NumSourcePackets = 20;
+const size_t NumRepairPackets = 10;
+
+const core::nanoseconds_t Cooldown = core::Second;
+
+WriterConfig make_writer_config() {
+    WriterConfig config;
+    config.n_source_packets = NumSourcePackets;
+    config.n_repair_packets = NumRepairPackets;
+    return config;
+}
+
+BlockTunerConfig make_tuner_config(size_t min_rblen, size_t max_rblen) {
+    BlockTunerConfig config;
+    config.enable_tuning = true;
+    config.min_repair_packets = min_rblen;
+    config.max_repair_packets = max_rblen;
+    config.loss_margin = 1;
+    config.loss_decay = 1;
+    config.decrease_cooldown = Cooldown;
+    config.deduce_defaults(make_writer_config());
+    return config;
+}
+
+} // namespace
+
+TEST_GROUP(block_tuner) {};
+
+TEST(block_tuner, defaults) {
+    BlockTunerConfig config;
+    config.deduce_defaults(make_writer_config());
+
+    UNSIGNED_LONGS_EQUAL(1, config.min_repair_packets);
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, config.max_repair_packets);
+    CHECK(config.loss_margin > 0);
+    CHECK(config.loss_decay > 0);
+    CHECK(config.decrease_cooldown > 0);
+
+    BlockTuner tuner(config, make_writer_config());
+    CHECK(tuner.is_valid());
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(NumRepairPackets, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, invalid_bounds) {
+    BlockTuner tuner(make_tuner_config(10, 5), make_writer_config());
+    CHECK(!tuner.is_valid());
+}
+
+TEST(block_tuner, initial_trimmed) {
+    {
+        BlockTuner tuner(make_tuner_config(1, 4), make_writer_config());
+        CHECK(tuner.is_valid());
+        UNSIGNED_LONGS_EQUAL(4, tuner.n_repair_packets());
+    }
+    {
+        BlockTuner tuner(make_tuner_config(15, 20), make_writer_config());
+        CHECK(tuner.is_valid());
+        UNSIGNED_LONGS_EQUAL(15, tuner.n_repair_packets());
+    }
+}
+
+TEST(block_tuner, increase_immediately) {
+    BlockTuner tuner(make_tuner_config(1, 20), make_writer_config());
+    CHECK(tuner.is_valid());
+
+    core::nanoseconds_t ts = 100 * core::Second;
+
+    // 50% loss requires 20 repair packets for 20 source packets
+    ts += core::Millisecond;
+    CHECK(tuner.update(0.5f, ts));
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_repair_packets());
+
+    // same loss, no changes
+    ts += core::Millisecond;
+    CHECK(!tuner.update(0.5f, ts));
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, decrease_gradually) {
+    BlockTuner tuner(make_tuner_config(2, 20), make_writer_config());
+    CHECK(tuner.is_valid());
+
+    core::nanoseconds_t ts = 100 * core::Second;
+
+    CHECK(tuner.update(0.5f, ts));
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_repair_packets());
+
+    // loss disappeared, but cooldown not expired
+    ts += Cooldown / 2;
+    CHECK(!tuner.update(0, ts));
+    UNSIGNED_LONGS_EQUAL(20, tuner.n_repair_packets());
+
+    // decrease by one packet per cooldown until minimum is reached
+    for (size_t rblen = 19; rblen >= 2; rblen--) {
+        ts += Cooldown;
+        CHECK(tuner.update(0, ts));
+        UNSIGNED_LONGS_EQUAL(rblen, tuner.n_repair_packets());
+    }
+
+    ts += Cooldown;
+    CHECK(!tuner.update(0, ts));
+    UNSIGNED_LONGS_EQUAL(2, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, upper_bound) {
+    BlockTuner tuner(make_tuner_config(1, 12), make_writer_config());
+    CHECK(tuner.is_valid());
+
+    CHECK(tuner.update(0.9f, core::Second));
+    UNSIGNED_LONGS_EQUAL(12, tuner.n_repair_packets());
+
+    CHECK(!tuner.update(1.0f, 2 * core::Second));
+    UNSIGNED_LONGS_EQUAL(12, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, loss_margin) {
+    BlockTunerConfig config = make_tuner_config(1, 20);
+    config.loss_margin = 2;
+
+    BlockTuner tuner(config, make_writer_config());
+    CHECK(tuner.is_valid());
+
+    // 10% loss with 2x margin is treated as 20% loss,
+    // which requires 5 repair packets for 20 source packets;
+    // since it's below current length, nothing changes until cooldown
+    CHECK(!tuner.update(0.1f, 0));
+    UNSIGNED_LONGS_EQUAL(NumRepairPackets, tuner.n_repair_packets());
+
+    // 20% loss with 2x margin is treated as 40% loss,
+    // which requires 14 repair packets for 20 source packets
+    CHECK(tuner.update(0.2f, core::Millisecond));
+    UNSIGNED_LONGS_EQUAL(14, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, loss_decay) {
+    BlockTunerConfig config = make_tuner_config(1, 20);
+    config.loss_decay = 0.5f;
+
+    BlockTuner tuner(config, make_writer_config());
+    CHECK(tuner.is_valid());
+
+    tuner.update(0.4f, 0);
+    DOUBLES_EQUAL(0.4, tuner.loss_ratio(), 1e-6);
+
+    tuner.update(0.0f, 0);
+    DOUBLES_EQUAL(0.2, tuner.loss_ratio(), 1e-6);
+
+    tuner.update(0.0f, 0);
+    DOUBLES_EQUAL(0.1, tuner.loss_ratio(), 1e-6);
+
+    tuner.update(0.3f, 0);
+    DOUBLES_EQUAL(0.3, tuner.loss_ratio(), 1e-6);
+}
+
+} // namespace fec
+} // namespace roc
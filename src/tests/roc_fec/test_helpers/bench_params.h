@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ROC_FEC_TEST_HELPERS_BENCH_PARAMS_H_
+#define ROC_FEC_TEST_HELPERS_BENCH_PARAMS_H_
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/macro_helpers.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/codec_map.h"
+#include "roc_packet/fec.h"
+
+namespace roc {
+namespace fec {
+namespace test {
+
+// Which source packets are lost in every block.
+enum LossPattern {
+    // No source packets lost.
+    Loss_None,
+    // One source packet lost in the middle of the block.
+    Loss_Single,
+    // Half of repair block length, consecutive source packets.
+    Loss_Burst,
+    // Repair block length, source packets spread evenly over block.
+    Loss_Spread
+};
+
+// Check if packet with given index in block is lost according to pattern.
+inline bool
+is_lost(LossPattern pattern, size_t index, size_t sblen, size_t rblen) {
+    if (index >= sblen) {
+        return false;
+    }
+
+    switch (pattern) {
+    case Loss_None:
+        return false;
+
+    case Loss_Single:
+        return index == sblen / 2;
+
+    case Loss_Burst: {
+        const size_t n_lost = std::min(std::max(rblen / 2, (size_t)1), sblen);
+        const size_t first = (sblen - n_lost) / 2;
+        return index >= first && index < first + n_lost;
+    }
+
+    case Loss_Spread: {
+        const size_t n_lost = std::min(rblen, sblen);
+        if (n_lost == 0) {
+            return false;
+        }
+        const size_t step = sblen / n_lost;
+        return index % step == 0 && index / step < n_lost;
+    }
+    }
+
+    return false;
+}
+
+// Register benchmark arguments: scheme, sblen, rblen, psize, and optionally loss.
+// Every scheme supported by CodecMap is registered.
+inline void apply_bench_params(benchmark::internal::Benchmark* bench, bool with_loss) {
+    const CodecMap& codec_map = CodecMap::instance();
+
+    const size_t block_sizes[][2] = {
+        { 10, 5 },   //
+        { 20, 10 },  //
+        { 50, 25 },  //
+        { 100, 50 }, //
+        { 150, 100 },
+    };
+
+    const size_t payload_sizes[] = { 64, 256, 1280 };
+
+    const LossPattern loss_patterns[] = {
+        Loss_None,
+        Loss_Single,
+        Loss_Burst,
+        Loss_Spread,
+    };
+
+    std::vector<std::string> names;
+    names.push_back("scheme");
+    names.push_back("sblen");
+    names.push_back("rblen");
+    names.push_back("psize");
+    if (with_loss) {
+        names.push_back("loss");
+    }
+    bench->ArgNames(names);
+
+    const size_t n_patterns = with_loss ? ROC_ARRAY_SIZE(loss_patterns) : 1;
+
+    for (size_t n_sc = 0; n_sc < codec_map.num_schemes(); n_sc++) {
+        for (size_t n_bs = 0; n_bs < ROC_ARRAY_SIZE(block_sizes); n_bs++) {
+            for (size_t n_ps = 0; n_ps < ROC_ARRAY_SIZE(payload_sizes); n_ps++) {
+                for (size_t n_lp = 0; n_lp < n_patterns; n_lp++) {
+                    std::vector<int64_t> args;
+                    args.push_back((int64_t)codec_map.nth_scheme(n_sc));
+                    args.push_back((int64_t)block_sizes[n_bs][0]);
+                    args.push_back((int64_t)block_sizes[n_bs][1]);
+                    args.push_back((int64_t)payload_sizes[n_ps]);
+                    if (with_loss) {
+                        args.push_back((int64_t)loss_patterns[n_lp]);
+                    }
+                    bench->Args(args);
+                }
+            }
+        }
+    }
+}
+
+} // namespace test
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_TEST_HELPERS_BENCH_PARAMS_H_
@@ -50,5 +50,71 @@ TEST(context, reference_counting) {
     CHECK(context.getref() == 0);
 }
 
+TEST(context, preallocate) {
+    enum { NumPackets = 50, NumFrames = 20 };
+
+    ContextConfig context_config;
+    context_config.prealloc_packets = NumPackets;
+    context_config.prealloc_frames = NumFrames;
+    context_config.fixed_pools = true;
+
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    ContextMetrics metrics = context.get_metrics();
+
+    CHECK(metrics.packet_pool.capacity >= NumPackets);
+    CHECK(metrics.packet_buffer_pool.capacity >= NumPackets);
+    CHECK(metrics.frame_buffer_pool.capacity >= NumFrames);
+
+    UNSIGNED_LONGS_EQUAL(0, metrics.frame_buffer_pool.num_used);
+    UNSIGNED_LONGS_EQUAL(0, metrics.frame_buffer_pool.max_used);
+
+    // allocate all frames, pool doesn't grow
+    const size_t capacity = metrics.frame_buffer_pool.capacity;
+    void* frames[NumFrames * 2] = {};
+
+    for (size_t n = 0; n < capacity; n++) {
+        frames[n] = context.frame_buffer_pool().allocate();
+        CHECK(frames[n]);
+    }
+    CHECK(!context.frame_buffer_pool().allocate());
+
+    for (size_t n = 0; n < capacity; n++) {
+        context.frame_buffer_pool().deallocate(frames[n]);
+    }
+
+    metrics = context.get_metrics();
+
+    UNSIGNED_LONGS_EQUAL(capacity, metrics.frame_buffer_pool.capacity);
+    UNSIGNED_LONGS_EQUAL(0, metrics.frame_buffer_pool.num_used);
+    UNSIGNED_LONGS_EQUAL(capacity, metrics.frame_buffer_pool.max_used);
+}
+
+TEST(context, huge_pages) {
+    enum { NumPackets = 100 };
+
+    ContextConfig context_config;
+    context_config.prealloc_packets = NumPackets;
+    context_config.huge_pages = true;
+
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    ContextMetrics metrics = context.get_metrics();
+
+    CHECK(metrics.packet_pool.capacity >= NumPackets);
+    CHECK(metrics.packet_buffer_pool.capacity >= NumPackets);
+
+    // pool memory is counted
+    CHECK(metrics.memory.num_bytes > 0);
+    CHECK(metrics.memory.max_bytes >= metrics.memory.num_bytes);
+
+    void* buffer = context.packet_buffer_pool().allocate();
+    CHECK(buffer);
+    memset(buffer, 0xff, context.packet_buffer_pool().object_size());
+    context.packet_buffer_pool().deallocate(buffer);
+}
+
 } // namespace node
 } // namespace roc
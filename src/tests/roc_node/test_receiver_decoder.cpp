@@ -73,6 +73,53 @@ TEST(receiver_decoder, write_packet) {
                 receiver_decoder.write_packet(address::Iface_AudioControl, pp));
 }
 
+TEST(receiver_decoder, write_packets) {
+    enum { NumPackets = 5 };
+
+    Context context(context_config, arena);
+    CHECK(context.is_valid());
+
+    ReceiverDecoder receiver_decoder(context, receiver_config);
+    CHECK(receiver_decoder.is_valid());
+
+    packet::PacketPtr packets[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = packet_factory.new_packet();
+        CHECK(packets[n]);
+    }
+
+    status::StatusCode codes[NumPackets];
+
+    // interface not activated, no packets written
+    for (size_t n = 0; n < NumPackets; n++) {
+        codes[n] = status::StatusOK;
+    }
+    // TODO(gh-183): compare with StatusNotFound
+    LONGS_EQUAL(status::StatusUnknown,
+                receiver_decoder.write_packets(address::Iface_AudioSource, packets,
+                                               NumPackets, codes));
+    for (size_t n = 0; n < NumPackets; n++) {
+        LONGS_EQUAL(status::StatusUnknown, codes[n]);
+    }
+
+    CHECK(receiver_decoder.activate(address::Iface_AudioSource, address::Proto_RTP));
+
+    // interface activated, whole batch written
+    for (size_t n = 0; n < NumPackets; n++) {
+        codes[n] = status::StatusUnknown;
+    }
+    LONGS_EQUAL(status::StatusOK,
+                receiver_decoder.write_packets(address::Iface_AudioSource, packets,
+                                               NumPackets, codes));
+    for (size_t n = 0; n < NumPackets; n++) {
+        LONGS_EQUAL(status::StatusOK, codes[n]);
+    }
+
+    // empty batch
+    LONGS_EQUAL(status::StatusOK, receiver_decoder.write_packets(
+                                      address::Iface_AudioSource, NULL, 0, NULL));
+}
+
 TEST(receiver_decoder, read_packet) {
     Context context(context_config, arena);
     CHECK(context.is_valid());
@@ -47,6 +47,44 @@ struct TestWriter : core::Thread {
     }
 };
 
+struct TestBatchWriter : core::Thread {
+    TestBatchWriter(ConcurrentQueue& queue, const PacketPtr* packets, size_t n_packets)
+        : queue(queue)
+        , packets(packets)
+        , n_packets(n_packets) {
+    }
+
+    ConcurrentQueue& queue;
+    const PacketPtr* packets;
+    size_t n_packets;
+
+    virtual void run() {
+        core::sleep_for(core::ClockMonotonic, core::Microsecond * 10);
+
+        status::StatusCode codes[MaxBufSize];
+        LONGS_EQUAL(status::StatusOK, queue.write_many(packets, n_packets, codes));
+    }
+};
+
+// Writer that fails every second packet.
+struct FailingWriter : IWriter {
+    FailingWriter()
+        : n_calls(0)
+        , n_written(0) {
+    }
+
+    size_t n_calls;
+    size_t n_written;
+
+    virtual status::StatusCode write(const PacketPtr&) {
+        if (n_calls++ % 2 == 1) {
+            return status::StatusNoSpace;
+        }
+        n_written++;
+        return status::StatusOK;
+    }
+};
+
 } // namespace
 
 TEST_GROUP(concurrent_queue) {};
@@ -154,5 +192,198 @@ TEST(concurrent_queue, nonblocking_queue_read_empty) {
     }
 }
 
+TEST(concurrent_queue, blocking_queue_read_many) {
+    ConcurrentQueue queue(ConcurrentQueue::Blocking);
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr packets[10];
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            packets[j] = new_packet();
+            LONGS_EQUAL(status::StatusOK, queue.write(packets[j]));
+        }
+
+        // read less than available
+        PacketPtr rp[20];
+        size_t n_read = 0;
+        LONGS_EQUAL(status::StatusOK, queue.read_many(rp, 4, n_read));
+        LONGS_EQUAL(4, n_read);
+
+        // read rest, doesn't block when queue becomes empty
+        LONGS_EQUAL(status::StatusOK,
+                    queue.read_many(rp + 4, ROC_ARRAY_SIZE(rp) - 4, n_read));
+        LONGS_EQUAL(6, n_read);
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            CHECK(rp[j] == packets[j]);
+        }
+    }
+}
+
+TEST(concurrent_queue, blocking_queue_read_many_empty) {
+    ConcurrentQueue queue(ConcurrentQueue::Blocking);
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr wp = new_packet();
+
+        TestWriter writer(queue, wp);
+        CHECK(writer.start());
+
+        // blocks until first packet
+        PacketPtr rp[10];
+        size_t n_read = 0;
+        LONGS_EQUAL(status::StatusOK, queue.read_many(rp, ROC_ARRAY_SIZE(rp), n_read));
+        LONGS_EQUAL(1, n_read);
+        CHECK(wp == rp[0]);
+
+        writer.join();
+    }
+}
+
+TEST(concurrent_queue, nonblocking_queue_read_many) {
+    ConcurrentQueue queue(ConcurrentQueue::NonBlocking);
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr packets[10];
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            packets[j] = new_packet();
+            LONGS_EQUAL(status::StatusOK, queue.write(packets[j]));
+        }
+
+        PacketPtr rp[20];
+        size_t n_read = 0;
+        LONGS_EQUAL(status::StatusOK, queue.read_many(rp, ROC_ARRAY_SIZE(rp), n_read));
+        LONGS_EQUAL(ROC_ARRAY_SIZE(packets), n_read);
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            CHECK(rp[j] == packets[j]);
+        }
+
+        LONGS_EQUAL(status::StatusNoData,
+                    queue.read_many(rp, ROC_ARRAY_SIZE(rp), n_read));
+        LONGS_EQUAL(0, n_read);
+    }
+}
+
+TEST(concurrent_queue, blocking_queue_write_many) {
+    ConcurrentQueue queue(ConcurrentQueue::Blocking);
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr packets[10];
+        status::StatusCode codes[10];
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            packets[j] = new_packet();
+            codes[j] = status::StatusUnknown;
+        }
+
+        LONGS_EQUAL(status::StatusOK,
+                    queue.write_many(packets, ROC_ARRAY_SIZE(packets), codes));
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            LONGS_EQUAL(status::StatusOK, codes[j]);
+        }
+
+        // each packet of batch can be read separately, although reader
+        // was signaled at most once
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            PacketPtr pp;
+            LONGS_EQUAL(status::StatusOK, queue.read(pp));
+            CHECK(pp == packets[j]);
+        }
+    }
+}
+
+TEST(concurrent_queue, blocking_queue_write_many_wakeup) {
+    ConcurrentQueue queue(ConcurrentQueue::Blocking);
+
+    for (size_t i = 0; i < 100; i++) {
+        PacketPtr packets[10];
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            packets[j] = new_packet();
+        }
+
+        TestBatchWriter writer(queue, packets, ROC_ARRAY_SIZE(packets));
+        CHECK(writer.start());
+
+        // blocks until batch is written, then gets all packets
+        // that are already queued
+        PacketPtr rp[10];
+        size_t n_total = 0;
+
+        while (n_total < ROC_ARRAY_SIZE(rp)) {
+            size_t n_read = 0;
+            LONGS_EQUAL(status::StatusOK, queue.read_many(rp + n_total,
+                                                          ROC_ARRAY_SIZE(rp) - n_total,
+                                                          n_read));
+            CHECK(n_read > 0);
+            n_total += n_read;
+        }
+
+        writer.join();
+
+        for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+            CHECK(rp[j] == packets[j]);
+        }
+    }
+}
+
+TEST(concurrent_queue, nonblocking_queue_write_many) {
+    ConcurrentQueue queue(ConcurrentQueue::NonBlocking);
+
+    PacketPtr packets[10];
+    status::StatusCode codes[10];
+
+    for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+        packets[j] = new_packet();
+    }
+
+    // empty batch
+    LONGS_EQUAL(status::StatusOK, queue.write_many(NULL, 0, NULL));
+
+    PacketPtr pp;
+    LONGS_EQUAL(status::StatusNoData, queue.read(pp));
+
+    LONGS_EQUAL(status::StatusOK,
+                queue.write_many(packets, ROC_ARRAY_SIZE(packets), codes));
+
+    PacketPtr rp[20];
+    size_t n_read = 0;
+    LONGS_EQUAL(status::StatusOK, queue.read_many(rp, ROC_ARRAY_SIZE(rp), n_read));
+    LONGS_EQUAL(ROC_ARRAY_SIZE(packets), n_read);
+
+    for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+        LONGS_EQUAL(status::StatusOK, codes[j]);
+        CHECK(rp[j] == packets[j]);
+    }
+}
+
+// Default IWriter::write_many() continues after failed packets
+// and reports first failure.
+TEST(concurrent_queue, default_write_many_partial) {
+    FailingWriter writer;
+
+    PacketPtr packets[5];
+    status::StatusCode codes[5];
+
+    for (size_t j = 0; j < ROC_ARRAY_SIZE(packets); j++) {
+        packets[j] = new_packet();
+    }
+
+    LONGS_EQUAL(status::StatusNoSpace,
+                writer.write_many(packets, ROC_ARRAY_SIZE(packets), codes));
+
+    UNSIGNED_LONGS_EQUAL(5, writer.n_calls);
+    UNSIGNED_LONGS_EQUAL(3, writer.n_written);
+
+    LONGS_EQUAL(status::StatusOK, codes[0]);
+    LONGS_EQUAL(status::StatusNoSpace, codes[1]);
+    LONGS_EQUAL(status::StatusOK, codes[2]);
+    LONGS_EQUAL(status::StatusNoSpace, codes[3]);
+    LONGS_EQUAL(status::StatusOK, codes[4]);
+}
+
 } // namespace packet
 } // namespace roc
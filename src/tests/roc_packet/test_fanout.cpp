@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_packet/fanout.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { MaxBufSize = 100, NumPackets = 10 };
+
+core::HeapArena arena;
+PacketFactory packet_factory(arena, MaxBufSize);
+
+// Remembers written packets.
+// Unlike Queue, doesn't link packet into a list, so the same packet
+// may be written to multiple writers.
+class RecordingWriter : public IWriter {
+public:
+    RecordingWriter()
+        : size_(0) {
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    const PacketPtr& get(size_t n) const {
+        CHECK(n < size_);
+        return packets_[n];
+    }
+
+    virtual ROC_ATTR_NODISCARD status::StatusCode write(const PacketPtr& packet) {
+        CHECK(size_ < NumPackets);
+        packets_[size_++] = packet;
+        return status::StatusOK;
+    }
+
+private:
+    PacketPtr packets_[NumPackets];
+    size_t size_;
+};
+
+PacketPtr new_packet() {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+    packet->add_flags(Packet::FlagRTP | Packet::FlagAudio);
+    return packet;
+}
+
+} // namespace
+
+TEST_GROUP(fanout) {};
+
+TEST(fanout, no_outputs) {
+    Fanout fanout(arena);
+
+    PacketPtr p = new_packet();
+
+    LONGS_EQUAL(status::StatusOK, fanout.write(p));
+
+    LONGS_EQUAL(1, p->getref());
+}
+
+TEST(fanout, multiple_outputs) {
+    Fanout fanout(arena);
+
+    RecordingWriter writer1;
+    RecordingWriter writer2;
+    RecordingWriter writer3;
+
+    CHECK(fanout.add_output(writer1));
+    CHECK(fanout.add_output(writer2));
+    CHECK(fanout.add_output(writer3));
+
+    UNSIGNED_LONGS_EQUAL(3, fanout.num_outputs());
+
+    PacketPtr packets[NumPackets];
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet();
+        LONGS_EQUAL(status::StatusOK, fanout.write(packets[n]));
+    }
+
+    RecordingWriter* writers[] = { &writer1, &writer2, &writer3 };
+
+    for (size_t q = 0; q < 3; q++) {
+        UNSIGNED_LONGS_EQUAL(NumPackets, writers[q]->size());
+
+        for (size_t n = 0; n < NumPackets; n++) {
+            CHECK(writers[q]->get(n) == packets[n]);
+        }
+    }
+}
+
+TEST(fanout, remove_output) {
+    Fanout fanout(arena);
+
+    RecordingWriter writer1;
+    RecordingWriter writer2;
+
+    CHECK(fanout.add_output(writer1));
+    CHECK(fanout.add_output(writer2));
+
+    CHECK(fanout.has_output(writer1));
+    CHECK(fanout.has_output(writer2));
+
+    LONGS_EQUAL(status::StatusOK, fanout.write(new_packet()));
+
+    fanout.remove_output(writer1);
+
+    CHECK(!fanout.has_output(writer1));
+    CHECK(fanout.has_output(writer2));
+    UNSIGNED_LONGS_EQUAL(1, fanout.num_outputs());
+
+    LONGS_EQUAL(status::StatusOK, fanout.write(new_packet()));
+
+    UNSIGNED_LONGS_EQUAL(1, writer1.size());
+    UNSIGNED_LONGS_EQUAL(2, writer2.size());
+}
+
+} // namespace packet
+} // namespace roc
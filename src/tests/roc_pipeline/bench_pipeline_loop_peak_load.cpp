@@ -13,6 +13,7 @@
 #include "roc_core/heap_arena.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
 #include "roc_core/ticker.h"
 #include "roc_core/time.h"
 #include "roc_ctl/control_task_executor.h"
@@ -46,6 +47,10 @@ namespace {
 // Bench_NoTasks         - frames without tasks
 // Bench_NoPreciseSched  - frames and tasks, precise task scheduling is disabled
 // Bench_Normal          - frames and tasks, precise task scheduling is enabled
+// Bench_BgLoad          - frames and tasks, plus background threads that
+//                         saturate CPUs, default thread policy
+// Bench_BgLoadRealtime  - same, but frame and control threads use real-time
+//                         scheduler (skipped if not permitted)
 //
 // The first benchmark gives us an idea how the unloaded pipeline operates and
 // what are its normal frame processing timings.
@@ -65,6 +70,11 @@ namespace {
 //    cancellations (sc)
 //  - task processing time (t_avg t_p95) is slightly increased
 //
+// The last two benchmarks show the effect of thread policy under background load.
+// With default policy, frame wakeup delay and jitter (w_avg, w_p95, w_jit, w_max)
+// grow with the load, because frame thread competes for CPU with load threads.
+// With real-time policy, they should stay close to the unloaded case.
+//
 // --------------
 // Output columns
 // --------------
@@ -83,6 +93,12 @@ namespace {
 //                process_subframes_and_tasks() (i.e. delay after frame processing)
 // fa_p95      -  95% percentile of the above
 //
+// w_avg       -  average delay between frame deadline and actual wakeup of frame
+//                thread (i.e. wakeup delay)
+// w_p95       -  95% percentile of the above
+// w_jit       -  standard deviation of the above (i.e. wakeup jitter)
+// w_max       -  maximum of the above
+//
 // t_avg       -  average delay between schedule() and process_task_imp() calls
 //                (i.e. task processing delay)
 // t_p95       -  95% percentile of the above
@@ -120,6 +136,9 @@ const core::nanoseconds_t MaxTaskDelay = core::Millisecond;
 const size_t MinTaskBurst = 1;
 const size_t MaxTaskBurst = 10;
 
+// number of threads that produce background load
+const size_t NumLoadThreads = 8;
+
 core::HeapArena arena;
 
 double round_digits(double x, unsigned int digits) {
@@ -144,6 +163,8 @@ public:
     Counter()
         : last_(0)
         , total_(0)
+        , total_sq_(0)
+        , max_(0)
         , count_(0)
         , warmed_up_(false) {
         memset(buckets_, 0, sizeof(buckets_));
@@ -164,6 +185,10 @@ public:
         }
 
         total_ += t;
+        total_sq_ += double(t) * double(t);
+        if (t > max_) {
+            max_ = t;
+        }
         count_++;
 
         for (int n = NumBuckets; n > 0; n--) {
@@ -179,6 +204,16 @@ public:
         return round_digits(double(total_) / count_ / 1000, 3);
     }
 
+    double stddev() const {
+        const double mean = double(total_) / count_;
+        const double var = total_sq_ / count_ - mean * mean;
+        return round_digits(sqrt(var > 0 ? var : 0) / 1000, 3);
+    }
+
+    double max() const {
+        return round_digits(double(max_) / 1000, 3);
+    }
+
     double p95() const {
         for (int n = 0; n < NumBuckets; n++) {
             const double ratio = double(buckets_[n]) / count_;
@@ -193,6 +228,8 @@ private:
     core::nanoseconds_t last_;
 
     core::nanoseconds_t total_;
+    double total_sq_;
+    core::nanoseconds_t max_;
     size_t count_;
 
     core::nanoseconds_t buckets_[NumBuckets];
@@ -203,6 +240,7 @@ private:
 class DelayStats {
 public:
     void reset() {
+        wakeup_delay_ = Counter();
         task_processing_delay_ = Counter();
         frame_delay_before_processing_ = Counter();
         frame_delay_after_processing_ = Counter();
@@ -212,6 +250,10 @@ public:
         task_processing_delay_.add_time(t);
     }
 
+    void frame_woken(core::nanoseconds_t t) {
+        wakeup_delay_.add_time(t);
+    }
+
     void frame_started() {
         frame_delay_before_processing_.begin();
     }
@@ -229,6 +271,11 @@ public:
     }
 
     void export_counters(benchmark::State& state) {
+        state.counters["w_avg"] = wakeup_delay_.avg();
+        state.counters["w_p95"] = wakeup_delay_.p95();
+        state.counters["w_jit"] = wakeup_delay_.stddev();
+        state.counters["w_max"] = wakeup_delay_.max();
+
         state.counters["t_avg"] = task_processing_delay_.avg();
         state.counters["t_p95"] = task_processing_delay_.p95();
 
@@ -240,6 +287,7 @@ public:
     }
 
 private:
+    Counter wakeup_delay_;
     Counter task_processing_delay_;
     Counter frame_delay_before_processing_;
     Counter frame_delay_after_processing_;
@@ -402,6 +450,45 @@ private:
     core::Atomic<int> stop_;
 };
 
+class LoadThread : public core::Thread {
+public:
+    LoadThread()
+        : stop_(false) {
+    }
+
+    void stop() {
+        stop_ = true;
+    }
+
+private:
+    virtual void run() {
+        while (!stop_) {
+            busy_wait(MaxTaskProcessingDuration);
+        }
+    }
+
+    core::Atomic<int> stop_;
+};
+
+class LoadThreads {
+public:
+    LoadThreads() {
+        for (size_t n = 0; n < NumLoadThreads; n++) {
+            (void)threads_[n].start();
+        }
+    }
+
+    ~LoadThreads() {
+        for (size_t n = 0; n < NumLoadThreads; n++) {
+            threads_[n].stop();
+            threads_[n].join();
+        }
+    }
+
+private:
+    LoadThread threads_[NumLoadThreads];
+};
+
 class FrameWriter {
 public:
     FrameWriter(TestPipeline& pipeline, DelayStats& stats, benchmark::State& state)
@@ -414,6 +501,7 @@ public:
         core::Ticker ticker(SampleRate);
 
         size_t ts = 0;
+        core::nanoseconds_t start_time = 0;
 
         audio::sample_t data[FrameSize];
 
@@ -422,6 +510,13 @@ public:
         while (state_.KeepRunning()) {
             ticker.wait(ts);
 
+            // 1 sample = 1 us
+            const core::nanoseconds_t now = core::timestamp(core::ClockMonotonic);
+            if (ts == 0) {
+                start_time = now;
+            }
+            stats_.frame_woken(now - start_time - core::nanoseconds_t(ts) * 1000);
+
             stats_.frame_started();
 
             pipeline_.process_subframes_and_tasks(frame);
@@ -519,6 +614,77 @@ BENCHMARK(BM_PipelinePeakLoad_PreciseSchedOn)
     ->UseRealTime()
     ->Unit(benchmark::kMicrosecond);
 
+void BM_PipelinePeakLoad_BgLoad(benchmark::State& state) {
+    ctl::ControlTaskQueue control_queue;
+
+    DelayStats stats;
+
+    PipelineLoopConfig config;
+    TestPipeline pipeline(config, control_queue, stats);
+
+    TaskThread task_thr(pipeline);
+
+    FrameWriter frame_wr(pipeline, stats, state);
+
+    LoadThreads load_thrs;
+
+    (void)task_thr.start();
+
+    frame_wr.run();
+
+    task_thr.stop();
+    task_thr.join();
+
+    stats.export_counters(state);
+    pipeline.export_counters(state);
+}
+
+BENCHMARK(BM_PipelinePeakLoad_BgLoad)
+    ->Iterations(NumIterations)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_PipelinePeakLoad_BgLoadRealtime(benchmark::State& state) {
+    core::ThreadPolicy policy;
+    policy.scheduler = core::ThreadSched_Fifo;
+
+    ctl::ControlTaskQueue control_queue(policy);
+
+    DelayStats stats;
+
+    PipelineLoopConfig config;
+    TestPipeline pipeline(config, control_queue, stats);
+
+    TaskThread task_thr(pipeline);
+
+    FrameWriter frame_wr(pipeline, stats, state);
+
+    // New threads inherit scheduler of their creator, so we start task
+    // and load threads before switching frame thread to real-time.
+    LoadThreads load_thrs;
+
+    (void)task_thr.start();
+
+    // Frame thread is the benchmark thread itself. We can't restore its
+    // scheduler afterwards, so this benchmark should be run last.
+    if (core::Thread::apply_policy(policy)) {
+        frame_wr.run();
+    } else {
+        state.SkipWithError("can't apply real-time policy (insufficient privileges?)");
+    }
+
+    task_thr.stop();
+    task_thr.join();
+
+    stats.export_counters(state);
+    pipeline.export_counters(state);
+}
+
+BENCHMARK(BM_PipelinePeakLoad_BgLoadRealtime)
+    ->Iterations(NumIterations)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
 } // namespace
 } // namespace pipeline
 } // namespace roc
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/array.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/slab_pool.h"
+#include "roc_pipeline/chunked_transcoder_sink.h"
+#include "roc_pipeline/transcoder_sink.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum {
+    MaxBufSize = 4000,
+
+    SampleRate = 44100,
+    SignalFreq = 440,
+
+    SamplesPerFrame = 100,
+    NumFrames = 1000,
+
+    MaxTailDiff = 500
+};
+
+const audio::ChannelMask Chans_Mono = audio::ChanMask_Surround_Mono;
+const audio::ChannelMask Chans_Stereo = audio::ChanMask_Surround_Stereo;
+
+const double Epsilon = 0.05;
+
+core::HeapArena arena;
+
+core::SlabPool<core::Buffer> buffer_pool("frame_buffer_pool",
+                                         arena,
+                                         sizeof(core::Buffer)
+                                             + MaxBufSize * sizeof(audio::sample_t));
+
+class CollectingWriter : public audio::IFrameWriter {
+public:
+    CollectingWriter()
+        : samples(arena)
+        , n_frames(0) {
+    }
+
+    virtual void write(audio::Frame& frame) {
+        const size_t pos = samples.size();
+        CHECK(samples.grow_exp(pos + frame.num_raw_samples()));
+        CHECK(samples.resize(pos + frame.num_raw_samples()));
+        memcpy(samples.data() + pos, frame.raw_samples(),
+               frame.num_raw_samples() * sizeof(audio::sample_t));
+        n_frames++;
+    }
+
+    core::Array<audio::sample_t> samples;
+    size_t n_frames;
+};
+
+audio::SampleSpec make_spec(size_t rate, audio::ChannelMask chans) {
+    audio::SampleSpec spec;
+    spec.set_sample_rate(rate);
+    spec.set_sample_format(audio::SampleFormat_Pcm);
+    spec.set_pcm_format(audio::Sample_RawFormat);
+    spec.channel_set().set_layout(audio::ChanLayout_Surround);
+    spec.channel_set().set_order(audio::ChanOrder_Smpte);
+    spec.channel_set().set_mask(chans);
+    return spec;
+}
+
+TranscoderConfig make_config(size_t in_rate,
+                             audio::ChannelMask in_chans,
+                             size_t out_rate,
+                             audio::ChannelMask out_chans) {
+    TranscoderConfig config;
+    config.input_sample_spec = make_spec(in_rate, in_chans);
+    config.output_sample_spec = make_spec(out_rate, out_chans);
+    return config;
+}
+
+ChunkedTranscoderConfig make_chunked_config(size_t num_threads) {
+    ChunkedTranscoderConfig config;
+    config.num_threads = num_threads;
+    config.chunk_length = 100 * core::Millisecond;
+    config.chunk_overlap = 20 * core::Millisecond;
+    config.frame_length = 5 * core::Millisecond;
+    return config;
+}
+
+void write_input(sndio::ISink& sink, const TranscoderConfig& config) {
+    const size_t n_chans = config.input_sample_spec.num_channels();
+
+    audio::sample_t samples[SamplesPerFrame * 2] = {};
+
+    for (size_t nf = 0; nf < NumFrames; nf++) {
+        for (size_t ns = 0; ns < SamplesPerFrame; ns++) {
+            for (size_t nc = 0; nc < n_chans; nc++) {
+                const size_t pos = nf * SamplesPerFrame + ns;
+                samples[ns * n_chans + nc] = (audio::sample_t)sin(
+                    2 * M_PI * (double)pos * SignalFreq / SampleRate + (double)nc);
+            }
+        }
+
+        audio::Frame frame(samples, SamplesPerFrame * n_chans);
+        frame.set_duration(SamplesPerFrame);
+
+        sink.write(frame);
+    }
+}
+
+void transcode_serial(const TranscoderConfig& config, CollectingWriter& output) {
+    TranscoderSink transcoder(config, &output, buffer_pool, arena);
+    CHECK(transcoder.is_valid());
+
+    write_input(transcoder, config);
+}
+
+void transcode_chunked(const TranscoderConfig& config,
+                       const ChunkedTranscoderConfig& chunked_config,
+                       CollectingWriter& output) {
+    ChunkedTranscoderSink transcoder(config, chunked_config, &output, buffer_pool,
+                                     arena);
+    CHECK(transcoder.is_valid());
+
+    write_input(transcoder, config);
+
+    CHECK(transcoder.flush());
+}
+
+} // namespace
+
+TEST_GROUP(chunked_transcoder_sink) {};
+
+TEST(chunked_transcoder_sink, channel_mapping) {
+    const TranscoderConfig config =
+        make_config(44100, Chans_Mono, 44100, Chans_Stereo);
+
+    for (size_t n_threads = 1; n_threads <= 4; n_threads++) {
+        CollectingWriter serial_output;
+        transcode_serial(config, serial_output);
+
+        CollectingWriter chunked_output;
+        transcode_chunked(config, make_chunked_config(n_threads), chunked_output);
+
+        UNSIGNED_LONGS_EQUAL(NumFrames * SamplesPerFrame * 2,
+                             serial_output.samples.size());
+        UNSIGNED_LONGS_EQUAL(serial_output.samples.size(),
+                             chunked_output.samples.size());
+
+        for (size_t n = 0; n < serial_output.samples.size(); n++) {
+            DOUBLES_EQUAL(serial_output.samples[n], chunked_output.samples[n], 0);
+        }
+    }
+}
+
+TEST(chunked_transcoder_sink, resampling) {
+    const TranscoderConfig config =
+        make_config(44100, Chans_Stereo, 48000, Chans_Stereo);
+
+    for (size_t n_threads = 1; n_threads <= 4; n_threads++) {
+        CollectingWriter serial_output;
+        transcode_serial(config, serial_output);
+
+        CollectingWriter chunked_output;
+        transcode_chunked(config, make_chunked_config(n_threads), chunked_output);
+
+        // Resampler may keep different number of samples at the very end
+        // of the stream, depending on where the last chunk starts.
+        const size_t n_samples =
+            std::min(serial_output.samples.size(), chunked_output.samples.size());
+
+        CHECK(n_samples > 0);
+        CHECK(std::max(serial_output.samples.size(), chunked_output.samples.size())
+                  - n_samples
+              < MaxTailDiff);
+
+        // Chunks are aligned in time with serial output, but resampler output
+        // differs slightly depending on fractional position.
+        for (size_t n = 0; n < n_samples; n++) {
+            DOUBLES_EQUAL(serial_output.samples[n], chunked_output.samples[n],
+                          Epsilon);
+        }
+    }
+}
+
+TEST(chunked_transcoder_sink, frame_size) {
+    const TranscoderConfig config =
+        make_config(44100, Chans_Stereo, 44100, Chans_Stereo);
+
+    const ChunkedTranscoderConfig chunked_config = make_chunked_config(2);
+
+    CollectingWriter output;
+    transcode_chunked(config, chunked_config, output);
+
+    const size_t out_frame_size =
+        config.output_sample_spec.ns_2_samples_overall(chunked_config.frame_length);
+
+    UNSIGNED_LONGS_EQUAL(NumFrames * SamplesPerFrame * 2, output.samples.size());
+    CHECK(output.n_frames >= output.samples.size() / out_frame_size);
+}
+
+TEST(chunked_transcoder_sink, invalid_config) {
+    const TranscoderConfig config =
+        make_config(44100, Chans_Stereo, 48000, Chans_Stereo);
+
+    {
+        ChunkedTranscoderConfig chunked_config = make_chunked_config(0);
+
+        ChunkedTranscoderSink transcoder(config, chunked_config, NULL, buffer_pool,
+                                         arena);
+        CHECK(!transcoder.is_valid());
+    }
+    {
+        ChunkedTranscoderConfig chunked_config = make_chunked_config(2);
+        chunked_config.chunk_overlap = chunked_config.chunk_length * 2;
+
+        ChunkedTranscoderSink transcoder(config, chunked_config, NULL, buffer_pool,
+                                         arena);
+        CHECK(!transcoder.is_valid());
+    }
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -98,6 +98,42 @@ public:
         return false;
     }
 
+    bool has_bye(packet::stream_source_t from = 0) const {
+        CHECK(packet_);
+        CHECK(packet_->rtcp());
+
+        rtcp::Traverser traverser(packet_->rtcp()->payload);
+        CHECK(traverser.parse());
+
+        rtcp::Traverser::Iterator iter = traverser.iter();
+        rtcp::Traverser::Iterator::State state;
+
+        while ((state = iter.next()) != rtcp::Traverser::Iterator::END) {
+            switch (state) {
+            case rtcp::Traverser::Iterator::BYE: {
+                rtcp::ByeTraverser bye = iter.get_bye();
+                CHECK(bye.parse());
+
+                rtcp::ByeTraverser::Iterator bye_iter = bye.iter();
+                rtcp::ByeTraverser::Iterator::State bye_state;
+
+                while ((bye_state = bye_iter.next())
+                       != rtcp::ByeTraverser::Iterator::END) {
+                    if (bye_state == rtcp::ByeTraverser::Iterator::SSRC
+                        && (bye_iter.get_ssrc() == from || from == 0)) {
+                        return true;
+                    }
+                }
+            } break;
+
+            default:
+                break;
+            }
+        }
+
+        return false;
+    }
+
     bool has_rr(packet::stream_source_t from = 0, packet::stream_source_t to = 0) const {
         CHECK(packet_);
         CHECK(packet_->rtcp());
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_pipeline/metrics_snapshot.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum {
+    MaxParties = ReceiverMetricsSnapshot::MaxParticipants,
+    ManyParties = MaxParties + 5
+};
+
+void fill_metrics(ReceiverSlotMetrics& slot_metrics,
+                  ReceiverParticipantMetrics* party_metrics,
+                  size_t party_count) {
+    slot_metrics.source_id = 123;
+    slot_metrics.num_participants = party_count;
+
+    for (size_t n = 0; n < party_count; n++) {
+        party_metrics[n].link.total_packets = n + 1;
+        party_metrics[n].latency.niq_latency = core::nanoseconds_t(n + 1);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(metrics_snapshot) {};
+
+TEST(metrics_snapshot, empty) {
+    ReceiverMetricsSnapshot snapshot;
+
+    ReceiverSlotMetrics slot_metrics;
+    ReceiverParticipantMetrics party_metrics[MaxParties];
+    size_t party_count = MaxParties;
+
+    CHECK(snapshot.load(slot_metrics, party_metrics, &party_count));
+
+    UNSIGNED_LONGS_EQUAL(0, slot_metrics.source_id);
+    UNSIGNED_LONGS_EQUAL(0, slot_metrics.num_participants);
+    UNSIGNED_LONGS_EQUAL(0, party_count);
+}
+
+TEST(metrics_snapshot, store_load) {
+    ReceiverMetricsSnapshot snapshot;
+
+    ReceiverSlotMetrics in_slot;
+    ReceiverParticipantMetrics in_party[3];
+    fill_metrics(in_slot, in_party, 3);
+
+    snapshot.store(in_slot, in_party, 3);
+
+    { // request all
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_count = MaxParties;
+
+        CHECK(snapshot.load(slot_metrics, party_metrics, &party_count));
+
+        UNSIGNED_LONGS_EQUAL(123, slot_metrics.source_id);
+        UNSIGNED_LONGS_EQUAL(3, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(3, party_count);
+
+        for (size_t n = 0; n < party_count; n++) {
+            UNSIGNED_LONGS_EQUAL(n + 1, party_metrics[n].link.total_packets);
+            LONGS_EQUAL(n + 1, party_metrics[n].latency.niq_latency);
+        }
+    }
+    { // request less
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[2];
+        size_t party_count = 2;
+
+        CHECK(snapshot.load(slot_metrics, party_metrics, &party_count));
+
+        UNSIGNED_LONGS_EQUAL(3, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(2, party_count);
+    }
+    { // request only slot
+        ReceiverSlotMetrics slot_metrics;
+        size_t party_count = 2;
+
+        CHECK(snapshot.load(slot_metrics, NULL, &party_count));
+
+        UNSIGNED_LONGS_EQUAL(123, slot_metrics.source_id);
+        UNSIGNED_LONGS_EQUAL(0, party_count);
+    }
+}
+
+TEST(metrics_snapshot, overflow) {
+    ReceiverMetricsSnapshot snapshot;
+
+    ReceiverSlotMetrics in_slot;
+    ReceiverParticipantMetrics in_party[ManyParties];
+    fill_metrics(in_slot, in_party, ManyParties);
+
+    snapshot.store(in_slot, in_party, ManyParties);
+
+    { // request fits into snapshot
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_count = MaxParties;
+
+        CHECK(snapshot.load(slot_metrics, party_metrics, &party_count));
+
+        UNSIGNED_LONGS_EQUAL(ManyParties, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(MaxParties, party_count);
+    }
+    { // request doesn't fit into snapshot
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[ManyParties];
+        size_t party_count = ManyParties;
+
+        CHECK(!snapshot.load(slot_metrics, party_metrics, &party_count));
+
+        UNSIGNED_LONGS_EQUAL(ManyParties, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(MaxParties, party_count);
+    }
+}
+
+TEST(metrics_snapshot, read_flag) {
+    ReceiverMetricsSnapshot snapshot;
+
+    ReceiverSlotMetrics slot_metrics;
+    ReceiverParticipantMetrics party_metrics[MaxParties];
+    size_t party_count = MaxParties;
+
+    // initially set, so that first publish is complete
+    CHECK(snapshot.check_and_clear_read());
+    CHECK(!snapshot.check_and_clear_read());
+
+    // store doesn't set flag
+    snapshot.store(slot_metrics, party_metrics, 0);
+    CHECK(!snapshot.check_and_clear_read());
+
+    // load sets flag
+    CHECK(snapshot.load(slot_metrics, party_metrics, &party_count));
+    CHECK(snapshot.check_and_clear_read());
+    CHECK(!snapshot.check_and_clear_read());
+}
+
+} // namespace pipeline
+} // namespace roc
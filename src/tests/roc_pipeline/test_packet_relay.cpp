@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/packet_writer.h"
+
+#include "roc_address/interface.h"
+#include "roc_address/protocol.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/slab_pool.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/parser.h"
+#include "roc_packet/queue.h"
+#include "roc_pipeline/packet_relay.h"
+#include "roc_rtp/encoding_map.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+const rtp::PayloadType PayloadType = rtp::PayloadType_L16_Stereo;
+
+enum {
+    MaxBufSize = 1000,
+
+    SampleRate = 44100,
+    SamplesPerPacket = 40,
+
+    SourcePackets = 10,
+    RepairPackets = 5,
+
+    NumPackets = SourcePackets * 5
+};
+
+core::HeapArena arena;
+
+core::SlabPool<packet::Packet> packet_pool("packet_pool", arena);
+core::SlabPool<core::Buffer>
+    packet_buffer_pool("packet_buffer_pool", arena, sizeof(core::Buffer) + MaxBufSize);
+
+packet::PacketFactory packet_factory(packet_pool, packet_buffer_pool);
+
+rtp::EncodingMap encoding_map(arena);
+
+audio::SampleSpec sample_spec(SampleRate,
+                              audio::Sample_RawFormat,
+                              audio::ChanLayout_Surround,
+                              audio::ChanOrder_Smpte,
+                              audio::ChanMask_Surround_Stereo);
+
+address::SocketAddr new_address(int port) {
+    address::SocketAddr addr;
+    CHECK(addr.set_host_port(address::Family_IPv4, "127.0.0.1", port));
+    return addr;
+}
+
+RelayOutput* create_output(PacketRelay& relay,
+                           address::Interface iface,
+                           address::Protocol proto,
+                           const address::SocketAddr& dst_addr,
+                           packet::IWriter& writer) {
+    RelayOutput* output = relay.create_output();
+    CHECK(output);
+    CHECK(relay.add_output_endpoint(output, iface, proto, dst_addr, writer));
+    return output;
+}
+
+// Reads packets sent by relay output and checks that they
+// form a valid RTP stream.
+void check_source_packets(packet::IReader& reader,
+                          const address::SocketAddr& dst_addr,
+                          size_t num_packets,
+                          packet::stream_source_t* source_id) {
+    rtp::Parser rtp_parser(encoding_map, NULL);
+
+    packet::seqnum_t first_sn = 0;
+    packet::stream_timestamp_t first_ts = 0;
+
+    for (size_t n = 0; n < num_packets; n++) {
+        packet::PacketPtr pp;
+        LONGS_EQUAL(status::StatusOK, reader.read(pp));
+        CHECK(pp);
+
+        CHECK(pp->has_flags(packet::Packet::FlagUDP));
+        CHECK(pp->udp()->dst_addr == dst_addr);
+
+        packet::PacketPtr parsed = packet_factory.new_packet();
+        CHECK(parsed);
+        CHECK(rtp_parser.parse(*parsed, pp->buffer()));
+
+        LONGS_EQUAL(PayloadType, parsed->rtp()->payload_type);
+
+        if (n == 0) {
+            *source_id = parsed->rtp()->source_id;
+            first_sn = parsed->rtp()->seqnum;
+            first_ts = parsed->rtp()->stream_timestamp;
+        } else {
+            UNSIGNED_LONGS_EQUAL(*source_id, parsed->rtp()->source_id);
+            UNSIGNED_LONGS_EQUAL(packet::seqnum_t(first_sn + n), parsed->rtp()->seqnum);
+            UNSIGNED_LONGS_EQUAL(
+                packet::stream_timestamp_t(first_ts + n * SamplesPerPacket),
+                parsed->rtp()->stream_timestamp);
+        }
+    }
+
+    packet::PacketPtr pp;
+    LONGS_EQUAL(status::StatusNoData, reader.read(pp));
+}
+
+} // namespace
+
+TEST_GROUP(packet_relay) {
+    RelayConfig config;
+
+    void setup() {
+        config.rtcp.report_interval = core::Second;
+    }
+};
+
+TEST(packet_relay, no_outputs) {
+    PacketRelay relay(config, encoding_map, packet_pool, packet_buffer_pool, arena);
+    CHECK(relay.is_valid());
+
+    const address::SocketAddr src_addr = new_address(1);
+    const address::SocketAddr inbound_addr = new_address(2);
+
+    RelayEndpoint* endpoint = relay.add_input_endpoint(
+        address::Iface_AudioSource, address::Proto_RTP, inbound_addr, NULL);
+    CHECK(endpoint);
+
+    test::PacketWriter packet_writer(arena, endpoint->inbound_writer(), encoding_map,
+                                     packet_factory, 111, src_addr, inbound_addr,
+                                     PayloadType);
+
+    packet_writer.write_packets(NumPackets, SamplesPerPacket, sample_spec);
+
+    relay.refresh(0);
+
+    UNSIGNED_LONGS_EQUAL(0, relay.num_outputs());
+}
+
+TEST(packet_relay, rtp_multiple_outputs) {
+    enum { NumOutputs = 3 };
+
+    PacketRelay relay(config, encoding_map, packet_pool, packet_buffer_pool, arena);
+    CHECK(relay.is_valid());
+
+    const address::SocketAddr src_addr = new_address(1);
+    const address::SocketAddr inbound_addr = new_address(2);
+
+    RelayEndpoint* endpoint = relay.add_input_endpoint(
+        address::Iface_AudioSource, address::Proto_RTP, inbound_addr, NULL);
+    CHECK(endpoint);
+
+    packet::Queue queues[NumOutputs];
+    address::SocketAddr dst_addrs[NumOutputs];
+
+    for (size_t n = 0; n < NumOutputs; n++) {
+        dst_addrs[n] = new_address(int(10 + n));
+        create_output(relay, address::Iface_AudioSource, address::Proto_RTP,
+                      dst_addrs[n], queues[n]);
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumOutputs, relay.num_outputs());
+
+    test::PacketWriter packet_writer(arena, endpoint->inbound_writer(), encoding_map,
+                                     packet_factory, 111, src_addr, inbound_addr,
+                                     PayloadType);
+
+    packet_writer.write_packets(NumPackets, SamplesPerPacket, sample_spec);
+
+    relay.refresh(0);
+
+    packet::stream_source_t source_ids[NumOutputs];
+
+    for (size_t n = 0; n < NumOutputs; n++) {
+        check_source_packets(queues[n], dst_addrs[n], NumPackets, &source_ids[n]);
+    }
+
+    // Every output has its own RTP stream.
+    for (size_t n = 0; n < NumOutputs; n++) {
+        CHECK(source_ids[n] != 111);
+        for (size_t m = n + 1; m < NumOutputs; m++) {
+            CHECK(source_ids[n] != source_ids[m]);
+        }
+    }
+}
+
+TEST(packet_relay, rtp_delete_output) {
+    PacketRelay relay(config, encoding_map, packet_pool, packet_buffer_pool, arena);
+    CHECK(relay.is_valid());
+
+    const address::SocketAddr src_addr = new_address(1);
+    const address::SocketAddr inbound_addr = new_address(2);
+    const address::SocketAddr dst_addr1 = new_address(10);
+    const address::SocketAddr dst_addr2 = new_address(11);
+
+    RelayEndpoint* endpoint = relay.add_input_endpoint(
+        address::Iface_AudioSource, address::Proto_RTP, inbound_addr, NULL);
+    CHECK(endpoint);
+
+    packet::Queue queue1;
+    packet::Queue queue2;
+
+    RelayOutput* output1 = create_output(relay, address::Iface_AudioSource,
+                                         address::Proto_RTP, dst_addr1, queue1);
+    create_output(relay, address::Iface_AudioSource, address::Proto_RTP, dst_addr2,
+                  queue2);
+
+    test::PacketWriter packet_writer(arena, endpoint->inbound_writer(), encoding_map,
+                                     packet_factory, 111, src_addr, inbound_addr,
+                                     PayloadType);
+
+    packet_writer.write_packets(NumPackets, SamplesPerPacket, sample_spec);
+    relay.refresh(0);
+
+    relay.delete_output(output1);
+    UNSIGNED_LONGS_EQUAL(1, relay.num_outputs());
+
+    packet_writer.write_packets(NumPackets, SamplesPerPacket, sample_spec);
+    relay.refresh(0);
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, queue1.size());
+    UNSIGNED_LONGS_EQUAL(NumPackets * 2, queue2.size());
+}
+
+TEST(packet_relay, protocol_mismatch) {
+    PacketRelay relay(config, encoding_map, packet_pool, packet_buffer_pool, arena);
+    CHECK(relay.is_valid());
+
+    const address::SocketAddr inbound_addr = new_address(2);
+    const address::SocketAddr dst_addr = new_address(10);
+
+    packet::Queue queue;
+
+    RelayOutput* output = relay.create_output();
+    CHECK(output);
+
+    // Input is not bound yet.
+    CHECK(!relay.add_output_endpoint(output, address::Iface_AudioSource,
+                                     address::Proto_RTP, dst_addr, queue));
+
+    CHECK(relay.add_input_endpoint(address::Iface_AudioSource, address::Proto_RTP,
+                                   inbound_addr, NULL));
+
+    // Output uses different protocol.
+    CHECK(!relay.add_output_endpoint(output, address::Iface_AudioSource,
+                                     address::Proto_RTP_RS8M_Source, dst_addr, queue));
+
+    CHECK(relay.add_output_endpoint(output, address::Iface_AudioSource,
+                                    address::Proto_RTP, dst_addr, queue));
+}
+
+TEST(packet_relay, fec_forwarded_as_is) {
+    if (!fec::CodecMap::instance().is_supported(packet::FEC_ReedSolomon_M8)) {
+        return;
+    }
+
+    PacketRelay relay(config, encoding_map, packet_pool, packet_buffer_pool, arena);
+    CHECK(relay.is_valid());
+
+    const address::SocketAddr src_addr = new_address(1);
+    const address::SocketAddr source_inbound_addr = new_address(2);
+    const address::SocketAddr repair_inbound_addr = new_address(3);
+    const address::SocketAddr source_dst_addr = new_address(10);
+    const address::SocketAddr repair_dst_addr = new_address(11);
+
+    RelayEndpoint* source_endpoint =
+        relay.add_input_endpoint(address::Iface_AudioSource,
+                                 address::Proto_RTP_RS8M_Source, source_inbound_addr, NULL);
+    CHECK(source_endpoint);
+
+    RelayEndpoint* repair_endpoint =
+        relay.add_input_endpoint(address::Iface_AudioRepair, address::Proto_RS8M_Repair,
+                                 repair_inbound_addr, NULL);
+    CHECK(repair_endpoint);
+
+    packet::Queue source_queue;
+    packet::Queue repair_queue;
+
+    RelayOutput* output = create_output(relay, address::Iface_AudioSource,
+                                        address::Proto_RTP_RS8M_Source, source_dst_addr,
+                                        source_queue);
+    CHECK(relay.add_output_endpoint(output, address::Iface_AudioRepair,
+                                    address::Proto_RS8M_Repair, repair_dst_addr,
+                                    repair_queue));
+
+    fec::WriterConfig fec_config;
+    fec_config.n_source_packets = SourcePackets;
+    fec_config.n_repair_packets = RepairPackets;
+
+    test::PacketWriter packet_writer(
+        arena, source_endpoint->inbound_writer(), repair_endpoint->inbound_writer(),
+        encoding_map, packet_factory, 111, src_addr, source_inbound_addr,
+        repair_inbound_addr, PayloadType, packet::FEC_ReedSolomon_M8, fec_config);
+
+    packet_writer.write_packets(NumPackets, SamplesPerPacket, sample_spec);
+
+    relay.refresh(0);
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, source_queue.size());
+    UNSIGNED_LONGS_EQUAL(NumPackets / SourcePackets * RepairPackets,
+                         repair_queue.size());
+
+    rtp::Parser rtp_parser(encoding_map, NULL);
+    fec::Parser<fec::RS8M_PayloadID, fec::Source, fec::Footer> source_parser(
+        &rtp_parser);
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        packet::PacketPtr pp;
+        LONGS_EQUAL(status::StatusOK, source_queue.read(pp));
+        CHECK(pp->udp()->dst_addr == source_dst_addr);
+
+        packet::PacketPtr parsed = packet_factory.new_packet();
+        CHECK(parsed);
+        CHECK(source_parser.parse(*parsed, pp->buffer()));
+
+        // Headers are not rewritten, because repair packets depend on them.
+        UNSIGNED_LONGS_EQUAL(111, parsed->rtp()->source_id);
+        UNSIGNED_LONGS_EQUAL(n, parsed->rtp()->seqnum);
+    }
+
+    for (size_t n = 0; n < NumPackets / SourcePackets * RepairPackets; n++) {
+        packet::PacketPtr pp;
+        LONGS_EQUAL(status::StatusOK, repair_queue.read(pp));
+        CHECK(pp->udp()->dst_addr == repair_dst_addr);
+    }
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -167,5 +167,48 @@ TEST(receiver_loop, endpoints_async) {
     scheduler.wait_done();
 }
 
+TEST(receiver_loop, read_slot_metrics) {
+    ReceiverLoop receiver(scheduler, config, encoding_map, packet_pool,
+                          packet_buffer_pool, frame_buffer_pool, arena);
+
+    CHECK(receiver.is_valid());
+
+    ReceiverLoop::SlotHandle slot = NULL;
+
+    {
+        ReceiverSlotConfig config;
+        ReceiverLoop::Tasks::CreateSlot task(config);
+        CHECK(receiver.schedule_and_wait(task));
+        CHECK(task.success());
+
+        slot = task.get_handle();
+    }
+
+    { // metrics are published after task, without frames
+        ReceiverSlotMetrics query_metrics;
+        ReceiverLoop::Tasks::QuerySlot task(slot, query_metrics, NULL, NULL);
+        CHECK(receiver.schedule_and_wait(task));
+        CHECK(task.success());
+
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[2];
+        size_t party_metrics_size = 2;
+
+        CHECK(receiver.read_slot_metrics(slot, slot_metrics, party_metrics,
+                                         &party_metrics_size));
+
+        CHECK(slot_metrics.source_id != 0);
+        UNSIGNED_LONGS_EQUAL(query_metrics.source_id, slot_metrics.source_id);
+        UNSIGNED_LONGS_EQUAL(0, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(0, party_metrics_size);
+    }
+
+    {
+        ReceiverLoop::Tasks::DeleteSlot task(slot);
+        CHECK(receiver.schedule_and_wait(task));
+        CHECK(task.success());
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
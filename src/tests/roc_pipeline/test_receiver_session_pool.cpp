@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/time.h"
+#include "roc_pipeline/receiver_session_pool.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum { MaxBufSize = 500, PoolSize = 3 };
+
+core::HeapArena arena;
+core::SlabPool<packet::Packet> packet_pool("packet_pool", arena);
+core::SlabPool<core::Buffer>
+    packet_buffer_pool("packet_buffer_pool", arena, sizeof(core::Buffer) + MaxBufSize);
+core::SlabPool<core::Buffer>
+    frame_buffer_pool("frame_buffer_pool",
+                      arena,
+                      sizeof(core::Buffer) + MaxBufSize * sizeof(audio::sample_t));
+
+packet::PacketFactory packet_factory(packet_pool, packet_buffer_pool);
+audio::FrameFactory frame_factory(frame_buffer_pool);
+
+rtp::EncodingMap encoding_map(arena);
+
+ReceiverSourceConfig make_config() {
+    ReceiverSourceConfig config;
+
+    config.common.output_sample_spec.set_sample_rate(44100);
+    config.common.output_sample_spec.set_sample_format(audio::SampleFormat_Pcm);
+    config.common.output_sample_spec.set_pcm_format(audio::Sample_RawFormat);
+    config.common.output_sample_spec.channel_set().set_layout(audio::ChanLayout_Surround);
+    config.common.output_sample_spec.channel_set().set_order(audio::ChanOrder_Smpte);
+    config.common.output_sample_spec.channel_set().set_mask(
+        audio::ChanMask_Surround_Stereo);
+
+    config.common.enable_timing = false;
+
+    config.deduce_defaults();
+
+    return config;
+}
+
+ReceiverSessionConfig make_session_config(const ReceiverSourceConfig& source_config,
+                                          unsigned int payload_type) {
+    ReceiverSessionConfig session_config = source_config.session_defaults;
+    session_config.payload_type = payload_type;
+    return session_config;
+}
+
+void wait_spare(ReceiverSessionPool& pool, size_t n_spare) {
+    while (pool.num_spare() != n_spare) {
+        core::sleep_for(core::ClockMonotonic, core::Microsecond * 100);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(receiver_session_pool) {};
+
+TEST(receiver_session_pool, acquire_release) {
+    const ReceiverSourceConfig config = make_config();
+    const ReceiverSessionConfig session_config =
+        make_session_config(config, rtp::PayloadType_L16_Stereo);
+
+    ReceiverSessionPool pool(PoolSize, config.common, encoding_map, packet_factory,
+                             frame_factory, NULL, arena);
+    CHECK(pool.start());
+
+    // first request only tells pool what to prepare
+    CHECK(!pool.acquire(session_config));
+
+    wait_spare(pool, PoolSize);
+
+    core::SharedPtr<ReceiverSession> session = pool.acquire(session_config);
+    CHECK(session);
+    CHECK(session->is_valid());
+
+    // taken session is replaced
+    wait_spare(pool, PoolSize);
+
+    pool.release(session);
+    session = NULL;
+
+    pool.stop();
+    pool.join();
+}
+
+TEST(receiver_session_pool, config_change) {
+    const ReceiverSourceConfig config = make_config();
+    const ReceiverSessionConfig session_config1 =
+        make_session_config(config, rtp::PayloadType_L16_Stereo);
+    const ReceiverSessionConfig session_config2 =
+        make_session_config(config, rtp::PayloadType_L16_Mono);
+
+    ReceiverSessionPool pool(PoolSize, config.common, encoding_map, packet_factory,
+                             frame_factory, NULL, arena);
+    CHECK(pool.start());
+
+    CHECK(!pool.acquire(session_config1));
+    wait_spare(pool, PoolSize);
+
+    // spares for other payload type are not used and are discarded
+    CHECK(!pool.acquire(session_config2));
+    wait_spare(pool, PoolSize);
+
+    core::SharedPtr<ReceiverSession> session = pool.acquire(session_config2);
+    CHECK(session);
+    CHECK(session->is_valid());
+
+    pool.release(session);
+    session = NULL;
+
+    pool.stop();
+    pool.join();
+}
+
+TEST(receiver_session_pool, invalid_config) {
+    const ReceiverSourceConfig config = make_config();
+    const ReceiverSessionConfig session_config = make_session_config(config, 123);
+
+    ReceiverSessionPool pool(PoolSize, config.common, encoding_map, packet_factory,
+                             frame_factory, NULL, arena);
+    CHECK(pool.start());
+
+    // pool doesn't retry failed configuration in loop
+    CHECK(!pool.acquire(session_config));
+    core::sleep_for(core::ClockMonotonic, core::Millisecond * 10);
+
+    UNSIGNED_LONGS_EQUAL(0, pool.num_spare());
+    CHECK(!pool.acquire(session_config));
+
+    pool.stop();
+    pool.join();
+}
+
+} // namespace pipeline
+} // namespace roc
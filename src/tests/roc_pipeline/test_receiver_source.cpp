@@ -829,6 +829,90 @@ TEST(receiver_source, two_sessions_two_endpoints) {
     }
 }
 
+TEST(receiver_source, parallel_sessions) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo, NumThreads = 2 };
+
+    init(Rate, Chans, Rate, Chans);
+
+    ReceiverSourceConfig config = make_default_config();
+    config.common.session_threads = NumThreads;
+
+    ReceiverSource receiver(config, encoding_map, packet_pool, packet_buffer_pool,
+                            frame_buffer_pool, arena);
+    CHECK(receiver.is_valid());
+
+    ReceiverSlot* slot1 = create_slot(receiver);
+    CHECK(slot1);
+
+    packet::IWriter* endpoint1_writer =
+        create_transport_endpoint(slot1, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint1_writer);
+
+    ReceiverSlot* slot2 = create_slot(receiver);
+    CHECK(slot2);
+
+    packet::IWriter* endpoint2_writer =
+        create_transport_endpoint(slot2, address::Iface_AudioSource, proto2, dst_addr2);
+    CHECK(endpoint2_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    // Two sessions in first slot and one session in second slot.
+    test::PacketWriter packet_writer1(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr1,
+                                      PayloadType_Ch2);
+
+    test::PacketWriter packet_writer2(arena, *endpoint1_writer, encoding_map,
+                                      packet_factory, src_id2, src_addr2, dst_addr1,
+                                      PayloadType_Ch2);
+
+    test::PacketWriter packet_writer3(arena, *endpoint2_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr2,
+                                      PayloadType_Ch2);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer3.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 3, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(3, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer3.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    // Stop one session and wait until it's removed.
+    while (receiver.num_sessions() != 2) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_any_samples(SamplesPerFrame, output_sample_spec);
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer3.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            receiver.refresh(frame_reader.refresh_ts());
+            frame_reader.read_nonzero_samples(SamplesPerFrame, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer3.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+}
+
 TEST(receiver_source, two_sessions_same_address_same_stream) {
     enum { Rate = SampleRate, Chans = Chans_Stereo };
 
@@ -2913,5 +2997,80 @@ TEST(receiver_source, pipeline_state) {
     }
 }
 
+// Check per-stage timing metrics.
+TEST(receiver_source, metrics_stage_timing) {
+    enum {
+        Rate = SampleRate,
+        OutputChans = Chans_Stereo,
+        PacketChans = Chans_Mono,
+        MaxParties = 10
+    };
+
+    init(Rate, OutputChans, Rate, PacketChans);
+
+    for (int enable = 0; enable <= 1; enable++) {
+        ReceiverSourceConfig config = make_default_config();
+        config.common.enable_stage_timing = enable;
+
+        ReceiverSource receiver(config, encoding_map, packet_pool, packet_buffer_pool,
+                                frame_buffer_pool, arena);
+        CHECK(receiver.is_valid());
+
+        ReceiverSlot* slot = create_slot(receiver);
+        CHECK(slot);
+
+        packet::IWriter* endpoint1_writer = create_transport_endpoint(
+            slot, address::Iface_AudioSource, proto1, dst_addr1);
+        CHECK(endpoint1_writer);
+
+        test::FrameReader frame_reader(receiver, frame_factory);
+
+        test::PacketWriter packet_writer(arena, *endpoint1_writer, encoding_map,
+                                         packet_factory, src_id1, src_addr1, dst_addr1,
+                                         PayloadType_Ch1);
+
+        packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                    packet_sample_spec);
+
+        for (size_t np = 0; np < ManyPackets; np++) {
+            for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+                receiver.refresh(frame_reader.refresh_ts());
+                frame_reader.read_samples(SamplesPerFrame, 1, output_sample_spec);
+            }
+
+            packet_writer.write_packets(1, SamplesPerPacket, packet_sample_spec);
+        }
+
+        ReceiverSlotMetrics slot_metrics;
+        ReceiverParticipantMetrics party_metrics[MaxParties];
+        size_t party_metrics_size = MaxParties;
+
+        slot->get_metrics(slot_metrics, party_metrics, &party_metrics_size);
+
+        UNSIGNED_LONGS_EQUAL(1, party_metrics_size);
+
+        if (enable) {
+            UNSIGNED_LONGS_EQUAL(ManyPackets * FramesPerPacket,
+                                 slot_metrics.mixer_timing.count);
+            CHECK(slot_metrics.mixer_timing.max >= slot_metrics.mixer_timing.p50);
+
+            UNSIGNED_LONGS_EQUAL(ManyPackets * FramesPerPacket,
+                                 party_metrics[0].channel_mapper_timing.count);
+            CHECK(party_metrics[0].depacketizer_timing.count > 0);
+            CHECK(party_metrics[0].depacketizer_timing.max > 0);
+            CHECK(party_metrics[0].depacketizer_timing.max
+                  >= party_metrics[0].depacketizer_timing.p99);
+
+            // no resampler and no fec
+            UNSIGNED_LONGS_EQUAL(0, party_metrics[0].resampler_timing.count);
+            UNSIGNED_LONGS_EQUAL(0, party_metrics[0].fec_reader_timing.count);
+        } else {
+            UNSIGNED_LONGS_EQUAL(0, slot_metrics.mixer_timing.count);
+            UNSIGNED_LONGS_EQUAL(0, party_metrics[0].channel_mapper_timing.count);
+            UNSIGNED_LONGS_EQUAL(0, party_metrics[0].depacketizer_timing.count);
+        }
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
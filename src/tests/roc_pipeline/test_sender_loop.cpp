@@ -169,5 +169,67 @@ TEST(sender_loop, endpoints_async) {
     scheduler.wait_done();
 }
 
+TEST(sender_loop, read_slot_metrics) {
+    SenderLoop sender(scheduler, config, encoding_map, packet_pool, packet_buffer_pool,
+                      frame_buffer_pool, arena);
+    CHECK(sender.is_valid());
+
+    SenderLoop::SlotHandle slot = NULL;
+
+    address::SocketAddr outbound_address;
+    packet::Queue outbound_writer;
+
+    {
+        SenderSlotConfig config;
+        SenderLoop::Tasks::CreateSlot task(config);
+        CHECK(sender.schedule_and_wait(task));
+        CHECK(task.success());
+
+        slot = task.get_handle();
+    }
+
+    { // metrics are published after task, without frames
+        SenderSlotMetrics slot_metrics;
+        SenderParticipantMetrics party_metrics[2];
+        size_t party_metrics_size = 2;
+
+        CHECK(sender.read_slot_metrics(slot, slot_metrics, party_metrics,
+                                       &party_metrics_size));
+
+        CHECK(slot_metrics.source_id != 0);
+        CHECK(!slot_metrics.is_complete);
+        UNSIGNED_LONGS_EQUAL(0, party_metrics_size);
+    }
+
+    {
+        SenderLoop::Tasks::AddEndpoint task(slot, address::Iface_AudioSource,
+                                            address::Proto_RTP, outbound_address,
+                                            outbound_writer);
+        CHECK(sender.schedule_and_wait(task));
+        CHECK(task.success());
+    }
+
+    { // snapshot matches metrics queried from pipeline
+        SenderSlotMetrics query_metrics;
+        SenderLoop::Tasks::QuerySlot task(slot, query_metrics, NULL, NULL);
+        CHECK(sender.schedule_and_wait(task));
+        CHECK(task.success());
+
+        SenderSlotMetrics slot_metrics;
+        CHECK(sender.read_slot_metrics(slot, slot_metrics, NULL, NULL));
+
+        CHECK(slot_metrics.is_complete);
+        UNSIGNED_LONGS_EQUAL(query_metrics.source_id, slot_metrics.source_id);
+        UNSIGNED_LONGS_EQUAL(query_metrics.num_participants,
+                             slot_metrics.num_participants);
+    }
+
+    {
+        SenderLoop::Tasks::DeleteSlot task(slot);
+        CHECK(sender.schedule_and_wait(task));
+        CHECK(task.success());
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -214,6 +214,177 @@ TEST(sender_sink, basic) {
     packet_reader.read_eof();
 }
 
+// Two slots with identical transport share encoding.
+// Both receive complete streams with different identifiers.
+TEST(sender_sink, shared_encoding) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo };
+
+    init(Rate, Chans, Rate, Chans);
+
+    packet::Queue queue1;
+    packet::Queue queue2;
+
+    SenderSinkConfig config = make_config();
+    config.enable_shared_encoding = true;
+
+    SenderSink sender(config, encoding_map, packet_pool, packet_buffer_pool,
+                      frame_buffer_pool, arena);
+    CHECK(sender.is_valid());
+
+    SenderSlot* slot1 = create_slot(sender);
+    create_transport_endpoint(slot1, address::Iface_AudioSource, proto, dst_addr1,
+                              queue1);
+
+    SenderSlot* slot2 = create_slot(sender);
+    create_transport_endpoint(slot2, address::Iface_AudioSource, proto, dst_addr2,
+                              queue2);
+
+    UNSIGNED_LONGS_EQUAL(2, sender.num_sessions());
+
+    test::FrameWriter frame_writer(sender, frame_factory);
+
+    test::PacketReader packet_reader1(arena, queue1, encoding_map, packet_factory,
+                                      dst_addr1, PayloadType_Ch2);
+    test::PacketReader packet_reader2(arena, queue2, encoding_map, packet_factory,
+                                      dst_addr2, PayloadType_Ch2);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame, input_sample_spec);
+        sender.refresh(frame_writer.refresh_ts());
+    }
+
+    for (size_t np = 0; np < ManyFrames / FramesPerPacket; np++) {
+        packet_reader1.read_packet(SamplesPerPacket, packet_sample_spec);
+        packet_reader2.read_packet(SamplesPerPacket, packet_sample_spec);
+    }
+
+    packet_reader1.read_eof();
+    packet_reader2.read_eof();
+
+    {
+        SenderSlotMetrics slot_metrics1;
+        slot1->get_metrics(slot_metrics1, NULL, NULL);
+
+        SenderSlotMetrics slot_metrics2;
+        slot2->get_metrics(slot_metrics2, NULL, NULL);
+
+        CHECK(slot_metrics1.is_complete);
+        CHECK(slot_metrics2.is_complete);
+
+        CHECK(slot_metrics1.source_id != slot_metrics2.source_id);
+    }
+
+    // Remove slot that encodes packets, second slot should continue
+    // receiving packets.
+    sender.delete_slot(slot1);
+
+    UNSIGNED_LONGS_EQUAL(1, sender.num_sessions());
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame, input_sample_spec);
+        sender.refresh(frame_writer.refresh_ts());
+    }
+
+    for (size_t np = 0; np < ManyFrames / FramesPerPacket; np++) {
+        packet_reader2.read_packet(SamplesPerPacket, packet_sample_spec);
+    }
+
+    packet_reader1.read_eof();
+    packet_reader2.read_eof();
+}
+
+// Removed slot that encodes packets for another slot sends goodbye to its
+// receivers, while second slot continues sending reports.
+TEST(sender_sink, shared_encoding_goodbye) {
+    enum { Rate = SampleRate, Chans = Chans_Stereo };
+
+    init(Rate, Chans, Rate, Chans);
+
+    packet::Queue queue1;
+    packet::Queue queue2;
+    packet::Queue control_queue1;
+    packet::Queue control_queue2;
+
+    SenderSinkConfig config = make_config();
+    config.enable_shared_encoding = true;
+
+    SenderSink sender(config, encoding_map, packet_pool, packet_buffer_pool,
+                      frame_buffer_pool, arena);
+    CHECK(sender.is_valid());
+
+    SenderSlot* slot1 = create_slot(sender);
+    create_transport_endpoint(slot1, address::Iface_AudioSource, proto, dst_addr1,
+                              queue1);
+    CHECK(create_control_endpoint(slot1, address::Iface_AudioControl,
+                                  address::Proto_RTCP, dst_addr1, control_queue1));
+
+    SenderSlot* slot2 = create_slot(sender);
+    create_transport_endpoint(slot2, address::Iface_AudioSource, proto, dst_addr2,
+                              queue2);
+    CHECK(create_control_endpoint(slot2, address::Iface_AudioControl,
+                                  address::Proto_RTCP, dst_addr2, control_queue2));
+
+    packet::stream_source_t send_src_id1 = 0;
+    packet::stream_source_t send_src_id2 = 0;
+
+    {
+        SenderSlotMetrics slot_metrics;
+        slot1->get_metrics(slot_metrics, NULL, NULL);
+        send_src_id1 = slot_metrics.source_id;
+        slot2->get_metrics(slot_metrics, NULL, NULL);
+        send_src_id2 = slot_metrics.source_id;
+    }
+
+    test::FrameWriter frame_writer(sender, frame_factory);
+
+    test::ControlReader control_reader1(control_queue1);
+    test::ControlReader control_reader2(control_queue2);
+
+    const core::nanoseconds_t unix_base = 1000000000000000;
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame, input_sample_spec, unix_base);
+        sender.refresh(frame_writer.refresh_ts());
+    }
+
+    while (control_queue1.size() != 0) {
+        control_reader1.read_report();
+        CHECK(!control_reader1.has_bye());
+    }
+
+    const size_t queue1_size = queue1.size();
+    const size_t queue2_size = queue2.size();
+
+    sender.delete_slot(slot1);
+
+    control_reader1.read_report();
+    CHECK(control_reader1.has_bye(send_src_id1));
+    UNSIGNED_LONGS_EQUAL(0, control_queue1.size());
+
+    while (control_queue2.size() != 0) {
+        control_reader2.read_report();
+    }
+
+    for (size_t np = 0; np < (ReportInterval / SamplesPerPacket) * 2; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_writer.write_samples(SamplesPerFrame, input_sample_spec, unix_base);
+            sender.refresh(frame_writer.refresh_ts());
+        }
+    }
+
+    CHECK(control_queue2.size() > 0);
+    while (control_queue2.size() != 0) {
+        control_reader2.read_report();
+        CHECK(control_reader2.has_sr(send_src_id2));
+        CHECK(!control_reader2.has_bye());
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, control_queue1.size());
+    UNSIGNED_LONGS_EQUAL(queue1_size, queue1.size());
+
+    CHECK(queue2.size() > queue2_size);
+}
+
 // Frames smaller than packets.
 TEST(sender_sink, frame_size_small) {
     enum {
@@ -876,5 +1047,44 @@ TEST(sender_sink, reports_two_receivers) {
     }
 }
 
+// Check per-stage timing metrics.
+TEST(sender_sink, metrics_stage_timing) {
+    enum { Rate = SampleRate, InputChans = Chans_Stereo, PacketChans = Chans_Mono };
+
+    init(Rate, InputChans, Rate, PacketChans);
+
+    packet::Queue queue;
+
+    SenderSinkConfig config = make_config();
+    config.enable_stage_timing = true;
+
+    SenderSink sender(config, encoding_map, packet_pool, packet_buffer_pool,
+                      frame_buffer_pool, arena);
+    CHECK(sender.is_valid());
+
+    SenderSlot* slot = create_slot(sender);
+    CHECK(slot);
+    create_transport_endpoint(slot, address::Iface_AudioSource, proto, dst_addr1, queue);
+
+    test::FrameWriter frame_writer(sender, frame_factory);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame, input_sample_spec);
+        sender.refresh(frame_writer.refresh_ts());
+    }
+
+    SenderSlotMetrics slot_metrics;
+    slot->get_metrics(slot_metrics, NULL, NULL);
+
+    UNSIGNED_LONGS_EQUAL(ManyFrames, slot_metrics.channel_mapper_timing.count);
+    UNSIGNED_LONGS_EQUAL(ManyFrames, slot_metrics.packetizer_timing.count);
+    CHECK(slot_metrics.packetizer_timing.max > 0);
+    CHECK(slot_metrics.packetizer_timing.max >= slot_metrics.packetizer_timing.p999);
+
+    // no resampler and no fec
+    UNSIGNED_LONGS_EQUAL(0, slot_metrics.resampler_timing.count);
+    UNSIGNED_LONGS_EQUAL(0, slot_metrics.fec_writer_timing.count);
+}
+
 } // namespace pipeline
 } // namespace roc
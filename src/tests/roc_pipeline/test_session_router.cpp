@@ -62,10 +62,10 @@ TEST_GROUP(session_router) {
 
             sess1 =
                 new (arena) ReceiverSession(session_config, common_config, encoding_map,
-                                            packet_factory, frame_factory, arena);
+                                            packet_factory, frame_factory, NULL, arena);
             sess2 =
                 new (arena) ReceiverSession(session_config, common_config, encoding_map,
-                                            packet_factory, frame_factory, arena);
+                                            packet_factory, frame_factory, NULL, arena);
         }
     }
 };
@@ -816,5 +816,105 @@ TEST(session_router, conflict_address_exists) {
     CHECK(!router.find_by_address(addr2));
 }
 
+TEST(session_router, cache_hit_miss) {
+    ReceiverSessionRouter router(arena);
+
+    LONGS_EQUAL(status::StatusOK, router.add_session(sess1, ssrc1, addr1));
+    LONGS_EQUAL(status::StatusOK, router.add_session(sess2, ssrc2, addr2));
+
+    LONGS_EQUAL(0, router.num_cache_hits());
+    LONGS_EQUAL(0, router.num_cache_misses());
+
+    CHECK(router.find_session(true, ssrc1, addr1) == sess1);
+    CHECK(router.find_session(true, ssrc2, addr2) == sess2);
+
+    LONGS_EQUAL(0, router.num_cache_hits());
+    LONGS_EQUAL(2, router.num_cache_misses());
+
+    for (int n = 0; n < 10; n++) {
+        CHECK(router.find_session(true, ssrc1, addr1) == sess1);
+        CHECK(router.find_session(true, ssrc2, addr2) == sess2);
+    }
+
+    LONGS_EQUAL(20, router.num_cache_hits());
+    LONGS_EQUAL(2, router.num_cache_misses());
+
+    // unknown stream is not cached
+    CHECK(!router.find_session(true, ssrc3, address::SocketAddr()));
+    CHECK(!router.find_session(true, ssrc3, address::SocketAddr()));
+
+    LONGS_EQUAL(20, router.num_cache_hits());
+    LONGS_EQUAL(4, router.num_cache_misses());
+}
+
+TEST(session_router, cache_address_fallback) {
+    ReceiverSessionRouter router(arena);
+
+    LONGS_EQUAL(status::StatusOK, router.add_session(sess1, ssrc1, addr1));
+
+    // no source id
+    CHECK(router.find_session(false, 0, addr1) == sess1);
+    CHECK(router.find_session(false, 0, addr1) == sess1);
+
+    // unknown source id, known address
+    CHECK(router.find_session(true, ssrc3, addr1) == sess1);
+    CHECK(router.find_session(true, ssrc3, addr1) == sess1);
+
+    // unknown address
+    CHECK(!router.find_session(false, 0, addr2));
+
+    LONGS_EQUAL(2, router.num_cache_hits());
+    LONGS_EQUAL(3, router.num_cache_misses());
+}
+
+TEST(session_router, cache_invalidate_remove_session) {
+    ReceiverSessionRouter router(arena);
+
+    LONGS_EQUAL(status::StatusOK, router.add_session(sess1, ssrc1, addr1));
+
+    CHECK(router.find_session(true, ssrc1, addr1) == sess1);
+    CHECK(router.find_session(true, ssrc1, addr1) == sess1);
+
+    router.remove_session(sess1);
+
+    CHECK(!router.find_session(true, ssrc1, addr1));
+
+    LONGS_EQUAL(status::StatusOK, router.add_session(sess2, ssrc1, addr1));
+
+    CHECK(router.find_session(true, ssrc1, addr1) == sess2);
+    CHECK(router.find_session(true, ssrc1, addr1) == sess2);
+
+    LONGS_EQUAL(2, router.num_cache_hits());
+    LONGS_EQUAL(3, router.num_cache_misses());
+}
+
+TEST(session_router, cache_invalidate_link_unlink) {
+    ReceiverSessionRouter router(arena);
+
+    LONGS_EQUAL(status::StatusOK, router.add_session(sess1, ssrc1, addr1));
+    LONGS_EQUAL(status::StatusOK, router.link_source(ssrc1, cname1));
+
+    LONGS_EQUAL(status::StatusOK, router.add_session(sess2, ssrc2, addr2));
+    LONGS_EQUAL(status::StatusOK, router.link_source(ssrc2, cname2));
+
+    // ssrc3 is unknown, routed by address
+    CHECK(router.find_session(true, ssrc3, addr2) == sess2);
+    CHECK(router.find_session(true, ssrc3, addr2) == sess2);
+
+    // ssrc3 is linked to first session, cached result should not be used
+    LONGS_EQUAL(status::StatusOK, router.link_source(ssrc3, cname1));
+
+    CHECK(router.find_session(true, ssrc3, addr2) == sess1);
+    CHECK(router.find_session(true, ssrc3, addr2) == sess1);
+
+    // ssrc3 is unlinked, routed by address again
+    router.unlink_source(ssrc3);
+
+    CHECK(router.find_session(true, ssrc3, addr2) == sess2);
+
+    LONGS_EQUAL(2, router.num_cache_hits());
+    LONGS_EQUAL(3, router.num_cache_misses());
+}
+
 } // namespace pipeline
 } // namespace roc
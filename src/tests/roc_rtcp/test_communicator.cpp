@@ -1334,6 +1334,80 @@ TEST(communicator, halt_goodbye) {
     CHECK_EQUAL(SendSsrc, recv_part.next_halt_notification());
 }
 
+// Check goodbye when sender already discovered receiver
+TEST(communicator, halt_goodbye_known_receiver) {
+    enum { SendSsrc = 11, RecvSsrc = 22 };
+
+    const char* SendCname = "send_cname";
+    const char* RecvCname = "recv_cname";
+
+    Config config;
+
+    packet::Queue send_queue;
+    MockParticipant send_part(SendCname, SendSsrc, Report_ToAddress);
+    Communicator send_comm(config, send_part, send_queue, composer, packet_factory,
+                           arena);
+    CHECK(send_comm.is_valid());
+
+    packet::Queue recv_queue;
+    MockParticipant recv_part(RecvCname, RecvSsrc, Report_Back);
+    Communicator recv_comm(config, recv_part, recv_queue, composer, packet_factory,
+                           arena);
+    CHECK(recv_comm.is_valid());
+
+    core::nanoseconds_t send_time = 10000000000000000;
+    core::nanoseconds_t recv_time = 30000000000000000;
+
+    // Generate sender report
+    send_part.set_send_report(make_send_report(send_time, SendCname, SendSsrc, Seed1));
+    LONGS_EQUAL(status::StatusOK, send_comm.generate_reports(send_time));
+    CHECK_EQUAL(1, send_queue.size());
+
+    // Deliver sender report to receiver
+    LONGS_EQUAL(status::StatusOK,
+                recv_comm.process_packet(read_packet(send_queue), recv_time));
+    CHECK_EQUAL(1, recv_part.pending_notifications());
+    expect_send_report(recv_part.next_send_notification(), send_time, SendCname, SendSsrc,
+                       Seed1);
+
+    advance_time(send_time);
+    advance_time(recv_time);
+
+    // Generate receiver report
+    recv_part.set_recv_report(
+        0, make_recv_report(recv_time, RecvCname, RecvSsrc, SendSsrc, Seed2));
+    LONGS_EQUAL(status::StatusOK, recv_comm.generate_reports(recv_time));
+    CHECK_EQUAL(1, recv_queue.size());
+
+    // Deliver receiver report to sender
+    send_part.set_send_report(make_send_report(send_time, SendCname, SendSsrc, Seed3));
+    LONGS_EQUAL(status::StatusOK,
+                send_comm.process_packet(read_packet(recv_queue), send_time));
+    CHECK_EQUAL(1, send_comm.total_streams());
+    CHECK_EQUAL(1, send_part.pending_notifications());
+    expect_recv_report(send_part.next_recv_notification(), recv_time, RecvCname, RecvSsrc,
+                       SendSsrc, Seed2);
+
+    advance_time(send_time);
+    advance_time(recv_time);
+
+    // Generate sender goodbye
+    send_part.set_send_report(make_send_report(send_time, SendCname, SendSsrc, Seed4));
+    LONGS_EQUAL(status::StatusOK, send_comm.generate_goodbye(send_time));
+    CHECK_EQUAL(1, send_queue.size());
+
+    // Deliver sender goodbye to receiver
+    recv_part.set_recv_report(
+        0, make_recv_report(recv_time, RecvCname, RecvSsrc, SendSsrc, Seed5));
+    LONGS_EQUAL(status::StatusOK,
+                recv_comm.process_packet(read_packet(send_queue), recv_time));
+    CHECK_EQUAL(0, recv_comm.total_streams());
+
+    // Check notifications on receiver
+    CHECK_EQUAL(1, recv_part.pending_notifications());
+    CHECK_EQUAL(SendSsrc, recv_part.next_halt_notification());
+}
+
 // Check how stream is terminated when we don't hear from it during timeout
 TEST(communicator, halt_timeout) {
     enum { SendSsrc1 = 11, SendSsrc2 = 22, RecvSsrc = 33, NumIters = 10 };
@@ -55,5 +55,34 @@ TEST(loss_estimator, jump_nackwards) {
     DOUBLES_EQUAL(0.2, le.update(20, 8), Epsilon);
 }
 
+TEST(loss_estimator, new_packets) {
+    LossEstimator le;
+
+    CHECK(!le.has_new_packets(0));
+    CHECK(le.has_new_packets(10));
+
+    DOUBLES_EQUAL(0.1, le.update(10, 1), Epsilon);
+
+    CHECK(!le.has_new_packets(10));
+    CHECK(!le.has_new_packets(5));
+    CHECK(le.has_new_packets(11));
+}
+
+TEST(loss_estimator, reset) {
+    LossEstimator le;
+
+    // +100, +10
+    DOUBLES_EQUAL(0.1, le.update(100, 10), Epsilon);
+
+    // counters of another receiver
+    le.reset();
+
+    CHECK(le.has_new_packets(20));
+    // +20, +5
+    DOUBLES_EQUAL(0.25, le.update(20, 5), Epsilon);
+    // +20, +2
+    DOUBLES_EQUAL(0.1, le.update(40, 7), Epsilon);
+}
+
 } // namespace rtcp
 } // namespace roc
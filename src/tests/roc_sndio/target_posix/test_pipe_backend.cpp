@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/temp_file.h"
+#include "roc_core/thread.h"
+#include "roc_sndio/backend_map.h"
+#include "roc_sndio/pipe_sink.h"
+#include "roc_sndio/pipe_source.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum {
+    SampleRate = 44100,
+    FrameSize = 500,
+    // Larger than pipe block, to cover block refills.
+    NumFrames = 200
+};
+
+core::HeapArena arena;
+
+Config make_config(audio::PcmFormat pcm_format) {
+    Config config;
+    config.sample_spec =
+        audio::SampleSpec(SampleRate, pcm_format, audio::ChanLayout_Surround,
+                          audio::ChanOrder_Smpte, audio::ChanMask_Surround_Stereo);
+    return config;
+}
+
+audio::sample_t nth_sample(size_t n) {
+    return audio::sample_t((int)(n * 97 % 2000) - 1000) / 1024;
+}
+
+void write_samples(PipeSink& sink) {
+    audio::sample_t samples[FrameSize];
+
+    for (size_t n_frame = 0; n_frame < NumFrames; n_frame++) {
+        for (size_t n = 0; n < FrameSize; n++) {
+            samples[n] = nth_sample(n_frame * FrameSize + n);
+        }
+        audio::Frame frame(samples, FrameSize);
+        sink.write(frame);
+    }
+}
+
+void read_samples(PipeSource& source, double epsilon) {
+    audio::sample_t samples[FrameSize];
+
+    for (size_t n_frame = 0; n_frame < NumFrames; n_frame++) {
+        audio::Frame frame(samples, FrameSize);
+        CHECK(source.read(frame));
+
+        for (size_t n = 0; n < FrameSize; n++) {
+            DOUBLES_EQUAL((double)nth_sample(n_frame * FrameSize + n),
+                          (double)samples[n], epsilon);
+        }
+    }
+
+    audio::Frame frame(samples, FrameSize);
+    CHECK(!source.read(frame));
+}
+
+class WriterThread : public core::Thread {
+public:
+    WriterThread(const char* path, audio::PcmFormat pcm_format)
+        : path_(path)
+        , pcm_format_(pcm_format) {
+    }
+
+private:
+    virtual void run() {
+        PipeSink sink(arena, make_config(pcm_format_));
+        CHECK(sink.is_valid());
+        CHECK(sink.open(path_));
+
+        write_samples(sink);
+    }
+
+    const char* path_;
+    audio::PcmFormat pcm_format_;
+};
+
+} // namespace
+
+TEST_GROUP(pipe_backend) {};
+
+TEST(pipe_backend, file_raw) {
+    core::TempFile file("test.raw");
+
+    {
+        PipeSink sink(arena, make_config(audio::Sample_RawFormat));
+        CHECK(sink.is_valid());
+        CHECK(sink.open(file.path()));
+
+        CHECK(sink.sample_spec().is_raw());
+        UNSIGNED_LONGS_EQUAL(SampleRate, sink.sample_spec().sample_rate());
+
+        write_samples(sink);
+    }
+
+    {
+        // headerless stream of native floats
+        struct stat st;
+        CHECK(stat(file.path(), &st) == 0);
+        LONGS_EQUAL(NumFrames * FrameSize * sizeof(audio::sample_t), st.st_size);
+    }
+
+    PipeSource source(arena, make_config(audio::Sample_RawFormat));
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    CHECK(source.sample_spec().is_raw());
+    UNSIGNED_LONGS_EQUAL(SampleRate, source.sample_spec().sample_rate());
+    UNSIGNED_LONGS_EQUAL(2, source.sample_spec().num_channels());
+
+    for (int pass = 0; pass < 2; pass++) {
+        read_samples(source, 0);
+
+        // regular file can be restarted
+        CHECK(source.restart());
+    }
+}
+
+TEST(pipe_backend, file_s16) {
+    core::TempFile file("test.raw");
+
+    {
+        PipeSink sink(arena, make_config(audio::PcmFormat_SInt16_Le));
+        CHECK(sink.is_valid());
+        CHECK(sink.open(file.path()));
+
+        write_samples(sink);
+    }
+
+    {
+        struct stat st;
+        CHECK(stat(file.path(), &st) == 0);
+        LONGS_EQUAL(NumFrames * FrameSize * sizeof(int16_t), st.st_size);
+    }
+
+    PipeSource source(arena, make_config(audio::PcmFormat_SInt16_Le));
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    CHECK(source.sample_spec().is_raw());
+
+    read_samples(source, 0.0001);
+}
+
+TEST(pipe_backend, file_packed) {
+    core::TempFile file("test.raw");
+
+    {
+        PipeSink sink(arena, make_config(audio::PcmFormat_SInt20_Be));
+        CHECK(sink.is_valid());
+        CHECK(sink.open(file.path()));
+
+        write_samples(sink);
+    }
+
+    {
+        // 20 bits per sample without padding
+        struct stat st;
+        CHECK(stat(file.path(), &st) == 0);
+        LONGS_EQUAL((NumFrames * FrameSize * 20 + 7) / 8, st.st_size);
+    }
+
+    PipeSource source(arena, make_config(audio::PcmFormat_SInt20_Be));
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    read_samples(source, 0.0001);
+}
+
+TEST(pipe_backend, fifo) {
+    core::TempFile file("test.fifo");
+    CHECK(unlink(file.path()) == 0);
+    CHECK(mkfifo(file.path(), 0600) == 0);
+
+    WriterThread writer(file.path(), audio::PcmFormat_SInt24_Le);
+    CHECK(writer.start());
+
+    PipeSource source(arena, make_config(audio::PcmFormat_SInt24_Le));
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    read_samples(source, 0.0001);
+
+    // fifo can't be restarted
+    CHECK(!source.restart());
+
+    writer.join();
+}
+
+TEST(pipe_backend, explicit_driver) {
+    core::TempFile file("test.raw");
+
+    for (size_t n = 0; n < BackendMap::instance().num_backends(); n++) {
+        IBackend& backend = BackendMap::instance().nth_backend(n);
+        if (strcmp(backend.name(), "pipe") != 0) {
+            continue;
+        }
+
+        // not auto-detected
+        CHECK(!backend.open_device(DeviceType_Sink, DriverType_File, NULL, file.path(),
+                                   make_config(audio::Sample_RawFormat), arena));
+
+        IDevice* device =
+            backend.open_device(DeviceType_Sink, DriverType_File, "raw", file.path(),
+                                make_config(audio::Sample_RawFormat), arena);
+        CHECK(device);
+        CHECK(device->to_sink());
+
+        core::ScopedPtr<ISink> sink(device->to_sink(), arena);
+
+        return;
+    }
+
+    FAIL("pipe backend not registered");
+}
+
+} // namespace sndio
+} // namespace roc
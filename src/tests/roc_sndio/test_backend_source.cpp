@@ -92,7 +92,7 @@ TEST(backend_source, open) {
             CHECK(backend_sink != NULL);
 
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
         }
@@ -138,7 +138,7 @@ TEST(backend_source, has_clock) {
             CHECK(backend_sink != NULL);
 
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
         }
@@ -173,7 +173,7 @@ TEST(backend_source, sample_rate_auto) {
             CHECK(backend_sink != NULL);
 
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
         }
@@ -211,7 +211,7 @@ TEST(backend_source, sample_rate_mismatch) {
             CHECK(backend_sink != NULL);
 
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
         }
@@ -246,7 +246,7 @@ TEST(backend_source, pause_resume) {
             CHECK(backend_sink != NULL);
 
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
         }
@@ -315,7 +315,7 @@ TEST(backend_source, pause_restart) {
             CHECK(backend_sink != NULL);
 
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
         }
@@ -385,7 +385,7 @@ TEST(backend_source, eof_restart) {
             CHECK(backend_sink != NULL);
 
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
         }
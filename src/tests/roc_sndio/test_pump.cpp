@@ -52,6 +52,23 @@ bool supports_wav(IBackend& backend) {
     return supports;
 }
 
+// Source with clock, which can't be blocked by pump.
+class ClockedMockSource : public test::MockSource {
+public:
+    virtual bool has_clock() const {
+        return true;
+    }
+};
+
+// Sink which is slower than source.
+class SlowMockSink : public test::MockSink {
+public:
+    virtual void write(audio::Frame& frame) {
+        core::sleep_for(core::ClockMonotonic, core::Millisecond);
+        test::MockSink::write(frame);
+    }
+};
+
 } // namespace
 
 TEST_GROUP(pump) {
@@ -92,7 +109,7 @@ TEST(pump, write_read) {
             core::ScopedPtr<ISink> backend_sink(backend_device->to_sink(), arena);
             CHECK(backend_sink != NULL);
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
 
@@ -108,7 +125,7 @@ TEST(pump, write_read) {
         test::MockSink mock_writer;
 
         Pump pump(buffer_pool, *backend_source, NULL, mock_writer, frame_duration,
-                  sample_spec, Pump::ModePermanent);
+                  sample_spec, Pump::ModePermanent, 0);
         CHECK(pump.is_valid());
         CHECK(pump.run());
 
@@ -138,7 +155,7 @@ TEST(pump, write_overwrite_read) {
             core::ScopedPtr<ISink> backend_sink(backend_device->to_sink(), arena);
             CHECK(backend_sink != NULL);
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
         }
@@ -155,7 +172,7 @@ TEST(pump, write_overwrite_read) {
             core::ScopedPtr<ISink> backend_sink(backend_device->to_sink(), arena);
             CHECK(backend_sink != NULL);
             Pump pump(buffer_pool, mock_source, NULL, *backend_sink, frame_duration,
-                      sample_spec, Pump::ModeOneshot);
+                      sample_spec, Pump::ModeOneshot, 0);
             CHECK(pump.is_valid());
             CHECK(pump.run());
         }
@@ -172,12 +189,52 @@ TEST(pump, write_overwrite_read) {
         test::MockSink mock_writer;
 
         Pump pump(buffer_pool, *backend_source, NULL, mock_writer, frame_duration,
-                  sample_spec, Pump::ModePermanent);
+                  sample_spec, Pump::ModePermanent, 0);
         CHECK(pump.is_valid());
         CHECK(pump.run());
 
         mock_writer.check(num_returned1, num_returned2);
     }
 }
+
+TEST(pump, pipelined) {
+    enum { NumSamples = FrameSize * 100, PipelineDepth = 4 };
+
+    test::MockSource mock_source;
+    mock_source.add(NumSamples);
+
+    test::MockSink mock_sink;
+
+    Pump pump(buffer_pool, mock_source, NULL, mock_sink, frame_duration, sample_spec,
+              Pump::ModeOneshot, PipelineDepth);
+    CHECK(pump.is_valid());
+    CHECK(pump.run());
+
+    // all frames are delivered in order
+    mock_sink.check(0, NumSamples);
+
+    // neither source nor sink has clock
+    UNSIGNED_LONGS_EQUAL(0, pump.num_stalls());
+    UNSIGNED_LONGS_EQUAL(0, pump.num_overruns());
+}
+
+TEST(pump, pipelined_overrun) {
+    enum { NumSamples = FrameSize * 20, PipelineDepth = 1 };
+
+    ClockedMockSource mock_source;
+    mock_source.add(NumSamples);
+
+    SlowMockSink mock_sink;
+
+    Pump pump(buffer_pool, mock_source, NULL, mock_sink, frame_duration, sample_spec,
+              Pump::ModeOneshot, PipelineDepth);
+    CHECK(pump.is_valid());
+    CHECK(pump.run());
+
+    // clocked source was not blocked by slow sink, frames were dropped instead
+    CHECK(pump.num_overruns() > 0);
+    UNSIGNED_LONGS_EQUAL(0, pump.num_stalls());
+}
+
 } // namespace sndio
 } // namespace roc
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/endian_ops.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/temp_file.h"
+#include "roc_sndio/wav_sink.h"
+#include "roc_sndio/wav_source.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum {
+    NumChans = 2,
+    SampleRate = 44100,
+    FrameSize = 64,
+    NumSamples = FrameSize * 3 + 10
+};
+
+core::HeapArena arena;
+
+void write_u16(FILE* fp, uint16_t v) {
+    v = core::EndianOps::swap_native_le(v);
+    CHECK(fwrite(&v, sizeof(v), 1, fp) == 1);
+}
+
+void write_u32(FILE* fp, uint32_t v) {
+    v = core::EndianOps::swap_native_le(v);
+    CHECK(fwrite(&v, sizeof(v), 1, fp) == 1);
+}
+
+int16_t nth_sample(size_t n) {
+    return int16_t((int)(n * 97 % 65536) - 32768);
+}
+
+// Write 16-bit PCM WAV file.
+void write_s16_wav(const char* path) {
+    FILE* fp = fopen(path, "wb");
+    CHECK(fp);
+
+    const uint32_t data_size = NumSamples * sizeof(int16_t);
+
+    CHECK(fwrite("RIFF", 4, 1, fp) == 1);
+    write_u32(fp, 36 + data_size);
+    CHECK(fwrite("WAVEfmt ", 8, 1, fp) == 1);
+    write_u32(fp, 16);
+    write_u16(fp, 1); // PCM
+    write_u16(fp, NumChans);
+    write_u32(fp, SampleRate);
+    write_u32(fp, SampleRate * NumChans * sizeof(int16_t));
+    write_u16(fp, NumChans * sizeof(int16_t));
+    write_u16(fp, 16);
+    CHECK(fwrite("data", 4, 1, fp) == 1);
+    write_u32(fp, data_size);
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        write_u16(fp, (uint16_t)nth_sample(n));
+    }
+
+    fclose(fp);
+}
+
+} // namespace
+
+TEST_GROUP(wav_source) {};
+
+TEST(wav_source, read_s16) {
+    core::TempFile file("test.wav");
+    write_s16_wav(file.path());
+
+    WavSource source(arena, Config());
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    UNSIGNED_LONGS_EQUAL(SampleRate, source.sample_spec().sample_rate());
+    UNSIGNED_LONGS_EQUAL(NumChans, source.sample_spec().num_channels());
+
+    for (int pass = 0; pass < 2; pass++) {
+        size_t pos = 0;
+
+        audio::sample_t samples[FrameSize];
+
+        for (;;) {
+            audio::Frame frame(samples, FrameSize);
+            if (!source.read(frame)) {
+                break;
+            }
+
+            for (size_t n = 0; n < FrameSize; n++) {
+                // tail of last frame is zeroed
+                const double expected =
+                    pos < NumSamples ? (double)nth_sample(pos) / 32768.0 : 0.0;
+                DOUBLES_EQUAL(expected, (double)samples[n], 0.0001);
+                pos++;
+            }
+        }
+
+        UNSIGNED_LONGS_EQUAL((NumSamples + FrameSize - 1) / FrameSize * FrameSize, pos);
+
+        // same samples after restart
+        CHECK(source.restart());
+    }
+}
+
+TEST(wav_source, sink_to_source) {
+    core::TempFile file("test.wav");
+
+    audio::sample_t samples[FrameSize];
+
+    {
+        Config config;
+        config.sample_spec =
+            audio::SampleSpec(SampleRate, audio::Sample_RawFormat,
+                              audio::ChanLayout_Surround, audio::ChanOrder_Smpte,
+                              audio::ChanMask_Surround_Stereo);
+
+        WavSink sink(arena, config);
+        CHECK(sink.is_valid());
+        CHECK(sink.open(file.path()));
+
+        for (size_t n_frame = 0; n_frame < 3; n_frame++) {
+            for (size_t n = 0; n < FrameSize; n++) {
+                samples[n] = audio::sample_t(n_frame * FrameSize + n) / 1000;
+            }
+            audio::Frame frame(samples, FrameSize);
+            sink.write(frame);
+        }
+    }
+
+    {
+        // file is truncated to written size
+        FILE* fp = fopen(file.path(), "rb");
+        CHECK(fp);
+        CHECK(fseek(fp, 0, SEEK_END) == 0);
+        LONGS_EQUAL(44 + 3 * FrameSize * sizeof(audio::sample_t), ftell(fp));
+        fclose(fp);
+    }
+
+    WavSource source(arena, Config());
+    CHECK(source.is_valid());
+    CHECK(source.open(file.path()));
+
+    UNSIGNED_LONGS_EQUAL(NumChans, source.sample_spec().num_channels());
+
+    for (size_t n_frame = 0; n_frame < 3; n_frame++) {
+        audio::Frame frame(samples, FrameSize);
+        CHECK(source.read(frame));
+
+        for (size_t n = 0; n < FrameSize; n++) {
+            DOUBLES_EQUAL((double)(n_frame * FrameSize + n) / 1000, (double)samples[n],
+                          0.0001);
+        }
+    }
+
+    audio::Frame frame(samples, FrameSize);
+    CHECK(!source.read(frame));
+}
+
+} // namespace sndio
+} // namespace roc
@@ -7,11 +7,16 @@
  */
 
 #include "roc_address/io_uri.h"
+#include "roc_audio/sample_spec.h"
 #include "roc_core/crash_handler.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/log.h"
+#include "roc_core/optional.h"
 #include "roc_core/parse_units.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
+#include "roc_pipeline/chunked_transcoder_sink.h"
 #include "roc_pipeline/transcoder_sink.h"
 #include "roc_sndio/backend_dispatcher.h"
 #include "roc_sndio/backend_map.h"
@@ -72,6 +77,20 @@ int main(int argc, char** argv) {
         transcoder_config.input_sample_spec.channel_set());
     source_config.sample_spec.set_sample_rate(0);
 
+    if (args.input_encoding_given) {
+        if (!audio::parse_sample_spec(args.input_encoding_arg,
+                                      source_config.sample_spec)) {
+            roc_log(LogError, "invalid --input-encoding");
+            return 1;
+        }
+        if (source_config.sample_spec.num_channels() == 0) {
+            source_config.sample_spec.set_channel_set(
+                transcoder_config.input_sample_spec.channel_set());
+        }
+        transcoder_config.input_sample_spec.set_channel_set(
+            source_config.sample_spec.channel_set());
+    }
+
     if (args.frame_len_given) {
         if (!core::parse_duration(args.frame_len_arg, source_config.frame_length)) {
             roc_log(LogError, "invalid --frame-len: bad format");
@@ -170,6 +189,26 @@ int main(int argc, char** argv) {
     sink_config.sample_spec = transcoder_config.output_sample_spec;
     sink_config.frame_length = source_config.frame_length;
 
+    if (args.output_encoding_given) {
+        if (!audio::parse_sample_spec(args.output_encoding_arg,
+                                      sink_config.sample_spec)) {
+            roc_log(LogError, "invalid --output-encoding");
+            return 1;
+        }
+        if (sink_config.sample_spec.sample_rate() == 0) {
+            sink_config.sample_spec.set_sample_rate(
+                transcoder_config.output_sample_spec.sample_rate());
+        }
+        if (sink_config.sample_spec.num_channels() == 0) {
+            sink_config.sample_spec.set_channel_set(
+                transcoder_config.output_sample_spec.channel_set());
+        }
+        transcoder_config.output_sample_spec.set_sample_rate(
+            sink_config.sample_spec.sample_rate());
+        transcoder_config.output_sample_spec.set_channel_set(
+            sink_config.sample_spec.channel_set());
+    }
+
     address::IoUri output_uri(arena);
     if (args.output_given) {
         if (!address::parse_io_uri(args.output_arg, output_uri)
@@ -204,22 +243,91 @@ int main(int argc, char** argv) {
         output_writer = output_sink.get();
     }
 
-    pipeline::TranscoderSink transcoder(transcoder_config, output_writer,
-                                        frame_buffer_pool, arena);
-    if (!transcoder.is_valid()) {
-        roc_log(LogError, "can't create transcoder pipeline");
-        return 1;
+    pipeline::ChunkedTranscoderConfig chunked_config;
+    chunked_config.frame_length = source_config.frame_length;
+
+    if (args.jobs_given) {
+        if (args.jobs_arg <= 0) {
+            roc_log(LogError, "invalid --jobs: should be > 0");
+            return 1;
+        }
+        chunked_config.num_threads = (size_t)args.jobs_arg;
+    } else {
+        chunked_config.num_threads = 1;
+    }
+
+    if (args.chunk_len_given) {
+        if (!core::parse_duration(args.chunk_len_arg, chunked_config.chunk_length)) {
+            roc_log(LogError, "invalid --chunk-len: bad format");
+            return 1;
+        }
+        if (chunked_config.chunk_length <= 0) {
+            roc_log(LogError, "invalid --chunk-len: should be > 0");
+            return 1;
+        }
     }
 
-    sndio::Pump pump(frame_buffer_pool, *input_source, NULL, transcoder,
+    core::Optional<pipeline::TranscoderSink> transcoder;
+    core::Optional<pipeline::ChunkedTranscoderSink> chunked_transcoder;
+
+    sndio::ISink* transcoder_sink = NULL;
+
+    if (chunked_config.num_threads > 1) {
+        chunked_transcoder.reset(new (chunked_transcoder) pipeline::ChunkedTranscoderSink(
+            transcoder_config, chunked_config, output_writer, frame_buffer_pool,
+            arena));
+        if (!chunked_transcoder->is_valid()) {
+            roc_log(LogError, "can't create transcoder pipeline");
+            return 1;
+        }
+        transcoder_sink = chunked_transcoder.get();
+    } else {
+        transcoder.reset(new (transcoder) pipeline::TranscoderSink(
+            transcoder_config, output_writer, frame_buffer_pool, arena));
+        if (!transcoder->is_valid()) {
+            roc_log(LogError, "can't create transcoder pipeline");
+            return 1;
+        }
+        transcoder_sink = transcoder.get();
+    }
+
+    size_t io_queue = 0;
+    if (args.io_queue_given) {
+        if (args.io_queue_arg < 0) {
+            roc_log(LogError, "invalid --io-queue: should be >= 0");
+            return 1;
+        }
+        io_queue = (size_t)args.io_queue_arg;
+    }
+
+    sndio::Pump pump(frame_buffer_pool, *input_source, NULL, *transcoder_sink,
                      source_config.frame_length, transcoder_config.input_sample_spec,
-                     sndio::Pump::ModePermanent);
+                     sndio::Pump::ModePermanent, io_queue);
     if (!pump.is_valid()) {
         roc_log(LogError, "can't create audio pump");
         return 1;
     }
 
-    const bool ok = pump.run();
+    if (args.pipeline_thread_given) {
+        core::ThreadPolicy pipeline_policy;
+        if (!core::parse_thread_policy(args.pipeline_thread_arg, pipeline_policy)) {
+            roc_log(LogError, "invalid --pipeline-thread: bad format");
+            return 1;
+        }
+        if (!core::Thread::apply_policy(pipeline_policy)) {
+            roc_log(LogError, "can't apply --pipeline-thread policy");
+            return 1;
+        }
+    }
+
+    bool ok = pump.run();
+
+    if (chunked_transcoder) {
+        if (!chunked_transcoder->flush()) {
+            roc_log(LogError, "can't transcode input");
+            ok = false;
+        }
+    }
 
     return ok ? 0 : 1;
 }
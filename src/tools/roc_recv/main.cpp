@@ -13,9 +13,14 @@
 #include "roc_core/crash_handler.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/log.h"
+#include "roc_core/optional.h"
 #include "roc_core/parse_units.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
 #include "roc_core/time.h"
+#include "roc_core/trace_dumper.h"
+#include "roc_core/tracer.h"
 #include "roc_netio/network_loop.h"
 #include "roc_node/context.h"
 #include "roc_node/receiver.h"
@@ -222,6 +227,22 @@ int main(int argc, char** argv) {
         break;
     }
 
+    if (args.sess_threads_given) {
+        if (args.sess_threads_arg < 0) {
+            roc_log(LogError, "invalid --sess-threads: should be >= 0");
+            return 1;
+        }
+        receiver_config.common.session_threads = (size_t)args.sess_threads_arg;
+    }
+
+    if (args.sess_pool_given) {
+        if (args.sess_pool_arg < 0) {
+            roc_log(LogError, "invalid --sess-pool: should be >= 0");
+            return 1;
+        }
+        receiver_config.common.session_pool_size = (size_t)args.sess_pool_arg;
+    }
+
     receiver_config.session_defaults.enable_beeping = args.beep_flag;
     receiver_config.common.enable_profiling = args.profiling_flag;
 
@@ -255,6 +276,22 @@ int main(int argc, char** argv) {
             spec.ns_2_samples_overall(io_config.frame_length) * sizeof(audio::sample_t);
     }
 
+    if (args.net_thread_given) {
+        if (!core::parse_thread_policy(args.net_thread_arg,
+                                       context_config.network_thread)) {
+            roc_log(LogError, "invalid --net-thread: bad format");
+            return 1;
+        }
+    }
+
+    if (args.ctl_thread_given) {
+        if (!core::parse_thread_policy(args.ctl_thread_arg,
+                                       context_config.control_thread)) {
+            roc_log(LogError, "invalid --ctl-thread: bad format");
+            return 1;
+        }
+    }
+
     node::Context context(context_config, heap_arena);
     if (!context.is_valid()) {
         roc_log(LogError, "can't initialize node context");
@@ -312,6 +349,20 @@ int main(int argc, char** argv) {
     }
 
     receiver_config.common.enable_timing = !output_sink->has_clock();
+    receiver_config.common.enable_precise_timing = args.precise_timing_flag;
+
+    if (args.precise_timing_margin_given) {
+        if (!core::parse_duration(args.precise_timing_margin_arg,
+                                  receiver_config.common.precise_timing_margin)) {
+            roc_log(LogError, "invalid --precise-timing-margin: bad format");
+            return 1;
+        }
+        if (receiver_config.common.precise_timing_margin <= 0) {
+            roc_log(LogError, "invalid --precise-timing-margin: should be > 0");
+            return 1;
+        }
+    }
+
     receiver_config.common.output_sample_spec = output_sink->sample_spec();
 
     if (!receiver_config.common.output_sample_spec.is_valid()) {
@@ -518,16 +569,64 @@ int main(int argc, char** argv) {
         }
     }
 
+    size_t io_queue = 0;
+    if (args.io_queue_given) {
+        if (args.io_queue_arg < 0) {
+            roc_log(LogError, "invalid --io-queue: should be >= 0");
+            return 1;
+        }
+        io_queue = (size_t)args.io_queue_arg;
+    }
+
     sndio::Pump pump(
         context.frame_buffer_pool(), receiver.source(), backup_pipeline.get(),
         *output_sink, io_config.frame_length, receiver_config.common.output_sample_spec,
-        args.oneshot_flag ? sndio::Pump::ModeOneshot : sndio::Pump::ModePermanent);
+        args.oneshot_flag ? sndio::Pump::ModeOneshot : sndio::Pump::ModePermanent,
+        io_queue);
     if (!pump.is_valid()) {
         roc_log(LogError, "can't create pump");
         return 1;
     }
 
+    if (args.pipeline_thread_given) {
+        core::ThreadPolicy pipeline_policy;
+        if (!core::parse_thread_policy(args.pipeline_thread_arg, pipeline_policy)) {
+            roc_log(LogError, "invalid --pipeline-thread: bad format");
+            return 1;
+        }
+        if (!core::Thread::apply_policy(pipeline_policy)) {
+            roc_log(LogError, "can't apply --pipeline-thread policy");
+            return 1;
+        }
+    }
+
+    core::Optional<core::TraceDumper> trace_dumper;
+    if (args.trace_given) {
+        if (!core::Tracer::is_compiled_in()) {
+            roc_log(LogError,
+                    "can't use --trace: tracing support is not compiled in,"
+                    " rebuild with --enable-tracing");
+            return 1;
+        }
+        trace_dumper.reset(new (trace_dumper) core::TraceDumper(
+            args.trace_arg, core::TraceDumperConfig(), core::Tracer::instance()));
+        if (!trace_dumper->is_valid()) {
+            roc_log(LogError, "can't open --trace file");
+            return 1;
+        }
+        if (!core::Tracer::instance().enable() || !trace_dumper->start()) {
+            roc_log(LogError, "can't start tracing");
+            return 1;
+        }
+    }
+
     const bool ok = pump.run();
 
+    if (trace_dumper) {
+        core::Tracer::instance().disable();
+        trace_dumper->stop();
+        trace_dumper->join();
+    }
+
     return ok ? 0 : 1;
 }
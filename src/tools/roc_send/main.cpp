@@ -13,9 +13,14 @@
 #include "roc_core/crash_handler.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/log.h"
+#include "roc_core/optional.h"
 #include "roc_core/parse_units.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_core/thread.h"
+#include "roc_core/thread_policy.h"
 #include "roc_core/time.h"
+#include "roc_core/trace_dumper.h"
+#include "roc_core/tracer.h"
 #include "roc_netio/network_loop.h"
 #include "roc_node/context.h"
 #include "roc_node/sender.h"
@@ -152,6 +157,42 @@ int main(int argc, char** argv) {
         sender_config.fec_writer.n_repair_packets = (size_t)args.nbrpr_arg;
     }
 
+    if (args.adaptive_fec_flag) {
+        if (sender_config.fec_encoder.scheme == packet::FEC_None) {
+            roc_log(LogError, "--adaptive-fec can't be used when fec is disabled");
+            return 1;
+        }
+        sender_config.fec_tuner.enable_tuning = true;
+    }
+
+    if (args.min_nbrpr_given) {
+        if (!sender_config.fec_tuner.enable_tuning) {
+            roc_log(LogError, "--min-nbrpr can't be used without --adaptive-fec");
+            return 1;
+        }
+        if (args.min_nbrpr_arg <= 0) {
+            roc_log(LogError, "invalid --min-nbrpr: should be > 0");
+            return 1;
+        }
+        sender_config.fec_tuner.min_repair_packets = (size_t)args.min_nbrpr_arg;
+    }
+
+    if (args.max_nbrpr_given) {
+        if (!sender_config.fec_tuner.enable_tuning) {
+            roc_log(LogError, "--max-nbrpr can't be used without --adaptive-fec");
+            return 1;
+        }
+        if (args.max_nbrpr_arg <= 0) {
+            roc_log(LogError, "invalid --max-nbrpr: should be > 0");
+            return 1;
+        }
+        if (args.min_nbrpr_given && args.max_nbrpr_arg < args.min_nbrpr_arg) {
+            roc_log(LogError, "invalid --max-nbrpr: should be >= --min-nbrpr");
+            return 1;
+        }
+        sender_config.fec_tuner.max_repair_packets = (size_t)args.max_nbrpr_arg;
+    }
+
     if (args.target_latency_given) {
         if (!core::parse_duration(args.target_latency_arg,
                                   sender_config.latency.target_latency)) {
@@ -230,6 +271,7 @@ int main(int argc, char** argv) {
     }
 
     sender_config.enable_interleaving = args.interleaving_flag;
+    sender_config.enable_shared_encoding = args.shared_encoding_flag;
     sender_config.enable_profiling = args.profiling_flag;
 
     node::ContextConfig context_config;
@@ -262,6 +304,22 @@ int main(int argc, char** argv) {
         }
     }
 
+    if (args.net_thread_given) {
+        if (!core::parse_thread_policy(args.net_thread_arg,
+                                       context_config.network_thread)) {
+            roc_log(LogError, "invalid --net-thread: bad format");
+            return 1;
+        }
+    }
+
+    if (args.ctl_thread_given) {
+        if (!core::parse_thread_policy(args.ctl_thread_arg,
+                                       context_config.control_thread)) {
+            roc_log(LogError, "invalid --ctl-thread: bad format");
+            return 1;
+        }
+    }
+
     node::Context context(context_config, heap_arena);
     if (!context.is_valid()) {
         roc_log(LogError, "can't initialize node context");
@@ -318,6 +376,20 @@ int main(int argc, char** argv) {
     }
 
     sender_config.enable_timing = !input_source->has_clock();
+    sender_config.enable_precise_timing = args.precise_timing_flag;
+
+    if (args.precise_timing_margin_given) {
+        if (!core::parse_duration(args.precise_timing_margin_arg,
+                                  sender_config.precise_timing_margin)) {
+            roc_log(LogError, "invalid --precise-timing-margin: bad format");
+            return 1;
+        }
+        if (sender_config.precise_timing_margin <= 0) {
+            roc_log(LogError, "invalid --precise-timing-margin: should be > 0");
+            return 1;
+        }
+    }
+
     sender_config.input_sample_spec = input_source->sample_spec();
 
     if (!sender_config.input_sample_spec.is_valid()) {
@@ -432,15 +504,62 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    size_t io_queue = 0;
+    if (args.io_queue_given) {
+        if (args.io_queue_arg < 0) {
+            roc_log(LogError, "invalid --io-queue: should be >= 0");
+            return 1;
+        }
+        io_queue = (size_t)args.io_queue_arg;
+    }
+
     sndio::Pump pump(context.frame_buffer_pool(), *input_source, NULL, sender.sink(),
                      io_config.frame_length, sender_config.input_sample_spec,
-                     sndio::Pump::ModePermanent);
+                     sndio::Pump::ModePermanent, io_queue);
     if (!pump.is_valid()) {
         roc_log(LogError, "can't create audio pump");
         return 1;
     }
 
+    if (args.pipeline_thread_given) {
+        core::ThreadPolicy pipeline_policy;
+        if (!core::parse_thread_policy(args.pipeline_thread_arg, pipeline_policy)) {
+            roc_log(LogError, "invalid --pipeline-thread: bad format");
+            return 1;
+        }
+        if (!core::Thread::apply_policy(pipeline_policy)) {
+            roc_log(LogError, "can't apply --pipeline-thread policy");
+            return 1;
+        }
+    }
+
+    core::Optional<core::TraceDumper> trace_dumper;
+    if (args.trace_given) {
+        if (!core::Tracer::is_compiled_in()) {
+            roc_log(LogError,
+                    "can't use --trace: tracing support is not compiled in,"
+                    " rebuild with --enable-tracing");
+            return 1;
+        }
+        trace_dumper.reset(new (trace_dumper) core::TraceDumper(
+            args.trace_arg, core::TraceDumperConfig(), core::Tracer::instance()));
+        if (!trace_dumper->is_valid()) {
+            roc_log(LogError, "can't open --trace file");
+            return 1;
+        }
+        if (!core::Tracer::instance().enable() || !trace_dumper->start()) {
+            roc_log(LogError, "can't start tracing");
+            return 1;
+        }
+    }
+
     const bool ok = pump.run();
 
+    if (trace_dumper) {
+        core::Tracer::instance().disable();
+        trace_dumper->stop();
+        trace_dumper->join();
+    }
+
     return ok ? 0 : 1;
 }